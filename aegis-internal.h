@@ -0,0 +1,94 @@
+/* aegis-internal.h
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_AEGIS_INTERNAL_H_INCLUDED
+#define NETTLE_AEGIS_INTERNAL_H_INCLUDED
+
+#include "aes-internal.h"
+
+/* One AES encryption round, as in the aesenc instruction, of the
+   words w (read in little-endian order), with round key k. The
+   output dst may alias k, but not w. */
+#define AEGIS_AES_ROUND(dst, w, k) do {					\
+    const struct aes_table *T_ = &_nettle_aes_encrypt_table;		\
+    (dst)[0] = AES_ROUND(T_, (w)[0], (w)[1], (w)[2], (w)[3], (k)[0]);	\
+    (dst)[1] = AES_ROUND(T_, (w)[1], (w)[2], (w)[3], (w)[0], (k)[1]);	\
+    (dst)[2] = AES_ROUND(T_, (w)[2], (w)[3], (w)[0], (w)[1], (k)[2]);	\
+    (dst)[3] = AES_ROUND(T_, (w)[3], (w)[0], (w)[1], (w)[2], (k)[3]);	\
+  } while (0)
+
+/* Native functions process as many full blocks as they can, and
+   return the number of bytes processed. The state is stored in the
+   byte order of the specification. */
+#if HAVE_NATIVE_aegis128l_encrypt
+
+/* Name mangling */
+#define _aegis128l_encrypt _nettle_aegis128l_encrypt
+#define _aegis128l_decrypt _nettle_aegis128l_decrypt
+#define _aegis256_encrypt _nettle_aegis256_encrypt
+#define _aegis256_decrypt _nettle_aegis256_decrypt
+#define _aegis128l_absorb _nettle_aegis128l_absorb
+#define _aegis256_absorb _nettle_aegis256_absorb
+
+size_t
+_aegis128l_encrypt (union nettle_block16 *state,
+		    size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_aegis128l_decrypt (union nettle_block16 *state,
+		    size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_aegis256_encrypt (union nettle_block16 *state,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_aegis256_decrypt (union nettle_block16 *state,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_aegis128l_absorb (union nettle_block16 *state,
+		   size_t length, const uint8_t *src);
+
+size_t
+_aegis256_absorb (union nettle_block16 *state,
+		  size_t length, const uint8_t *src);
+
+#else /* !HAVE_NATIVE_aegis128l_encrypt */
+#define _aegis128l_encrypt(state, length, dst, src) 0
+#define _aegis128l_decrypt(state, length, dst, src) 0
+#define _aegis256_encrypt(state, length, dst, src) 0
+#define _aegis256_decrypt(state, length, dst, src) 0
+#define _aegis128l_absorb(state, length, src) 0
+#define _aegis256_absorb(state, length, src) 0
+#endif /* !HAVE_NATIVE_aegis128l_encrypt */
+
+#endif /* NETTLE_AEGIS_INTERNAL_H_INCLUDED */
@@ -0,0 +1,338 @@
+/* aegis128l.c
+
+   The AEGIS-128L authenticated encryption mode.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "aegis128l.h"
+
+#include "aegis-internal.h"
+#include "macros.h"
+
+#define AEGIS128L_STATE 8
+
+/* Working copy of the state, as little-endian words. */
+typedef uint32_t aegis128l_state[AEGIS128L_STATE][4];
+
+static const uint8_t aegis_c0[16] = {
+  0x00, 0x01, 0x01, 0x02, 0x03, 0x05, 0x08, 0x0d,
+  0x15, 0x22, 0x37, 0x59, 0x90, 0xe9, 0x79, 0x62,
+};
+static const uint8_t aegis_c1[16] = {
+  0xdb, 0x3d, 0x18, 0x55, 0x6d, 0xc2, 0x2f, 0xf1,
+  0x20, 0x11, 0x31, 0x42, 0x73, 0xb5, 0x28, 0xdd,
+};
+
+static void
+load_block (uint32_t *w, const uint8_t *src)
+{
+  w[0] = LE_READ_UINT32 (src);
+  w[1] = LE_READ_UINT32 (src + 4);
+  w[2] = LE_READ_UINT32 (src + 8);
+  w[3] = LE_READ_UINT32 (src + 12);
+}
+
+static void
+store_block (uint8_t *dst, const uint32_t *w)
+{
+  LE_WRITE_UINT32 (dst, w[0]);
+  LE_WRITE_UINT32 (dst + 4, w[1]);
+  LE_WRITE_UINT32 (dst + 8, w[2]);
+  LE_WRITE_UINT32 (dst + 12, w[3]);
+}
+
+static void
+aegis128l_load (aegis128l_state s, const union nettle_block16 *state)
+{
+  unsigned i;
+  for (i = 0; i < AEGIS128L_STATE; i++)
+    load_block (s[i], state[i].b);
+}
+
+static void
+aegis128l_store (union nettle_block16 *state, aegis128l_state s)
+{
+  unsigned i;
+  for (i = 0; i < AEGIS128L_STATE; i++)
+    store_block (state[i].b, s[i]);
+}
+
+static void
+aegis128l_round (aegis128l_state s, const uint32_t *m0, const uint32_t *m1)
+{
+  uint32_t s7[4];
+  unsigned i;
+
+  /* Update in place, from the end, so that each round reads the old
+     value of the preceding block. */
+  memcpy (s7, s[7], sizeof (s7));
+  AEGIS_AES_ROUND (s[7], s[6], s[7]);
+  AEGIS_AES_ROUND (s[6], s[5], s[6]);
+  AEGIS_AES_ROUND (s[5], s[4], s[5]);
+  for (i = 0; i < 4; i++)
+    s[4][i] ^= m1[i];
+  AEGIS_AES_ROUND (s[4], s[3], s[4]);
+  AEGIS_AES_ROUND (s[3], s[2], s[3]);
+  AEGIS_AES_ROUND (s[2], s[1], s[2]);
+  AEGIS_AES_ROUND (s[1], s[0], s[1]);
+  for (i = 0; i < 4; i++)
+    s[0][i] ^= m0[i];
+  AEGIS_AES_ROUND (s[0], s7, s[0]);
+}
+
+/* Computes the key stream block. */
+static void
+aegis128l_stream (uint32_t *z, aegis128l_state s)
+{
+  unsigned i;
+  for (i = 0; i < 4; i++)
+    {
+      z[i] = s[6][i] ^ s[1][i] ^ (s[2][i] & s[3][i]);
+      z[i + 4] = s[2][i] ^ s[5][i] ^ (s[6][i] & s[7][i]);
+    }
+}
+
+void
+aegis128l_set_key (struct aegis128l_ctx *ctx, const uint8_t *key)
+{
+  memcpy (ctx->key[0].b, key, AEGIS128L_KEY_SIZE);
+}
+
+void
+aegis128l_set_nonce (struct aegis128l_ctx *ctx, const uint8_t *nonce)
+{
+  aegis128l_state s;
+  uint32_t k[4], n[4], c0[4], c1[4];
+  unsigned i;
+
+  load_block (k, ctx->key[0].b);
+  load_block (n, nonce);
+  load_block (c0, aegis_c0);
+  load_block (c1, aegis_c1);
+
+  for (i = 0; i < 4; i++)
+    {
+      s[0][i] = s[4][i] = k[i] ^ n[i];
+      s[1][i] = s[3][i] = c1[i];
+      s[2][i] = c0[i];
+      s[5][i] = s[7][i] = k[i] ^ c0[i];
+      s[6][i] = k[i] ^ c1[i];
+    }
+  for (i = 0; i < 10; i++)
+    aegis128l_round (s, n, k);
+
+  aegis128l_store (ctx->state, s);
+  ctx->auth_size = ctx->data_size = 0;
+}
+
+void
+aegis128l_update (struct aegis128l_ctx *ctx,
+		  size_t length, const uint8_t *data)
+{
+  aegis128l_state s;
+  uint32_t m[8];
+  size_t done;
+
+  assert (ctx->data_size == 0);
+  assert (ctx->auth_size % AEGIS128L_BLOCK_SIZE == 0);
+
+  if (!length)
+    return;
+
+  ctx->auth_size += length;
+  done = _aegis128l_absorb (ctx->state, length, data);
+  length -= done;
+  if (!length)
+    return;
+
+  data += done;
+  aegis128l_load (s, ctx->state);
+  for (; length >= AEGIS128L_BLOCK_SIZE;
+       length -= AEGIS128L_BLOCK_SIZE, data += AEGIS128L_BLOCK_SIZE)
+    {
+      load_block (m, data);
+      load_block (m + 4, data + 16);
+      aegis128l_round (s, m, m + 4);
+    }
+  if (length > 0)
+    {
+      uint8_t block[AEGIS128L_BLOCK_SIZE];
+      memset (block, 0, sizeof (block));
+      memcpy (block, data, length);
+      load_block (m, block);
+      load_block (m + 4, block + 16);
+      aegis128l_round (s, m, m + 4);
+    }
+  aegis128l_store (ctx->state, s);
+}
+
+void
+aegis128l_encrypt (struct aegis128l_ctx *ctx,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  aegis128l_state s;
+  uint32_t m[8], z[8];
+  size_t done;
+  unsigned i;
+
+  assert (ctx->data_size % AEGIS128L_BLOCK_SIZE == 0);
+
+  if (!length)
+    return;
+
+  ctx->data_size += length;
+  done = _aegis128l_encrypt (ctx->state, length, dst, src);
+  length -= done;
+  if (!length)
+    return;
+
+  dst += done;
+  src += done;
+  aegis128l_load (s, ctx->state);
+  for (; length >= AEGIS128L_BLOCK_SIZE; length -= AEGIS128L_BLOCK_SIZE,
+	 dst += AEGIS128L_BLOCK_SIZE, src += AEGIS128L_BLOCK_SIZE)
+    {
+      aegis128l_stream (z, s);
+      load_block (m, src);
+      load_block (m + 4, src + 16);
+      for (i = 0; i < 8; i++)
+	z[i] ^= m[i];
+      store_block (dst, z);
+      store_block (dst + 16, z + 4);
+      aegis128l_round (s, m, m + 4);
+    }
+  if (length > 0)
+    {
+      uint8_t block[AEGIS128L_BLOCK_SIZE];
+      memset (block, 0, sizeof (block));
+      memcpy (block, src, length);
+
+      aegis128l_stream (z, s);
+      load_block (m, block);
+      load_block (m + 4, block + 16);
+      for (i = 0; i < 8; i++)
+	z[i] ^= m[i];
+      store_block (block, z);
+      store_block (block + 16, z + 4);
+      memcpy (dst, block, length);
+      aegis128l_round (s, m, m + 4);
+    }
+  aegis128l_store (ctx->state, s);
+}
+
+void
+aegis128l_decrypt (struct aegis128l_ctx *ctx,
+		   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  aegis128l_state s;
+  uint32_t m[8], z[8];
+  size_t done;
+  unsigned i;
+
+  assert (ctx->data_size % AEGIS128L_BLOCK_SIZE == 0);
+
+  if (!length)
+    return;
+
+  ctx->data_size += length;
+  done = _aegis128l_decrypt (ctx->state, length, dst, src);
+  length -= done;
+  if (!length)
+    return;
+
+  dst += done;
+  src += done;
+  aegis128l_load (s, ctx->state);
+  for (; length >= AEGIS128L_BLOCK_SIZE; length -= AEGIS128L_BLOCK_SIZE,
+	 dst += AEGIS128L_BLOCK_SIZE, src += AEGIS128L_BLOCK_SIZE)
+    {
+      aegis128l_stream (z, s);
+      load_block (m, src);
+      load_block (m + 4, src + 16);
+      for (i = 0; i < 8; i++)
+	m[i] ^= z[i];
+      store_block (dst, m);
+      store_block (dst + 16, m + 4);
+      aegis128l_round (s, m, m + 4);
+    }
+  if (length > 0)
+    {
+      uint8_t block[AEGIS128L_BLOCK_SIZE];
+      memset (block, 0, sizeof (block));
+      memcpy (block, src, length);
+
+      aegis128l_stream (z, s);
+      load_block (m, block);
+      load_block (m + 4, block + 16);
+      for (i = 0; i < 8; i++)
+	m[i] ^= z[i];
+      store_block (block, m);
+      store_block (block + 16, m + 4);
+      memcpy (dst, block, length);
+
+      /* The state is updated with the zero padded plaintext. */
+      memset (block + length, 0, sizeof (block) - length);
+      load_block (m, block);
+      load_block (m + 4, block + 16);
+      aegis128l_round (s, m, m + 4);
+    }
+  aegis128l_store (ctx->state, s);
+}
+
+void
+aegis128l_digest (struct aegis128l_ctx *ctx, uint8_t *digest)
+{
+  aegis128l_state s;
+  uint8_t block[16];
+  uint32_t t[4];
+  unsigned i, j;
+
+  aegis128l_load (s, ctx->state);
+  LE_WRITE_UINT64 (block, ctx->auth_size * 8);
+  LE_WRITE_UINT64 (block + 8, ctx->data_size * 8);
+  load_block (t, block);
+  for (i = 0; i < 4; i++)
+    t[i] ^= s[2][i];
+
+  for (i = 0; i < 7; i++)
+    aegis128l_round (s, t, t);
+
+  for (i = 0; i < 4; i++)
+    for (j = 1; j < AEGIS128L_STATE - 1; j++)
+      s[0][i] ^= s[j][i];
+  store_block (digest, s[0]);
+}
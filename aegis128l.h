@@ -0,0 +1,93 @@
+/* aegis128l.h
+
+   The AEGIS-128L authenticated encryption mode.
+   See draft-irtf-cfrg-aegis-aead.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_AEGIS128L_H_INCLUDED
+#define NETTLE_AEGIS128L_H_INCLUDED
+
+#include "nettle-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name mangling */
+#define aegis128l_set_key nettle_aegis128l_set_key
+#define aegis128l_set_nonce nettle_aegis128l_set_nonce
+#define aegis128l_update nettle_aegis128l_update
+#define aegis128l_encrypt nettle_aegis128l_encrypt
+#define aegis128l_decrypt nettle_aegis128l_decrypt
+#define aegis128l_digest nettle_aegis128l_digest
+
+#define AEGIS128L_KEY_SIZE 16
+#define AEGIS128L_NONCE_SIZE 16
+#define AEGIS128L_BLOCK_SIZE 32
+#define AEGIS128L_DIGEST_SIZE 16
+
+struct aegis128l_ctx
+{
+  union nettle_block16 key[AEGIS128L_KEY_SIZE / 16];
+  union nettle_block16 state[8];
+  uint64_t auth_size;
+  uint64_t data_size;
+};
+
+void
+aegis128l_set_key (struct aegis128l_ctx *ctx, const uint8_t *key);
+
+void
+aegis128l_set_nonce (struct aegis128l_ctx *ctx, const uint8_t *nonce);
+
+/* All calls to update, encrypt and decrypt, except the last one for
+   the associated data and for the message, must use a multiple of
+   the block size. */
+void
+aegis128l_update (struct aegis128l_ctx *ctx,
+		  size_t length, const uint8_t *data);
+
+void
+aegis128l_encrypt (struct aegis128l_ctx *ctx,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+aegis128l_decrypt (struct aegis128l_ctx *ctx,
+		   size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+aegis128l_digest (struct aegis128l_ctx *ctx, uint8_t *digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_AEGIS128L_H_INCLUDED */
@@ -0,0 +1,51 @@
+/* aegis256-meta.c
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "nettle-meta.h"
+
+#include "aegis256.h"
+
+const struct nettle_aead nettle_aegis256 =
+  { "aegis256", sizeof(struct aegis256_ctx),
+    AEGIS256_BLOCK_SIZE, AEGIS256_KEY_SIZE,
+    AEGIS256_NONCE_SIZE, AEGIS256_DIGEST_SIZE,
+    (nettle_set_key_func *) aegis256_set_key,
+    (nettle_set_key_func *) aegis256_set_key,
+    (nettle_set_key_func *) aegis256_set_nonce,
+    (nettle_hash_update_func *) aegis256_update,
+    (nettle_crypt_func *) aegis256_encrypt,
+    (nettle_crypt_func *) aegis256_decrypt,
+    (nettle_hash_digest_func *) aegis256_digest,
+  };
@@ -0,0 +1,327 @@
+/* aegis256.c
+
+   The AEGIS-256 authenticated encryption mode.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "aegis256.h"
+
+#include "aegis-internal.h"
+#include "macros.h"
+
+#define AEGIS256_STATE 6
+
+/* Working copy of the state, as little-endian words. */
+typedef uint32_t aegis256_state[AEGIS256_STATE][4];
+
+static const uint8_t aegis_c0[16] = {
+  0x00, 0x01, 0x01, 0x02, 0x03, 0x05, 0x08, 0x0d,
+  0x15, 0x22, 0x37, 0x59, 0x90, 0xe9, 0x79, 0x62,
+};
+static const uint8_t aegis_c1[16] = {
+  0xdb, 0x3d, 0x18, 0x55, 0x6d, 0xc2, 0x2f, 0xf1,
+  0x20, 0x11, 0x31, 0x42, 0x73, 0xb5, 0x28, 0xdd,
+};
+
+static void
+load_block (uint32_t *w, const uint8_t *src)
+{
+  w[0] = LE_READ_UINT32 (src);
+  w[1] = LE_READ_UINT32 (src + 4);
+  w[2] = LE_READ_UINT32 (src + 8);
+  w[3] = LE_READ_UINT32 (src + 12);
+}
+
+static void
+store_block (uint8_t *dst, const uint32_t *w)
+{
+  LE_WRITE_UINT32 (dst, w[0]);
+  LE_WRITE_UINT32 (dst + 4, w[1]);
+  LE_WRITE_UINT32 (dst + 8, w[2]);
+  LE_WRITE_UINT32 (dst + 12, w[3]);
+}
+
+static void
+aegis256_load (aegis256_state s, const union nettle_block16 *state)
+{
+  unsigned i;
+  for (i = 0; i < AEGIS256_STATE; i++)
+    load_block (s[i], state[i].b);
+}
+
+static void
+aegis256_store (union nettle_block16 *state, aegis256_state s)
+{
+  unsigned i;
+  for (i = 0; i < AEGIS256_STATE; i++)
+    store_block (state[i].b, s[i]);
+}
+
+static void
+aegis256_round (aegis256_state s, const uint32_t *m)
+{
+  uint32_t s5[4];
+  unsigned i;
+
+  /* Update in place, from the end, so that each round reads the old
+     value of the preceding block. */
+  memcpy (s5, s[5], sizeof (s5));
+  for (i = AEGIS256_STATE - 1; i > 0; i--)
+    AEGIS_AES_ROUND (s[i], s[i-1], s[i]);
+  for (i = 0; i < 4; i++)
+    s[0][i] ^= m[i];
+  AEGIS_AES_ROUND (s[0], s5, s[0]);
+}
+
+/* Computes the key stream block. */
+static void
+aegis256_stream (uint32_t *z, aegis256_state s)
+{
+  unsigned i;
+  for (i = 0; i < 4; i++)
+    z[i] = s[1][i] ^ s[4][i] ^ s[5][i] ^ (s[2][i] & s[3][i]);
+}
+
+void
+aegis256_set_key (struct aegis256_ctx *ctx, const uint8_t *key)
+{
+  memcpy (ctx->key[0].b, key, AEGIS256_KEY_SIZE);
+}
+
+void
+aegis256_set_nonce (struct aegis256_ctx *ctx, const uint8_t *nonce)
+{
+  aegis256_state s;
+  uint32_t k0[4], k1[4], kn0[4], kn1[4], c0[4], c1[4];
+  unsigned i;
+
+  load_block (k0, ctx->key[0].b);
+  load_block (k1, ctx->key[1].b);
+  load_block (kn0, nonce);
+  load_block (kn1, nonce + 16);
+  load_block (c0, aegis_c0);
+  load_block (c1, aegis_c1);
+
+  for (i = 0; i < 4; i++)
+    {
+      kn0[i] ^= k0[i];
+      kn1[i] ^= k1[i];
+      s[0][i] = kn0[i];
+      s[1][i] = kn1[i];
+      s[2][i] = c1[i];
+      s[3][i] = c0[i];
+      s[4][i] = k0[i] ^ c0[i];
+      s[5][i] = k1[i] ^ c1[i];
+    }
+  for (i = 0; i < 4; i++)
+    {
+      aegis256_round (s, k0);
+      aegis256_round (s, k1);
+      aegis256_round (s, kn0);
+      aegis256_round (s, kn1);
+    }
+
+  aegis256_store (ctx->state, s);
+  ctx->auth_size = ctx->data_size = 0;
+}
+
+void
+aegis256_update (struct aegis256_ctx *ctx,
+		 size_t length, const uint8_t *data)
+{
+  aegis256_state s;
+  uint32_t m[4];
+  size_t done;
+
+  assert (ctx->data_size == 0);
+  assert (ctx->auth_size % AEGIS256_BLOCK_SIZE == 0);
+
+  if (!length)
+    return;
+
+  ctx->auth_size += length;
+  done = _aegis256_absorb (ctx->state, length, data);
+  length -= done;
+  if (!length)
+    return;
+
+  data += done;
+  aegis256_load (s, ctx->state);
+  for (; length >= AEGIS256_BLOCK_SIZE;
+       length -= AEGIS256_BLOCK_SIZE, data += AEGIS256_BLOCK_SIZE)
+    {
+      load_block (m, data);
+      aegis256_round (s, m);
+    }
+  if (length > 0)
+    {
+      uint8_t block[AEGIS256_BLOCK_SIZE];
+      memset (block, 0, sizeof (block));
+      memcpy (block, data, length);
+      load_block (m, block);
+      aegis256_round (s, m);
+    }
+  aegis256_store (ctx->state, s);
+}
+
+void
+aegis256_encrypt (struct aegis256_ctx *ctx,
+		  size_t length, uint8_t *dst, const uint8_t *src)
+{
+  aegis256_state s;
+  uint32_t m[4], z[4];
+  size_t done;
+  unsigned i;
+
+  assert (ctx->data_size % AEGIS256_BLOCK_SIZE == 0);
+
+  if (!length)
+    return;
+
+  ctx->data_size += length;
+  done = _aegis256_encrypt (ctx->state, length, dst, src);
+  length -= done;
+  if (!length)
+    return;
+
+  dst += done;
+  src += done;
+  aegis256_load (s, ctx->state);
+  for (; length >= AEGIS256_BLOCK_SIZE; length -= AEGIS256_BLOCK_SIZE,
+	 dst += AEGIS256_BLOCK_SIZE, src += AEGIS256_BLOCK_SIZE)
+    {
+      aegis256_stream (z, s);
+      load_block (m, src);
+      for (i = 0; i < 4; i++)
+	z[i] ^= m[i];
+      store_block (dst, z);
+      aegis256_round (s, m);
+    }
+  if (length > 0)
+    {
+      uint8_t block[AEGIS256_BLOCK_SIZE];
+      memset (block, 0, sizeof (block));
+      memcpy (block, src, length);
+
+      aegis256_stream (z, s);
+      load_block (m, block);
+      for (i = 0; i < 4; i++)
+	z[i] ^= m[i];
+      store_block (block, z);
+      memcpy (dst, block, length);
+      aegis256_round (s, m);
+    }
+  aegis256_store (ctx->state, s);
+}
+
+void
+aegis256_decrypt (struct aegis256_ctx *ctx,
+		  size_t length, uint8_t *dst, const uint8_t *src)
+{
+  aegis256_state s;
+  uint32_t m[4], z[4];
+  size_t done;
+  unsigned i;
+
+  assert (ctx->data_size % AEGIS256_BLOCK_SIZE == 0);
+
+  if (!length)
+    return;
+
+  ctx->data_size += length;
+  done = _aegis256_decrypt (ctx->state, length, dst, src);
+  length -= done;
+  if (!length)
+    return;
+
+  dst += done;
+  src += done;
+  aegis256_load (s, ctx->state);
+  for (; length >= AEGIS256_BLOCK_SIZE; length -= AEGIS256_BLOCK_SIZE,
+	 dst += AEGIS256_BLOCK_SIZE, src += AEGIS256_BLOCK_SIZE)
+    {
+      aegis256_stream (z, s);
+      load_block (m, src);
+      for (i = 0; i < 4; i++)
+	m[i] ^= z[i];
+      store_block (dst, m);
+      aegis256_round (s, m);
+    }
+  if (length > 0)
+    {
+      uint8_t block[AEGIS256_BLOCK_SIZE];
+      memset (block, 0, sizeof (block));
+      memcpy (block, src, length);
+
+      aegis256_stream (z, s);
+      load_block (m, block);
+      for (i = 0; i < 4; i++)
+	m[i] ^= z[i];
+      store_block (block, m);
+      memcpy (dst, block, length);
+
+      /* The state is updated with the zero padded plaintext. */
+      memset (block + length, 0, sizeof (block) - length);
+      load_block (m, block);
+      aegis256_round (s, m);
+    }
+  aegis256_store (ctx->state, s);
+}
+
+void
+aegis256_digest (struct aegis256_ctx *ctx, uint8_t *digest)
+{
+  aegis256_state s;
+  uint8_t block[16];
+  uint32_t t[4];
+  unsigned i, j;
+
+  aegis256_load (s, ctx->state);
+  LE_WRITE_UINT64 (block, ctx->auth_size * 8);
+  LE_WRITE_UINT64 (block + 8, ctx->data_size * 8);
+  load_block (t, block);
+  for (i = 0; i < 4; i++)
+    t[i] ^= s[3][i];
+
+  for (i = 0; i < 7; i++)
+    aegis256_round (s, t);
+
+  for (i = 0; i < 4; i++)
+    for (j = 1; j < AEGIS256_STATE; j++)
+      s[0][i] ^= s[j][i];
+  store_block (digest, s[0]);
+}
@@ -32,6 +32,7 @@ ifelse(`
 
 dnl picked up by configure
 dnl PROLOGUE(_nettle_ghash_set_key)
+dnl PROLOGUE(_nettle_fat_ghash_set_key)
 
 define(`fat_transform', `$1_arm64')
 include_src(`arm64/crypto/ghash-set-key.asm')
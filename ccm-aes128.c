@@ -40,6 +40,8 @@
 
 #include "aes.h"
 #include "ccm.h"
+#include "ccm-internal.h"
+#include "memops.h"
 
 void
 ccm_aes128_set_key(struct ccm_aes128_ctx *ctx, const uint8_t *key)
@@ -68,16 +70,18 @@ void
 ccm_aes128_encrypt(struct ccm_aes128_ctx *ctx,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
+  size_t done = _ccm_aes128_encrypt (&ctx->ccm, &ctx->cipher, length, dst, src);
   ccm_encrypt(&ctx->ccm, &ctx->cipher, (nettle_cipher_func *) aes128_encrypt,
-	      length, dst, src);
+	      length - done, dst + done, src + done);
 }
 
 void
 ccm_aes128_decrypt(struct ccm_aes128_ctx *ctx,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
+  size_t done = _ccm_aes128_decrypt (&ctx->ccm, &ctx->cipher, length, dst, src);
   ccm_decrypt(&ctx->ccm, &ctx->cipher, (nettle_cipher_func *) aes128_encrypt,
-	      length, dst, src);
+	      length - done, dst + done, src + done);
 }
 
 void
@@ -93,9 +97,20 @@ ccm_aes128_encrypt_message(const struct aes128_ctx *ctx,
 			   size_t tlength,
 			   size_t clength, uint8_t *dst, const uint8_t *src)
 {
-  ccm_encrypt_message(ctx, (nettle_cipher_func *) aes128_encrypt,
-		      nlength, nonce, alength, adata,
-		      tlength, clength, dst, src);
+  struct ccm_ctx ccm;
+  size_t mlength, done;
+
+  assert(clength >= tlength);
+  mlength = clength - tlength;
+  ccm_set_nonce(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+		nlength, nonce, alength, mlength, tlength);
+  ccm_update(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+	     alength, adata);
+  done = _ccm_aes128_encrypt (&ccm, ctx, mlength, dst, src);
+  ccm_encrypt(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+	      mlength - done, dst + done, src + done);
+  ccm_digest(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+	     dst + mlength);
 }
 
 int
@@ -105,7 +120,36 @@ ccm_aes128_decrypt_message(const struct aes128_ctx *ctx,
 			   size_t tlength,
 			   size_t mlength, uint8_t *dst, const uint8_t *src)
 {
-  return ccm_decrypt_message(ctx, (nettle_cipher_func *) aes128_encrypt,
-			     nlength, nonce, alength, adata,
-			     tlength, mlength, dst, src);
+  struct ccm_ctx ccm;
+  uint8_t tag[CCM_BLOCK_SIZE];
+  size_t done;
+
+  ccm_set_nonce(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+		nlength, nonce, alength, mlength, tlength);
+  ccm_update(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+	     alength, adata);
+  done = _ccm_aes128_decrypt (&ccm, ctx, mlength, dst, src);
+  ccm_decrypt(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt,
+	      mlength - done, dst + done, src + done);
+  ccm_digest(&ccm, ctx, (nettle_cipher_func *) aes128_encrypt, tag);
+  return memeql_sec(tag, src + mlength, tlength);
+}
+
+void
+ccm_aes128_seal_batch(const struct aes128_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs)
+{
+  ccm_seal_batch(ctx, (nettle_cipher_func *) aes128_encrypt,
+		 nlength, tlength, count, msgs);
+}
+
+int
+ccm_aes128_open_batch(const struct aes128_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs,
+		      int *valid)
+{
+  return ccm_open_batch(ctx, (nettle_cipher_func *) aes128_encrypt,
+			nlength, tlength, count, msgs, valid);
 }
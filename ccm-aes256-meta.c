@@ -0,0 +1,75 @@
+/* ccm-aes256-meta.c
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ccm.h"
+#include "nettle-meta.h"
+
+/* Nonce size as for the TLS cipher suites, RFC 6655. */
+#define CCM_AES256_V2_NONCE_SIZE 12
+
+static void
+ccm_aes256_v2_encrypt_message (const struct aes256_ctx *key,
+				const uint8_t *nonce,
+				size_t alength, const uint8_t *adata,
+				size_t clength, uint8_t *dst, const uint8_t *src)
+{
+  ccm_aes256_encrypt_message (key, CCM_AES256_V2_NONCE_SIZE, nonce,
+			       alength, adata, CCM_DIGEST_SIZE,
+			       clength, dst, src);
+}
+
+static int
+ccm_aes256_v2_decrypt_message (const struct aes256_ctx *key,
+				const uint8_t *nonce,
+				size_t alength, const uint8_t *adata,
+				size_t mlength, uint8_t *dst, const uint8_t *src)
+{
+  return ccm_aes256_decrypt_message (key, CCM_AES256_V2_NONCE_SIZE, nonce,
+				      alength, adata, CCM_DIGEST_SIZE,
+				      mlength, dst, src);
+}
+
+/* CCM needs the message size up front, so there's no incremental
+   interface. */
+const struct nettle_aead_v2
+nettle_ccm_aes256_v2 =
+  { "ccm_aes256", sizeof(struct aes256_ctx), 0,
+    CCM_BLOCK_SIZE, AES256_KEY_SIZE,
+    CCM_AES256_V2_NONCE_SIZE, CCM_DIGEST_SIZE,
+    (nettle_set_key_func *) aes256_set_encrypt_key,
+    NULL, NULL, NULL, NULL, NULL,
+    (nettle_aead_encrypt_message_func *) ccm_aes256_v2_encrypt_message,
+    (nettle_aead_decrypt_message_func *) ccm_aes256_v2_decrypt_message,
+  };
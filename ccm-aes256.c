@@ -40,6 +40,8 @@
 
 #include "aes.h"
 #include "ccm.h"
+#include "ccm-internal.h"
+#include "memops.h"
 
 
 void
@@ -69,16 +71,18 @@ void
 ccm_aes256_encrypt(struct ccm_aes256_ctx *ctx,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
+  size_t done = _ccm_aes256_encrypt (&ctx->ccm, &ctx->cipher, length, dst, src);
   ccm_encrypt(&ctx->ccm, &ctx->cipher, (nettle_cipher_func *) aes256_encrypt,
-	      length, dst, src);
+	      length - done, dst + done, src + done);
 }
 
 void
 ccm_aes256_decrypt(struct ccm_aes256_ctx *ctx,
 		   size_t length, uint8_t *dst, const uint8_t *src)
 {
+  size_t done = _ccm_aes256_decrypt (&ctx->ccm, &ctx->cipher, length, dst, src);
   ccm_decrypt(&ctx->ccm, &ctx->cipher, (nettle_cipher_func *) aes256_encrypt,
-	      length, dst, src);
+	      length - done, dst + done, src + done);
 }
 
 void
@@ -94,9 +98,20 @@ ccm_aes256_encrypt_message(const struct aes256_ctx *ctx,
 			   size_t tlength,
 			   size_t clength, uint8_t *dst, const uint8_t *src)
 {
-  ccm_encrypt_message(ctx, (nettle_cipher_func *) aes256_encrypt,
-		      nlength, nonce, alength, adata,
-		      tlength, clength, dst, src);
+  struct ccm_ctx ccm;
+  size_t mlength, done;
+
+  assert(clength >= tlength);
+  mlength = clength - tlength;
+  ccm_set_nonce(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+		nlength, nonce, alength, mlength, tlength);
+  ccm_update(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+	     alength, adata);
+  done = _ccm_aes256_encrypt (&ccm, ctx, mlength, dst, src);
+  ccm_encrypt(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+	      mlength - done, dst + done, src + done);
+  ccm_digest(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+	     dst + mlength);
 }
 
 int
@@ -106,7 +121,36 @@ ccm_aes256_decrypt_message(const struct aes256_ctx *ctx,
 			   size_t tlength,
 			   size_t mlength, uint8_t *dst, const uint8_t *src)
 {
-  return ccm_decrypt_message(ctx, (nettle_cipher_func *) aes256_encrypt,
-			     nlength, nonce, alength, adata,
-			     tlength, mlength, dst, src);
+  struct ccm_ctx ccm;
+  uint8_t tag[CCM_BLOCK_SIZE];
+  size_t done;
+
+  ccm_set_nonce(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+		nlength, nonce, alength, mlength, tlength);
+  ccm_update(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+	     alength, adata);
+  done = _ccm_aes256_decrypt (&ccm, ctx, mlength, dst, src);
+  ccm_decrypt(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt,
+	      mlength - done, dst + done, src + done);
+  ccm_digest(&ccm, ctx, (nettle_cipher_func *) aes256_encrypt, tag);
+  return memeql_sec(tag, src + mlength, tlength);
+}
+
+void
+ccm_aes256_seal_batch(const struct aes256_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs)
+{
+  ccm_seal_batch(ctx, (nettle_cipher_func *) aes256_encrypt,
+		 nlength, tlength, count, msgs);
+}
+
+int
+ccm_aes256_open_batch(const struct aes256_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs,
+		      int *valid)
+{
+  return ccm_open_batch(ctx, (nettle_cipher_func *) aes256_encrypt,
+			nlength, tlength, count, msgs, valid);
 }
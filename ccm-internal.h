@@ -0,0 +1,72 @@
+/* ccm-internal.h
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_CCM_INTERNAL_H_INCLUDED
+#define NETTLE_CCM_INTERNAL_H_INCLUDED
+
+#include "ccm.h"
+
+/* Native functions doing both CTR mode and the CBC-MAC, interleaving
+   the independent cipher operations. They process as many full
+   blocks as they can, and return the number of bytes processed. Any
+   pending partial block of associated data is completed first. */
+#if HAVE_NATIVE_ccm_aes128_encrypt
+
+/* Name mangling */
+#define _ccm_aes128_encrypt _nettle_ccm_aes128_encrypt
+#define _ccm_aes128_decrypt _nettle_ccm_aes128_decrypt
+#define _ccm_aes256_encrypt _nettle_ccm_aes256_encrypt
+#define _ccm_aes256_decrypt _nettle_ccm_aes256_decrypt
+
+size_t
+_ccm_aes128_encrypt (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		     size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_ccm_aes128_decrypt (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		     size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_ccm_aes256_encrypt (struct ccm_ctx *ctx, const struct aes256_ctx *cipher,
+		     size_t length, uint8_t *dst, const uint8_t *src);
+
+size_t
+_ccm_aes256_decrypt (struct ccm_ctx *ctx, const struct aes256_ctx *cipher,
+		     size_t length, uint8_t *dst, const uint8_t *src);
+
+#else /* !HAVE_NATIVE_ccm_aes128_encrypt */
+#define _ccm_aes128_encrypt(ctx, cipher, length, dst, src) 0
+#define _ccm_aes128_decrypt(ctx, cipher, length, dst, src) 0
+#define _ccm_aes256_encrypt(ctx, cipher, length, dst, src) 0
+#define _ccm_aes256_decrypt(ctx, cipher, length, dst, src) 0
+#endif /* !HAVE_NATIVE_ccm_aes128_encrypt */
+
+#endif /* NETTLE_CCM_INTERNAL_H_INCLUDED */
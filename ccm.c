@@ -44,6 +44,7 @@
 #include "ccm.h"
 #include "ctr.h"
 
+#include "block-internal.h"
 #include "memops.h"
 #include "nettle-internal.h"
 #include "macros.h"
@@ -69,6 +70,9 @@
 #define CCM_OFFSET_NONCE    1
 #define CCM_L_SIZE(_nlen_)  (CCM_BLOCK_SIZE - CCM_OFFSET_NONCE - (_nlen_))
 
+/* Maximum size of the encoding of L(a). */
+#define CCM_MAX_ALENGTH_SIZE 10
+
 /*
  * The data input to the CBC-MAC: L(a) | adata | padding | plaintext | padding
  *
@@ -116,11 +120,44 @@ ccm_build_iv(uint8_t *iv, size_t noncelen, const uint8_t *nonce,
   assert(!count);
 }
 
+/* Encodes L(a), and returns the size of the encoding. */
+static unsigned
+ccm_encode_alength(uint8_t *prefix, size_t authlen)
+{
+  unsigned length = 0;
+#if SIZEOF_SIZE_T > 4
+  if (authlen >= (0x01ULL << 32)) {
+    /* Encode L(a) as 0xff || 0xff || <64-bit integer> */
+    prefix[length++] = 0xff;
+    prefix[length++] = 0xff;
+    prefix[length++] = (authlen >> 56) & 0xff;
+    prefix[length++] = (authlen >> 48) & 0xff;
+    prefix[length++] = (authlen >> 40) & 0xff;
+    prefix[length++] = (authlen >> 32) & 0xff;
+    prefix[length++] = (authlen >> 24) & 0xff;
+    prefix[length++] = (authlen >> 16) & 0xff;
+  }
+  else
+#endif
+    if (authlen >= ((0x1ULL << 16) - (0x1ULL << 8))) {
+      /* Encode L(a) as 0xff || 0xfe || <32-bit integer> */
+      prefix[length++] = 0xff;
+      prefix[length++] = 0xfe;
+      prefix[length++] = (authlen >> 24) & 0xff;
+      prefix[length++] = (authlen >> 16) & 0xff;
+    }
+  prefix[length++] = (authlen >> 8) & 0xff;
+  prefix[length++] = (authlen >> 0) & 0xff;
+  return length;
+}
+
 void
 ccm_set_nonce(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
 	      size_t length, const uint8_t *nonce,
 	      size_t authlen, size_t msglen, size_t taglen)
 {
+  uint8_t prefix[CCM_MAX_ALENGTH_SIZE];
+
   assert (taglen >= 4 && taglen <= 16 && !(taglen & 1));
   ctx->tag_length = taglen;
 
@@ -138,29 +175,8 @@ ccm_set_nonce(struct ccm_ctx *ctx, const void *cipher, nettle_cipher_func *f,
   /* Encrypt B0 (with the adata flag), and input L(a) to the CBC-MAC. */
   ctx->tag.b[CCM_OFFSET_FLAGS] |= CCM_FLAG_ADATA;
   f(cipher, CCM_BLOCK_SIZE, ctx->tag.b, ctx->tag.b);
-#if SIZEOF_SIZE_T > 4
-  if (authlen >= (0x01ULL << 32)) {
-    /* Encode L(a) as 0xff || 0xff || <64-bit integer> */
-    ctx->tag.b[ctx->blength++] ^= 0xff;
-    ctx->tag.b[ctx->blength++] ^= 0xff;
-    ctx->tag.b[ctx->blength++] ^= (authlen >> 56) & 0xff;
-    ctx->tag.b[ctx->blength++] ^= (authlen >> 48) & 0xff;
-    ctx->tag.b[ctx->blength++] ^= (authlen >> 40) & 0xff;
-    ctx->tag.b[ctx->blength++] ^= (authlen >> 32) & 0xff;
-    ctx->tag.b[ctx->blength++] ^= (authlen >> 24) & 0xff;
-    ctx->tag.b[ctx->blength++] ^= (authlen >> 16) & 0xff;
-  }
-  else
-#endif
-    if (authlen >= ((0x1ULL << 16) - (0x1ULL << 8))) {
-      /* Encode L(a) as 0xff || 0xfe || <32-bit integer> */
-      ctx->tag.b[ctx->blength++] ^= 0xff;
-      ctx->tag.b[ctx->blength++] ^= 0xfe;
-      ctx->tag.b[ctx->blength++] ^= (authlen >> 24) & 0xff;
-      ctx->tag.b[ctx->blength++] ^= (authlen >> 16) & 0xff;
-    }
-  ctx->tag.b[ctx->blength++] ^= (authlen >> 8) & 0xff;
-  ctx->tag.b[ctx->blength++] ^= (authlen >> 0) & 0xff;
+  ctx->blength = ccm_encode_alength(prefix, authlen);
+  memxor(ctx->tag.b, prefix, ctx->blength);
 }
 
 void
@@ -263,3 +279,198 @@ ccm_decrypt_message(const void *cipher, nettle_cipher_func *f,
   ccm_digest(&ctx, cipher, f, tag);
   return memeql_sec(tag, src + mlength, tlength);
 }
+
+/* Number of messages processed in parallel by the batch functions. */
+#define CCM_BATCH_LANES 8
+
+/* The remaining CBC-MAC input of one message. The first block of
+   associated data, which includes the encoding of L(a), is kept in
+   the lane, followed by the rest of the associated data and the
+   message, each zero padded to a complete block. */
+struct ccm_lane
+{
+  size_t index;
+  int first_pending;
+  union nettle_block16 first;
+  unsigned segment;
+  const uint8_t *data[2];
+  size_t length[2];
+};
+
+static void
+ccm_lane_init(struct ccm_lane *lane, union nettle_block16 *block,
+	      size_t nlength, size_t tlength,
+	      size_t index, const struct nettle_aead_batch *m,
+	      const uint8_t *text)
+{
+  uint8_t flags = CCM_FLAG_SET_M(tlength);
+  size_t n = 0;
+
+  lane->index = index;
+  lane->first_pending = m->adata_length > 0;
+  if (lane->first_pending)
+    {
+      unsigned prefix;
+      flags |= CCM_FLAG_ADATA;
+
+      block16_zero (&lane->first);
+      prefix = ccm_encode_alength(lane->first.b, m->adata_length);
+      n = CCM_BLOCK_SIZE - prefix;
+      if (n > m->adata_length)
+	n = m->adata_length;
+      memcpy (lane->first.b + prefix, m->adata, n);
+    }
+  lane->segment = 0;
+  lane->data[0] = m->adata + n;
+  lane->length[0] = m->adata_length - n;
+  lane->data[1] = text;
+  lane->length[1] = m->length;
+
+  /* B0 is the first input to the CBC-MAC. */
+  ccm_build_iv(block->b, nlength, m->nonce, flags, m->length);
+}
+
+/* Adds the next block of input to the CBC-MAC state, and returns 1,
+   or returns 0 if all input is processed. */
+static int
+ccm_lane_next(struct ccm_lane *lane, union nettle_block16 *block)
+{
+  if (lane->first_pending)
+    {
+      lane->first_pending = 0;
+      block16_xor (block, &lane->first);
+      return 1;
+    }
+  for (; lane->segment < 2; lane->segment++)
+    {
+      size_t n = lane->length[lane->segment];
+      if (n > 0)
+	{
+	  if (n > CCM_BLOCK_SIZE)
+	    n = CCM_BLOCK_SIZE;
+	  memxor (block->b, lane->data[lane->segment], n);
+	  lane->data[lane->segment] += n;
+	  lane->length[lane->segment] -= n;
+	  return 1;
+	}
+    }
+  return 0;
+}
+
+/* Generates the key stream for a message, starting with the counter
+   block count. */
+static void
+ccm_batch_ctr(const void *cipher, nettle_cipher_func *f,
+	      size_t nlength, const uint8_t *nonce, size_t count,
+	      size_t length, uint8_t *dst, const uint8_t *src)
+{
+  uint8_t ctr[CCM_BLOCK_SIZE];
+  ccm_build_iv(ctr, nlength, nonce, 0, count);
+  ctr_crypt(cipher, f, CCM_BLOCK_SIZE, ctr, length, dst, src);
+}
+
+/* Each of the lanes processes one message at a time, and when it is
+   done, it continues with the next message. All lanes are encrypted
+   with a single call to f, so that the cipher's pipeline is kept
+   busy, in spite of each CBC-MAC being a serial chain. When opening,
+   a message is decrypted when its lane is started, since the CBC-MAC
+   is computed from the plaintext. When sealing, it is encrypted
+   when the CBC-MAC is complete, to allow in-place operation. */
+static int
+ccm_batch(const void *cipher, nettle_cipher_func *f,
+	  size_t nlength, size_t tlength,
+	  size_t count, const struct nettle_aead_batch *msgs,
+	  int open, int *valid)
+{
+  struct ccm_lane lanes[CCM_BATCH_LANES];
+  union nettle_block16 blocks[CCM_BATCH_LANES];
+  size_t i, j, n;
+  int all_valid = 1;
+
+  assert (tlength >= 4 && tlength <= 16 && !(tlength & 1));
+
+  for (i = n = 0; n < CCM_BATCH_LANES && i < count; i++, n++)
+    {
+      const struct nettle_aead_batch *m = &msgs[i];
+      if (open)
+	ccm_batch_ctr(cipher, f, nlength, m->nonce, 1,
+		      m->length, m->dst, m->src);
+      ccm_lane_init(&lanes[n], &blocks[n], nlength, tlength,
+		    i, m, open ? m->dst : m->src);
+    }
+
+  while (n > 0)
+    {
+      f(cipher, n * CCM_BLOCK_SIZE, blocks[0].b, blocks[0].b);
+
+      for (j = 0; j < n; )
+	{
+	  const struct nettle_aead_batch *m;
+
+	  if (ccm_lane_next(&lanes[j], &blocks[j]))
+	    {
+	      j++;
+	      continue;
+	    }
+
+	  /* The CBC-MAC is complete. */
+	  m = &msgs[lanes[j].index];
+	  if (open)
+	    {
+	      uint8_t digest[CCM_BLOCK_SIZE];
+	      int res;
+
+	      ccm_batch_ctr(cipher, f, nlength, m->nonce, 0,
+			    tlength, digest, blocks[j].b);
+	      res = memeql_sec(digest, m->digest, tlength);
+	      if (valid)
+		valid[lanes[j].index] = res;
+	      all_valid &= res;
+	    }
+	  else
+	    {
+	      ccm_batch_ctr(cipher, f, nlength, m->nonce, 0,
+			    tlength, m->digest, blocks[j].b);
+	      ccm_batch_ctr(cipher, f, nlength, m->nonce, 1,
+			    m->length, m->dst, m->src);
+	    }
+
+	  if (i < count)
+	    {
+	      m = &msgs[i];
+	      if (open)
+		ccm_batch_ctr(cipher, f, nlength, m->nonce, 1,
+			      m->length, m->dst, m->src);
+	      ccm_lane_init(&lanes[j], &blocks[j], nlength, tlength,
+			    i, m, open ? m->dst : m->src);
+	      i++;
+	      j++;
+	    }
+	  else
+	    {
+	      /* Move the last lane here, and process it next. */
+	      n--;
+	      lanes[j] = lanes[n];
+	      blocks[j] = blocks[n];
+	    }
+	}
+    }
+  return all_valid;
+}
+
+void
+ccm_seal_batch(const void *cipher, nettle_cipher_func *f,
+	       size_t nlength, size_t tlength,
+	       size_t count, const struct nettle_aead_batch *msgs)
+{
+  ccm_batch(cipher, f, nlength, tlength, count, msgs, 0, NULL);
+}
+
+int
+ccm_open_batch(const void *cipher, nettle_cipher_func *f,
+	       size_t nlength, size_t tlength,
+	       size_t count, const struct nettle_aead_batch *msgs,
+	       int *valid)
+{
+  return ccm_batch(cipher, f, nlength, tlength, count, msgs, 1, valid);
+}
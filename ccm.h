@@ -59,6 +59,8 @@ extern "C" {
 #define ccm_digest nettle_ccm_digest
 #define ccm_encrypt_message nettle_ccm_encrypt_message
 #define ccm_decrypt_message nettle_ccm_decrypt_message
+#define ccm_seal_batch nettle_ccm_seal_batch
+#define ccm_open_batch nettle_ccm_open_batch
 
 #define ccm_aes128_set_key nettle_ccm_aes128_set_key
 #define ccm_aes128_set_nonce nettle_ccm_aes128_set_nonce
@@ -68,6 +70,8 @@ extern "C" {
 #define ccm_aes128_digest nettle_ccm_aes128_digest
 #define ccm_aes128_encrypt_message nettle_ccm_aes128_encrypt_message
 #define ccm_aes128_decrypt_message nettle_ccm_aes128_decrypt_message
+#define ccm_aes128_seal_batch nettle_ccm_aes128_seal_batch
+#define ccm_aes128_open_batch nettle_ccm_aes128_open_batch
 
 #define ccm_aes192_set_key nettle_ccm_aes192_set_key
 #define ccm_aes192_set_nonce nettle_ccm_aes192_set_nonce
@@ -86,6 +90,8 @@ extern "C" {
 #define ccm_aes256_digest nettle_ccm_aes256_digest
 #define ccm_aes256_encrypt_message nettle_ccm_aes256_encrypt_message
 #define ccm_aes256_decrypt_message nettle_ccm_aes256_decrypt_message
+#define ccm_aes256_seal_batch nettle_ccm_aes256_seal_batch
+#define ccm_aes256_open_batch nettle_ccm_aes256_open_batch
 
 /* For CCM, the block size of the block cipher shall be 128 bits. */
 #define CCM_BLOCK_SIZE  16
@@ -166,6 +172,24 @@ ccm_decrypt_message(const void *cipher, nettle_cipher_func *f,
 		    size_t tlength,
 		    size_t mlength, uint8_t *dst, const uint8_t *src);
 
+/* Processes several messages, all with nonces of size nlength and
+   digests of size tlength. The CBC-MAC computations of up to eight
+   messages are interleaved, so that each call to f processes several
+   independent blocks. In-place operation is allowed. */
+void
+ccm_seal_batch(const void *cipher, nettle_cipher_func *f,
+	       size_t nlength, size_t tlength,
+	       size_t count, const struct nettle_aead_batch *msgs);
+
+/* Returns 1 if all digests are valid. If valid is non-NULL, the
+   result for each message is stored in valid[i]. The output for a
+   message with an invalid digest must be discarded. */
+int
+ccm_open_batch(const void *cipher, nettle_cipher_func *f,
+	       size_t nlength, size_t tlength,
+	       size_t count, const struct nettle_aead_batch *msgs,
+	       int *valid);
+
 /* CCM Mode with AES-128 */
 struct ccm_aes128_ctx {
     struct ccm_ctx      ccm;
@@ -209,6 +233,17 @@ ccm_aes128_decrypt_message(const struct aes128_ctx *ctx,
 			   size_t tlength,
 			   size_t mlength, uint8_t *dst, const uint8_t *src);
 
+void
+ccm_aes128_seal_batch(const struct aes128_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs);
+
+int
+ccm_aes128_open_batch(const struct aes128_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs,
+		      int *valid);
+
 struct ccm_aes192_ctx {
     struct ccm_ctx      ccm;
     struct aes192_ctx   cipher;
@@ -295,6 +330,17 @@ ccm_aes256_decrypt_message(const struct aes256_ctx *ctx,
 			   size_t tlength,
 			   size_t mlength, uint8_t *dst, const uint8_t *src);
 
+void
+ccm_aes256_seal_batch(const struct aes256_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs);
+
+int
+ccm_aes256_open_batch(const struct aes256_ctx *ctx,
+		      size_t nlength, size_t tlength,
+		      size_t count, const struct nettle_aead_batch *msgs,
+		      int *valid);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,3 +51,65 @@ const struct nettle_aead nettle_chacha_poly1305 =
     (nettle_crypt_func *) chacha_poly1305_decrypt,
     (nettle_hash_digest_func *) chacha_poly1305_digest,
   };
+
+/* The expanded key is the chacha key schedule, which is copied to the
+   state for each message. */
+static void
+chacha_poly1305_v2_set_key (struct chacha_ctx *key, const uint8_t *data)
+{
+  chacha_set_key (key, data);
+}
+
+static void
+chacha_poly1305_v2_init (struct chacha_poly1305_ctx *ctx,
+			 const struct chacha_ctx *key, const uint8_t *nonce)
+{
+  ctx->chacha = *key;
+  chacha_poly1305_set_nonce (ctx, nonce);
+}
+
+static void
+chacha_poly1305_v2_update (struct chacha_poly1305_ctx *ctx,
+			   const struct chacha_ctx *key UNUSED,
+			   size_t length, const uint8_t *data)
+{
+  chacha_poly1305_update (ctx, length, data);
+}
+
+static void
+chacha_poly1305_v2_encrypt (struct chacha_poly1305_ctx *ctx,
+			    const struct chacha_ctx *key UNUSED,
+			    size_t length, uint8_t *dst, const uint8_t *src)
+{
+  chacha_poly1305_encrypt (ctx, length, dst, src);
+}
+
+static void
+chacha_poly1305_v2_decrypt (struct chacha_poly1305_ctx *ctx,
+			    const struct chacha_ctx *key UNUSED,
+			    size_t length, uint8_t *dst, const uint8_t *src)
+{
+  chacha_poly1305_decrypt (ctx, length, dst, src);
+}
+
+static void
+chacha_poly1305_v2_digest (struct chacha_poly1305_ctx *ctx,
+			   const struct chacha_ctx *key UNUSED,
+			   uint8_t *digest)
+{
+  chacha_poly1305_digest (ctx, digest);
+}
+
+const struct nettle_aead_v2 nettle_chacha_poly1305_v2 =
+  { "chacha_poly1305", sizeof(struct chacha_ctx),
+    sizeof(struct chacha_poly1305_ctx),
+    CHACHA_POLY1305_BLOCK_SIZE, CHACHA_POLY1305_KEY_SIZE,
+    CHACHA_POLY1305_NONCE_SIZE, CHACHA_POLY1305_DIGEST_SIZE,
+    (nettle_set_key_func *) chacha_poly1305_v2_set_key,
+    (nettle_aead_init_func *) chacha_poly1305_v2_init,
+    (nettle_aead_update_func *) chacha_poly1305_v2_update,
+    (nettle_aead_crypt_func *) chacha_poly1305_v2_encrypt,
+    (nettle_aead_crypt_func *) chacha_poly1305_v2_decrypt,
+    (nettle_aead_digest_func *) chacha_poly1305_v2_digest,
+    NULL, NULL,
+  };
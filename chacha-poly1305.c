@@ -57,6 +57,8 @@
 #include "poly1305-internal.h"
 
 #include "macros.h"
+#include "memops.h"
+#include "memxor.h"
 
 #define CHACHA_ROUNDS 20
 
@@ -112,6 +114,43 @@ poly1305_pad (struct chacha_poly1305_ctx *ctx)
       ctx->index = 0;
     }
 }
+
+/* Large messages are processed in chunks small enough to stay in the
+   L1 cache, so that the data is read from memory only once, for both
+   encryption and authentication. A multiple of the chacha block
+   size. */
+#define CHACHA_POLY1305_CHUNK_SIZE 2048
+
+static void
+chacha_poly1305_encrypt_chunks (struct chacha_poly1305_ctx *ctx,
+				size_t length, uint8_t *dst, const uint8_t *src)
+{
+  for (; length > CHACHA_POLY1305_CHUNK_SIZE;
+       length -= CHACHA_POLY1305_CHUNK_SIZE,
+	 dst += CHACHA_POLY1305_CHUNK_SIZE, src += CHACHA_POLY1305_CHUNK_SIZE)
+    {
+      chacha_crypt32 (&ctx->chacha, CHACHA_POLY1305_CHUNK_SIZE, dst, src);
+      poly1305_update (ctx, CHACHA_POLY1305_CHUNK_SIZE, dst);
+    }
+  chacha_crypt32 (&ctx->chacha, length, dst, src);
+  poly1305_update (ctx, length, dst);
+}
+
+static void
+chacha_poly1305_decrypt_chunks (struct chacha_poly1305_ctx *ctx,
+				size_t length, uint8_t *dst, const uint8_t *src)
+{
+  for (; length > CHACHA_POLY1305_CHUNK_SIZE;
+       length -= CHACHA_POLY1305_CHUNK_SIZE,
+	 dst += CHACHA_POLY1305_CHUNK_SIZE, src += CHACHA_POLY1305_CHUNK_SIZE)
+    {
+      poly1305_update (ctx, CHACHA_POLY1305_CHUNK_SIZE, src);
+      chacha_crypt32 (&ctx->chacha, CHACHA_POLY1305_CHUNK_SIZE, dst, src);
+    }
+  poly1305_update (ctx, length, src);
+  chacha_crypt32 (&ctx->chacha, length, dst, src);
+}
+
 void
 chacha_poly1305_update (struct chacha_poly1305_ctx *ctx,
 			size_t length, const uint8_t *data)
@@ -132,8 +171,7 @@ chacha_poly1305_encrypt (struct chacha_poly1305_ctx *ctx,
   assert (ctx->data_size % CHACHA_POLY1305_BLOCK_SIZE == 0);
   poly1305_pad (ctx);
 
-  chacha_crypt32 (&ctx->chacha, length, dst, src);
-  poly1305_update (ctx, length, dst);
+  chacha_poly1305_encrypt_chunks (ctx, length, dst, src);
   ctx->data_size += length;
 }
 			 
@@ -147,8 +185,7 @@ chacha_poly1305_decrypt (struct chacha_poly1305_ctx *ctx,
   assert (ctx->data_size % CHACHA_POLY1305_BLOCK_SIZE == 0);
   poly1305_pad (ctx);
 
-  poly1305_update (ctx, length, src);
-  chacha_crypt32 (&ctx->chacha, length, dst, src);
+  chacha_poly1305_decrypt_chunks (ctx, length, dst, src);
   ctx->data_size += length;
 }
 			 
@@ -167,3 +204,180 @@ chacha_poly1305_digest (struct chacha_poly1305_ctx *ctx,
   _nettle_poly1305_digest (&ctx->poly1305, &ctx->s);
   memcpy (digest, &ctx->s.b, CHACHA_POLY1305_DIGEST_SIZE);
 }
+
+/* Processes a partial block using previously generated key stream. */
+static void
+chacha_poly1305_crypt_stream (struct chacha_poly1305_ctx *ctx,
+			      size_t length, uint8_t *dst, const uint8_t *src,
+			      const uint8_t *stream, int decrypt)
+{
+  if (decrypt)
+    poly1305_update (ctx, length, src);
+  memxor3 (dst, src, stream, length);
+  if (!decrypt)
+    poly1305_update (ctx, length, dst);
+}
+
+/* Processes fragments as a single message. Full blocks within a
+   fragment are processed directly, only key stream for blocks
+   straddling fragment boundaries is kept between fragments. */
+static void
+chacha_poly1305_crypt_iov (struct chacha_poly1305_ctx *ctx,
+			   size_t count, const struct nettle_crypt_iov *iov,
+			   int decrypt)
+{
+  static const uint8_t zero_block[CHACHA_BLOCK_SIZE];
+  uint8_t stream[CHACHA_BLOCK_SIZE];
+  unsigned pos = 0;
+  size_t i;
+
+  assert (ctx->data_size % CHACHA_POLY1305_BLOCK_SIZE == 0);
+  poly1305_pad (ctx);
+
+  for (i = 0; i < count; i++)
+    {
+      size_t length = iov[i].length;
+      uint8_t *dst = iov[i].dst;
+      const uint8_t *src = iov[i].src;
+      size_t n;
+
+      ctx->data_size += length;
+
+      if (pos > 0 && length > 0)
+	{
+	  n = CHACHA_BLOCK_SIZE - pos;
+	  if (n > length)
+	    n = length;
+	  chacha_poly1305_crypt_stream (ctx, n, dst, src, stream + pos,
+					decrypt);
+	  pos = (pos + n) % CHACHA_BLOCK_SIZE;
+	  length -= n;
+	  dst += n;
+	  src += n;
+	}
+      n = length & ~(size_t) (CHACHA_BLOCK_SIZE - 1);
+      if (n > 0)
+	{
+	  if (decrypt)
+	    chacha_poly1305_decrypt_chunks (ctx, n, dst, src);
+	  else
+	    chacha_poly1305_encrypt_chunks (ctx, n, dst, src);
+	}
+      if (length > n)
+	{
+	  chacha_crypt32 (&ctx->chacha, CHACHA_BLOCK_SIZE, stream, zero_block);
+	  chacha_poly1305_crypt_stream (ctx, length - n, dst + n, src + n,
+					stream, decrypt);
+	  pos = length - n;
+	}
+    }
+}
+
+void
+chacha_poly1305_encrypt_iov (struct chacha_poly1305_ctx *ctx,
+			     size_t count, const struct nettle_crypt_iov *iov)
+{
+  chacha_poly1305_crypt_iov (ctx, count, iov, 0);
+}
+
+void
+chacha_poly1305_decrypt_iov (struct chacha_poly1305_ctx *ctx,
+			     size_t count, const struct nettle_crypt_iov *iov)
+{
+  chacha_poly1305_crypt_iov (ctx, count, iov, 1);
+}
+
+/* Size of the first chacha_crypt32 call for each message of a batch,
+   which generates the poly1305 key together with the first part of
+   the key stream, to make use of the multi-block chacha code also for
+   short messages. */
+#define CHACHA_POLY1305_BATCH_SIZE (4 * CHACHA_BLOCK_SIZE)
+
+/* Sets up ctx for a message, and leaves the first part of the
+   processed message after the initial block of the buffer. Returns
+   the size of that part. */
+static size_t
+chacha_poly1305_batch_start (struct chacha_poly1305_ctx *ctx,
+			     const struct chacha_poly1305_ctx *key,
+			     const struct nettle_aead_batch *m,
+			     uint8_t *buffer)
+{
+  size_t n = m->length;
+  if (n > CHACHA_POLY1305_BATCH_SIZE - CHACHA_BLOCK_SIZE)
+    n = CHACHA_POLY1305_BATCH_SIZE - CHACHA_BLOCK_SIZE;
+
+  ctx->chacha = key->chacha;
+  chacha_set_nonce96 (&ctx->chacha, m->nonce);
+
+  memset (buffer, 0, CHACHA_BLOCK_SIZE);
+  memcpy (buffer + CHACHA_BLOCK_SIZE, m->src, n);
+  chacha_crypt32 (&ctx->chacha, CHACHA_BLOCK_SIZE + n, buffer, buffer);
+
+  _nettle_poly1305_set_key (&ctx->poly1305, buffer);
+  memcpy (ctx->s.b, buffer + 16, 16);
+  ctx->auth_size = ctx->data_size = ctx->index = 0;
+
+  poly1305_update (ctx, m->adata_length, m->adata);
+  ctx->auth_size = m->adata_length;
+  poly1305_pad (ctx);
+
+  return n;
+}
+
+void
+chacha_poly1305_seal_batch (const struct chacha_poly1305_ctx *key,
+			    size_t count,
+			    const struct nettle_aead_batch *msgs)
+{
+  uint8_t buffer[CHACHA_POLY1305_BATCH_SIZE];
+  struct chacha_poly1305_ctx ctx;
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      const struct nettle_aead_batch *m = &msgs[i];
+      size_t n = chacha_poly1305_batch_start (&ctx, key, m, buffer);
+
+      memcpy (m->dst, buffer + CHACHA_BLOCK_SIZE, n);
+      if (m->length > n)
+	chacha_crypt32 (&ctx.chacha, m->length - n, m->dst + n, m->src + n);
+
+      poly1305_update (&ctx, m->length, m->dst);
+      ctx.data_size = m->length;
+      chacha_poly1305_digest (&ctx, m->digest);
+    }
+}
+
+int
+chacha_poly1305_open_batch (const struct chacha_poly1305_ctx *key,
+			    size_t count,
+			    const struct nettle_aead_batch *msgs,
+			    int *valid)
+{
+  uint8_t buffer[CHACHA_POLY1305_BATCH_SIZE];
+  uint8_t digest[CHACHA_POLY1305_DIGEST_SIZE];
+  struct chacha_poly1305_ctx ctx;
+  int all_valid = 1;
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    {
+      const struct nettle_aead_batch *m = &msgs[i];
+      size_t n = chacha_poly1305_batch_start (&ctx, key, m, buffer);
+      int res;
+
+      /* Digest first, since src and dst may overlap. */
+      poly1305_update (&ctx, m->length, m->src);
+      ctx.data_size = m->length;
+      chacha_poly1305_digest (&ctx, digest);
+      res = memeql_sec (digest, m->digest, CHACHA_POLY1305_DIGEST_SIZE);
+      if (valid)
+	valid[i] = res;
+      all_valid &= res;
+
+      memcpy (m->dst, buffer + CHACHA_BLOCK_SIZE, n);
+      if (m->length > n)
+	chacha_crypt32 (&ctx.chacha, m->length - n, m->dst + n, m->src + n);
+    }
+  return all_valid;
+}
@@ -49,6 +49,10 @@ extern "C" {
 #define chacha_poly1305_decrypt nettle_chacha_poly1305_decrypt
 #define chacha_poly1305_encrypt nettle_chacha_poly1305_encrypt
 #define chacha_poly1305_digest nettle_chacha_poly1305_digest
+#define chacha_poly1305_encrypt_iov nettle_chacha_poly1305_encrypt_iov
+#define chacha_poly1305_decrypt_iov nettle_chacha_poly1305_decrypt_iov
+#define chacha_poly1305_seal_batch nettle_chacha_poly1305_seal_batch
+#define chacha_poly1305_open_batch nettle_chacha_poly1305_open_batch
 
 #define CHACHA_POLY1305_BLOCK_SIZE 64
 /* FIXME: Any need for 128-bit variant? */
@@ -91,6 +95,34 @@ void
 chacha_poly1305_digest (struct chacha_poly1305_ctx *ctx,
 			uint8_t *digest);
 
+/* Like chacha_poly1305_encrypt and chacha_poly1305_decrypt, for a
+   message split into fragments of any size. */
+void
+chacha_poly1305_encrypt_iov (struct chacha_poly1305_ctx *ctx,
+			     size_t count,
+			     const struct nettle_crypt_iov *iov);
+
+void
+chacha_poly1305_decrypt_iov (struct chacha_poly1305_ctx *ctx,
+			     size_t count,
+			     const struct nettle_crypt_iov *iov);
+
+/* Processes several messages, using only the key of ctx. In-place
+   operation is allowed. */
+void
+chacha_poly1305_seal_batch (const struct chacha_poly1305_ctx *ctx,
+			    size_t count,
+			    const struct nettle_aead_batch *msgs);
+
+/* Returns 1 if all digests are valid. If valid is non-NULL, the
+   result for each message is stored in valid[i]. The output for a
+   message with an invalid digest must be discarded. */
+int
+chacha_poly1305_open_batch (const struct chacha_poly1305_ctx *ctx,
+			    size_t count,
+			    const struct nettle_aead_batch *msgs,
+			    int *valid);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,3 +58,13 @@ cmac_aes128_digest(struct cmac_aes128_ctx *ctx,
 {
   CMAC128_DIGEST(ctx, aes128_encrypt, digest);
 }
+
+void
+cmac_aes128_digest_multi(const struct cmac_aes128_ctx *ctx,
+			 size_t count, const struct nettle_iov *msgs,
+			 uint8_t *digests)
+{
+  cmac128_digest_multi(&ctx->key, &ctx->cipher,
+		       (nettle_cipher_func *) aes128_encrypt,
+		       count, msgs, digests);
+}
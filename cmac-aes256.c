@@ -58,3 +58,13 @@ cmac_aes256_digest(struct cmac_aes256_ctx *ctx,
 {
   CMAC128_DIGEST(ctx, aes256_encrypt, digest);
 }
+
+void
+cmac_aes256_digest_multi(const struct cmac_aes256_ctx *ctx,
+			 size_t count, const struct nettle_iov *msgs,
+			 uint8_t *digests)
+{
+  cmac128_digest_multi(&ctx->key, &ctx->cipher,
+		       (nettle_cipher_func *) aes256_encrypt,
+		       count, msgs, digests);
+}
@@ -0,0 +1,61 @@
+/* cmac-internal.h
+
+   Interleaved processing of several CMAC messages.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_CMAC_INTERNAL_H_INCLUDED
+#define NETTLE_CMAC_INTERNAL_H_INCLUDED
+
+#include "cmac.h"
+
+#define _cmac128_update_lanes _nettle_cmac128_update_lanes
+#define _cmac128_digest_lanes _nettle_cmac128_digest_lanes
+
+/* Maximum number of contexts processed together. */
+#define CMAC128_LANES 8
+
+/* Like cmac128_update, for n independent contexts and messages.
+   Blocks from all active lanes are passed to a single call to
+   encrypt, so that a cipher implementation processing several blocks
+   in parallel can keep them all in flight. */
+void
+_cmac128_update_lanes(const void *cipher, nettle_cipher_func *encrypt,
+		      size_t n, struct cmac128_ctx *ctx,
+		      const struct nettle_iov *msgs);
+
+/* Like cmac128_digest, for n contexts, writing the n digests
+   consecutively to dst. */
+void
+_cmac128_digest_lanes(const struct cmac128_key *key,
+		      const void *cipher, nettle_cipher_func *encrypt,
+		      size_t n, struct cmac128_ctx *ctx, uint8_t *dst);
+
+#endif /* NETTLE_CMAC_INTERNAL_H_INCLUDED */
@@ -42,6 +42,7 @@
 
 #include "cmac.h"
 
+#include "cmac-internal.h"
 #include "memxor.h"
 #include "nettle-internal.h"
 #include "block-internal.h"
@@ -142,3 +143,125 @@ cmac128_digest(struct cmac128_ctx *ctx, const struct cmac128_key *key,
   /* reset state for re-use */
   cmac128_init(ctx);
 }
+
+void
+_cmac128_update_lanes(const void *cipher, nettle_cipher_func *encrypt,
+		      size_t n, struct cmac128_ctx *ctx,
+		      const struct nettle_iov *msgs)
+{
+  union nettle_block16 Y[CMAC128_LANES];
+  /* For each active lane, the context, the next block to process,
+     and the rest of the message. */
+  unsigned lane[CMAC128_LANES];
+  const uint8_t *next[CMAC128_LANES];
+  const uint8_t *msg[CMAC128_LANES];
+  size_t left[CMAC128_LANES];
+  size_t active, i, j;
+
+  assert (n <= CMAC128_LANES);
+
+  for (i = active = 0; i < n; i++)
+    {
+      const uint8_t *m = msgs[i].data;
+      size_t length = msgs[i].length;
+
+      if (ctx[i].index < 16)
+	{
+	  size_t len = MIN(16 - ctx[i].index, length);
+	  memcpy(&ctx[i].block.b[ctx[i].index], m, len);
+	  m += len;
+	  length -= len;
+	  ctx[i].index += len;
+	}
+      if (length == 0)
+	continue;
+
+      lane[active] = i;
+      next[active] = ctx[i].block.b;
+      msg[active] = m;
+      left[active] = length;
+      active++;
+    }
+
+  while (active > 0)
+    {
+      for (j = 0; j < active; j++)
+	block16_xor_bytes (&Y[j], &ctx[lane[j]].X, next[j]);
+
+      encrypt(cipher, 16*active, Y[0].b, Y[0].b);
+
+      for (i = j = 0; j < active; j++)
+	{
+	  struct cmac128_ctx *c = &ctx[lane[j]];
+	  c->X = Y[j];
+	  if (left[j] > 16)
+	    {
+	      lane[i] = lane[j];
+	      next[i] = msg[j];
+	      msg[i] = msg[j] + 16;
+	      left[i] = left[j] - 16;
+	      i++;
+	    }
+	  else
+	    {
+	      /* Keep the last block for the digest. */
+	      memcpy(c->block.b, msg[j], left[j]);
+	      c->index = left[j];
+	    }
+	}
+      active = i;
+    }
+}
+
+void
+_cmac128_digest_lanes(const struct cmac128_key *key,
+		      const void *cipher, nettle_cipher_func *encrypt,
+		      size_t n, struct cmac128_ctx *ctx, uint8_t *dst)
+{
+  union nettle_block16 Y[CMAC128_LANES];
+  size_t i;
+
+  assert (n <= CMAC128_LANES);
+
+  for (i = 0; i < n; i++)
+    {
+      if (ctx[i].index < 16)
+	{
+	  ctx[i].block.b[ctx[i].index] = 0x80;
+	  memset(ctx[i].block.b + ctx[i].index + 1, 0,
+		 16 - 1 - ctx[i].index);
+	  block16_xor (&ctx[i].block, &key->K2);
+	}
+      else
+	block16_xor (&ctx[i].block, &key->K1);
+
+      block16_xor3 (&Y[i], &ctx[i].block, &ctx[i].X);
+      cmac128_init(&ctx[i]);
+    }
+  encrypt(cipher, 16*n, dst, Y[0].b);
+}
+
+void
+cmac128_digest_multi(const struct cmac128_key *key,
+		     const void *cipher, nettle_cipher_func *encrypt,
+		     size_t count, const struct nettle_iov *msgs,
+		     uint8_t *digests)
+{
+  struct cmac128_ctx ctx[CMAC128_LANES];
+
+  while (count > 0)
+    {
+      size_t n = MIN(count, CMAC128_LANES);
+      size_t i;
+
+      for (i = 0; i < n; i++)
+	cmac128_init(&ctx[i]);
+
+      _cmac128_update_lanes(cipher, encrypt, n, ctx, msgs);
+      _cmac128_digest_lanes(key, cipher, encrypt, n, ctx, digests);
+
+      count -= n;
+      msgs += n;
+      digests += n * CMAC128_DIGEST_SIZE;
+    }
+}
@@ -51,12 +51,15 @@ extern "C" {
 #define cmac128_init nettle_cmac128_init
 #define cmac128_update nettle_cmac128_update
 #define cmac128_digest nettle_cmac128_digest
+#define cmac128_digest_multi nettle_cmac128_digest_multi
 #define cmac_aes128_set_key nettle_cmac_aes128_set_key
 #define cmac_aes128_update nettle_cmac_aes128_update
 #define cmac_aes128_digest nettle_cmac_aes128_digest
+#define cmac_aes128_digest_multi nettle_cmac_aes128_digest_multi
 #define cmac_aes256_set_key nettle_cmac_aes256_set_key
 #define cmac_aes256_update nettle_cmac_aes256_update
 #define cmac_aes256_digest nettle_cmac_aes256_digest
+#define cmac_aes256_digest_multi nettle_cmac_aes256_digest_multi
 
 #define cmac64_set_key nettle_cmac64_set_key
 #define cmac64_init nettle_cmac64_init
@@ -114,6 +117,15 @@ cmac128_digest(struct cmac128_ctx *ctx, const struct cmac128_key *key,
 	       const void *cipher, nettle_cipher_func *encrypt,
 	       uint8_t *digest);
 
+/* Computes the CMAC of count independent messages, writing the
+   digests consecutively. Blocks of several messages are passed to
+   each call to encrypt. */
+void
+cmac128_digest_multi(const struct cmac128_key *key,
+		     const void *cipher, nettle_cipher_func *encrypt,
+		     size_t count, const struct nettle_iov *msgs,
+		     uint8_t *digests);
+
 
 #define CMAC128_CTX(type) \
   { struct cmac128_key key; struct cmac128_ctx ctx; type cipher; }
@@ -204,6 +216,13 @@ void
 cmac_aes128_digest(struct cmac_aes128_ctx *ctx,
 		   uint8_t *digest);
 
+/* Computes the CMAC of count independent messages, using the key of
+   ctx, and without affecting its state. */
+void
+cmac_aes128_digest_multi(const struct cmac_aes128_ctx *ctx,
+			 size_t count, const struct nettle_iov *msgs,
+			 uint8_t *digests);
+
 struct cmac_aes256_ctx CMAC128_CTX(struct aes256_ctx);
 
 void
@@ -217,6 +236,11 @@ void
 cmac_aes256_digest(struct cmac_aes256_ctx *ctx,
 		   uint8_t *digest);
 
+void
+cmac_aes256_digest_multi(const struct cmac_aes256_ctx *ctx,
+			 size_t count, const struct nettle_iov *msgs,
+			 uint8_t *digests);
+
 struct cmac_des3_ctx CMAC64_CTX(struct des3_ctx);
 
 void
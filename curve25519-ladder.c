@@ -0,0 +1,339 @@
+/* curve25519-ladder.c
+
+   Montgomery ladder for X25519, with radix 2^51 field arithmetic.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ecc-internal.h"
+#include "macros.h"
+
+#if HAVE_UINT128
+
+/* Field elements are represented as five 51-bit limbs, with 128-bit
+   products. Outputs of fe_mul, fe_sqr and fe_mul_small have limbs
+   less than 2^52. Sums and differences of such elements, with limbs
+   less than 2^54, are valid inputs to multiplication. */
+typedef uint64_t fe51[5];
+typedef unsigned __int128 uint128_t;
+
+#define MASK51 (((uint64_t) 1 << 51) - 1)
+
+static void
+fe_load (fe51 r, const uint8_t *p)
+{
+  /* Bit 255 is ignored, as required by RFC 7748. */
+  r[0] = LE_READ_UINT64 (p) & MASK51;
+  r[1] = (LE_READ_UINT64 (p + 6) >> 3) & MASK51;
+  r[2] = (LE_READ_UINT64 (p + 12) >> 6) & MASK51;
+  r[3] = (LE_READ_UINT64 (p + 19) >> 1) & MASK51;
+  r[4] = (LE_READ_UINT64 (p + 24) >> 12) & MASK51;
+}
+
+/* Reduces to canonical form, and stores as 32 bytes. */
+static void
+fe_store (uint8_t *p, const fe51 a)
+{
+  uint64_t t0, t1, t2, t3, t4, q;
+
+  t0 = a[0]; t1 = a[1]; t2 = a[2]; t3 = a[3]; t4 = a[4];
+
+  /* Two carry passes, after which t < 2^255 + 19 * 2^4. */
+  t1 += t0 >> 51; t0 &= MASK51;
+  t2 += t1 >> 51; t1 &= MASK51;
+  t3 += t2 >> 51; t2 &= MASK51;
+  t4 += t3 >> 51; t3 &= MASK51;
+  t0 += 19 * (t4 >> 51); t4 &= MASK51;
+  t1 += t0 >> 51; t0 &= MASK51;
+  t2 += t1 >> 51; t1 &= MASK51;
+  t3 += t2 >> 51; t2 &= MASK51;
+  t4 += t3 >> 51; t3 &= MASK51;
+  t0 += 19 * (t4 >> 51); t4 &= MASK51;
+
+  /* q = 1 if t >= p, i.e., if t + 19 >= 2^255. */
+  q = (t0 + 19) >> 51;
+  q = (t1 + q) >> 51;
+  q = (t2 + q) >> 51;
+  q = (t3 + q) >> 51;
+  q = (t4 + q) >> 51;
+
+  /* Subtract p, by adding 19 and dropping bit 255. */
+  t0 += 19 * q;
+  t1 += t0 >> 51; t0 &= MASK51;
+  t2 += t1 >> 51; t1 &= MASK51;
+  t3 += t2 >> 51; t2 &= MASK51;
+  t4 += t3 >> 51; t3 &= MASK51;
+  t4 &= MASK51;
+
+  LE_WRITE_UINT64 (p, t0 | (t1 << 51));
+  LE_WRITE_UINT64 (p + 8, (t1 >> 13) | (t2 << 38));
+  LE_WRITE_UINT64 (p + 16, (t2 >> 26) | (t3 << 25));
+  LE_WRITE_UINT64 (p + 24, (t3 >> 39) | (t4 << 12));
+}
+
+static void
+fe_add (fe51 r, const fe51 a, const fe51 b)
+{
+  r[0] = a[0] + b[0];
+  r[1] = a[1] + b[1];
+  r[2] = a[2] + b[2];
+  r[3] = a[3] + b[3];
+  r[4] = a[4] + b[4];
+}
+
+/* Adds 2p, to keep limbs non-negative. */
+static void
+fe_sub (fe51 r, const fe51 a, const fe51 b)
+{
+  r[0] = a[0] + 0xfffffffffffdaULL - b[0];
+  r[1] = a[1] + 0xffffffffffffeULL - b[1];
+  r[2] = a[2] + 0xffffffffffffeULL - b[2];
+  r[3] = a[3] + 0xffffffffffffeULL - b[3];
+  r[4] = a[4] + 0xffffffffffffeULL - b[4];
+}
+
+/* Carry propagation of the 128-bit limbs of a product, reducing
+   using 2^255 = 19 (mod p). */
+static void
+fe_carry (fe51 r, uint128_t t0, uint128_t t1, uint128_t t2,
+	  uint128_t t3, uint128_t t4)
+{
+  uint64_t r0, r1, r2, r3, r4;
+
+  t1 += (uint64_t) (t0 >> 51); r0 = (uint64_t) t0 & MASK51;
+  t2 += (uint64_t) (t1 >> 51); r1 = (uint64_t) t1 & MASK51;
+  t3 += (uint64_t) (t2 >> 51); r2 = (uint64_t) t2 & MASK51;
+  t4 += (uint64_t) (t3 >> 51); r3 = (uint64_t) t3 & MASK51;
+  r0 += 19 * (uint64_t) (t4 >> 51); r4 = (uint64_t) t4 & MASK51;
+  r1 += r0 >> 51; r0 &= MASK51;
+
+  r[0] = r0; r[1] = r1; r[2] = r2; r[3] = r3; r[4] = r4;
+}
+
+static void
+fe_mul (fe51 r, const fe51 a, const fe51 b)
+{
+  uint64_t b1 = 19 * b[1];
+  uint64_t b2 = 19 * b[2];
+  uint64_t b3 = 19 * b[3];
+  uint64_t b4 = 19 * b[4];
+
+  fe_carry (r,
+	    (uint128_t) a[0] * b[0] + (uint128_t) a[1] * b4
+	    + (uint128_t) a[2] * b3 + (uint128_t) a[3] * b2
+	    + (uint128_t) a[4] * b1,
+	    (uint128_t) a[0] * b[1] + (uint128_t) a[1] * b[0]
+	    + (uint128_t) a[2] * b4 + (uint128_t) a[3] * b3
+	    + (uint128_t) a[4] * b2,
+	    (uint128_t) a[0] * b[2] + (uint128_t) a[1] * b[1]
+	    + (uint128_t) a[2] * b[0] + (uint128_t) a[3] * b4
+	    + (uint128_t) a[4] * b3,
+	    (uint128_t) a[0] * b[3] + (uint128_t) a[1] * b[2]
+	    + (uint128_t) a[2] * b[1] + (uint128_t) a[3] * b[0]
+	    + (uint128_t) a[4] * b4,
+	    (uint128_t) a[0] * b[4] + (uint128_t) a[1] * b[3]
+	    + (uint128_t) a[2] * b[2] + (uint128_t) a[3] * b[1]
+	    + (uint128_t) a[4] * b[0]);
+}
+
+static void
+fe_sqr (fe51 r, const fe51 a)
+{
+  uint64_t a0_2 = 2 * a[0];
+  uint64_t a1_2 = 2 * a[1];
+  uint64_t a1_38 = 38 * a[1];
+  uint64_t a2_38 = 38 * a[2];
+  uint64_t a3_38 = 38 * a[3];
+  uint64_t a3_19 = 19 * a[3];
+  uint64_t a4_19 = 19 * a[4];
+
+  fe_carry (r,
+	    (uint128_t) a[0] * a[0] + (uint128_t) a1_38 * a[4]
+	    + (uint128_t) a2_38 * a[3],
+	    (uint128_t) a0_2 * a[1] + (uint128_t) a2_38 * a[4]
+	    + (uint128_t) a3_19 * a[3],
+	    (uint128_t) a0_2 * a[2] + (uint128_t) a[1] * a[1]
+	    + (uint128_t) a3_38 * a[4],
+	    (uint128_t) a0_2 * a[3] + (uint128_t) a1_2 * a[2]
+	    + (uint128_t) a4_19 * a[4],
+	    (uint128_t) a0_2 * a[4] + (uint128_t) a1_2 * a[3]
+	    + (uint128_t) a[2] * a[2]);
+}
+
+static void
+fe_sqr_n (fe51 r, const fe51 a, unsigned n)
+{
+  fe_sqr (r, a);
+  while (--n > 0)
+    fe_sqr (r, r);
+}
+
+static void
+fe_mul_small (fe51 r, const fe51 a, uint64_t c)
+{
+  fe_carry (r, (uint128_t) a[0] * c, (uint128_t) a[1] * c,
+	    (uint128_t) a[2] * c, (uint128_t) a[3] * c,
+	    (uint128_t) a[4] * c);
+}
+
+static void
+fe_cswap (uint64_t cnd, fe51 a, fe51 b)
+{
+  uint64_t mask = -cnd;
+  unsigned i;
+
+  for (i = 0; i < 5; i++)
+    {
+      uint64_t t = (a[i] ^ b[i]) & mask;
+      a[i] ^= t;
+      b[i] ^= t;
+    }
+}
+
+/* Computes a^{p-2} = a^{-1}. */
+static void
+fe_invert (fe51 r, const fe51 a)
+{
+  fe51 a2, a11, a5m1, a10m1, a50m1, a100m1, t;
+
+  /* Addition chain
+
+       p - 2 = 2^{255} - 21 = 2^5 (2^{250} - 1) + 11
+  */
+  fe_sqr (a2, a);			/* a^2 */
+  fe_sqr_n (t, a2, 2);			/* a^8 */
+  fe_mul (t, t, a);			/* a^9 */
+  fe_mul (a11, t, a2);			/* a^11 */
+  fe_sqr (a5m1, a11);			/* a^22 */
+  fe_mul (a5m1, a5m1, t);		/* a^{2^5-1} */
+  fe_sqr_n (t, a5m1, 5);
+  fe_mul (a10m1, t, a5m1);		/* a^{2^10-1} */
+  fe_sqr_n (t, a10m1, 10);
+  fe_mul (t, t, a10m1);			/* a^{2^20-1} */
+  fe_sqr_n (a50m1, t, 20);
+  fe_mul (t, a50m1, t);			/* a^{2^40-1} */
+  fe_sqr_n (t, t, 10);
+  fe_mul (a50m1, t, a10m1);		/* a^{2^50-1} */
+  fe_sqr_n (t, a50m1, 50);
+  fe_mul (a100m1, t, a50m1);		/* a^{2^100-1} */
+  fe_sqr_n (t, a100m1, 100);
+  fe_mul (t, t, a100m1);		/* a^{2^200-1} */
+  fe_sqr_n (t, t, 50);
+  fe_mul (t, t, a50m1);			/* a^{2^250-1} */
+  fe_sqr_n (t, t, 5);
+  fe_mul (r, t, a11);			/* a^{2^255-21} */
+}
+
+/* Same ladder as ecc_mul_m, with a24 = 121665, and scalar bits 3 to
+   253, bit 254 implicitly one. */
+void
+curve25519_ladder (uint8_t *q, const uint8_t *n, const uint8_t *p)
+{
+  fe51 x1, x2, z2, x3, z3, a, aa, b, d;
+  uint64_t swap;
+  unsigned i;
+
+  fe_load (x1, p);
+
+  /* x2 = x1, z2 = 1, and x3, z3 from doubling. */
+  for (i = 0; i < 5; i++)
+    {
+      x2[i] = x1[i];
+      z2[i] = 0;
+    }
+  z2[0] = 1;
+
+  fe_add (a, x2, z2);
+  fe_sub (b, x2, z2);
+  fe_sqr (aa, a);
+  fe_sqr (b, b);
+  fe_mul (x3, aa, b);
+  fe_sub (b, aa, b);			/* E */
+  fe_mul_small (d, b, 121665);
+  fe_add (aa, aa, d);
+  fe_mul (z3, b, aa);
+
+  for (i = 253, swap = 0; i >= 3; i--)
+    {
+      uint64_t bit = (n[i/8] >> (i & 7)) & 1;
+
+      fe_cswap (swap ^ bit, x2, x3);
+      fe_cswap (swap ^ bit, z2, z3);
+      swap = bit;
+
+      fe_add (a, x2, z2);
+      fe_sub (d, x3, z3);
+      fe_mul (d, d, a);			/* DA */
+      fe_sqr (aa, a);			/* AA */
+
+      fe_sub (b, x2, z2);		/* B */
+      fe_add (z3, x3, z3);		/* C */
+      fe_mul (z3, z3, b);		/* CB */
+      fe_sqr (b, b);			/* BB */
+
+      fe_mul (x2, aa, b);
+
+      fe_sub (b, aa, b);		/* E */
+      fe_mul_small (a, b, 121665);
+      fe_add (aa, aa, a);
+      fe_mul (z2, b, aa);
+
+      fe_add (x3, d, z3);
+      fe_sqr (x3, x3);
+
+      fe_sub (z3, d, z3);
+      fe_sqr (z3, z3);
+      fe_mul (z3, z3, x1);
+    }
+  fe_cswap (swap, x2, x3);
+  fe_cswap (swap, z2, z3);
+
+  /* The low three bits, just duplicating x2. */
+  for (i = 0; i < 3; i++)
+    {
+      fe_add (a, x2, z2);
+      fe_sub (b, x2, z2);
+      fe_sqr (aa, a);
+      fe_sqr (b, b);
+      fe_mul (x2, aa, b);
+      fe_sub (b, aa, b);
+      fe_mul_small (d, b, 121665);
+      fe_add (aa, aa, d);
+      fe_mul (z2, b, aa);
+    }
+
+  fe_invert (z2, z2);
+  fe_mul (x2, x2, z2);
+  fe_store (q, x2);
+}
+#endif /* HAVE_UINT128 */
@@ -71,3 +71,73 @@ curve25519_mul_g (uint8_t *r, const uint8_t *n)
 #undef x
 #undef scratch_out
 }
+
+/* Number of scalars sharing one inversion. */
+#define MUL_G_BATCH_SIZE 16
+
+void
+curve25519_mul_g_batch (size_t count, uint8_t *r, const uint8_t *n)
+{
+  const struct ecc_curve *ecc = &_nettle_curve25519;
+  mp_size_t size = ecc->p.size;
+  uint8_t t[CURVE25519_SIZE];
+  mp_limb_t *scratch;
+  mp_size_t itch;
+  size_t batch, i;
+
+  if (count == 0)
+    return;
+
+  batch = count < MUL_G_BATCH_SIZE ? count : MUL_G_BATCH_SIZE;
+  itch = ECC_MOD_INV_BATCH_ITCH (size, ecc->p.invert_itch);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  itch += 5*batch*size;
+  scratch = gmp_alloc_limbs (itch);
+
+#define ng scratch
+#define d (scratch + 3*batch*size)
+#define id (scratch + 4*batch*size)
+#define scratch_out (scratch + 5*batch*size)
+  while (count > 0)
+    {
+      size_t m = count < batch ? count : batch;
+
+      for (i = 0; i < m; i++)
+	{
+	  mp_limb_t *x = id + i*size;
+	  memcpy (t, n + i*CURVE25519_SIZE, sizeof(t));
+	  t[0] &= ~7;
+	  t[CURVE25519_SIZE-1] = (t[CURVE25519_SIZE-1] & 0x3f) | 0x40;
+
+	  mpn_set_base256_le (x, size, t, CURVE25519_SIZE);
+	  ecc_mul_g_eh (ecc, ng + 3*i*size, x, scratch_out);
+	}
+
+      /* As in curve25519_eh_to_x, x = (W + V) / (W - V). The
+	 clamped scalars are non-zero mod q, so W - V is invertible. */
+      for (i = 0; i < m; i++)
+	{
+	  const mp_limb_t *p = ng + 3*i*size;
+	  ecc_mod_sub (&ecc->p, d + i*size, p + 2*size, p + size);
+	}
+      ecc_mod_inv_batch (&ecc->p, m, id, d, scratch_out);
+
+      for (i = 0; i < m; i++)
+	{
+	  const mp_limb_t *p = ng + 3*i*size;
+	  ecc_mod_add (&ecc->p, d, p + 2*size, p + size);
+	  ecc_mod_mul_canonical (&ecc->p, d, d, id + i*size, scratch_out);
+	  mpn_get_base256_le (r + i*CURVE25519_SIZE, CURVE25519_SIZE, d, size);
+	}
+
+      count -= m;
+      n += m*CURVE25519_SIZE;
+      r += m*CURVE25519_SIZE;
+    }
+  gmp_free_limbs (scratch, itch);
+#undef ng
+#undef d
+#undef id
+#undef scratch_out
+}
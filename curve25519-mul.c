@@ -44,6 +44,9 @@
 void
 curve25519_mul (uint8_t *q, const uint8_t *n, const uint8_t *p)
 {
+#if HAVE_UINT128
+  curve25519_ladder (q, n, p);
+#else
   const struct ecc_modulo *m = &_nettle_curve25519.p;
   mp_size_t itch;
   mp_limb_t *x;
@@ -61,4 +64,5 @@ curve25519_mul (uint8_t *q, const uint8_t *n, const uint8_t *p)
   mpn_get_base256_le (q, CURVE25519_SIZE, x, m->size);
 
   gmp_free_limbs (x, itch);
+#endif
 }
@@ -41,6 +41,7 @@ extern "C" {
 /* Name mangling */
 #define curve25519_mul_g nettle_curve25519_mul_g
 #define curve25519_mul nettle_curve25519_mul
+#define curve25519_mul_g_batch nettle_curve25519_mul_g_batch
 
 #define CURVE25519_SIZE 32
 
@@ -53,6 +54,11 @@ curve25519_mul_g (uint8_t *q, const uint8_t *n);
 void
 curve25519_mul (uint8_t *q, const uint8_t *n, const uint8_t *p);
 
+/* Like curve25519_mul_g, for count scalars stored consecutively,
+   sharing the final inversions. */
+void
+curve25519_mul_g_batch (size_t count, uint8_t *q, const uint8_t *n);
+
 #ifdef __cplusplus
 }
 #endif
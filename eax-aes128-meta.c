@@ -56,3 +56,70 @@ nettle_eax_aes128 =
     (nettle_crypt_func *) eax_aes128_decrypt,
     (nettle_hash_digest_func *) eax_aes128_digest
   };
+
+/* Expanded key for nettle_eax_aes128_v2. */
+struct eax_aes128_v2_key
+{
+  struct eax_key key;
+  struct aes128_ctx cipher;
+};
+
+static void
+eax_aes128_v2_set_key (struct eax_aes128_v2_key *key, const uint8_t *aes_key)
+{
+  EAX_SET_KEY (key, aes128_set_encrypt_key, aes128_encrypt, aes_key);
+}
+
+static void
+eax_aes128_v2_init (struct eax_ctx *ctx, const struct eax_aes128_v2_key *key,
+		    const uint8_t *nonce)
+{
+  eax_set_nonce (ctx, &key->key, &key->cipher,
+		 (nettle_cipher_func *) aes128_encrypt, EAX_IV_SIZE, nonce);
+}
+
+static void
+eax_aes128_v2_update (struct eax_ctx *ctx, const struct eax_aes128_v2_key *key,
+		      size_t length, const uint8_t *data)
+{
+  eax_update (ctx, &key->key, &key->cipher,
+	      (nettle_cipher_func *) aes128_encrypt, length, data);
+}
+
+static void
+eax_aes128_v2_encrypt (struct eax_ctx *ctx, const struct eax_aes128_v2_key *key,
+		       size_t length, uint8_t *dst, const uint8_t *src)
+{
+  eax_encrypt (ctx, &key->key, &key->cipher,
+	       (nettle_cipher_func *) aes128_encrypt, length, dst, src);
+}
+
+static void
+eax_aes128_v2_decrypt (struct eax_ctx *ctx, const struct eax_aes128_v2_key *key,
+		       size_t length, uint8_t *dst, const uint8_t *src)
+{
+  eax_decrypt (ctx, &key->key, &key->cipher,
+	       (nettle_cipher_func *) aes128_encrypt, length, dst, src);
+}
+
+static void
+eax_aes128_v2_digest (struct eax_ctx *ctx, const struct eax_aes128_v2_key *key,
+		      uint8_t *digest)
+{
+  eax_digest (ctx, &key->key, &key->cipher,
+	      (nettle_cipher_func *) aes128_encrypt, digest);
+}
+
+const struct nettle_aead_v2
+nettle_eax_aes128_v2 =
+  { "eax_aes128", sizeof(struct eax_aes128_v2_key), sizeof(struct eax_ctx),
+    EAX_BLOCK_SIZE, AES128_KEY_SIZE,
+    EAX_IV_SIZE, EAX_DIGEST_SIZE,
+    (nettle_set_key_func *) eax_aes128_v2_set_key,
+    (nettle_aead_init_func *) eax_aes128_v2_init,
+    (nettle_aead_update_func *) eax_aes128_v2_update,
+    (nettle_aead_crypt_func *) eax_aes128_v2_encrypt,
+    (nettle_aead_crypt_func *) eax_aes128_v2_decrypt,
+    (nettle_aead_digest_func *) eax_aes128_v2_digest,
+    NULL, NULL,
+  };
@@ -53,6 +53,97 @@ ecc_ecdsa_sign_itch (const struct ecc_curve *ecc)
   return ECC_ECDSA_SIGN_ITCH (ecc->p.size);
 }
 
+void
+ecc_ecdsa_presign (const struct ecc_curve *ecc,
+		   const mp_limb_t *kp,
+		   mp_limb_t *rp, mp_limb_t *kinvp,
+		   mp_limb_t *scratch)
+{
+#define P	    scratch
+  ecc_mul_g (ecc, P, kp, P + 3*ecc->p.size);
+  /* x coordinate only, modulo q */
+  ecc_j_to_a (ecc, 2, rp, P, P + 3*ecc->p.size);
+
+  /* Invert k, uses up to 7 * ecc->p.size including scratch (for secp384). */
+  ecc->q.invert (&ecc->q, kinvp, kp, scratch);
+#undef P
+}
+
+void
+ecc_ecdsa_sign_presigned (const struct ecc_curve *ecc,
+			  const mp_limb_t *zp,
+			  const mp_limb_t *rp, const mp_limb_t *kinvp,
+			  size_t length, const uint8_t *digest,
+			  mp_limb_t *sp, mp_limb_t *scratch)
+{
+#define hp	    scratch /* NOTE: ecc->p.size + 1 limbs! */
+#define tp	    (scratch + ecc->p.size + 1)
+  /* Process hash digest */
+  _nettle_dsa_hash (hp, ecc->q.bit_size, length, digest);
+
+  ecc_mod_mul (&ecc->q, tp, zp, rp, tp);
+  ecc_mod_add (&ecc->q, hp, hp, tp);
+  ecc_mod_mul_canonical (&ecc->q, sp, hp, kinvp, tp);
+#undef hp
+#undef tp
+}
+
+mp_size_t
+ecc_ecdsa_sign_batch_itch (const struct ecc_curve *ecc, size_t n)
+{
+  mp_size_t size = ecc->p.size;
+  mp_size_t itch = ECC_J_TO_A_BATCH_ITCH (n, size, ecc->p.invert_itch);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  if (itch < ECC_MOD_INV_BATCH_ITCH (size, ecc->q.invert_itch))
+    itch = ECC_MOD_INV_BATCH_ITCH (size, ecc->q.invert_itch);
+  if (itch < ECC_ECDSA_SIGN_ITCH (size))
+    itch = ECC_ECDSA_SIGN_ITCH (size);
+
+  return 3*n*size + itch;
+}
+
+void
+ecc_ecdsa_presign_batch (const struct ecc_curve *ecc, size_t n,
+			 const mp_limb_t *kp,
+			 mp_limb_t *rp, mp_limb_t *kinvp,
+			 mp_limb_t *scratch)
+{
+#define P	    scratch
+#define scratch_out (scratch + 3*n*size)
+  mp_size_t size = ecc->p.size;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    ecc_mul_g (ecc, P + 3*i*size, kp + i*size, scratch_out);
+
+  /* x coordinates only, modulo q */
+  ecc_j_to_a_batch (ecc, 2, n, rp, P, scratch_out);
+  ecc_mod_inv_batch (&ecc->q, n, kinvp, kp, scratch_out);
+#undef P
+#undef scratch_out
+}
+
+void
+ecc_ecdsa_sign_batch (const struct ecc_curve *ecc,
+		      const mp_limb_t *zp,
+		      size_t n, const mp_limb_t *kp,
+		      size_t length, const uint8_t *digests,
+		      mp_limb_t *rp, mp_limb_t *sp,
+		      mp_limb_t *scratch)
+{
+  mp_size_t size = ecc->p.size;
+  size_t i;
+
+  /* The inverses of k are stored temporarily in sp. */
+  ecc_ecdsa_presign_batch (ecc, n, kp, rp, sp, scratch);
+
+  for (i = 0; i < n; i++)
+    ecc_ecdsa_sign_presigned (ecc, zp, rp + i*size, sp + i*size,
+			      length, digests + i*length,
+			      sp + i*size, scratch);
+}
+
 /* NOTE: Caller should check if r or s is zero. */
 void
 ecc_ecdsa_sign (const struct ecc_curve *ecc,
@@ -64,10 +155,6 @@ ecc_ecdsa_sign (const struct ecc_curve *ecc,
 		mp_limb_t *rp, mp_limb_t *sp,
 		mp_limb_t *scratch)
 {
-#define P	    scratch
-#define kinv	    scratch
-#define hp	    (scratch  + ecc->p.size) /* NOTE: ecc->p.size + 1 limbs! */
-#define tp	    (scratch + 2*ecc->p.size)
   /* Procedure, according to RFC 6090, "KT-I". q denotes the group
      order.
 
@@ -78,24 +165,9 @@ ecc_ecdsa_sign (const struct ecc_curve *ecc,
      3. s1 <-- r_x mod q
 
      4. s2 <-- (h + z*s1)/k mod q.
-  */
-
-  ecc_mul_g (ecc, P, kp, P + 3*ecc->p.size);
-  /* x coordinate only, modulo q */
-  ecc_j_to_a (ecc, 2, rp, P, P + 3*ecc->p.size);
-
-  /* Invert k, uses up to 7 * ecc->p.size including scratch (for secp384). */
-  ecc->q.invert (&ecc->q, kinv, kp, tp);
-  
-  /* Process hash digest */
-  _nettle_dsa_hash (hp, ecc->q.bit_size, length, digest);
 
-  ecc_mod_mul (&ecc->q, tp, zp, rp, tp);
-  ecc_mod_add (&ecc->q, hp, hp, tp);
-  ecc_mod_mul_canonical (&ecc->q, sp, hp, kinv, tp);
-
-#undef P
-#undef hp
-#undef kinv
-#undef tp
+     The inverse of k is stored temporarily in sp.
+  */
+  ecc_ecdsa_presign (ecc, kp, rp, sp, scratch);
+  ecc_ecdsa_sign_presigned (ecc, zp, rp, sp, length, digest, sp, scratch);
 }
@@ -98,8 +98,9 @@ ecc_ecdsa_verify (const struct ecc_curve *ecc,
      Or convert to projective coordinates (can be done without
      division, I think), and write an ecc_add_ppp. */
 
-  /* Compute sinv */
-  ecc->q.invert (&ecc->q, sinv, sp, sinv + ecc->p.size);
+  /* Compute sinv. The signature is public, so use the faster
+     variable time inversion. */
+  ecc_mod_inv_vartime (&ecc->q, sinv, sp, sinv + ecc->p.size);
 
   /* u1 = h / s, P1 = u1 * G */
   _nettle_dsa_hash (hp, ecc->q.bit_size, length, digest);
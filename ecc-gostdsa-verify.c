@@ -99,8 +99,9 @@ ecc_gostdsa_verify (const struct ecc_curve *ecc,
   if (mpn_zero_p (hp, ecc->p.size))
     mpn_add_1 (hp, hp, ecc->p.size, 1);
 
-  /* Compute v */
-  ecc->q.invert (&ecc->q, vp, hp, vp + ecc->p.size);
+  /* Compute v. The digest is public, so use the faster variable
+     time inversion. */
+  ecc_mod_inv_vartime (&ecc->q, vp, hp, vp + ecc->p.size);
 
   /* z1 = s / h, P1 = z1 * G */
   ecc_mod_mul_canonical (&ecc->q, z1, sp, vp, z1);
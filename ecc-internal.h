@@ -58,8 +58,12 @@
 #define ecc_mod_random _nettle_ecc_mod_random
 #define ecc_mod _nettle_ecc_mod
 #define ecc_mod_inv _nettle_ecc_mod_inv
+#define ecc_mod_inv_vartime _nettle_ecc_mod_inv_vartime
+#define ecc_mod_inv_batch _nettle_ecc_mod_inv_batch
 #define ecc_a_to_j _nettle_ecc_a_to_j
 #define ecc_j_to_a _nettle_ecc_j_to_a
+#define ecc_j_to_a_batch _nettle_ecc_j_to_a_batch
+#define ecc_ecdsa_presign_batch _nettle_ecc_ecdsa_presign_batch
 #define ecc_eh_to_a _nettle_ecc_eh_to_a
 #define ecc_dup_jj _nettle_ecc_dup_jj
 #define ecc_add_jja _nettle_ecc_add_jja
@@ -82,6 +86,7 @@
 #define sec_modinv _nettle_sec_modinv
 #define curve25519_eh_to_x _nettle_curve25519_eh_to_x
 #define curve448_eh_to_x _nettle_curve448_eh_to_x
+#define curve25519_ladder _nettle_curve25519_ladder
 
 extern const struct ecc_curve _nettle_secp_192r1;
 extern const struct ecc_curve _nettle_secp_224r1;
@@ -248,6 +253,17 @@ ecc_mod_func ecc_pp1_redc;
 ecc_mod_func ecc_pm1_redc;
 
 ecc_mod_inv_func ecc_mod_inv;
+/* Variable time, for public values only. */
+ecc_mod_inv_func ecc_mod_inv_vartime;
+
+/* Inverts n elements, stored consecutively, using Montgomery's
+   trick: a single call to m->invert, and three multiplications per
+   element. All elements must be invertible. Output must not overlap
+   the input. Needs ECC_MOD_INV_BATCH_ITCH limbs of scratch space. */
+void
+ecc_mod_inv_batch (const struct ecc_modulo *m, size_t n,
+		   mp_limb_t *rp, const mp_limb_t *ap,
+		   mp_limb_t *scratch);
 
 /* Side channel silent. Requires that x < 2m, so checks if x == 0 or x == p */
 int
@@ -342,6 +358,24 @@ ecc_j_to_a (const struct ecc_curve *ecc,
 	    mp_limb_t *r, const mp_limb_t *p,
 	    mp_limb_t *scratch);
 
+/* Converts n points, stored consecutively, sharing a single
+   inversion. The output points are also stored consecutively, each
+   of size 2*ecc->p.size, or ecc->p.size if op > 0. None of the points
+   may be zero. */
+void
+ecc_j_to_a_batch (const struct ecc_curve *ecc,
+		  int op, size_t n,
+		  mp_limb_t *r, const mp_limb_t *p,
+		  mp_limb_t *scratch);
+
+/* Like ecc_ecdsa_presign, for n nonces, sharing the inversions.
+   Needs ecc_ecdsa_sign_batch_itch (ecc, n) limbs of scratch. */
+void
+ecc_ecdsa_presign_batch (const struct ecc_curve *ecc, size_t n,
+			 const mp_limb_t *kp,
+			 mp_limb_t *rp, mp_limb_t *kinvp,
+			 mp_limb_t *scratch);
+
 /* Converts a point P in homogeneous coordinates on an Edwards curve
    to affine coordinates. Meaning of op is the same as for
    ecc_j_to_a. */
@@ -470,9 +504,20 @@ void
 curve448_eh_to_x (mp_limb_t *xp, const mp_limb_t *p,
 		  mp_limb_t *scratch);
 
+#if HAVE_UINT128
+/* Dedicated ladder for curve25519_mul, using radix 2^51 and 128-bit
+   products. */
+void
+curve25519_ladder (uint8_t *q, const uint8_t *n, const uint8_t *p);
+#endif
+
 /* Current scratch needs: */
-#define ECC_MOD_INV_ITCH(size) (3*(size))
+/* The divsteps need 2n + 4 limbs, and callers, e.g., ecc_j_to_a,
+   assume at least 3n. */
+#define ECC_MOD_INV_ITCH(size) (3*(size) + 4)
 #define ECC_J_TO_A_ITCH(size, inv) ((size)+(inv))
+#define ECC_MOD_INV_BATCH_ITCH(size, inv) ((size)+(inv))
+#define ECC_J_TO_A_BATCH_ITCH(n, size, inv) (2*(n)*(size) + 2*(size) + (inv))
 #define ECC_EH_TO_A_ITCH(size, inv) ((size)+(inv))
 #define ECC_DUP_JJ_ITCH(size) (4*(size))
 #define ECC_DUP_EH_ITCH(size) (3*(size))
@@ -84,3 +84,58 @@ ecc_j_to_a (const struct ecc_curve *ecc,
 #undef iz3p
 #undef tp
 }
+
+void
+ecc_j_to_a_batch (const struct ecc_curve *ecc,
+		  int op, size_t n,
+		  mp_limb_t *r, const mp_limb_t *p,
+		  mp_limb_t *scratch)
+{
+#define zp    scratch
+#define izp  (scratch + n*size)
+#define iz2p (scratch + 2*n*size)
+#define iz3p (scratch + 2*n*size + size)
+#define tp    scratch
+
+  mp_size_t size = ecc->p.size;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    mpn_copyi (zp + i*size, p + 3*i*size + 2*size, size);
+
+  ecc_mod_inv_batch (&ecc->p, n, izp, zp, iz2p);
+
+  for (i = 0; i < n; i++, p += 3*size)
+    {
+      const mp_limb_t *ip = izp + i*size;
+      ecc_mod_sqr (&ecc->p, iz2p, ip, iz3p);
+
+      if (ecc->use_redc)
+	{
+	  mpn_zero (iz2p + size, size);
+	  ecc->p.reduce (&ecc->p, iz2p, iz2p);
+	}
+
+      ecc_mod_mul_canonical (&ecc->p, r, iz2p, p, iz3p);
+      if (op)
+	{
+	  if (op > 1)
+	    {
+	      mp_limb_t cy;
+	      cy = mpn_sub_n (iz3p, r, ecc->q.m, size);
+	      cnd_copy (1 - cy, r, iz3p, size);
+	    }
+	  r += size;
+	  continue;
+	}
+      ecc_mod_mul (&ecc->p, iz3p, iz2p, ip, iz3p);
+      /* The z values are no longer needed. */
+      ecc_mod_mul_canonical (&ecc->p, r + size, iz3p, p + size, tp);
+      r += 2*size;
+    }
+#undef zp
+#undef izp
+#undef iz2p
+#undef iz3p
+#undef tp
+}
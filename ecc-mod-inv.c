@@ -55,105 +55,255 @@ cnd_neg (int cnd, mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
     }
 }
 
+/* Constant-time inversion using the divsteps of Bernstein and Yang,
+   "Fast constant-time gcd computation and modular inversion" (2019).
+   The divsteps are computed in batches on the low limbs of f and g
+   only, collecting a 2x2 transition matrix, which is then applied to
+   the full numbers.
+
+   With K = GMP_NUMB_BITS - 2 divsteps per batch, the matrix entries
+   are at most 2^K in absolute value, and fit in a signed limb. */
+#define DIVSTEP_BATCH (GMP_NUMB_BITS - 2)
+#define DIVSTEP_MASK (((mp_limb_t) 1 << DIVSTEP_BATCH) - 1)
+
+/* All ones if the most significant bit is set. */
+#define SIGN_MASK(x) (-((x) >> (GMP_NUMB_BITS - 1)))
+
+/* Performs DIVSTEP_BATCH divsteps, starting from the low limbs of f
+   and g, and the given delta, all interpreted as signed. Stores the
+   transition matrix (u, v; q, r) such that
+
+     2^K (f', g') = (u f + v g, q f + r g)
+
+   and returns the new delta. */
+static mp_limb_t
+divsteps (mp_limb_t delta, mp_limb_t f, mp_limb_t g, mp_limb_t *t)
+{
+  mp_limb_t u = 1, v = 0, q = 0, r = 1;
+  unsigned i;
+
+  for (i = 0; i < DIVSTEP_BATCH; i++)
+    {
+      /* The logic of the iteration is
+
+	   if (delta > 0 && g odd)
+	     (delta, f, g) = (-delta, g, -f)
+	   delta++
+	   if (g odd)
+	     g += f
+	   g /= 2
+
+	 where the first step keeps f odd, and g/2 is exact. */
+      mp_limb_t odd = -(g & 1);
+      mp_limb_t swap = odd & SIGN_MASK (-delta);
+      mp_limb_t x;
+
+      delta = (delta ^ swap) - swap;
+      x = (f ^ g) & swap; f ^= x; g ^= x; g = (g ^ swap) - swap;
+      x = (u ^ q) & swap; u ^= x; q ^= x; q = (q ^ swap) - swap;
+      x = (v ^ r) & swap; v ^= x; r ^= x; r = (r ^ swap) - swap;
+
+      delta++;
+      g += f & odd;
+      q += u & odd;
+      r += v & odd;
+
+      g >>= 1;
+      u <<= 1;
+      v <<= 1;
+    }
+  t[0] = u; t[1] = v; t[2] = q; t[3] = r;
+  return delta;
+}
+
+/* Sets {rp, n+1} = u a, where {ap, n} is a two's complement number,
+   and u is a signed limb. The product is computed modulo B^{n+1},
+   which is exact when it fits. */
+static void
+mul_signed (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n, mp_limb_t u)
+{
+  rp[n] = mpn_mul_1 (rp, ap, n, u) - (u & SIGN_MASK (ap[n-1]));
+  mpn_cnd_sub_n (u >> (GMP_NUMB_BITS - 1), rp + 1, rp + 1, ap, n);
+}
+
+/* Like mul_signed, but adds the product to {rp, n+1}. */
+static void
+addmul_signed (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n, mp_limb_t u)
+{
+  rp[n] += mpn_addmul_1 (rp, ap, n, u) - (u & SIGN_MASK (ap[n-1]));
+  mpn_cnd_sub_n (u >> (GMP_NUMB_BITS - 1), rp + 1, rp + 1, ap, n);
+}
+
+/* Sets {rp, n} = {ap, n+1} / 2^K, where the division is exact. Clobbers ap. */
+static void
+shift_batch (mp_limb_t *rp, mp_limb_t *ap, mp_size_t n)
+{
+  mpn_rshift (ap, ap, n + 1, DIVSTEP_BATCH);
+  mpn_copyi (rp, ap, n);
+}
+
+static void
+mod_inv_divsteps (const struct ecc_modulo *m,
+		  mp_limb_t *vp, const mp_limb_t *ap,
+		  mp_limb_t *scratch, int vartime)
+{
+#define t0 scratch
+#define t1 (scratch + n + 2)
+  /* All numbers are two's complement, with an extra limb for the
+     sign. */
+  mp_limb_t fp[ECC_MAX_SIZE + 1];
+  mp_limb_t gp[ECC_MAX_SIZE + 1];
+  mp_limb_t dp[ECC_MAX_SIZE + 1];
+  mp_limb_t ep[ECC_MAX_SIZE + 1];
+  mp_limb_t mp[ECC_MAX_SIZE + 1];
+
+  mp_size_t n = m->size;
+  mp_size_t nn = n + 1;
+  mp_limb_t minv, delta, sf, ok;
+  unsigned i, steps;
+
+  assert (n <= ECC_MAX_SIZE);
+  assert (m->m[0] & 1);
+
+  /* m^{-1} mod B, by Newton iteration. Initial value is correct to
+     5 bits. */
+  minv = (3 * m->m[0]) ^ 2;
+  for (i = 5; i < GMP_NUMB_BITS; i *= 2)
+    minv = 2*minv - minv*minv*m->m[0];
+
+  /* Number of divsteps that suffice for inputs of the given bit
+     size, according to the paper's Theorem 11.2. */
+  steps = (49 * n * GMP_NUMB_BITS + 80) / 17;
+
+  /* Maintain
+
+       f = d * a (mod m)
+       g = e * a (mod m)
+
+     with f odd, and -2m < d, e < m. Initially,
+
+       f = m, d = 0
+       g = a, e = 1
+  */
+  mpn_copyi (mp, m->m, n);
+  mp[n] = 0;
+  mpn_copyi (fp, mp, nn);
+  mpn_copyi (gp, ap, n);
+  gp[n] = 0;
+  mpn_zero (dp, nn);
+  mpn_zero (ep, nn);
+  ep[0] = 1;
+  delta = 1;
+
+  for (i = 0; i < steps; i += DIVSTEP_BATCH)
+    {
+      mp_limb_t t[4];
+      mp_limb_t sd, se, md, me;
+
+      if (vartime && mpn_zero_p (gp, nn))
+	break;
+
+      delta = divsteps (delta, fp[0], gp[0], t);
+
+      mul_signed (t0, fp, nn, t[0]);
+      addmul_signed (t0, gp, nn, t[1]);
+      mul_signed (t1, fp, nn, t[2]);
+      addmul_signed (t1, gp, nn, t[3]);
+      shift_batch (fp, t0, nn);
+      shift_batch (gp, t1, nn);
+
+      /* To update d and e, add multiples of m to make them divisible
+	 by 2^K. Adding m to negative d and e first keeps them in
+	 range. */
+      sd = SIGN_MASK (dp[n]);
+      se = SIGN_MASK (ep[n]);
+      md = (t[0] & sd) + (t[1] & se);
+      me = (t[2] & sd) + (t[3] & se);
+
+      mul_signed (t0, dp, nn, t[0]);
+      addmul_signed (t0, ep, nn, t[1]);
+      mul_signed (t1, dp, nn, t[2]);
+      addmul_signed (t1, ep, nn, t[3]);
+
+      md -= (minv * t0[0] + md) & DIVSTEP_MASK;
+      me -= (minv * t1[0] + me) & DIVSTEP_MASK;
+
+      addmul_signed (t0, mp, nn, md);
+      addmul_signed (t1, mp, nn, me);
+
+      shift_batch (dp, t0, nn);
+      shift_batch (ep, t1, nn);
+    }
+  assert_maybe (sec_zero_p (gp, nn));
+
+  /* Now f = ± gcd(a, m), and f = d a (mod m). Normalize d from the
+     range -2m < d < m, and the sign of f. */
+  mpn_cnd_add_n (SIGN_MASK (dp[n]), dp, dp, mp, nn);
+  sf = SIGN_MASK (fp[n]);
+  cnd_neg (sf & 1, fp, fp, nn);
+  cnd_neg (sf & 1, dp, dp, nn);
+  mpn_cnd_add_n (SIGN_MASK (dp[n]), dp, dp, mp, nn);
+
+  /* Return zero if a is not invertible, including a = 0 (mod m). */
+  fp[0] ^= 1;
+  ok = -(mp_limb_t) sec_zero_p (fp, nn);
+  for (i = 0; i < n; i++)
+    vp[i] = dp[i] & ok;
+#undef t0
+#undef t1
+}
+
 /* Compute a^{-1} mod m, with running time depending only on the size.
    Returns zero if a == 0 (mod m), to be consistent with a^{phi(m)-1}.
-   Also needs (m+1)/2, and m must be odd.
+   The modulus m must be odd.
 
-   Needs 3n limbs of scratch space.
+   Needs 2n + 4 limbs of scratch space.
 */
-
-/* FIXME: Could use mpn_sec_invert (in GMP-6), but with a bit more
-   scratch need since it doesn't precompute (m+1)/2. */
 void
 ecc_mod_inv (const struct ecc_modulo *m,
-	     mp_limb_t *vp, const mp_limb_t *in_ap,
+	     mp_limb_t *vp, const mp_limb_t *ap,
 	     mp_limb_t *scratch)
 {
-#define ap scratch
-#define bp (scratch + n)
-#define up (scratch + 2*n)
-
-  mp_size_t n = m->size;
-  mp_bitcnt_t i;
-
-  /* Maintain
+  mod_inv_divsteps (m, vp, ap, scratch, 0);
+}
 
-       a = u * orig_a (mod m)
-       b = v * orig_a (mod m)
+/* Like ecc_mod_inv, but stops as soon as the gcd is found, so the
+   running time depends on the input. Only for public values. */
+void
+ecc_mod_inv_vartime (const struct ecc_modulo *m,
+		     mp_limb_t *vp, const mp_limb_t *ap,
+		     mp_limb_t *scratch)
+{
+  mod_inv_divsteps (m, vp, ap, scratch, 1);
+}
 
-     and b odd at all times. Initially,
+void
+ecc_mod_inv_batch (const struct ecc_modulo *m, size_t n,
+		   mp_limb_t *rp, const mp_limb_t *ap,
+		   mp_limb_t *scratch)
+{
+#define ip scratch
+#define tp (scratch + size)
+  mp_size_t size = m->size;
+  size_t i;
 
-       a = a_orig, u = 1
-       b = m,      v = 0
-     */
+  assert (n > 0);
+  assert (m->invert_itch >= 2*size);
 
-  assert (ap != vp);
+  /* Prefix products, c_i = a_0 a_1 ... a_i, stored in rp. */
+  mpn_copyi (rp, ap, size);
+  for (i = 1; i < n; i++)
+    ecc_mod_mul (m, rp + i*size, rp + (i-1)*size, ap + i*size, tp);
 
-  up[0] = 1;
-  mpn_zero (up+1, n - 1);
-  mpn_copyi (bp, m->m, n);
-  mpn_zero (vp, n);
-  mpn_copyi (ap, in_ap, n);
+  m->invert (m, ip, rp + (n-1)*size, tp);
 
-  for (i = m->bit_size + GMP_NUMB_BITS * n; i-- > 0; )
+  /* Invariant: ip = (a_0 ... a_i)^{-1} */
+  for (i = n - 1; i > 0; i--)
     {
-      mp_limb_t odd, swap, cy;
-      
-      /* Always maintain b odd. The logic of the iteration is as
-	 follows. For a, b:
-
-	   odd = a & 1
-	   a -= odd * b
-	   if (underflow from a-b)
-	     {
-	       b += a, assigns old a
-	       a = B^n-a
-	     }
-	   
-	   a /= 2
-
-	 For u, v:
-
-	   if (underflow from a - b)
-	     swap u, v
-	   u -= odd * v
-	   if (underflow from u - v)
-	     u += m
-
-	   u /= 2
-	   if (a one bit was shifted out)
-	     u += (m+1)/2
-
-	 As long as a > 0, the quantity
-
-	   (bitsize of a) + (bitsize of b)
-
-	 is reduced by at least one bit per iteration, hence after
-         (bit_size of orig_a) + (bit_size of m) - 1 iterations we
-         surely have a = 0. Then b = gcd(orig_a, m) and if b = 1 then
-         also v = orig_a^{-1} (mod m)
-      */
-
-      assert_maybe (bp[0] & 1);
-      odd = ap[0] & 1;
-
-      swap = mpn_cnd_sub_n (odd, ap, ap, bp, n);
-      mpn_cnd_add_n (swap, bp, bp, ap, n);
-      cnd_neg (swap, ap, ap, n);
-
-      mpn_cnd_swap (swap, up, vp, n);
-      cy = mpn_cnd_sub_n (odd, up, up, vp, n);
-      cy -= mpn_cnd_add_n (cy, up, up, m->m, n);
-      assert_maybe (cy == 0);
-
-      cy = mpn_rshift (ap, ap, n, 1);
-      assert_maybe (cy == 0);
-      cy = mpn_rshift (up, up, n, 1);
-      cy = mpn_cnd_add_n (cy, up, up, m->mp1h, n);
-      assert_maybe (cy == 0);
+      ecc_mod_mul (m, rp + i*size, ip, rp + (i-1)*size, tp);
+      ecc_mod_mul (m, ip, ip, ap + i*size, tp);
     }
-  assert_maybe ( (ap[0] | ap[n-1]) == 0);
-#undef ap
-#undef bp
-#undef up
+  mpn_copyi (rp, ip, size);
+#undef ip
+#undef tp
 }
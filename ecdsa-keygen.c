@@ -60,3 +60,59 @@ ecdsa_generate_keypair (struct ecc_point *pub,
   ecc->mul_g (ecc, p, key->p, p + 3*ecc->p.size);
   ecc->h_to_a (ecc, 0, pub->p, p, p + 3*ecc->p.size);
 }
+
+/* Number of keys sharing one inversion. */
+#define KEYGEN_BATCH_SIZE 16
+
+void
+ecdsa_generate_keypair_batch (size_t n, struct ecc_point *pub,
+			      struct ecc_scalar *key,
+			      void *random_ctx, nettle_random_func *random)
+{
+  const struct ecc_curve *ecc;
+  mp_size_t size, itch;
+  size_t batch, i;
+  mp_limb_t *scratch;
+
+  if (n == 0)
+    return;
+
+  ecc = pub->ecc;
+  /* Only for curves using jacobian coordinates. */
+  assert (ecc->h_to_a == ecc_j_to_a);
+  size = ecc->p.size;
+  batch = n < KEYGEN_BATCH_SIZE ? n : KEYGEN_BATCH_SIZE;
+  itch = ECC_J_TO_A_BATCH_ITCH (batch, size, ecc->p.invert_itch);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  /* Points, followed by affine coordinates. */
+  itch += 5*batch*size;
+
+  scratch = gmp_alloc_limbs (itch);
+
+#define P scratch
+#define A (scratch + 3*batch*size)
+#define scratch_out (scratch + 5*batch*size)
+  while (n > 0)
+    {
+      size_t m = n < batch ? n : batch;
+      for (i = 0; i < m; i++)
+	{
+	  assert (pub[i].ecc == ecc);
+	  assert (key[i].ecc == ecc);
+	  ecc_mod_random (&ecc->q, key[i].p, random_ctx, random, scratch_out);
+	  ecc->mul_g (ecc, P + 3*i*size, key[i].p, scratch_out);
+	}
+      ecc_j_to_a_batch (ecc, 0, m, A, P, scratch_out);
+      for (i = 0; i < m; i++)
+	mpn_copyi (pub[i].p, A + 2*i*size, 2*size);
+
+      n -= m;
+      pub += m;
+      key += m;
+    }
+  gmp_free_limbs (scratch, itch);
+#undef P
+#undef A
+#undef scratch_out
+}
@@ -0,0 +1,191 @@
+/* ecdsa-presign.c
+
+   ECDSA signing with precomputed nonces.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#if HAVE_STDATOMIC
+# include <stdatomic.h>
+#endif
+
+#include "ecdsa.h"
+#include "ecc-internal.h"
+#include "nettle-internal.h"
+
+/* The head index is written only by the consumer, and the tail index
+   only by the producer. The release store of an index publishes the
+   entries written, or wiped, before it. Without C11 atomics, the
+   pool must not be shared between threads. */
+#if HAVE_STDATOMIC
+# define LOAD_INDEX(p) \
+  atomic_load_explicit ((_Atomic unsigned *) (p), memory_order_acquire)
+# define STORE_INDEX(p, x) \
+  atomic_store_explicit ((_Atomic unsigned *) (p), (x), memory_order_release)
+#else
+# define LOAD_INDEX(p) (*(p))
+# define STORE_INDEX(p, x) (*(p) = (x))
+#endif
+
+/* Indices are counted modulo 2 size. Each entry holds r followed by
+   k^{-1}. */
+#define NEXT(pool, i) ((i) + 1 == 2 * (pool)->size ? 0 : (i) + 1)
+#define COUNT(pool, head, tail) \
+  ((tail) >= (head) ? (tail) - (head) : 2 * (pool)->size + (tail) - (head))
+#define ENTRY(pool, i) ((pool)->entries + 2 * (pool)->ecc->p.size \
+			* ((i) < (pool)->size ? (i) : (i) - (pool)->size))
+
+void
+ecdsa_presign_pool_init (struct ecdsa_presign_pool *pool,
+			 const struct ecc_curve *ecc, unsigned size)
+{
+  assert (size > 0);
+  pool->ecc = ecc;
+  pool->size = size;
+  pool->head = pool->tail = 0;
+  pool->entries = gmp_alloc_limbs (2 * ecc->p.size * size);
+}
+
+void
+ecdsa_presign_pool_clear (struct ecdsa_presign_pool *pool)
+{
+  mp_size_t n = 2 * pool->ecc->p.size * pool->size;
+  /* Don't leave any nonces behind. */
+  mpn_zero (pool->entries, n);
+  gmp_free_limbs (pool->entries, n);
+}
+
+/* Number of entries sharing one inversion. */
+#define PRESIGN_BATCH_SIZE 16
+
+unsigned
+ecdsa_presign_pool_fill (struct ecdsa_presign_pool *pool,
+			 void *random_ctx, nettle_random_func *random,
+			 unsigned n)
+{
+  const struct ecc_curve *ecc = pool->ecc;
+  mp_size_t size = ecc->p.size;
+  mp_size_t itch;
+  mp_limb_t *scratch;
+  unsigned batch, done, tail, count;
+
+  /* The consumer may free more entries concurrently, but never
+     fewer, so the free space can only grow while we work. */
+  tail = pool->tail;
+  count = COUNT (pool, LOAD_INDEX (&pool->head), tail);
+  if (n > pool->size - count)
+    n = pool->size - count;
+  if (n == 0)
+    return 0;
+
+  batch = n < PRESIGN_BATCH_SIZE ? n : PRESIGN_BATCH_SIZE;
+  itch = 3*batch*size + ecc_ecdsa_sign_batch_itch (ecc, batch);
+  scratch = gmp_alloc_limbs (itch);
+
+#define kp scratch
+#define rp (scratch + batch*size)
+#define kinvp (scratch + 2*batch*size)
+#define scratch_out (scratch + 3*batch*size)
+  for (done = 0; done < n; )
+    {
+      unsigned m = n - done < batch ? n - done : batch;
+      unsigned i;
+
+      for (i = 0; i < m; i++)
+	ecc_mod_random (&ecc->q, kp + i*size, random_ctx, random, scratch_out);
+
+      ecc_ecdsa_presign_batch (ecc, m, kp, rp, kinvp, scratch_out);
+
+      /* Only copying touches the ring. */
+      for (i = 0; i < m; i++)
+	{
+	  mp_limb_t *entry;
+	  /* Discard the unlikely nonce giving r = 0. */
+	  if (mpn_zero_p (rp + i*size, size))
+	    continue;
+	  entry = ENTRY (pool, tail);
+	  mpn_copyi (entry, rp + i*size, size);
+	  mpn_copyi (entry + size, kinvp + i*size, size);
+	  tail = NEXT (pool, tail);
+	  done++;
+	}
+      STORE_INDEX (&pool->tail, tail);
+    }
+  mpn_zero (scratch, itch);
+  gmp_free_limbs (scratch, itch);
+#undef kp
+#undef rp
+#undef kinvp
+#undef scratch_out
+  return done;
+}
+
+int
+ecdsa_sign_from_pool (struct ecdsa_presign_pool *pool,
+		      const struct ecc_scalar *key,
+		      size_t digest_length,
+		      const uint8_t *digest,
+		      struct dsa_signature *signature)
+{
+  TMP_DECL(scratch, mp_limb_t, ECC_ECDSA_SIGN_ITCH (ECC_MAX_SIZE));
+  const struct ecc_curve *ecc = key->ecc;
+  mp_size_t size = ecc->p.size;
+  unsigned head;
+
+  assert (ecc == pool->ecc);
+  TMP_ALLOC (scratch, ECC_ECDSA_SIGN_ITCH (size));
+
+  for (head = pool->head; head != LOAD_INDEX (&pool->tail); )
+    {
+      mp_limb_t *rp = ENTRY (pool, head);
+
+      ecc_ecdsa_sign_presigned (ecc, key->p, rp, rp + size,
+				digest_length, digest,
+				mpz_limbs_write (signature->s, size),
+				scratch);
+      mpz_set_n (signature->r, rp, size);
+      mpz_limbs_finish (signature->s, size);
+
+      /* Each nonce must be used only once. Wipe it before handing the
+	 slot back to the producer. */
+      mpn_zero (rp, 2 * size);
+      head = NEXT (pool, head);
+      STORE_INDEX (&pool->head, head);
+
+      if (mpz_sgn (signature->s) != 0)
+	return 1;
+    }
+  return 0;
+}
@@ -47,6 +47,15 @@ extern "C" {
 #define ecdsa_generate_keypair nettle_ecdsa_generate_keypair
 #define ecc_ecdsa_sign nettle_ecc_ecdsa_sign
 #define ecc_ecdsa_sign_itch nettle_ecc_ecdsa_sign_itch
+#define ecc_ecdsa_presign nettle_ecc_ecdsa_presign
+#define ecc_ecdsa_sign_presigned nettle_ecc_ecdsa_sign_presigned
+#define ecc_ecdsa_sign_batch nettle_ecc_ecdsa_sign_batch
+#define ecc_ecdsa_sign_batch_itch nettle_ecc_ecdsa_sign_batch_itch
+#define ecdsa_generate_keypair_batch nettle_ecdsa_generate_keypair_batch
+#define ecdsa_presign_pool_init nettle_ecdsa_presign_pool_init
+#define ecdsa_presign_pool_clear nettle_ecdsa_presign_pool_clear
+#define ecdsa_presign_pool_fill nettle_ecdsa_presign_pool_fill
+#define ecdsa_sign_from_pool nettle_ecdsa_sign_from_pool
 #define ecc_ecdsa_verify nettle_ecc_ecdsa_verify
 #define ecc_ecdsa_verify_itch nettle_ecc_ecdsa_verify_itch
 
@@ -71,6 +80,59 @@ ecdsa_generate_keypair (struct ecc_point *pub,
 			struct ecc_scalar *key,
 			void *random_ctx, nettle_random_func *random);
 
+/* Generates n key pairs, sharing the inversions needed to convert
+   the public keys to affine coordinates. */
+void
+ecdsa_generate_keypair_batch (size_t n, struct ecc_point *pub,
+			      struct ecc_scalar *key,
+			      void *random_ctx, nettle_random_func *random);
+
+/* A bounded ring of precomputed pairs (r, k^{-1}), moving the
+   scalar multiplication and inversion out of the signing call. Each
+   entry is wiped when used. The ring is lock-free for one producer
+   and one consumer: one thread may call ecdsa_presign_pool_fill
+   while another calls ecdsa_sign_from_pool, with no locking, on
+   systems with C11 atomics. Several producers, or several
+   consumers, must be serialized by the caller. */
+struct ecdsa_presign_pool
+{
+  const struct ecc_curve *ecc;
+  /* Capacity. */
+  unsigned size;
+  /* Positions of the oldest entry, written only by the consumer, and
+     of the next free slot, written only by the producer. Both are
+     counted modulo 2 size, so that a full ring can be distinguished
+     from an empty one. */
+  unsigned head;
+  unsigned tail;
+  mp_limb_t *entries;
+};
+
+void
+ecdsa_presign_pool_init (struct ecdsa_presign_pool *pool,
+			 const struct ecc_curve *ecc, unsigned size);
+
+void
+ecdsa_presign_pool_clear (struct ecdsa_presign_pool *pool);
+
+/* Adds at most n entries, limited by the free space. The scalar
+   multiplications are done outside of the ring, which is updated
+   only by copying in the finished entries. Returns the number of
+   entries added. */
+unsigned
+ecdsa_presign_pool_fill (struct ecdsa_presign_pool *pool,
+			 void *random_ctx, nettle_random_func *random,
+			 unsigned n);
+
+/* Returns 1 on success, and 0 if the pool is empty, in which case
+   the caller can fall back to ecdsa_sign. */
+int
+ecdsa_sign_from_pool (struct ecdsa_presign_pool *pool,
+		      const struct ecc_scalar *key,
+		      size_t digest_length,
+		      const uint8_t *digest,
+		      struct dsa_signature *signature);
+
 /* Low-level ECDSA functions. */
 mp_size_t
 ecc_ecdsa_sign_itch (const struct ecc_curve *ecc);
@@ -85,6 +147,37 @@ ecc_ecdsa_sign (const struct ecc_curve *ecc,
 		mp_limb_t *rp, mp_limb_t *sp,
 		mp_limb_t *scratch);
 
+/* Computes r and k^{-1} for the nonce k. Uses the same scratch
+   space as ecc_ecdsa_sign. */
+void
+ecc_ecdsa_presign (const struct ecc_curve *ecc,
+		   const mp_limb_t *kp,
+		   mp_limb_t *rp, mp_limb_t *kinvp,
+		   mp_limb_t *scratch);
+
+/* Completes the signature, using values from ecc_ecdsa_presign,
+   which must never be used for more than one signature. */
+void
+ecc_ecdsa_sign_presigned (const struct ecc_curve *ecc,
+			  const mp_limb_t *zp,
+			  const mp_limb_t *rp, const mp_limb_t *kinvp,
+			  size_t length, const uint8_t *digest,
+			  mp_limb_t *sp, mp_limb_t *scratch);
+
+mp_size_t
+ecc_ecdsa_sign_batch_itch (const struct ecc_curve *ecc, size_t n);
+
+/* Signs n digests of the same length, stored consecutively, with n
+   nonces, sharing the inversions. Outputs n values each of r and s.
+   Caller should check if any of them is zero. */
+void
+ecc_ecdsa_sign_batch (const struct ecc_curve *ecc,
+		      const mp_limb_t *zp,
+		      size_t n, const mp_limb_t *kp,
+		      size_t length, const uint8_t *digests,
+		      mp_limb_t *rp, mp_limb_t *sp,
+		      mp_limb_t *scratch);
+
 mp_size_t
 ecc_ecdsa_verify_itch (const struct ecc_curve *ecc);
 
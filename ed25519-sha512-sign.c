@@ -33,6 +33,9 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "eddsa.h"
 #include "eddsa-internal.h"
 
@@ -40,28 +43,52 @@
 #include "sha2.h"
 
 void
-ed25519_sha512_sign (const uint8_t *pub,
-		     const uint8_t *priv,
-		     size_t length, const uint8_t *msg,
-		     uint8_t *signature)
+ed25519_sha512_set_key (struct ed25519_sha512_key *key,
+			const uint8_t *pub, const uint8_t *priv)
 {
   const struct ecc_curve *ecc = &_nettle_curve25519;
-  mp_size_t itch = ecc->q.size + _eddsa_sign_itch (ecc);
-  mp_limb_t *scratch = gmp_alloc_limbs (itch);
-#define k2 scratch
-#define scratch_out (scratch + ecc->q.size)
   struct sha512_ctx ctx;
   uint8_t digest[SHA512_DIGEST_SIZE];
 
+  assert (ecc->p.size <= sizeof (key->k) / sizeof (key->k[0]));
+
+  sha512_init (&ctx);
+  _eddsa_expand_key (ecc, &_nettle_ed25519_sha512, &ctx, priv, digest, key->k);
+  memcpy (key->prefix, digest + ED25519_KEY_SIZE, ED25519_KEY_SIZE);
+  memcpy (key->pub, pub, ED25519_KEY_SIZE);
+}
+
+mp_size_t
+ed25519_sha512_sign_itch (void)
+{
+  return _eddsa_sign_itch (&_nettle_curve25519);
+}
+
+void
+ed25519_sha512_sign_with_key (const struct ed25519_sha512_key *key,
+			      size_t length, const uint8_t *msg,
+			      uint8_t *signature, mp_limb_t *scratch)
+{
+  struct sha512_ctx ctx;
+
   sha512_init (&ctx);
-  _eddsa_expand_key (ecc, &_nettle_ed25519_sha512, &ctx, priv, digest, k2);
+  _eddsa_sign (&_nettle_curve25519, &_nettle_ed25519_sha512, &ctx,
+	       key->pub, key->prefix, key->k,
+	       length, msg, signature, scratch);
+}
+
+void
+ed25519_sha512_sign (const uint8_t *pub,
+		     const uint8_t *priv,
+		     size_t length, const uint8_t *msg,
+		     uint8_t *signature)
+{
+  mp_size_t itch = ed25519_sha512_sign_itch ();
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+  struct ed25519_sha512_key key;
 
-  _eddsa_sign (ecc, &_nettle_ed25519_sha512, &ctx,
-	       pub, digest + ED25519_KEY_SIZE, k2,
-	       length, msg, signature, scratch_out);
+  ed25519_sha512_set_key (&key, pub, priv);
+  ed25519_sha512_sign_with_key (&key, length, msg, signature, scratch);
 
   gmp_free_limbs (scratch, itch);
-#undef k1
-#undef k2
-#undef scratch_out
 }
@@ -34,6 +34,9 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "eddsa.h"
 
 #include "ecc-internal.h"
@@ -41,29 +44,52 @@
 #include "sha3.h"
 
 void
-ed448_shake256_sign (const uint8_t *pub,
-		     const uint8_t *priv,
-		     size_t length, const uint8_t *msg,
-		     uint8_t *signature)
+ed448_shake256_set_key (struct ed448_shake256_key *key,
+			const uint8_t *pub, const uint8_t *priv)
 {
   const struct ecc_curve *ecc = &_nettle_curve448;
-  const struct ecc_eddsa *eddsa = &_nettle_ed448_shake256;
-  mp_size_t itch = ecc->q.size + _eddsa_sign_itch (ecc);
-  mp_limb_t *scratch = gmp_alloc_limbs (itch);
-#define k2 scratch
-#define scratch_out (scratch + ecc->q.size)
   struct sha3_ctx ctx;
   uint8_t digest[ED448_SIGNATURE_SIZE];
 
+  assert (ecc->p.size <= sizeof (key->k) / sizeof (key->k[0]));
+
+  sha3_init (&ctx);
+  _eddsa_expand_key (ecc, &_nettle_ed448_shake256, &ctx, priv, digest, key->k);
+  memcpy (key->prefix, digest + ED448_KEY_SIZE, ED448_KEY_SIZE);
+  memcpy (key->pub, pub, ED448_KEY_SIZE);
+}
+
+mp_size_t
+ed448_shake256_sign_itch (void)
+{
+  return _eddsa_sign_itch (&_nettle_curve448);
+}
+
+void
+ed448_shake256_sign_with_key (const struct ed448_shake256_key *key,
+			      size_t length, const uint8_t *msg,
+			      uint8_t *signature, mp_limb_t *scratch)
+{
+  struct sha3_ctx ctx;
+
   sha3_init (&ctx);
-  _eddsa_expand_key (ecc, eddsa, &ctx, priv, digest, k2);
+  _eddsa_sign (&_nettle_curve448, &_nettle_ed448_shake256, &ctx,
+	       key->pub, key->prefix, key->k,
+	       length, msg, signature, scratch);
+}
+
+void
+ed448_shake256_sign (const uint8_t *pub,
+		     const uint8_t *priv,
+		     size_t length, const uint8_t *msg,
+		     uint8_t *signature)
+{
+  mp_size_t itch = ed448_shake256_sign_itch ();
+  mp_limb_t *scratch = gmp_alloc_limbs (itch);
+  struct ed448_shake256_key key;
 
-  _eddsa_sign (ecc, eddsa, &ctx,
-	       pub, digest + ED448_KEY_SIZE, k2,
-	       length, msg, signature, scratch_out);
+  ed448_shake256_set_key (&key, pub, priv);
+  ed448_shake256_sign_with_key (&key, length, msg, signature, scratch);
 
   gmp_free_limbs (scratch, itch);
-#undef k1
-#undef k2
-#undef scratch_out
 }
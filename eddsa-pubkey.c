@@ -33,8 +33,6 @@
 # include "config.h"
 #endif
 
-#include <assert.h>
-
 #include "eddsa.h"
 #include "eddsa-internal.h"
 
@@ -43,8 +41,10 @@
 mp_size_t
 _eddsa_public_key_itch (const struct ecc_curve *ecc)
 {
-  assert (ecc->mul_g_itch <= _eddsa_compress_itch (ecc));
-  return 3*ecc->p.size + _eddsa_compress_itch (ecc);
+  mp_size_t itch = _eddsa_compress_itch (ecc);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  return 3*ecc->p.size + itch;
 }
 
 void
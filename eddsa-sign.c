@@ -46,8 +46,10 @@
 mp_size_t
 _eddsa_sign_itch (const struct ecc_curve *ecc)
 {
-  assert (ecc->mul_g_itch <= _eddsa_compress_itch (ecc));
-  return 5*ecc->p.size + _eddsa_compress_itch (ecc);
+  mp_size_t itch = _eddsa_compress_itch (ecc);
+  if (itch < ecc->mul_g_itch)
+    itch = ecc->mul_g_itch;
+  return 5*ecc->p.size + itch;
 }
 
 void
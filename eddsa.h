@@ -48,6 +48,12 @@ extern "C" {
 #define ed448_shake256_public_key nettle_ed448_shake256_public_key
 #define ed448_shake256_sign nettle_ed448_shake256_sign
 #define ed448_shake256_verify nettle_ed448_shake256_verify
+#define ed25519_sha512_set_key nettle_ed25519_sha512_set_key
+#define ed25519_sha512_sign_itch nettle_ed25519_sha512_sign_itch
+#define ed25519_sha512_sign_with_key nettle_ed25519_sha512_sign_with_key
+#define ed448_shake256_set_key nettle_ed448_shake256_set_key
+#define ed448_shake256_sign_itch nettle_ed448_shake256_sign_itch
+#define ed448_shake256_sign_with_key nettle_ed448_shake256_sign_with_key
 
 #define ED25519_KEY_SIZE 32
 #define ED25519_SIGNATURE_SIZE 64
@@ -66,6 +72,32 @@ ed25519_sha512_verify (const uint8_t *pub,
 		       size_t length, const uint8_t *msg,
 		       const uint8_t *signature);
 
+/* Expanded private key, for signing several messages without
+   repeating the key expansion. */
+struct ed25519_sha512_key
+{
+  /* The secret scalar. */
+  mp_limb_t k[(ED25519_KEY_SIZE + sizeof(mp_limb_t) - 1)
+	      / sizeof(mp_limb_t)];
+  /* Key for nonce generation. */
+  uint8_t prefix[ED25519_KEY_SIZE];
+  uint8_t pub[ED25519_KEY_SIZE];
+};
+
+void
+ed25519_sha512_set_key (struct ed25519_sha512_key *key,
+			const uint8_t *pub, const uint8_t *priv);
+
+mp_size_t
+ed25519_sha512_sign_itch (void);
+
+/* Uses no heap allocation. The scratch area must have room for
+   ed25519_sha512_sign_itch () limbs. */
+void
+ed25519_sha512_sign_with_key (const struct ed25519_sha512_key *key,
+			      size_t length, const uint8_t *msg,
+			      uint8_t *signature, mp_limb_t *scratch);
+
 #define ED448_KEY_SIZE 57
 #define ED448_SIGNATURE_SIZE 114
 
@@ -82,6 +114,27 @@ int
 ed448_shake256_verify (const uint8_t *pub,
 		       size_t length, const uint8_t *msg,
 		       const uint8_t *signature);
+
+struct ed448_shake256_key
+{
+  /* The secret scalar, 448 bits. */
+  mp_limb_t k[(ED448_KEY_SIZE - 1 + sizeof(mp_limb_t) - 1)
+	      / sizeof(mp_limb_t)];
+  uint8_t prefix[ED448_KEY_SIZE];
+  uint8_t pub[ED448_KEY_SIZE];
+};
+
+void
+ed448_shake256_set_key (struct ed448_shake256_key *key,
+			const uint8_t *pub, const uint8_t *priv);
+
+mp_size_t
+ed448_shake256_sign_itch (void);
+
+void
+ed448_shake256_sign_with_key (const struct ed448_shake256_key *key,
+			      size_t length, const uint8_t *msg,
+			      uint8_t *signature, mp_limb_t *scratch);
 			   
 #ifdef __cplusplus
 }
@@ -0,0 +1,473 @@
+/* bench.c
+
+   Shared measurement and output code for the benchmark programs.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+/* For sched_setaffinity. */
+#define _GNU_SOURCE
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if HAVE_FORK
+# include <sys/types.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+#if HAVE_SCHED_SETAFFINITY
+# include <sched.h>
+#endif
+#if HAVE_LINUX_PERF_EVENT_H
+# include <linux/perf_event.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+#include "bench.h"
+#include "timing.h"
+
+#define BENCH_INTERVAL 0.1
+
+enum bench_format bench_format = BENCH_FORMAT_TABLE;
+unsigned bench_trials = 1;
+double bench_frequency = 0.0;
+int bench_header = 1;
+
+static int bench_cpu = -1;
+static const char *bench_fat = NULL;
+
+enum { CYCLES_NONE, CYCLES_TSC, CYCLES_PERF };
+static int cycle_source = CYCLES_NONE;
+static int perf_fd = -1;
+
+static void NORETURN PRINTF_STYLE(1,2)
+die(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+
+  exit(EXIT_FAILURE);
+}
+
+static void *
+xalloc(size_t size)
+{
+  void *p = malloc(size);
+  if (!p)
+    die("Virtual memory exhausted.\n");
+
+  return p;
+}
+
+int
+bench_option(int c, const char *arg)
+{
+  char *end;
+  switch (c)
+    {
+    case 'f':
+      bench_frequency = atof(arg);
+      if (bench_frequency <= 0.0)
+	die("Invalid clock frequency: %s\n", arg);
+      return 1;
+    case BENCH_OPT_FORMAT:
+      if (!strcmp(arg, "table"))
+	bench_format = BENCH_FORMAT_TABLE;
+      else if (!strcmp(arg, "json"))
+	bench_format = BENCH_FORMAT_JSON;
+      else if (!strcmp(arg, "csv"))
+	bench_format = BENCH_FORMAT_CSV;
+      else
+	die("Unknown output format: %s\n", arg);
+      return 1;
+    case BENCH_OPT_TRIALS:
+      bench_trials = strtoul(arg, &end, 10);
+      if (*end || bench_trials < 1 || bench_trials > 10000)
+	die("Invalid number of trials: %s\n", arg);
+      return 1;
+    case BENCH_OPT_CPU:
+      bench_cpu = strtol(arg, &end, 10);
+      if (*end || bench_cpu < 0)
+	die("Invalid cpu number: %s\n", arg);
+      return 1;
+    case BENCH_OPT_CYCLES:
+      if (!strcmp(arg, "tsc"))
+	cycle_source = CYCLES_TSC;
+      else if (!strcmp(arg, "perf"))
+	cycle_source = CYCLES_PERF;
+      else
+	die("Unknown cycle counter: %s\n", arg);
+      return 1;
+    case BENCH_OPT_FAT:
+      bench_fat = arg;
+      return 1;
+    case BENCH_OPT_NO_HEADER:
+      bench_header = 0;
+      return 1;
+    default:
+      return 0;
+    }
+}
+
+void
+bench_usage(FILE *f)
+{
+  fprintf(f,
+	  "  -f, --clock-frequency=HZ  Report cycles, based on this frequency.\n"
+	  "  --cycles=tsc|perf         Count cycles using rdtsc or perf events.\n"
+	  "  --format=table|json|csv   Output format. json outputs one object per line.\n"
+	  "  --trials=N                Measure each function N times, and report\n"
+	  "                            median, 99th percentile and confidence interval.\n"
+	  "  --cpu=N                   Run on cpu N only.\n"
+	  "  --fat=LIST                Run once for each comma separated\n"
+	  "                            NETTLE_FAT_OVERRIDE value.\n"
+	  "  --no-header               Omit the csv or table header.\n");
+}
+
+/* Runs the program once per listed override. Any csv header is
+   printed here, and omitted by the child processes. */
+static void NORETURN
+bench_run_fat(char **argv)
+{
+#if HAVE_FORK
+  char **child_argv;
+  char *list;
+  char *variant;
+  int argc, i, j;
+  int status = EXIT_SUCCESS;
+
+  for (argc = 0; argv[argc]; argc++)
+    ;
+  child_argv = xalloc((argc + 2) * sizeof(*child_argv));
+  child_argv[0] = argv[0];
+  j = 1;
+  if (bench_format == BENCH_FORMAT_CSV)
+    child_argv[j++] = (char *) "--no-header";
+  for (i = 1; i < argc; i++)
+    {
+      if (!strcmp(argv[i], "--fat"))
+	i++;
+      else if (strncmp(argv[i], "--fat=", 6))
+	child_argv[j++] = argv[i];
+    }
+  child_argv[j] = NULL;
+
+  if (bench_header)
+    bench_output_header();
+
+  list = xalloc(strlen(bench_fat) + 1);
+  strcpy(list, bench_fat);
+
+  for (variant = strtok(list, ","); variant; variant = strtok(NULL, ","))
+    {
+      pid_t pid;
+      int child_status;
+
+      if (bench_format == BENCH_FORMAT_TABLE)
+	printf("\nNETTLE_FAT_OVERRIDE=%s\n", variant);
+      fflush(stdout);
+
+      pid = fork();
+      if (pid < 0)
+	die("fork failed: %s\n", strerror(errno));
+      if (!pid)
+	{
+	  if (setenv("NETTLE_FAT_OVERRIDE", variant, 1) < 0)
+	    die("setenv failed: %s\n", strerror(errno));
+	  execvp(child_argv[0], child_argv);
+	  die("exec %s failed: %s\n", child_argv[0], strerror(errno));
+	}
+      if (waitpid(pid, &child_status, 0) < 0)
+	die("waitpid failed: %s\n", strerror(errno));
+      if (!WIFEXITED(child_status) || WEXITSTATUS(child_status))
+	status = EXIT_FAILURE;
+    }
+  exit(status);
+#else
+  (void) argv;
+  die("--fat is not supported on this system.\n");
+#endif
+}
+
+#if HAVE_LINUX_PERF_EVENT_H
+static int
+perf_init(void)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = PERF_COUNT_HW_CPU_CYCLES;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+
+  perf_fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  return perf_fd >= 0;
+}
+#endif
+
+static double
+read_cycles(void)
+{
+  switch (cycle_source)
+    {
+#if WITH_CYCLE_COUNTER
+    case CYCLES_TSC:
+      {
+	uint32_t hi, lo;
+	GET_CYCLE_COUNTER(hi, lo);
+	return ldexp(hi, 32) + lo;
+      }
+#endif
+#if HAVE_LINUX_PERF_EVENT_H
+    case CYCLES_PERF:
+      {
+	uint64_t count;
+	if (read(perf_fd, &count, sizeof(count)) != sizeof(count))
+	  die("Reading cycle counter failed: %s\n", strerror(errno));
+	return count;
+      }
+#endif
+    default:
+      return 0.0;
+    }
+}
+
+void
+bench_init(char **argv)
+{
+  if (bench_fat)
+    bench_run_fat(argv);
+
+  if (bench_cpu >= 0)
+    {
+#if HAVE_SCHED_SETAFFINITY
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(bench_cpu, &set);
+      if (sched_setaffinity(0, sizeof(set), &set) < 0)
+	die("Pinning to cpu %d failed: %s\n", bench_cpu, strerror(errno));
+#else
+      die("--cpu is not supported on this system.\n");
+#endif
+    }
+
+  switch (cycle_source)
+    {
+    case CYCLES_TSC:
+#if !WITH_CYCLE_COUNTER
+      die("No cycle counter available.\n");
+#endif
+      break;
+    case CYCLES_PERF:
+#if HAVE_LINUX_PERF_EVENT_H
+      if (!perf_init())
+	die("perf_event_open failed: %s\n", strerror(errno));
+#else
+      die("perf events not supported on this system.\n");
+#endif
+      break;
+    }
+
+  time_init();
+
+  if (bench_header && bench_format != BENCH_FORMAT_TABLE)
+    bench_output_header();
+}
+
+int
+bench_cycles_p(void)
+{
+  return cycle_source != CYCLES_NONE || bench_frequency > 0.0;
+}
+
+static int
+compare_double(const void *ap, const void *bp)
+{
+  double a = *(const double *) ap;
+  double b = *(const double *) bp;
+  if (a < b)
+    return -1;
+  else if (a > b)
+    return 1;
+  else
+    return 0;
+}
+
+void
+bench_measure(struct bench_result *r, void (*f)(void *arg), void *arg)
+{
+  double *times = xalloc(2 * bench_trials * sizeof(*times));
+  double *cycles = times + bench_trials;
+  double sum, sum2;
+  unsigned ncalls;
+  unsigned n;
+
+  /* Warm up */
+  f(arg);
+
+  /* Choose ncalls so that each trial takes at least BENCH_INTERVAL.
+     The final calibration run counts as the first trial. */
+  for (n = 0, ncalls = 10; n < bench_trials; )
+    {
+      double elapsed, start_cycles;
+      unsigned i;
+
+      start_cycles = read_cycles();
+      time_start();
+      for (i = 0; i < ncalls; i++)
+	f(arg);
+      elapsed = time_end();
+
+      if (n == 0 && elapsed <= BENCH_INTERVAL)
+	{
+	  if (elapsed < BENCH_INTERVAL / 10)
+	    ncalls *= 10;
+	  else
+	    ncalls *= 2;
+	  continue;
+	}
+      cycles[n] = (read_cycles() - start_cycles) / ncalls;
+      times[n++] = elapsed / ncalls;
+    }
+
+  for (n = 0, sum = sum2 = 0.0; n < bench_trials; n++)
+    {
+      sum += times[n];
+      sum2 += times[n] * times[n];
+    }
+  qsort(times, bench_trials, sizeof(*times), compare_double);
+  qsort(cycles, bench_trials, sizeof(*cycles), compare_double);
+
+  r->trials = bench_trials;
+  r->median = times[bench_trials / 2];
+  /* Nearest rank. */
+  r->p99 = times[(99 * bench_trials + 99) / 100 - 1];
+  if (bench_trials > 1)
+    {
+      double mean = sum / bench_trials;
+      double var = (sum2 - bench_trials * mean * mean) / (bench_trials - 1);
+      r->ci = var > 0.0 ? 1.96 * sqrt(var / bench_trials) : 0.0;
+    }
+  else
+    r->ci = 0.0;
+
+  if (cycle_source != CYCLES_NONE)
+    r->cycles = cycles[bench_trials / 2];
+  else
+    r->cycles = r->median * bench_frequency;
+
+  free(times);
+}
+
+static void
+output_string(const char *s)
+{
+  putchar('"');
+  for (; *s; s++)
+    {
+      if (*s == '"' || (bench_format == BENCH_FORMAT_JSON && *s == '\\'))
+	putchar(bench_format == BENCH_FORMAT_JSON ? '\\' : '"');
+      putchar(*s);
+    }
+  putchar('"');
+}
+
+void
+bench_output_header(void)
+{
+  if (bench_format == BENCH_FORMAT_CSV)
+    printf("name,mode,param,bytes,fat,trials,median_ns,p99_ns,ci95_ns,"
+	   "mbytes_per_s,cycles\n");
+}
+
+void
+bench_output(const char *name, const char *mode,
+	     unsigned param, size_t bytes,
+	     const struct bench_result *r)
+{
+  const char *fat = getenv("NETTLE_FAT_OVERRIDE");
+  double rate = bytes ? bytes / (r->median * 1048576.0) : 0.0;
+
+  /* Modes are indented for the table. */
+  while (*mode == ' ')
+    mode++;
+
+  switch (bench_format)
+    {
+    case BENCH_FORMAT_JSON:
+      printf("{\"name\": ");
+      output_string(name);
+      printf(", \"mode\": ");
+      output_string(mode);
+      printf(", \"param\": %u, \"bytes\": %lu, \"fat\": ",
+	     param, (unsigned long) bytes);
+      output_string(fat ? fat : "");
+      printf(", \"trials\": %u, \"median_ns\": %.3f, \"p99_ns\": %.3f, "
+	     "\"ci95_ns\": %.3f",
+	     r->trials, 1e9 * r->median, 1e9 * r->p99, 1e9 * r->ci);
+      if (bytes)
+	printf(", \"mbytes_per_s\": %.2f", rate);
+      if (r->cycles > 0.0)
+	printf(", \"cycles\": %.1f", r->cycles);
+      printf("}\n");
+      break;
+
+    case BENCH_FORMAT_CSV:
+      output_string(name);
+      putchar(',');
+      output_string(mode);
+      printf(",%u,%lu,", param, (unsigned long) bytes);
+      output_string(fat ? fat : "");
+      printf(",%u,%.3f,%.3f,%.3f,",
+	     r->trials, 1e9 * r->median, 1e9 * r->p99, 1e9 * r->ci);
+      if (bytes)
+	printf("%.2f", rate);
+      putchar(',');
+      if (r->cycles > 0.0)
+	printf("%.1f", r->cycles);
+      putchar('\n');
+      break;
+
+    default:
+      abort();
+    }
+}
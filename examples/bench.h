@@ -0,0 +1,156 @@
+/* bench.h
+
+   Shared measurement and output code for the benchmark programs.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_EXAMPLES_BENCH_H_INCLUDED
+#define NETTLE_EXAMPLES_BENCH_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* FIXME: Proper configure test for rdtsc? */
+#ifndef WITH_CYCLE_COUNTER
+# if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#  define WITH_CYCLE_COUNTER 1
+# else
+#  define WITH_CYCLE_COUNTER 0
+# endif
+#endif
+
+#if WITH_CYCLE_COUNTER
+# if defined(__i386__)
+#define GET_CYCLE_COUNTER(hi, lo)		\
+  __asm__ volatile ("xorl %%eax,%%eax\n"	\
+		    "movl %%ebx, %%edi\n"	\
+		    "cpuid\n"			\
+		    "rdtsc\n"			\
+		    "movl %%edi, %%ebx\n"	\
+		    : "=a" (lo), "=d" (hi)	\
+		    : /* No inputs. */		\
+		    : "%edi", "%ecx", "cc")
+# elif defined(__x86_64__)
+#define GET_CYCLE_COUNTER(hi, lo)		\
+  __asm__ volatile ("xorl %%eax,%%eax\n"	\
+		    "mov %%rbx, %%r10\n"	\
+		    "cpuid\n"			\
+		    "rdtsc\n"			\
+		    "mov %%r10, %%rbx\n"	\
+		    : "=a" (lo), "=d" (hi)	\
+		    : /* No inputs. */		\
+		    : "%r10", "%rcx", "cc")
+# endif
+#endif
+
+enum bench_format
+  {
+    BENCH_FORMAT_TABLE,
+    /* One JSON object per line. */
+    BENCH_FORMAT_JSON,
+    BENCH_FORMAT_CSV,
+  };
+
+struct bench_result
+{
+  unsigned trials;
+  /* All times are seconds per call. */
+  double median;
+  double p99;
+  /* Half width of the 95% confidence interval of the mean. */
+  double ci;
+  /* Median cycles per call, zero if unknown. */
+  double cycles;
+};
+
+extern enum bench_format bench_format;
+extern unsigned bench_trials;
+extern double bench_frequency;
+/* Zero if --no-header was given. */
+extern int bench_header;
+
+/* Options shared by the benchmark programs, for getopt_long. */
+enum {
+  BENCH_OPT_FORMAT = 400,
+  BENCH_OPT_TRIALS,
+  BENCH_OPT_CPU,
+  BENCH_OPT_CYCLES,
+  BENCH_OPT_FAT,
+  BENCH_OPT_NO_HEADER,
+};
+
+#define BENCH_SHORT_OPTIONS "f:"
+#define BENCH_LONG_OPTIONS						\
+  { "clock-frequency", required_argument, NULL, 'f' },			\
+  { "format", required_argument, NULL, BENCH_OPT_FORMAT },		\
+  { "trials", required_argument, NULL, BENCH_OPT_TRIALS },		\
+  { "cpu", required_argument, NULL, BENCH_OPT_CPU },			\
+  { "cycles", required_argument, NULL, BENCH_OPT_CYCLES },		\
+  { "fat", required_argument, NULL, BENCH_OPT_FAT },			\
+  { "no-header", no_argument, NULL, BENCH_OPT_NO_HEADER }
+
+/* Returns 1 if the option was recognized. Exits on invalid
+   arguments. */
+int
+bench_option(int c, const char *arg);
+
+void
+bench_usage(FILE *f);
+
+/* To be called after option parsing. If --fat was given, runs the
+   program once for each listed NETTLE_FAT_OVERRIDE value, and
+   exits. Otherwise, pins the process to a cpu, and sets up timing and
+   cycle counting. */
+void
+bench_init(char **argv);
+
+/* Non-zero if results include cycle counts. */
+int
+bench_cycles_p(void);
+
+/* Calls f repeatedly, for bench_trials intervals of about 0.1 s
+   each. */
+void
+bench_measure(struct bench_result *r, void (*f)(void *arg), void *arg);
+
+/* Output for the machine readable formats. Bytes is the amount of
+   data processed per call, or zero, and param is an algorithm
+   dependent parameter, e.g., a key size. The table format is left to
+   the caller. */
+void
+bench_output_header(void);
+
+void
+bench_output(const char *name, const char *mode,
+	     unsigned param, size_t bytes,
+	     const struct bench_result *r);
+
+#endif /* NETTLE_EXAMPLES_BENCH_H_INCLUDED */
@@ -43,7 +43,7 @@
 
 #include <time.h>
 
-#include "timing.h"
+#include "bench.h"
 
 #include "dsa.h"
 #include "rsa.h"
@@ -63,14 +63,14 @@
 #include "../ecc-internal.h"
 #include "../gmp-glue.h"
 
+#include "getopt.h"
+
 #if WITH_OPENSSL
 #include <openssl/evp.h>
 #include <openssl/ec.h>
 #include <openssl/rsa.h>
 #endif
 
-#define BENCH_INTERVAL 0.1
-
 static void NORETURN PRINTF_STYLE(1,2)
 die(const char *format, ...)
 {
@@ -107,33 +107,6 @@ hash_string (const struct nettle_hash *hash, const char *s)
   return digest;
 }
 
-/* Returns second per function call */
-static double
-time_function(void (*f)(void *arg), void *arg)
-{
-  unsigned ncalls;
-  double elapsed;
-
-  /* Warm up */
-  f(arg);
-  for (ncalls = 10 ;;)
-    {
-      unsigned i;
-
-      time_start();
-      for (i = 0; i < ncalls; i++)
-	f(arg);
-      elapsed = time_end();
-      if (elapsed > BENCH_INTERVAL)
-	break;
-      else if (elapsed < BENCH_INTERVAL / 10)
-	ncalls *= 10;
-      else
-	ncalls *= 2;
-    }
-  return elapsed / ncalls;
-}
-
 struct sign_alg
 {
   const char *name;
@@ -147,28 +120,34 @@ struct sign_alg
 static void 
 bench_sign_alg (const struct sign_alg *alg)
 {
-  double sign;
-  double verify;
+  struct bench_result sign;
+  struct bench_result verify;
   void *ctx;
 
   ctx = alg->init(alg->size);
   if (ctx == NULL)
     {
-      printf("%16s %4d N/A\n", alg->name, alg->size);
+      if (bench_format == BENCH_FORMAT_TABLE)
+	printf("%16s %4d N/A\n", alg->name, alg->size);
       return;
     }
 
-  sign = time_function (alg->sign, ctx);
-  verify = time_function (alg->verify, ctx);
+  bench_measure (&sign, alg->sign, ctx);
+  bench_measure (&verify, alg->verify, ctx);
 
   alg->clear (ctx);
 
-  if (sign < 0.02)
+  if (bench_format != BENCH_FORMAT_TABLE)
+    {
+      bench_output (alg->name, "sign", alg->size, 0, &sign);
+      bench_output (alg->name, "verify", alg->size, 0, &verify);
+    }
+  else if (sign.median < 0.02)
     printf ("%16s %4d %9.1f %9.1f\n",
-	    alg->name, alg->size, 1.0/sign, 1.0/verify);
+	    alg->name, alg->size, 1.0/sign.median, 1.0/verify.median);
   else
     printf ("%16s %4d %9.2f %9.2f\n",
-	    alg->name, alg->size, 1.0/sign, 1.0/verify);
+	    alg->name, alg->size, 1.0/sign.median, 1.0/verify.median);
 }
 
 struct kem_alg
@@ -185,26 +164,35 @@ struct kem_alg
 static void
 bench_kem_alg (const struct kem_alg *alg)
 {
-  double keygen;
-  double encrypt;
-  double decrypt;
+  struct bench_result keygen;
+  struct bench_result encrypt;
+  struct bench_result decrypt;
   void *ctx;
 
   ctx = alg->init(alg->size);
   if (ctx == NULL)
     {
-      printf("%16s %4d N/A\n", alg->name, alg->size);
+      if (bench_format == BENCH_FORMAT_TABLE)
+	printf("%16s %4d N/A\n", alg->name, alg->size);
       return;
     }
 
-  keygen = time_function (alg->keygen, ctx);
-  encrypt = time_function (alg->encrypt, ctx);
-  decrypt = time_function (alg->decrypt, ctx);
+  bench_measure (&keygen, alg->keygen, ctx);
+  bench_measure (&encrypt, alg->encrypt, ctx);
+  bench_measure (&decrypt, alg->decrypt, ctx);
 
   alg->clear (ctx);
 
-  printf ("%16s %4d %9.1f %9.1f %9.1f\n",
-	  alg->name, alg->size, 1.0/keygen, 1.0/encrypt, 1.0/decrypt);
+  if (bench_format != BENCH_FORMAT_TABLE)
+    {
+      bench_output (alg->name, "keygen", alg->size, 0, &keygen);
+      bench_output (alg->name, "encrypt", alg->size, 0, &encrypt);
+      bench_output (alg->name, "decrypt", alg->size, 0, &decrypt);
+    }
+  else
+    printf ("%16s %4d %9.1f %9.1f %9.1f\n",
+	    alg->name, alg->size,
+	    1.0/keygen.median, 1.0/encrypt.median, 1.0/decrypt.median);
 }
 
 struct rsa_ctx
@@ -1071,6 +1059,8 @@ struct ml_kem_ctx
   uint8_t ciphertext[ML_KEM_1024_CIPHERTEXT_SIZE];
   struct knuth_lfib_ctx lfib;
   uint16_t *scratch;
+  uint16_t *expanded_pub;
+  uint16_t *expanded_key;
 };
 
 static void *
@@ -1100,6 +1090,13 @@ bench_ml_kem_init (unsigned size)
 		&ctx->lfib, (nettle_random_func *)knuth_lfib_random,
 		ctx->scratch);
 
+  ctx->expanded_pub = xalloc (ml_kem_expanded_public_key_size (ctx->params)
+			      * sizeof(uint16_t));
+  ctx->expanded_key = xalloc (ml_kem_expanded_private_key_size (ctx->params)
+			      * sizeof(uint16_t));
+  ml_kem_public_key_expand (ctx->params, ctx->expanded_pub, ctx->public_key);
+  ml_kem_private_key_expand (ctx->params, ctx->expanded_key, ctx->secret_key);
+
   return ctx;
 }
 
@@ -1138,10 +1135,33 @@ bench_ml_kem_decrypt (void *p)
 		ctx->scratch);
 }
 
+static void
+bench_ml_kem_encrypt_expanded (void *p)
+{
+  struct ml_kem_ctx *ctx = p;
+  uint8_t session_key[ML_KEM_SESSION_KEY_SIZE];
+
+  ml_kem_encap_expanded (ctx->params, ctx->expanded_pub,
+			 session_key, ctx->ciphertext,
+			 &ctx->lfib, (nettle_random_func *)knuth_lfib_random,
+			 ctx->scratch);
+}
+
+static void
+bench_ml_kem_decrypt_expanded (void *p)
+{
+  struct ml_kem_ctx *ctx = p;
+  uint8_t session_key[ML_KEM_SESSION_KEY_SIZE];
+  ml_kem_decap_expanded (ctx->params, ctx->expanded_key, session_key,
+			 ctx->ciphertext, ctx->scratch);
+}
+
 static void
 bench_ml_kem_clear (void *p)
 {
   struct ml_kem_ctx *ctx = p;
+  free (ctx->expanded_pub);
+  free (ctx->expanded_key);
   free (ctx->scratch);
   free (ctx);
 }
@@ -1187,6 +1207,8 @@ static const struct kem_alg kem_alg_list[] = {
   { "sntrup", 761, bench_sntrup_init, bench_sntrup_keygen, bench_sntrup_encrypt, bench_sntrup_decrypt, bench_sntrup_clear },
   { "ml_kem", 768, bench_ml_kem_init, bench_ml_kem_keygen, bench_ml_kem_encrypt, bench_ml_kem_decrypt, bench_ml_kem_clear },
   { "ml_kem", 1024, bench_ml_kem_init, bench_ml_kem_keygen, bench_ml_kem_encrypt, bench_ml_kem_decrypt, bench_ml_kem_clear },
+  { "ml_kem-expanded", 768, bench_ml_kem_init, bench_ml_kem_keygen, bench_ml_kem_encrypt_expanded, bench_ml_kem_decrypt_expanded, bench_ml_kem_clear },
+  { "ml_kem-expanded", 1024, bench_ml_kem_init, bench_ml_kem_keygen, bench_ml_kem_encrypt_expanded, bench_ml_kem_decrypt_expanded, bench_ml_kem_clear },
 };
 #define numberof(x)  (sizeof (x) / sizeof ((x)[0]))
 
@@ -1195,20 +1217,49 @@ main (int argc, char **argv)
 {
   const char *filter = NULL;
   unsigned i;
+  int c;
 
-  if (argc > 1)
-    filter = argv[1];
-
-  time_init();
-  printf ("%16s %4s %9s %9s\n",
-	  "name", "size", "sign/s", "verify/s");
+  enum { OPT_HELP = 300 };
+  static const struct option options[] =
+    {
+      /* Name, args, flag, val */
+      { "help", no_argument, NULL, OPT_HELP },
+      BENCH_LONG_OPTIONS,
+      { NULL, 0, NULL, 0 }
+    };
+
+  while ( (c = getopt_long (argc, argv, BENCH_SHORT_OPTIONS,
+			    options, NULL)) != -1)
+    switch (c)
+      {
+      case OPT_HELP:
+	printf ("Usage: hogweed-benchmark [OPTIONS] [alg]\n\n");
+	bench_usage (stdout);
+	return EXIT_SUCCESS;
+
+      case '?':
+	return EXIT_FAILURE;
+
+      default:
+	if (!bench_option (c, optarg))
+	  abort ();
+      }
+
+  if (optind < argc)
+    filter = argv[optind];
+
+  bench_init (argv);
+  if (bench_format == BENCH_FORMAT_TABLE && bench_header)
+    printf ("%16s %4s %9s %9s\n",
+	    "name", "size", "sign/s", "verify/s");
 
   for (i = 0; i < numberof(sign_alg_list); i++)
     if (!filter || strstr (sign_alg_list[i].name, filter))
       bench_sign_alg (&sign_alg_list[i]);
 
-  printf ("%16s %4s %9s %9s %9s\n",
-	  "name", "size", "gen/s", "enc/s", "dec/s");
+  if (bench_format == BENCH_FORMAT_TABLE && bench_header)
+    printf ("%16s %4s %9s %9s %9s\n",
+	    "name", "size", "gen/s", "enc/s", "dec/s");
 
   for (i = 0; i < numberof(kem_alg_list); i++)
     if (!filter || strstr (kem_alg_list[i].name, filter))
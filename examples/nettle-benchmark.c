@@ -45,7 +45,7 @@
 
 #include <time.h>
 
-#include "timing.h"
+#include "bench.h"
 
 #include "aes.h"
 #include "arcfour.h"
@@ -77,46 +77,23 @@
 
 #include "getopt.h"
 
-static double frequency = 0.0;
-
-/* Process BENCH_BLOCK bytes at a time, for BENCH_INTERVAL seconds. */
+/* Process BENCH_BLOCK bytes at a time, by default. With --sizes,
+   up to BENCH_MAX_BLOCK. */
 #define BENCH_BLOCK 10240
-#define BENCH_INTERVAL 0.1
-
-/* FIXME: Proper configure test for rdtsc? */
-#ifndef WITH_CYCLE_COUNTER
-# if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
-#  define WITH_CYCLE_COUNTER 1
-# else
-#  define WITH_CYCLE_COUNTER 0
-# endif
-#endif
+#define BENCH_MAX_BLOCK 0x100000
 
 #if WITH_CYCLE_COUNTER
-# if defined(__i386__)
-#define GET_CYCLE_COUNTER(hi, lo)		\
-  __asm__ volatile ("xorl %%eax,%%eax\n"	\
-		    "movl %%ebx, %%edi\n"	\
-		    "cpuid\n"			\
-		    "rdtsc\n"			\
-		    "movl %%edi, %%ebx\n"	\
-		    : "=a" (lo), "=d" (hi)	\
-		    : /* No inputs. */		\
-		    : "%edi", "%ecx", "cc")
-# elif defined(__x86_64__)
-#define GET_CYCLE_COUNTER(hi, lo)		\
-  __asm__ volatile ("xorl %%eax,%%eax\n"	\
-		    "mov %%rbx, %%r10\n"	\
-		    "cpuid\n"			\
-		    "rdtsc\n"			\
-		    "mov %%r10, %%rbx\n"	\
-		    : "=a" (lo), "=d" (hi)	\
-		    : /* No inputs. */		\
-		    : "%r10", "%rcx", "cc")
-# endif
 #define BENCH_ITERATIONS 10
 #endif
 
+static size_t bench_block = BENCH_BLOCK;
+
+static const size_t default_sizes[] = { BENCH_BLOCK, 0 };
+static const size_t sweep_sizes[] =
+  { 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 0 };
+static const size_t *bench_sizes = default_sizes;
+static int sweep_p = 0;
+
 static void NORETURN PRINTF_STYLE(1,2)
 die(const char *format, ...)
 {
@@ -128,33 +105,6 @@ die(const char *format, ...)
   exit(EXIT_FAILURE);
 }
 
-static double overhead = 0.0; 
-
-/* Returns second per function call */
-static double
-time_function(void (*f)(void *arg), void *arg)
-{
-  unsigned ncalls;
-  double elapsed;
-
-  for (ncalls = 10 ;;)
-    {
-      unsigned i;
-
-      time_start();
-      for (i = 0; i < ncalls; i++)
-	f(arg);
-      elapsed = time_end();
-      if (elapsed > BENCH_INTERVAL)
-	break;
-      else if (elapsed < BENCH_INTERVAL / 10)
-	ncalls *= 10;
-      else
-	ncalls *= 2;
-    }
-  return elapsed / ncalls - overhead;
-}
-
 struct bench_memxor_info
 {
   void *dst;
@@ -166,14 +116,14 @@ static void
 bench_memxor(void *arg)
 {
   struct bench_memxor_info *info = arg;
-  memxor (info->dst, info->src, BENCH_BLOCK);
+  memxor (info->dst, info->src, bench_block);
 }
 
 static void
 bench_memxor3(void *arg)
 {
   struct bench_memxor_info *info = arg;
-  memxor3 (info->dst, info->src, info->other, BENCH_BLOCK);
+  memxor3 (info->dst, info->src, info->other, bench_block);
 }
 
 struct bench_hash_info
@@ -187,7 +137,7 @@ static void
 bench_hash(void *arg)
 {
   struct bench_hash_info *info = arg;
-  info->update(info->ctx, BENCH_BLOCK, info->data);
+  info->update(info->ctx, bench_block, info->data);
 }
 
 struct bench_cipher_info
@@ -201,7 +151,7 @@ static void
 bench_cipher(void *arg)
 {
   struct bench_cipher_info *info = arg;
-  info->crypt(info->ctx, BENCH_BLOCK, info->data, info->data);
+  info->crypt(info->ctx, bench_block, info->data, info->data);
 }
 
 struct bench_cbc_info
@@ -222,7 +172,7 @@ bench_cbc_encrypt(void *arg)
   struct bench_cbc_info *info = arg;
   cbc_encrypt(info->ctx, info->crypt,
 	      info->block_size, info->iv,
-	      BENCH_BLOCK, info->dst, info->src);
+	      bench_block, info->dst, info->src);
 }
 
 static void
@@ -231,7 +181,7 @@ bench_cbc_decrypt(void *arg)
   struct bench_cbc_info *info = arg;
   cbc_decrypt(info->ctx, info->crypt,
 	      info->block_size, info->iv,
-	      BENCH_BLOCK, info->dst, info->src);
+	      bench_block, info->dst, info->src);
 }
 
 static void
@@ -240,7 +190,7 @@ bench_ctr(void *arg)
   struct bench_cbc_info *info = arg;
   ctr_crypt(info->ctx, info->crypt,
 	    info->block_size, info->iv,
-	    BENCH_BLOCK, info->dst, info->src);
+	    bench_block, info->dst, info->src);
 }
 
 struct bench_aead_info
@@ -255,14 +205,14 @@ static void
 bench_aead_crypt(void *arg)
 {
   const struct bench_aead_info *info = arg;
-  info->crypt (info->ctx, BENCH_BLOCK, info->data, info->data);
+  info->crypt (info->ctx, bench_block, info->data, info->data);
 }
 
 static void
 bench_aead_update(void *arg)
 {
   const struct bench_aead_info *info = arg;
-  info->update (info->ctx, BENCH_BLOCK, info->data);
+  info->update (info->ctx, bench_block, info->data);
 }
 
 /* Set data[i] = floor(sqrt(i)) */
@@ -270,7 +220,7 @@ static void
 init_data(uint8_t *data)
 {
   unsigned i,j;
-  for (i = j = 0; i<BENCH_BLOCK;  i++)
+  for (i = j = 0; i<BENCH_MAX_BLOCK;  i++)
     {
       if (j*j < i)
 	j++;
@@ -299,27 +249,73 @@ init_nonce(unsigned length,
 static void
 header(void)
 {
-  printf("%18s %12s Mbyte/s%s\n",
-	 "Algorithm", "mode", 
-	 frequency > 0.0 ? " cycles/byte cycles/block" : "");  
+  if (bench_format != BENCH_FORMAT_TABLE || !bench_header)
+    return;
+  printf("%18s %12s%s Mbyte/s%s%s\n",
+	 "Algorithm", "mode", sweep_p ? "    size" : "",
+	 bench_trials > 1 ? "  ci95" : "",
+	 bench_cycles_p() ? " cycles/byte cycles/block" : "");  
+}
+
+static void
+newline(void)
+{
+  if (bench_format == BENCH_FORMAT_TABLE)
+    printf("\n");
 }
 
 static void
 display(const char *name, const char *mode, unsigned block_size,
-	double time)
+	const struct bench_result *r)
 {
-  printf("%18s %12s %7.2f",
-	 name, mode,
-	 BENCH_BLOCK / (time * 1048576.0));
-  if (frequency > 0.0)
+  if (bench_format != BENCH_FORMAT_TABLE)
+    {
+      bench_output(name, mode, block_size, bench_block, r);
+      return;
+    }
+  printf("%18s %12s", name, mode);
+  if (sweep_p)
+    printf(" %7lu", (unsigned long) bench_block);
+  printf(" %7.2f", bench_block / (r->median * 1048576.0));
+  if (bench_trials > 1)
+    printf(" %4.1f%%", 100.0 * r->ci / r->median);
+  if (r->cycles > 0.0)
     {
-      printf(" %11.2f", time * frequency / BENCH_BLOCK);
+      printf(" %11.2f", r->cycles / bench_block);
       if (block_size > 0)
-	printf(" %12.2f", time * frequency * block_size / BENCH_BLOCK);
+	printf(" %12.2f", r->cycles * block_size / bench_block);
     }
   printf("\n");
 }
 
+/* Times f once for each of the selected sizes. */
+static void
+time_sizes(const char *name, const char *mode, unsigned block_size,
+	   void (*f)(void *arg), void *arg)
+{
+  struct bench_result r;
+  const size_t *size;
+
+  for (size = bench_sizes; *size; size++)
+    {
+      bench_block = *size;
+      bench_measure(&r, f, arg);
+      display(name, mode, block_size, &r);
+    }
+}
+
+/* For functions that always process BENCH_BLOCK bytes. */
+static void
+time_block(const char *name, const char *mode, unsigned block_size,
+	   void (*f)(void *arg), void *arg)
+{
+  struct bench_result r;
+
+  bench_block = BENCH_BLOCK;
+  bench_measure(&r, f, arg);
+  display(name, mode, block_size, &r);
+}
+
 static void *
 xalloc(size_t size)
 {
@@ -335,39 +331,39 @@ static void
 time_memxor(void)
 {
   struct bench_memxor_info info;
-  unsigned long src[BENCH_BLOCK / sizeof(long) + 2];
-  unsigned long other[BENCH_BLOCK / sizeof(long) + 2];
-  unsigned long dst[BENCH_BLOCK / sizeof(long) + 1];
+  static unsigned long src[BENCH_MAX_BLOCK / sizeof(long) + 2];
+  static unsigned long other[BENCH_MAX_BLOCK / sizeof(long) + 2];
+  static unsigned long dst[BENCH_MAX_BLOCK / sizeof(long) + 1];
 
   info.src = src;
   info.dst = dst;
 
-  display ("memxor", "aligned", sizeof(unsigned long),
-	   time_function(bench_memxor, &info));
+  time_sizes("memxor", "aligned", sizeof(unsigned long),
+	     bench_memxor, &info);
   info.src = (const char *) src + 1;
-  display ("memxor", "unaligned", sizeof(unsigned long),
-	   time_function(bench_memxor, &info));
+  time_sizes("memxor", "unaligned", sizeof(unsigned long),
+	     bench_memxor, &info);
 
   info.src = src;
   info.other = other;
-  display ("memxor3", "aligned", sizeof(unsigned long),
-	   time_function(bench_memxor3, &info));
+  time_sizes("memxor3", "aligned", sizeof(unsigned long),
+	     bench_memxor3, &info);
 
   info.other = (const char *) other + 1;
-  display ("memxor3", "unaligned01", sizeof(unsigned long),
-	   time_function(bench_memxor3, &info));
+  time_sizes("memxor3", "unaligned01", sizeof(unsigned long),
+	     bench_memxor3, &info);
   info.src = (const char *) src + 1;
-  display ("memxor3", "unaligned11", sizeof(unsigned long),
-	   time_function(bench_memxor3, &info));
+  time_sizes("memxor3", "unaligned11", sizeof(unsigned long),
+	     bench_memxor3, &info);
   info.other = (const char *) other + 2;
-  display ("memxor3", "unaligned12", sizeof(unsigned long),
-	   time_function(bench_memxor3, &info));  
+  time_sizes("memxor3", "unaligned12", sizeof(unsigned long),
+	     bench_memxor3, &info);  
 }
 
 static void
 time_hash(const struct nettle_hash *hash)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hash_info info;
 
   info.ctx = xalloc(hash->context_size); 
@@ -377,8 +373,8 @@ time_hash(const struct nettle_hash *hash)
   init_data(data);
   hash->init(info.ctx);
 
-  display(hash->name, "update", hash->block_size,
-	  time_function(bench_hash, &info));
+  time_sizes(hash->name, "update", hash->block_size,
+	     bench_hash, &info);
 
   free(info.ctx);
 }
@@ -386,7 +382,7 @@ time_hash(const struct nettle_hash *hash)
 static void
 time_umac(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hash_info info;
   struct umac32_ctx ctx32;
   struct umac64_ctx ctx64;
@@ -402,38 +398,38 @@ time_umac(void)
   info.update = (nettle_hash_update_func *) umac32_update;
   info.data = data;
 
-  display("umac32", "update", UMAC_BLOCK_SIZE,
-	  time_function(bench_hash, &info));
+  time_sizes("umac32", "update", UMAC_BLOCK_SIZE,
+	     bench_hash, &info);
 
   umac64_set_key (&ctx64, key);
   info.ctx = &ctx64;
   info.update = (nettle_hash_update_func *) umac64_update;
   info.data = data;
 
-  display("umac64", "update", UMAC_BLOCK_SIZE,
-	  time_function(bench_hash, &info));
+  time_sizes("umac64", "update", UMAC_BLOCK_SIZE,
+	     bench_hash, &info);
 
   umac96_set_key (&ctx96, key);
   info.ctx = &ctx96;
   info.update = (nettle_hash_update_func *) umac96_update;
   info.data = data;
 
-  display("umac96", "update", UMAC_BLOCK_SIZE,
-	  time_function(bench_hash, &info));
+  time_sizes("umac96", "update", UMAC_BLOCK_SIZE,
+	     bench_hash, &info);
 
   umac128_set_key (&ctx128, key);
   info.ctx = &ctx128;
   info.update = (nettle_hash_update_func *) umac128_update;
   info.data = data;
 
-  display("umac128", "update", UMAC_BLOCK_SIZE,
-	  time_function(bench_hash, &info));
+  time_sizes("umac128", "update", UMAC_BLOCK_SIZE,
+	     bench_hash, &info);
 }
 
 static void
 time_cmac(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hash_info info;
   struct cmac_aes128_ctx ctx;
 
@@ -446,14 +442,14 @@ time_cmac(void)
   info.update = (nettle_hash_update_func *) cmac_aes128_update;
   info.data = data;
 
-  display("cmac-aes128", "update", AES_BLOCK_SIZE,
-	  time_function(bench_hash, &info));
+  time_sizes("cmac-aes128", "update", AES_BLOCK_SIZE,
+	     bench_hash, &info);
 }
 
 static void
 time_poly1305_aes(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hash_info info;
   struct poly1305_aes_ctx ctx;
   uint8_t key[POLY1305_AES_KEY_SIZE];
@@ -465,8 +461,8 @@ time_poly1305_aes(void)
   info.update = (nettle_hash_update_func *) poly1305_aes_update;
   info.data = data;
 
-  display("poly1305-aes", "update", 1024,
-	  time_function(bench_hash, &info));
+  time_sizes("poly1305-aes", "update", 1024,
+	     bench_hash, &info);
 }
 
 struct bench_hmac_info
@@ -512,7 +508,7 @@ static const struct
 static void
 time_hmac_md5(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hmac_info info;
   struct hmac_md5_ctx md5_ctx;
   unsigned int pos;
@@ -528,15 +524,15 @@ time_hmac_md5(void)
   for (pos = 0; hmac_tests[pos].length != 0; pos++)
     {
       info.length = hmac_tests[pos].length;
-      display("hmac-md5", hmac_tests[pos].msg, MD5_BLOCK_SIZE,
-	      time_function(bench_hmac, &info));
+      time_block("hmac-md5", hmac_tests[pos].msg, MD5_BLOCK_SIZE,
+		 bench_hmac, &info);
     }
 }
 
 static void
 time_hmac_sha1(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hmac_info info;
   struct hmac_sha1_ctx sha1_ctx;
   unsigned int pos;
@@ -552,15 +548,15 @@ time_hmac_sha1(void)
   for (pos = 0; hmac_tests[pos].length != 0; pos++)
     {
       info.length = hmac_tests[pos].length;
-      display("hmac-sha1", hmac_tests[pos].msg, SHA1_BLOCK_SIZE,
-	      time_function(bench_hmac, &info));
+      time_block("hmac-sha1", hmac_tests[pos].msg, SHA1_BLOCK_SIZE,
+		 bench_hmac, &info);
     }
 }
 
 static void
 time_hmac_sha256(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hmac_info info;
   struct hmac_sha256_ctx sha256_ctx;
   unsigned int pos;
@@ -576,15 +572,15 @@ time_hmac_sha256(void)
   for (pos = 0; hmac_tests[pos].length != 0; pos++)
     {
       info.length = hmac_tests[pos].length;
-      display("hmac-sha256", hmac_tests[pos].msg, SHA256_BLOCK_SIZE,
-	      time_function(bench_hmac, &info));
+      time_block("hmac-sha256", hmac_tests[pos].msg, SHA256_BLOCK_SIZE,
+		 bench_hmac, &info);
     }
 }
 
 static void
 time_hmac_sha512(void)
 {
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
   struct bench_hmac_info info;
   struct hmac_sha512_ctx sha512_ctx;
   unsigned int pos;
@@ -600,8 +596,8 @@ time_hmac_sha512(void)
   for (pos = 0; hmac_tests[pos].length != 0; pos++)
     {
       info.length = hmac_tests[pos].length;
-      display("hmac-sha512", hmac_tests[pos].msg, SHA512_BLOCK_SIZE,
-	      time_function(bench_hmac, &info));
+      time_block("hmac-sha512", hmac_tests[pos].msg, SHA512_BLOCK_SIZE,
+		 bench_hmac, &info);
     }
 }
 
@@ -628,10 +624,10 @@ time_cipher(const struct nettle_cipher *cipher)
   void *ctx = xalloc(cipher->context_size);
   uint8_t *key = xalloc(cipher->key_size);
 
-  static uint8_t src_data[BENCH_BLOCK];
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t src_data[BENCH_MAX_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
 
-  printf("\n");
+  newline();
   
   init_data(data);
   init_data(src_data);
@@ -646,8 +642,8 @@ time_cipher(const struct nettle_cipher *cipher)
     init_key(cipher->key_size, key);
     cipher->set_encrypt_key(ctx, key);
 
-    display(cipher->name, "ECB encrypt", cipher->block_size,
-	    time_function(bench_cipher, &info));
+    time_sizes(cipher->name, "ECB encrypt", cipher->block_size,
+	       bench_cipher, &info);
   }
   
   {
@@ -659,8 +655,8 @@ time_cipher(const struct nettle_cipher *cipher)
     init_key(cipher->key_size, key);
     cipher->set_decrypt_key(ctx, key);
 
-    display(cipher->name, "ECB decrypt", cipher->block_size,
-	    time_function(bench_cipher, &info));
+    time_sizes(cipher->name, "ECB decrypt", cipher->block_size,
+	       bench_cipher, &info);
   }
 
   if (block_cipher_p(cipher))
@@ -681,8 +677,8 @@ time_cipher(const struct nettle_cipher *cipher)
     
         cipher->set_encrypt_key(ctx, key);
 
-	display(cipher->name, "CBC encrypt", cipher->block_size,
-		time_function(bench_cbc_encrypt, &info));
+	time_sizes(cipher->name, "CBC encrypt", cipher->block_size,
+		   bench_cbc_encrypt, &info);
       }
 
       {
@@ -698,14 +694,14 @@ time_cipher(const struct nettle_cipher *cipher)
 
         cipher->set_decrypt_key(ctx, key);
 
-	display(cipher->name, "CBC decrypt", cipher->block_size,
-		time_function(bench_cbc_decrypt, &info));
+	time_sizes(cipher->name, "CBC decrypt", cipher->block_size,
+		   bench_cbc_decrypt, &info);
 
 	memset(iv, 0, cipher->block_size);
 	info.src = data;
 
-	display(cipher->name, "  (in-place)", cipher->block_size,
-		time_function(bench_cbc_decrypt, &info));
+	time_sizes(cipher->name, "  (in-place)", cipher->block_size,
+		   bench_cbc_decrypt, &info);
       }
 
       /* Do CTR mode */
@@ -722,14 +718,14 @@ time_cipher(const struct nettle_cipher *cipher)
     
         cipher->set_encrypt_key(ctx, key);
 
-	display(cipher->name, "CTR", cipher->block_size,
-		time_function(bench_ctr, &info));	
+	time_sizes(cipher->name, "CTR", cipher->block_size,
+		   bench_ctr, &info);	
 
 	memset(iv, 0, cipher->block_size);
 	info.src = data;
 
-	display(cipher->name, "  (in-place)", cipher->block_size,
-		time_function(bench_ctr, &info));
+	time_sizes(cipher->name, "  (in-place)", cipher->block_size,
+		   bench_ctr, &info);
       }
       
       free(iv);
@@ -744,9 +740,9 @@ time_aead(const struct nettle_aead *aead)
   void *ctx = xalloc(aead->context_size);
   uint8_t *key = xalloc(aead->key_size);
   uint8_t *nonce = xalloc(aead->nonce_size);
-  static uint8_t data[BENCH_BLOCK];
+  static uint8_t data[BENCH_MAX_BLOCK];
 
-  printf("\n");
+  newline();
   
   init_data(data);
   if (aead->set_nonce)
@@ -764,8 +760,8 @@ time_aead(const struct nettle_aead *aead)
     if (aead->set_nonce)
       aead->set_nonce (ctx, nonce);
 
-    display(aead->name, "encrypt", aead->block_size,
-	    time_function(bench_aead_crypt, &info));
+    time_sizes(aead->name, "encrypt", aead->block_size,
+	       bench_aead_crypt, &info);
   }
 
   if (aead->decrypt)
@@ -780,8 +776,8 @@ time_aead(const struct nettle_aead *aead)
       if (aead->set_nonce)
 	aead->set_nonce (ctx, nonce);
 
-      display(aead->name, "decrypt", aead->block_size,
-	      time_function(bench_aead_crypt, &info));
+      time_sizes(aead->name, "decrypt", aead->block_size,
+		 bench_aead_crypt, &info);
     }
 
   if (aead->update)
@@ -796,8 +792,8 @@ time_aead(const struct nettle_aead *aead)
       if (aead->set_nonce)
 	aead->set_nonce (ctx, nonce);
     
-      display(aead->name, "update", aead->block_size,
-	      time_function(bench_aead_update, &info));
+      time_sizes(aead->name, "update", aead->block_size,
+		 bench_aead_update, &info);
     }
   free(ctx);
   free(key);
@@ -890,6 +886,35 @@ bench_ghash_update(void)
 #define bench_ghash_update()
 #endif
 
+static void
+parse_sizes(const char *arg)
+{
+  static size_t sizes[20];
+  unsigned n;
+
+  sweep_p = 1;
+  if (!strcmp(arg, "sweep"))
+    {
+      bench_sizes = sweep_sizes;
+      return;
+    }
+  for (n = 0; *arg; n++)
+    {
+      char *end;
+      if (n == sizeof(sizes) / sizeof(sizes[0]) - 1)
+	die("Too many sizes.\n");
+      sizes[n] = strtoul(arg, &end, 10);
+      if (sizes[n] == 0 || sizes[n] > BENCH_MAX_BLOCK
+	  || (*end && *end != ','))
+	die("Invalid size list: %s\n", arg);
+      arg = *end ? end + 1 : end;
+    }
+  if (!n)
+    die("Invalid size list: %s\n", arg);
+  sizes[n] = 0;
+  bench_sizes = sizes;
+}
+
 #if WITH_OPENSSL
 # define OPENSSL(x) x,
 #else
@@ -947,6 +972,8 @@ main(int argc, char **argv)
       &nettle_gcm_aes128,
       &nettle_gcm_aes192,
       &nettle_gcm_aes256,
+      &nettle_gcm_aes128_compact,
+      &nettle_gcm_aes256_compact,
       OPENSSL(&nettle_openssl_gcm_aes128)
       OPENSSL(&nettle_openssl_gcm_aes192)
       OPENSSL(&nettle_openssl_gcm_aes256)
@@ -955,44 +982,54 @@ main(int argc, char **argv)
       &nettle_eax_aes128,
       &nettle_chacha_poly1305,
       &nettle_ocb_aes128,
+      &nettle_aegis128l,
+      &nettle_aegis256,
       NULL
     };
 
-  enum { OPT_HELP = 300 };
+  enum { OPT_HELP = 300, OPT_SIZES };
   static const struct option options[] =
     {
       /* Name, args, flag, val */
       { "help", no_argument, NULL, OPT_HELP },
-      { "clock-frequency", required_argument, NULL, 'f' },
+      { "sizes", required_argument, NULL, OPT_SIZES },
+      BENCH_LONG_OPTIONS,
       { NULL, 0, NULL, 0 }
     };
   
-  while ( (c = getopt_long(argc, argv, "f:", options, NULL)) != -1)
+  while ( (c = getopt_long(argc, argv, BENCH_SHORT_OPTIONS,
+			   options, NULL)) != -1)
     switch (c)
       {
-      case 'f':
-	frequency = atof(optarg);
-	if (frequency > 0.0)
-	  break;
-	/* Fall through */
-
       case OPT_HELP:
-	printf("Usage: nettle-benchmark [-f clock frequency] [alg...]\n");
+	printf("Usage: nettle-benchmark [OPTIONS] [alg...]\n\n"
+	       "  --sizes=sweep|LIST        Message sizes, default %u. sweep means\n"
+	       "                            16 bytes to 1 Mbyte, in steps of 4.\n",
+	       BENCH_BLOCK);
+	bench_usage(stdout);
 	return EXIT_SUCCESS;
 
+      case OPT_SIZES:
+	parse_sizes(optarg);
+	break;
+
       case '?':
 	return EXIT_FAILURE;
 
       default:
-	abort();
-    }
+	if (!bench_option(c, optarg))
+	  abort();
+      }
 
-  time_init();
-  bench_sha1_compress();
-  bench_salsa20_core();
-  bench_sha3_permute();
-  bench_ghash_update();
-  printf("\n");
+  bench_init(argv);
+  if (bench_format == BENCH_FORMAT_TABLE)
+    {
+      bench_sha1_compress();
+      bench_salsa20_core();
+      bench_sha3_permute();
+      bench_ghash_update();
+      printf("\n");
+    }
 
   header();
 
@@ -1003,7 +1040,7 @@ main(int argc, char **argv)
       if (!alg || strstr ("memxor", alg))
 	{
 	  time_memxor();
-	  printf("\n");
+	  newline();
 	}
 
       for (i = 0; hashes[i]; i++)
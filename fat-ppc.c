@@ -173,6 +173,12 @@ DECLARE_FAT_FUNC(_nettle_ghash_update, ghash_update_func)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, c)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, ppc64)
 
+DECLARE_FAT_FUNC(_nettle_ghash_compact_set_key, ghash_compact_set_key_func)
+DECLARE_FAT_FUNC_VAR(ghash_compact_set_key, ghash_compact_set_key_func, c)
+
+DECLARE_FAT_FUNC(_nettle_ghash_compact_update, ghash_compact_update_func)
+DECLARE_FAT_FUNC_VAR(ghash_compact_update, ghash_compact_update_func, c)
+
 DECLARE_FAT_FUNC(_nettle_gcm_aes_encrypt, gcm_aes_crypt_func)
 DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, c)
 DECLARE_FAT_FUNC_VAR(gcm_aes_encrypt, gcm_aes_crypt_func, ppc64)
@@ -248,6 +254,11 @@ fat_init (void)
          _nettle_ghash_update_arm64() */
       _nettle_ghash_set_key_vec = _nettle_ghash_set_key_ppc64;
       _nettle_ghash_update_vec = _nettle_ghash_update_ppc64;
+      /* The native key layout fits in the compact key. */
+      _nettle_ghash_compact_set_key_vec
+	= (ghash_compact_set_key_func *) _nettle_ghash_set_key_ppc64;
+      _nettle_ghash_compact_update_vec
+	= (ghash_compact_update_func *) _nettle_ghash_update_ppc64;
       _nettle_gcm_aes_encrypt_vec = _nettle_gcm_aes_encrypt_ppc64;
       _nettle_gcm_aes_decrypt_vec = _nettle_gcm_aes_decrypt_ppc64;
       _nettle_sha256_compress_n_vec = _nettle_sha256_compress_n_ppc64;
@@ -259,6 +270,8 @@ fat_init (void)
       _nettle_aes_invert_vec = _nettle_aes_invert_c;
       _nettle_ghash_set_key_vec = _nettle_ghash_set_key_c;
       _nettle_ghash_update_vec = _nettle_ghash_update_c;
+      _nettle_ghash_compact_set_key_vec = _nettle_ghash_compact_set_key_c;
+      _nettle_ghash_compact_update_vec = _nettle_ghash_compact_update_c;
       _nettle_gcm_aes_encrypt_vec = gcm_aes_crypt_c;
       _nettle_gcm_aes_decrypt_vec = gcm_aes_crypt_c;
       _nettle_sha256_compress_n_vec = _nettle_sha256_compress_n_c;
@@ -322,6 +335,14 @@ DEFINE_FAT_FUNC(_nettle_ghash_update, const uint8_t *,
 		 size_t blocks, const uint8_t *data),
 		(ctx, state, blocks, data))
 
+DEFINE_FAT_FUNC(_nettle_ghash_compact_set_key, void,
+		(struct gcm_compact_key *ctx, const union nettle_block16 *key),
+		(ctx, key))
+DEFINE_FAT_FUNC(_nettle_ghash_compact_update, const uint8_t *,
+		(const struct gcm_compact_key *ctx, union nettle_block16 *state,
+		 size_t blocks, const uint8_t *data),
+		(ctx, state, blocks, data))
+
 DEFINE_FAT_FUNC(_nettle_gcm_aes_encrypt, size_t,
 		(struct gcm_key *key, unsigned rounds,
                  size_t len, uint8_t *dst, const uint8_t *src),
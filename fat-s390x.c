@@ -250,6 +250,12 @@ DECLARE_FAT_FUNC(_nettle_ghash_update, ghash_update_func)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, c)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, s390x)
 
+DECLARE_FAT_FUNC(_nettle_ghash_compact_set_key, ghash_compact_set_key_func)
+DECLARE_FAT_FUNC_VAR(ghash_compact_set_key, ghash_compact_set_key_func, c)
+
+DECLARE_FAT_FUNC(_nettle_ghash_compact_update, ghash_compact_update_func)
+DECLARE_FAT_FUNC_VAR(ghash_compact_update, ghash_compact_update_func, c)
+
 DECLARE_FAT_FUNC(nettle_sha1_compress, sha1_compress_func)
 DECLARE_FAT_FUNC_VAR(sha1_compress, sha1_compress_func, c)
 DECLARE_FAT_FUNC_VAR(sha1_compress, sha1_compress_func, s390x)
@@ -374,11 +380,18 @@ fat_init (void)
       fprintf (stderr, "libnettle: enabling hardware accelerated GHASH.\n");
     _nettle_ghash_set_key_vec = _nettle_ghash_set_key_s390x;
     _nettle_ghash_update_vec = _nettle_ghash_update_s390x;
+    /* The native key layout fits in the compact key. */
+    _nettle_ghash_compact_set_key_vec
+      = (ghash_compact_set_key_func *) _nettle_ghash_set_key_s390x;
+    _nettle_ghash_compact_update_vec
+      = (ghash_compact_update_func *) _nettle_ghash_update_s390x;
   }
   else
   {
     _nettle_ghash_set_key_vec = _nettle_ghash_set_key_c;
     _nettle_ghash_update_vec = _nettle_ghash_update_c;
+    _nettle_ghash_compact_set_key_vec = _nettle_ghash_compact_set_key_c;
+    _nettle_ghash_compact_update_vec = _nettle_ghash_compact_update_c;
   }
 
   /* SHA1 */
@@ -489,6 +502,14 @@ DEFINE_FAT_FUNC(_nettle_ghash_update, const uint8_t *,
 		 size_t blocks, const uint8_t *data),
 		(ctx, state, blocks, data))
 
+DEFINE_FAT_FUNC(_nettle_ghash_compact_set_key, void,
+		(struct gcm_compact_key *ctx, const union nettle_block16 *key),
+		(ctx, key))
+DEFINE_FAT_FUNC(_nettle_ghash_compact_update, const uint8_t *,
+		(const struct gcm_compact_key *ctx, union nettle_block16 *state,
+		 size_t blocks, const uint8_t *data),
+		(ctx, state, blocks, data))
+
 /* SHA1 */
 DEFINE_FAT_FUNC(nettle_sha1_compress, void,
 		(uint32_t *state, const uint8_t *input),
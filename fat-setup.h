@@ -161,10 +161,33 @@ typedef const uint8_t *
 ghash_update_func (const struct gcm_key *ctx, union nettle_block16 *state,
 		   size_t blocks, const uint8_t *data);
 
+struct gcm_compact_key;
+typedef void ghash_compact_set_key_func (struct gcm_compact_key *ctx,
+					 const union nettle_block16 *key);
+typedef const uint8_t *
+ghash_compact_update_func (const struct gcm_compact_key *ctx,
+			   union nettle_block16 *state,
+			   size_t blocks, const uint8_t *data);
+
 typedef size_t
 gcm_aes_crypt_func (struct gcm_key *key, unsigned rounds,
 		    size_t len, uint8_t *dst, const uint8_t *src);
 
+typedef size_t
+aegis_crypt_func (union nettle_block16 *state,
+		  size_t length, uint8_t *dst, const uint8_t *src);
+typedef size_t
+aegis_absorb_func (union nettle_block16 *state,
+		   size_t length, const uint8_t *src);
+
+struct ccm_ctx;
+typedef size_t
+ccm_aes128_crypt_func (struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		       size_t length, uint8_t *dst, const uint8_t *src);
+typedef size_t
+ccm_aes256_crypt_func (struct ccm_ctx *ctx, const struct aes256_ctx *cipher,
+		       size_t length, uint8_t *dst, const uint8_t *src);
+
 typedef void *(memxor_func)(void *dst, const void *src, size_t n);
 typedef void *(memxor3_func)(void *dst_in, const void *a_in, const void *b_in, size_t n);
 
@@ -177,6 +200,7 @@ typedef void sha1_compress_func(uint32_t *state, const uint8_t *input);
 typedef const uint8_t *
 sha256_compress_n_func(uint32_t *state, const uint32_t *k,
 		       size_t blocks, const uint8_t *input);
+typedef void sha256_compress_x4_func(uint32_t *state, const uint8_t *input);
 
 struct sha3_state;
 typedef void sha3_permute_func (struct sha3_state *state);
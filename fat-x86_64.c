@@ -147,6 +147,28 @@ DECLARE_FAT_FUNC(nettle_cbc_aes256_encrypt, cbc_aes256_encrypt_func)
 DECLARE_FAT_FUNC_VAR(cbc_aes256_encrypt, cbc_aes256_encrypt_func, c)
 DECLARE_FAT_FUNC_VAR(cbc_aes256_encrypt, cbc_aes256_encrypt_func, aesni)
 
+DECLARE_FAT_FUNC(_nettle_aegis128l_encrypt, aegis_crypt_func)
+DECLARE_FAT_FUNC_VAR(aegis128l_encrypt, aegis_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_aegis128l_decrypt, aegis_crypt_func)
+DECLARE_FAT_FUNC_VAR(aegis128l_decrypt, aegis_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_aegis256_encrypt, aegis_crypt_func)
+DECLARE_FAT_FUNC_VAR(aegis256_encrypt, aegis_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_aegis256_decrypt, aegis_crypt_func)
+DECLARE_FAT_FUNC_VAR(aegis256_decrypt, aegis_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_aegis128l_absorb, aegis_absorb_func)
+DECLARE_FAT_FUNC_VAR(aegis128l_absorb, aegis_absorb_func, aesni)
+DECLARE_FAT_FUNC(_nettle_aegis256_absorb, aegis_absorb_func)
+DECLARE_FAT_FUNC_VAR(aegis256_absorb, aegis_absorb_func, aesni)
+
+DECLARE_FAT_FUNC(_nettle_ccm_aes128_encrypt, ccm_aes128_crypt_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes128_encrypt, ccm_aes128_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_ccm_aes128_decrypt, ccm_aes128_crypt_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes128_decrypt, ccm_aes128_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_ccm_aes256_encrypt, ccm_aes256_crypt_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes256_encrypt, ccm_aes256_crypt_func, aesni)
+DECLARE_FAT_FUNC(_nettle_ccm_aes256_decrypt, ccm_aes256_crypt_func)
+DECLARE_FAT_FUNC_VAR(ccm_aes256_decrypt, ccm_aes256_crypt_func, aesni)
+
 DECLARE_FAT_FUNC(nettle_memxor, memxor_func)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, x86_64)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, sse2)
@@ -159,6 +181,10 @@ DECLARE_FAT_FUNC(_nettle_sha256_compress_n, sha256_compress_n_func)
 DECLARE_FAT_FUNC_VAR(sha256_compress_n, sha256_compress_n_func, x86_64)
 DECLARE_FAT_FUNC_VAR(sha256_compress_n, sha256_compress_n_func, sha_ni)
 
+DECLARE_FAT_FUNC(_nettle_sha256_compress_x4, sha256_compress_x4_func)
+DECLARE_FAT_FUNC_VAR(sha256_compress_x4, sha256_compress_x4_func, c)
+DECLARE_FAT_FUNC_VAR(sha256_compress_x4, sha256_compress_x4_func, sse2)
+
 DECLARE_FAT_FUNC(_nettle_ghash_set_key, ghash_set_key_func)
 DECLARE_FAT_FUNC_VAR(ghash_set_key, ghash_set_key_func, c)
 DECLARE_FAT_FUNC_VAR(ghash_set_key, ghash_set_key_func, pclmul)
@@ -167,6 +193,52 @@ DECLARE_FAT_FUNC(_nettle_ghash_update, ghash_update_func)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, table)
 DECLARE_FAT_FUNC_VAR(ghash_update, ghash_update_func, pclmul)
 
+DECLARE_FAT_FUNC(_nettle_siv_ghash_set_key, ghash_set_key_func)
+DECLARE_FAT_FUNC_VAR(siv_ghash_set_key, ghash_set_key_func, c)
+DECLARE_FAT_FUNC_VAR(siv_ghash_set_key, ghash_set_key_func, pclmul)
+
+DECLARE_FAT_FUNC(_nettle_siv_ghash_update, ghash_update_func)
+DECLARE_FAT_FUNC_VAR(siv_ghash_update, ghash_update_func, c)
+DECLARE_FAT_FUNC_VAR(siv_ghash_update, ghash_update_func, pclmul)
+
+DECLARE_FAT_FUNC(_nettle_ghash_compact_set_key, ghash_compact_set_key_func)
+DECLARE_FAT_FUNC_VAR(ghash_compact_set_key, ghash_compact_set_key_func, c)
+
+DECLARE_FAT_FUNC(_nettle_ghash_compact_update, ghash_compact_update_func)
+DECLARE_FAT_FUNC_VAR(ghash_compact_update, ghash_compact_update_func, c)
+
+/* Nop implementations for the native aegis functions, leaving all
+   processing to the C code. */
+static size_t
+aegis_crypt_c (union nettle_block16 *state UNUSED, size_t length UNUSED,
+	       uint8_t *dst UNUSED, const uint8_t *src UNUSED)
+{
+  return 0;
+}
+
+static size_t
+aegis_absorb_c (union nettle_block16 *state UNUSED, size_t length UNUSED,
+		const uint8_t *src UNUSED)
+{
+  return 0;
+}
+
+/* Likewise for ccm. */
+static size_t
+ccm_aes128_crypt_c (struct ccm_ctx *ctx UNUSED,
+		    const struct aes128_ctx *cipher UNUSED, size_t length UNUSED,
+		    uint8_t *dst UNUSED, const uint8_t *src UNUSED)
+{
+  return 0;
+}
+
+static size_t
+ccm_aes256_crypt_c (struct ccm_ctx *ctx UNUSED,
+		    const struct aes256_ctx *cipher UNUSED, size_t length UNUSED,
+		    uint8_t *dst UNUSED, const uint8_t *src UNUSED)
+{
+  return 0;
+}
 
 /* This function should usually be called only once, at startup. But
    it is idempotent, and on x86, pointer updates are atomic, so
@@ -207,6 +279,16 @@ fat_init (void)
       nettle_cbc_aes128_encrypt_vec = _nettle_cbc_aes128_encrypt_aesni;
       nettle_cbc_aes192_encrypt_vec = _nettle_cbc_aes192_encrypt_aesni;
       nettle_cbc_aes256_encrypt_vec = _nettle_cbc_aes256_encrypt_aesni;
+      _nettle_aegis128l_encrypt_vec = _nettle_aegis128l_encrypt_aesni;
+      _nettle_aegis128l_decrypt_vec = _nettle_aegis128l_decrypt_aesni;
+      _nettle_aegis256_encrypt_vec = _nettle_aegis256_encrypt_aesni;
+      _nettle_aegis256_decrypt_vec = _nettle_aegis256_decrypt_aesni;
+      _nettle_aegis128l_absorb_vec = _nettle_aegis128l_absorb_aesni;
+      _nettle_aegis256_absorb_vec = _nettle_aegis256_absorb_aesni;
+      _nettle_ccm_aes128_encrypt_vec = _nettle_ccm_aes128_encrypt_aesni;
+      _nettle_ccm_aes128_decrypt_vec = _nettle_ccm_aes128_decrypt_aesni;
+      _nettle_ccm_aes256_encrypt_vec = _nettle_ccm_aes256_encrypt_aesni;
+      _nettle_ccm_aes256_decrypt_vec = _nettle_ccm_aes256_decrypt_aesni;
     }
   else
     {
@@ -221,6 +303,16 @@ fat_init (void)
       nettle_cbc_aes128_encrypt_vec = _nettle_cbc_aes128_encrypt_c;
       nettle_cbc_aes192_encrypt_vec = _nettle_cbc_aes192_encrypt_c;
       nettle_cbc_aes256_encrypt_vec = _nettle_cbc_aes256_encrypt_c;
+      _nettle_aegis128l_encrypt_vec = aegis_crypt_c;
+      _nettle_aegis128l_decrypt_vec = aegis_crypt_c;
+      _nettle_aegis256_encrypt_vec = aegis_crypt_c;
+      _nettle_aegis256_decrypt_vec = aegis_crypt_c;
+      _nettle_aegis128l_absorb_vec = aegis_absorb_c;
+      _nettle_aegis256_absorb_vec = aegis_absorb_c;
+      _nettle_ccm_aes128_encrypt_vec = ccm_aes128_crypt_c;
+      _nettle_ccm_aes128_decrypt_vec = ccm_aes128_crypt_c;
+      _nettle_ccm_aes256_encrypt_vec = ccm_aes256_crypt_c;
+      _nettle_ccm_aes256_decrypt_vec = ccm_aes256_crypt_c;
     }
 
   if (features.have_sha_ni)
@@ -229,6 +321,8 @@ fat_init (void)
 	fprintf (stderr, "libnettle: using sha_ni instructions.\n");
       nettle_sha1_compress_vec = _nettle_sha1_compress_sha_ni;
       _nettle_sha256_compress_n_vec = _nettle_sha256_compress_n_sha_ni;
+      /* One lane at a time with sha_ni beats the sse2 code. */
+      _nettle_sha256_compress_x4_vec = _nettle_sha256_compress_x4_c;
     }
   else
     {
@@ -236,6 +330,7 @@ fat_init (void)
 	fprintf (stderr, "libnettle: not using sha_ni instructions.\n");
       nettle_sha1_compress_vec = _nettle_sha1_compress_x86_64;
       _nettle_sha256_compress_n_vec = _nettle_sha256_compress_n_x86_64;
+      _nettle_sha256_compress_x4_vec = _nettle_sha256_compress_x4_sse2;
     }
 
   if (features.have_pclmul)
@@ -244,6 +339,13 @@ fat_init (void)
 	fprintf (stderr, "libnettle: using pclmulqdq instructions.\n");
       _nettle_ghash_set_key_vec = _nettle_ghash_set_key_pclmul;
       _nettle_ghash_update_vec = _nettle_ghash_update_pclmul;
+      _nettle_siv_ghash_set_key_vec = _nettle_siv_ghash_set_key_pclmul;
+      _nettle_siv_ghash_update_vec = _nettle_siv_ghash_update_pclmul;
+      /* The native key layout fits in the compact key. */
+      _nettle_ghash_compact_set_key_vec
+	= (ghash_compact_set_key_func *) _nettle_ghash_set_key_pclmul;
+      _nettle_ghash_compact_update_vec
+	= (ghash_compact_update_func *) _nettle_ghash_update_pclmul;
     }
   else
     {
@@ -251,6 +353,10 @@ fat_init (void)
 	fprintf (stderr, "libnettle: not using pclmulqdq instructions.\n");
       _nettle_ghash_set_key_vec = _nettle_ghash_set_key_c;
       _nettle_ghash_update_vec = _nettle_ghash_update_table;
+      _nettle_siv_ghash_set_key_vec = _nettle_siv_ghash_set_key_c;
+      _nettle_siv_ghash_update_vec = _nettle_siv_ghash_update_c;
+      _nettle_ghash_compact_set_key_vec = _nettle_ghash_compact_set_key_c;
+      _nettle_ghash_compact_update_vec = _nettle_ghash_compact_update_c;
     }
 
   if (features.vendor == X86_INTEL)
@@ -307,6 +413,48 @@ DEFINE_FAT_FUNC(nettle_cbc_aes256_encrypt, void,
   size_t length, uint8_t *dst, const uint8_t *src),
  (ctx, iv, length, dst, src))
 
+DEFINE_FAT_FUNC(_nettle_aegis128l_encrypt, size_t,
+		(union nettle_block16 *state,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(state, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_aegis128l_decrypt, size_t,
+		(union nettle_block16 *state,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(state, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_aegis256_encrypt, size_t,
+		(union nettle_block16 *state,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(state, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_aegis256_decrypt, size_t,
+		(union nettle_block16 *state,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(state, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_aegis128l_absorb, size_t,
+		(union nettle_block16 *state,
+		 size_t length, const uint8_t *src),
+		(state, length, src))
+DEFINE_FAT_FUNC(_nettle_aegis256_absorb, size_t,
+		(union nettle_block16 *state,
+		 size_t length, const uint8_t *src),
+		(state, length, src))
+
+DEFINE_FAT_FUNC(_nettle_ccm_aes128_encrypt, size_t,
+		(struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_ccm_aes128_decrypt, size_t,
+		(struct ccm_ctx *ctx, const struct aes128_ctx *cipher,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_ccm_aes256_encrypt, size_t,
+		(struct ccm_ctx *ctx, const struct aes256_ctx *cipher,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, length, dst, src))
+DEFINE_FAT_FUNC(_nettle_ccm_aes256_decrypt, size_t,
+		(struct ccm_ctx *ctx, const struct aes256_ctx *cipher,
+		 size_t length, uint8_t *dst, const uint8_t *src),
+		(ctx, cipher, length, dst, src))
+
 DEFINE_FAT_FUNC(nettle_memxor, void *,
 		(void *dst, const void *src, size_t n),
 		(dst, src, n))
@@ -320,6 +468,10 @@ DEFINE_FAT_FUNC(_nettle_sha256_compress_n, const uint8_t *,
 		 size_t blocks, const uint8_t *input),
 		(state, k, blocks, input))
 
+DEFINE_FAT_FUNC(_nettle_sha256_compress_x4, void,
+		(uint32_t *state, const uint8_t *input),
+		(state, input))
+
 DEFINE_FAT_FUNC(_nettle_ghash_set_key, void,
 		(struct gcm_key *ctx, const union nettle_block16 *key),
 		(ctx, key))
@@ -327,3 +479,19 @@ DEFINE_FAT_FUNC(_nettle_ghash_update, const uint8_t *,
 		(const struct gcm_key *ctx, union nettle_block16 *state,
 		 size_t blocks, const uint8_t *data),
 		(ctx, state, blocks, data))
+
+DEFINE_FAT_FUNC(_nettle_siv_ghash_set_key, void,
+		(struct gcm_key *ctx, const union nettle_block16 *key),
+		(ctx, key))
+DEFINE_FAT_FUNC(_nettle_siv_ghash_update, const uint8_t *,
+		(const struct gcm_key *ctx, union nettle_block16 *state,
+		 size_t blocks, const uint8_t *data),
+		(ctx, state, blocks, data))
+
+DEFINE_FAT_FUNC(_nettle_ghash_compact_set_key, void,
+		(struct gcm_compact_key *ctx, const union nettle_block16 *key),
+		(ctx, key))
+DEFINE_FAT_FUNC(_nettle_ghash_compact_update, const uint8_t *,
+		(const struct gcm_compact_key *ctx, union nettle_block16 *state,
+		 size_t blocks, const uint8_t *data),
+		(ctx, state, blocks, data))
@@ -90,3 +90,79 @@ gcm_aes128_digest(struct gcm_aes128_ctx *ctx,
 {
   GCM_DIGEST(ctx, aes128_encrypt, digest);
 }
+
+void
+gcm_aes128_encrypt_iov(struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_crypt_iov *iov)
+{
+  gcm_encrypt_iov (&ctx->gcm, &ctx->key, &ctx->cipher,
+		   (nettle_cipher_func *) aes128_encrypt, count, iov);
+}
+
+void
+gcm_aes128_decrypt_iov(struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_crypt_iov *iov)
+{
+  gcm_decrypt_iov (&ctx->gcm, &ctx->key, &ctx->cipher,
+		   (nettle_cipher_func *) aes128_encrypt, count, iov);
+}
+
+void
+gcm_aes128_seal_batch(const struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_aead_batch *msgs)
+{
+  gcm_seal_batch (&ctx->key, &ctx->cipher,
+		  (nettle_cipher_func *) aes128_encrypt, count, msgs);
+}
+
+int
+gcm_aes128_open_batch(const struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_aead_batch *msgs,
+		       int *valid)
+{
+  return gcm_open_batch (&ctx->key, &ctx->cipher,
+			 (nettle_cipher_func *) aes128_encrypt,
+			 count, msgs, valid);
+}
+
+void
+gcm_aes128_compact_set_key(struct gcm_aes128_compact_ctx *ctx,
+			   const uint8_t *key)
+{
+  GCM_COMPACT_SET_KEY(ctx, aes128_set_encrypt_key, aes128_encrypt, key);
+}
+
+void
+gcm_aes128_compact_set_iv(struct gcm_aes128_compact_ctx *ctx,
+			  size_t length, const uint8_t *iv)
+{
+  GCM_COMPACT_SET_IV(ctx, length, iv);
+}
+
+void
+gcm_aes128_compact_update(struct gcm_aes128_compact_ctx *ctx,
+			  size_t length, const uint8_t *data)
+{
+  GCM_COMPACT_UPDATE(ctx, length, data);
+}
+
+void
+gcm_aes128_compact_encrypt(struct gcm_aes128_compact_ctx *ctx,
+			   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  GCM_COMPACT_ENCRYPT(ctx, aes128_encrypt, length, dst, src);
+}
+
+void
+gcm_aes128_compact_decrypt(struct gcm_aes128_compact_ctx *ctx,
+			   size_t length, uint8_t *dst, const uint8_t *src)
+{
+  GCM_COMPACT_DECRYPT(ctx, aes128_encrypt, length, dst, src);
+}
+
+void
+gcm_aes128_compact_digest(struct gcm_aes128_compact_ctx *ctx,
+			  uint8_t *digest)
+{
+  GCM_COMPACT_DIGEST(ctx, aes128_encrypt, digest);
+}
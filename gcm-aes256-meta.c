@@ -58,3 +58,87 @@ const struct nettle_aead nettle_gcm_aes256 =
     (nettle_crypt_func *) gcm_aes256_decrypt,
     (nettle_hash_digest_func *) gcm_aes256_digest,
   };
+
+static nettle_set_key_func gcm_aes256_compact_set_nonce_wrapper;
+static void
+gcm_aes256_compact_set_nonce_wrapper (void *ctx, const uint8_t *nonce)
+{
+  gcm_aes256_compact_set_iv (ctx, GCM_IV_SIZE, nonce);
+}
+
+const struct nettle_aead nettle_gcm_aes256_compact =
+  { "gcm_aes256_compact", sizeof(struct gcm_aes256_compact_ctx),
+    GCM_BLOCK_SIZE, AES256_KEY_SIZE,
+    GCM_IV_SIZE, GCM_DIGEST_SIZE,
+    (nettle_set_key_func *) gcm_aes256_compact_set_key,
+    (nettle_set_key_func *) gcm_aes256_compact_set_key,
+    gcm_aes256_compact_set_nonce_wrapper,
+    (nettle_hash_update_func *) gcm_aes256_compact_update,
+    (nettle_crypt_func *) gcm_aes256_compact_encrypt,
+    (nettle_crypt_func *) gcm_aes256_compact_decrypt,
+    (nettle_hash_digest_func *) gcm_aes256_compact_digest,
+  };
+
+/* Expanded key for nettle_gcm_aes256_v2. */
+struct gcm_aes256_v2_key
+{
+  struct gcm_key key;
+  struct aes256_ctx cipher;
+};
+
+static void
+gcm_aes256_v2_set_key (struct gcm_aes256_v2_key *key, const uint8_t *aes_key)
+{
+  GCM_SET_KEY (key, aes256_set_encrypt_key, aes256_encrypt, aes_key);
+}
+
+static void
+gcm_aes256_v2_init (struct gcm_ctx *ctx, const struct gcm_aes256_v2_key *key,
+		     const uint8_t *nonce)
+{
+  gcm_set_iv (ctx, &key->key, GCM_IV_SIZE, nonce);
+}
+
+static void
+gcm_aes256_v2_update (struct gcm_ctx *ctx, const struct gcm_aes256_v2_key *key,
+		       size_t length, const uint8_t *data)
+{
+  gcm_update (ctx, &key->key, length, data);
+}
+
+static void
+gcm_aes256_v2_encrypt (struct gcm_ctx *ctx, const struct gcm_aes256_v2_key *key,
+			size_t length, uint8_t *dst, const uint8_t *src)
+{
+  gcm_encrypt (ctx, &key->key, &key->cipher,
+	       (nettle_cipher_func *) aes256_encrypt, length, dst, src);
+}
+
+static void
+gcm_aes256_v2_decrypt (struct gcm_ctx *ctx, const struct gcm_aes256_v2_key *key,
+			size_t length, uint8_t *dst, const uint8_t *src)
+{
+  gcm_decrypt (ctx, &key->key, &key->cipher,
+	       (nettle_cipher_func *) aes256_encrypt, length, dst, src);
+}
+
+static void
+gcm_aes256_v2_digest (struct gcm_ctx *ctx, const struct gcm_aes256_v2_key *key,
+		       uint8_t *digest)
+{
+  gcm_digest (ctx, &key->key, &key->cipher,
+	      (nettle_cipher_func *) aes256_encrypt, digest);
+}
+
+const struct nettle_aead_v2 nettle_gcm_aes256_v2 =
+  { "gcm_aes256", sizeof(struct gcm_aes256_v2_key), sizeof(struct gcm_ctx),
+    GCM_BLOCK_SIZE, AES256_KEY_SIZE,
+    GCM_IV_SIZE, GCM_DIGEST_SIZE,
+    (nettle_set_key_func *) gcm_aes256_v2_set_key,
+    (nettle_aead_init_func *) gcm_aes256_v2_init,
+    (nettle_aead_update_func *) gcm_aes256_v2_update,
+    (nettle_aead_crypt_func *) gcm_aes256_v2_encrypt,
+    (nettle_aead_crypt_func *) gcm_aes256_v2_decrypt,
+    (nettle_aead_digest_func *) gcm_aes256_v2_digest,
+    NULL, NULL,
+  };
@@ -50,6 +50,7 @@
 #include "gcm.h"
 
 #include "ghash-internal.h"
+#include "memops.h"
 #include "memxor.h"
 #include "nettle-internal.h"
 #include "macros.h"
@@ -103,6 +104,29 @@ gcm_hash_sizes(const struct gcm_key *key, union nettle_block16 *x,
   _ghash_update (key, x, 1, buffer.b);
 }
 
+static void
+gcm_set_iv_96(struct gcm_ctx *ctx, const uint8_t *iv)
+{
+  memcpy (ctx->iv.b, iv, GCM_BLOCK_SIZE - 4);
+  ctx->iv.b[GCM_BLOCK_SIZE - 4] = 0;
+  ctx->iv.b[GCM_BLOCK_SIZE - 3] = 0;
+  ctx->iv.b[GCM_BLOCK_SIZE - 2] = 0;
+  ctx->iv.b[GCM_BLOCK_SIZE - 1] = 1;
+}
+
+/* Set up the counter, once ctx->iv is set. */
+static void
+gcm_start(struct gcm_ctx *ctx)
+{
+  ctx->ctr = ctx->iv;
+  /* Increment the rightmost 32 bits. */
+  INCREMENT (4, ctx->ctr.b + GCM_BLOCK_SIZE - 4);
+
+  /* Reset the rest of the message-dependent state. */
+  block16_zero(&ctx->x);
+  ctx->auth_size = ctx->data_size = 0;
+}
+
 /* NOTE: The key is needed only if length != GCM_IV_SIZE */
 void
 gcm_set_iv(struct gcm_ctx *ctx, const struct gcm_key *key,
@@ -110,27 +134,14 @@ gcm_set_iv(struct gcm_ctx *ctx, const struct gcm_key *key,
 {
   assert (length > 0);
   if (length == GCM_IV_SIZE)
-    {
-      memcpy (ctx->iv.b, iv, GCM_BLOCK_SIZE - 4);
-      ctx->iv.b[GCM_BLOCK_SIZE - 4] = 0;
-      ctx->iv.b[GCM_BLOCK_SIZE - 3] = 0;
-      ctx->iv.b[GCM_BLOCK_SIZE - 2] = 0;
-      ctx->iv.b[GCM_BLOCK_SIZE - 1] = 1;
-    }
+    gcm_set_iv_96 (ctx, iv);
   else
     {
       block16_zero(&ctx->iv);
       gcm_hash(key, &ctx->iv, length, iv);
       gcm_hash_sizes(key, &ctx->iv, 0, length);
     }
-
-  ctx->ctr = ctx->iv;
-  /* Increment the rightmost 32 bits. */
-  INCREMENT (4, ctx->ctr.b + GCM_BLOCK_SIZE - 4);
-
-  /* Reset the rest of the message-dependent state. */
-  block16_zero(&ctx->x);
-  ctx->auth_size = ctx->data_size = 0;
+  gcm_start (ctx);
 }
 
 void
@@ -245,3 +256,301 @@ gcm_digest(struct gcm_ctx *ctx, const struct gcm_key *key,
 
   return;
 }
+
+/* Processes fragments as a single message, which, unless it's the
+   final one, must be a multiple of the block size. Full blocks
+   within a fragment are processed in place, only blocks straddling
+   fragment boundaries are collected, for hashing. */
+static void
+gcm_crypt_iov(struct gcm_ctx *ctx, const struct gcm_key *key,
+	      const void *cipher, nettle_cipher_func *f,
+	      size_t count, const struct nettle_crypt_iov *iov,
+	      int decrypt)
+{
+  union nettle_block16 stream;
+  union nettle_block16 block;
+  unsigned pos = 0;
+  size_t i;
+
+  assert(ctx->data_size % GCM_BLOCK_SIZE == 0);
+
+  for (i = 0; i < count; i++)
+    {
+      size_t length = iov[i].length;
+      uint8_t *dst = iov[i].dst;
+      const uint8_t *src = iov[i].src;
+      size_t n;
+
+      ctx->data_size += length;
+      if (pos > 0)
+	{
+	  n = GCM_BLOCK_SIZE - pos;
+	  if (n > length)
+	    n = length;
+	  if (decrypt)
+	    memcpy (block.b + pos, src, n);
+	  memxor3 (dst, src, stream.b + pos, n);
+	  if (!decrypt)
+	    memcpy (block.b + pos, dst, n);
+	  pos += n;
+	  length -= n;
+	  dst += n;
+	  src += n;
+
+	  if (pos < GCM_BLOCK_SIZE)
+	    continue;
+	  _ghash_update (key, &ctx->x, 1, block.b);
+	  pos = 0;
+	}
+      n = length & ~(size_t) (GCM_BLOCK_SIZE - 1);
+      if (n > 0)
+	{
+	  if (decrypt)
+	    _ghash_update (key, &ctx->x, n / GCM_BLOCK_SIZE, src);
+	  _nettle_ctr_crypt16(cipher, f, gcm_fill, ctx->ctr.b, n, dst, src);
+	  if (!decrypt)
+	    _ghash_update (key, &ctx->x, n / GCM_BLOCK_SIZE, dst);
+	  length -= n;
+	  dst += n;
+	  src += n;
+	}
+      if (length > 0)
+	{
+	  gcm_fill (ctx->ctr.b, 1, &stream);
+	  f (cipher, GCM_BLOCK_SIZE, stream.b, stream.b);
+	  if (decrypt)
+	    memcpy (block.b, src, length);
+	  memxor3 (dst, src, stream.b, length);
+	  if (!decrypt)
+	    memcpy (block.b, dst, length);
+	  pos = length;
+	}
+    }
+  if (pos > 0)
+    gcm_hash (key, &ctx->x, pos, block.b);
+}
+
+void
+gcm_encrypt_iov(struct gcm_ctx *ctx, const struct gcm_key *key,
+		const void *cipher, nettle_cipher_func *f,
+		size_t count, const struct nettle_crypt_iov *iov)
+{
+  gcm_crypt_iov (ctx, key, cipher, f, count, iov, 0);
+}
+
+void
+gcm_decrypt_iov(struct gcm_ctx *ctx, const struct gcm_key *key,
+		const void *cipher, nettle_cipher_func *f,
+		size_t count, const struct nettle_crypt_iov *iov)
+{
+  gcm_crypt_iov (ctx, key, cipher, f, count, iov, 1);
+}
+
+/* Number of blocks per call to the cipher function, for the batch
+   functions. */
+#define GCM_BATCH_BLOCKS 32
+
+/* Generates the counter blocks for all messages into a single buffer,
+   so that short messages don't leave the cipher's pipeline mostly
+   empty. For each message, the J_0 block, used for the digest, comes
+   after the data blocks when sealing, and before them when opening,
+   so that the digest is computed from the ciphertext also for
+   in-place operation. */
+static int
+gcm_batch(const struct gcm_key *key,
+	  const void *cipher, nettle_cipher_func *f,
+	  size_t count, const struct nettle_aead_batch *msgs,
+	  int open, int *valid)
+{
+  union nettle_block16 buffer[GCM_BATCH_BLOCKS];
+  /* Position of the next block to generate, and to use. The index j
+     runs from 0 to the number of data blocks, inclusive. */
+  size_t gi, gj, ui, uj;
+  int all_valid = 1;
+
+  for (gi = gj = ui = uj = 0; ui < count; )
+    {
+      size_t n, k;
+      for (n = 0; n < GCM_BATCH_BLOCKS && gi < count; n++)
+	{
+	  const struct nettle_aead_batch *m = &msgs[gi];
+	  size_t blocks = (m->length + GCM_BLOCK_SIZE - 1) / GCM_BLOCK_SIZE;
+	  uint32_t c;
+
+	  if (open)
+	    c = gj + 1;
+	  else
+	    c = (gj == blocks) ? 1 : gj + 2;
+
+	  memcpy (buffer[n].b, m->nonce, GCM_IV_SIZE);
+	  WRITE_UINT32 (buffer[n].b + GCM_IV_SIZE, c);
+	  if (gj++ == blocks)
+	    {
+	      gi++;
+	      gj = 0;
+	    }
+	}
+      f (cipher, n * GCM_BLOCK_SIZE, buffer[0].b, buffer[0].b);
+
+      for (k = 0; k < n; k++)
+	{
+	  const struct nettle_aead_batch *m = &msgs[ui];
+	  size_t blocks = (m->length + GCM_BLOCK_SIZE - 1) / GCM_BLOCK_SIZE;
+
+	  if (uj == (open ? 0 : blocks))
+	    {
+	      union nettle_block16 x;
+	      block16_zero (&x);
+	      gcm_hash (key, &x, m->adata_length, m->adata);
+	      gcm_hash (key, &x, m->length, open ? m->src : m->dst);
+	      gcm_hash_sizes (key, &x, m->adata_length, m->length);
+	      block16_xor (&x, &buffer[k]);
+	      if (open)
+		{
+		  int res = memeql_sec (x.b, m->digest, GCM_DIGEST_SIZE);
+		  if (valid)
+		    valid[ui] = res;
+		  all_valid &= res;
+		}
+	      else
+		memcpy (m->digest, x.b, GCM_DIGEST_SIZE);
+	    }
+	  else
+	    {
+	      size_t offset = (uj - open) * GCM_BLOCK_SIZE;
+	      size_t left = m->length - offset;
+	      memxor3 (m->dst + offset, m->src + offset, buffer[k].b,
+		       left < GCM_BLOCK_SIZE ? left : GCM_BLOCK_SIZE);
+	    }
+	  if (uj++ == blocks)
+	    {
+	      ui++;
+	      uj = 0;
+	    }
+	}
+    }
+  return all_valid;
+}
+
+void
+gcm_seal_batch(const struct gcm_key *key,
+	       const void *cipher, nettle_cipher_func *f,
+	       size_t count, const struct nettle_aead_batch *msgs)
+{
+  gcm_batch (key, cipher, f, count, msgs, 0, NULL);
+}
+
+int
+gcm_open_batch(const struct gcm_key *key,
+	       const void *cipher, nettle_cipher_func *f,
+	       size_t count, const struct nettle_aead_batch *msgs,
+	       int *valid)
+{
+  return gcm_batch (key, cipher, f, count, msgs, 1, valid);
+}
+
+void
+gcm_compact_set_key(struct gcm_compact_key *key,
+		    const void *cipher, nettle_cipher_func *f)
+{
+  static const union nettle_block16 zero_block;
+  union nettle_block16 key_block;
+  f (cipher, GCM_BLOCK_SIZE, key_block.b, zero_block.b);
+
+  _ghash_compact_set_key (key, &key_block);
+}
+
+static void
+gcm_compact_hash (const struct gcm_compact_key *key, union nettle_block16 *x,
+		  size_t length, const uint8_t *data) {
+  data = _ghash_compact_update (key, x, length / GCM_BLOCK_SIZE, data);
+  length &= (GCM_BLOCK_SIZE - 1);
+  if (length > 0)
+    {
+      union nettle_block16 block;
+      block16_zero (&block);
+      memcpy (block.b, data, length);
+      _ghash_compact_update (key, x, 1, block.b);
+    }
+}
+
+static void
+gcm_compact_hash_sizes(const struct gcm_compact_key *key,
+		       union nettle_block16 *x,
+		       uint64_t auth_size, uint64_t data_size)
+{
+  union nettle_block16 buffer;
+
+  buffer.u64[0] = bswap64_if_le (auth_size * 8);
+  buffer.u64[1] = bswap64_if_le (data_size * 8);
+
+  _ghash_compact_update (key, x, 1, buffer.b);
+}
+
+void
+gcm_compact_set_iv(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		   size_t length, const uint8_t *iv)
+{
+  assert (length > 0);
+  if (length == GCM_IV_SIZE)
+    gcm_set_iv_96 (ctx, iv);
+  else
+    {
+      block16_zero(&ctx->iv);
+      gcm_compact_hash(key, &ctx->iv, length, iv);
+      gcm_compact_hash_sizes(key, &ctx->iv, 0, length);
+    }
+  gcm_start (ctx);
+}
+
+void
+gcm_compact_update(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		   size_t length, const uint8_t *data)
+{
+  assert(ctx->auth_size % GCM_BLOCK_SIZE == 0);
+  assert(ctx->data_size == 0);
+
+  gcm_compact_hash(key, &ctx->x, length, data);
+
+  ctx->auth_size += length;
+}
+
+void
+gcm_compact_encrypt (struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		     const void *cipher, nettle_cipher_func *f,
+		     size_t length, uint8_t *dst, const uint8_t *src)
+{
+  assert(ctx->data_size % GCM_BLOCK_SIZE == 0);
+
+  _nettle_ctr_crypt16(cipher, f, gcm_fill, ctx->ctr.b, length, dst, src);
+  gcm_compact_hash(key, &ctx->x, length, dst);
+
+  ctx->data_size += length;
+}
+
+void
+gcm_compact_decrypt(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		    const void *cipher, nettle_cipher_func *f,
+		    size_t length, uint8_t *dst, const uint8_t *src)
+{
+  assert(ctx->data_size % GCM_BLOCK_SIZE == 0);
+
+  gcm_compact_hash(key, &ctx->x, length, src);
+  _nettle_ctr_crypt16(cipher, f, gcm_fill, ctx->ctr.b, length, dst, src);
+
+  ctx->data_size += length;
+}
+
+void
+gcm_compact_digest(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		   const void *cipher, nettle_cipher_func *f,
+		   uint8_t *digest)
+{
+  union nettle_block16 buffer;
+
+  gcm_compact_hash_sizes(key, &ctx->x, ctx->auth_size, ctx->data_size);
+
+  f (cipher, GCM_BLOCK_SIZE, buffer.b, ctx->iv.b);
+  block16_xor (&buffer, &ctx->x);
+  memcpy (digest, buffer.b, GCM_DIGEST_SIZE);
+}
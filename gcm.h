@@ -53,6 +53,17 @@ extern "C" {
 #define gcm_encrypt nettle_gcm_encrypt
 #define gcm_decrypt nettle_gcm_decrypt
 #define gcm_digest nettle_gcm_digest
+#define gcm_encrypt_iov nettle_gcm_encrypt_iov
+#define gcm_decrypt_iov nettle_gcm_decrypt_iov
+#define gcm_seal_batch nettle_gcm_seal_batch
+#define gcm_open_batch nettle_gcm_open_batch
+
+#define gcm_compact_set_key nettle_gcm_compact_set_key
+#define gcm_compact_set_iv nettle_gcm_compact_set_iv
+#define gcm_compact_update nettle_gcm_compact_update
+#define gcm_compact_encrypt nettle_gcm_compact_encrypt
+#define gcm_compact_decrypt nettle_gcm_compact_decrypt
+#define gcm_compact_digest nettle_gcm_compact_digest
 
 #define gcm_aes128_set_key nettle_gcm_aes128_set_key
 #define gcm_aes128_set_iv nettle_gcm_aes128_set_iv
@@ -60,6 +71,17 @@ extern "C" {
 #define gcm_aes128_encrypt nettle_gcm_aes128_encrypt
 #define gcm_aes128_decrypt nettle_gcm_aes128_decrypt
 #define gcm_aes128_digest nettle_gcm_aes128_digest
+#define gcm_aes128_encrypt_iov nettle_gcm_aes128_encrypt_iov
+#define gcm_aes128_decrypt_iov nettle_gcm_aes128_decrypt_iov
+#define gcm_aes128_seal_batch nettle_gcm_aes128_seal_batch
+#define gcm_aes128_open_batch nettle_gcm_aes128_open_batch
+
+#define gcm_aes128_compact_set_key nettle_gcm_aes128_compact_set_key
+#define gcm_aes128_compact_set_iv nettle_gcm_aes128_compact_set_iv
+#define gcm_aes128_compact_update nettle_gcm_aes128_compact_update
+#define gcm_aes128_compact_encrypt nettle_gcm_aes128_compact_encrypt
+#define gcm_aes128_compact_decrypt nettle_gcm_aes128_compact_decrypt
+#define gcm_aes128_compact_digest nettle_gcm_aes128_compact_digest
 
 #define gcm_aes192_set_key nettle_gcm_aes192_set_key
 #define gcm_aes192_set_iv nettle_gcm_aes192_set_iv
@@ -74,6 +96,17 @@ extern "C" {
 #define gcm_aes256_encrypt nettle_gcm_aes256_encrypt
 #define gcm_aes256_decrypt nettle_gcm_aes256_decrypt
 #define gcm_aes256_digest nettle_gcm_aes256_digest
+#define gcm_aes256_encrypt_iov nettle_gcm_aes256_encrypt_iov
+#define gcm_aes256_decrypt_iov nettle_gcm_aes256_decrypt_iov
+#define gcm_aes256_seal_batch nettle_gcm_aes256_seal_batch
+#define gcm_aes256_open_batch nettle_gcm_aes256_open_batch
+
+#define gcm_aes256_compact_set_key nettle_gcm_aes256_compact_set_key
+#define gcm_aes256_compact_set_iv nettle_gcm_aes256_compact_set_iv
+#define gcm_aes256_compact_update nettle_gcm_aes256_compact_update
+#define gcm_aes256_compact_encrypt nettle_gcm_aes256_compact_encrypt
+#define gcm_aes256_compact_decrypt nettle_gcm_aes256_compact_decrypt
+#define gcm_aes256_compact_digest nettle_gcm_aes256_compact_digest
 
 #define gcm_aes_set_key nettle_gcm_aes_set_key
 #define gcm_aes_set_iv nettle_gcm_aes_set_iv
@@ -107,12 +140,22 @@ extern "C" {
 #define GCM_IV_SIZE (GCM_BLOCK_SIZE - 4)
 #define GCM_DIGEST_SIZE 16
 
-/* Hashing subkey */
+/* Hashing subkey, a table of 128 blocks, 2 KB. */
 struct gcm_key
 {
   union nettle_block16 h[0x80];
 };
 
+/* Smaller hashing subkey, 256 bytes, holding the first few powers
+   of the subkey. Uses carry-less multiplication instructions when available,
+   otherwise a table-free implementation, which is slower than the
+   table-based one used with struct gcm_key. */
+#define _GCM_COMPACT_KEY_BLOCKS 16
+struct gcm_compact_key
+{
+  union nettle_block16 h[_GCM_COMPACT_KEY_BLOCKS];
+};
+
 /* Per-message state, depending on the iv */
 struct gcm_ctx {
   /* Original counter block */
@@ -152,6 +195,63 @@ gcm_digest(struct gcm_ctx *ctx, const struct gcm_key *key,
 	   const void *cipher, nettle_cipher_func *f,
 	   uint8_t *digest);
 
+/* Like gcm_encrypt and gcm_decrypt, for a message split into
+   fragments of any size. */
+void
+gcm_encrypt_iov(struct gcm_ctx *ctx, const struct gcm_key *key,
+		const void *cipher, nettle_cipher_func *f,
+		size_t count, const struct nettle_crypt_iov *iov);
+
+void
+gcm_decrypt_iov(struct gcm_ctx *ctx, const struct gcm_key *key,
+		const void *cipher, nettle_cipher_func *f,
+		size_t count, const struct nettle_crypt_iov *iov);
+
+/* Processes several messages, each with a GCM_IV_SIZE nonce and a
+   GCM_DIGEST_SIZE digest, encrypting the counter blocks for all of
+   them with as few calls to f as possible. In-place operation is
+   allowed. */
+void
+gcm_seal_batch(const struct gcm_key *key,
+	       const void *cipher, nettle_cipher_func *f,
+	       size_t count, const struct nettle_aead_batch *msgs);
+
+/* Returns 1 if all digests are valid. If valid is non-NULL, the
+   result for each message is stored in valid[i]. The output for a
+   message with an invalid digest must be discarded. */
+int
+gcm_open_batch(const struct gcm_key *key,
+	       const void *cipher, nettle_cipher_func *f,
+	       size_t count, const struct nettle_aead_batch *msgs,
+	       int *valid);
+
+void
+gcm_compact_set_key(struct gcm_compact_key *key,
+		    const void *cipher, nettle_cipher_func *f);
+
+void
+gcm_compact_set_iv(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		   size_t length, const uint8_t *iv);
+
+void
+gcm_compact_update(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		   size_t length, const uint8_t *data);
+
+void
+gcm_compact_encrypt(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		    const void *cipher, nettle_cipher_func *f,
+		    size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+gcm_compact_decrypt(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		    const void *cipher, nettle_cipher_func *f,
+		    size_t length, uint8_t *dst, const uint8_t *src);
+
+void
+gcm_compact_digest(struct gcm_ctx *ctx, const struct gcm_compact_key *key,
+		   const void *cipher, nettle_cipher_func *f,
+		   uint8_t *digest);
+
 /* Convenience macrology (not sure how useful it is) */
 /* All-in-one context, with hash subkey, message state, and cipher. */
 #define GCM_CTX(type) \
@@ -194,6 +294,46 @@ gcm_digest(struct gcm_ctx *ctx, const struct gcm_key *key,
 		  (nettle_cipher_func *) (encrypt),			\
 		  (digest)))
 
+/* Same, using the compact hashing subkey. */
+#define GCM_COMPACT_CTX(type) \
+  { struct gcm_compact_key key; struct gcm_ctx gcm; type cipher; }
+
+#define GCM_COMPACT_SET_KEY(ctx, set_key, encrypt, gcm_key)	\
+  do {								\
+    (set_key)(&(ctx)->cipher, (gcm_key));			\
+    if (0) (encrypt)(&(ctx)->cipher, ~(size_t) 0,		\
+		     (uint8_t *) 0, (const uint8_t *) 0);	\
+    gcm_compact_set_key(&(ctx)->key, &(ctx)->cipher,		\
+			(nettle_cipher_func *) (encrypt));	\
+  } while (0)
+
+#define GCM_COMPACT_SET_IV(ctx, length, data)			\
+  gcm_compact_set_iv(&(ctx)->gcm, &(ctx)->key, (length), (data))
+
+#define GCM_COMPACT_UPDATE(ctx, length, data)			\
+  gcm_compact_update(&(ctx)->gcm, &(ctx)->key, (length), (data))
+
+#define GCM_COMPACT_ENCRYPT(ctx, encrypt, length, dst, src)		\
+  (0 ? (encrypt)(&(ctx)->cipher, ~(size_t) 0,				\
+		 (uint8_t *) 0, (const uint8_t *) 0)			\
+     : gcm_compact_encrypt(&(ctx)->gcm, &(ctx)->key, &(ctx)->cipher,	\
+			   (nettle_cipher_func *) (encrypt),		\
+			   (length), (dst), (src)))
+
+#define GCM_COMPACT_DECRYPT(ctx, encrypt, length, dst, src)		\
+  (0 ? (encrypt)(&(ctx)->cipher, ~(size_t) 0,				\
+		 (uint8_t *) 0, (const uint8_t *) 0)			\
+     : gcm_compact_decrypt(&(ctx)->gcm, &(ctx)->key, &(ctx)->cipher,	\
+			   (nettle_cipher_func *) (encrypt),		\
+			   (length), (dst), (src)))
+
+#define GCM_COMPACT_DIGEST(ctx, encrypt, digest)			\
+  (0 ? (encrypt)(&(ctx)->cipher, ~(size_t) 0,				\
+		 (uint8_t *) 0, (const uint8_t *) 0)			\
+     : gcm_compact_digest(&(ctx)->gcm, &(ctx)->key, &(ctx)->cipher,	\
+			  (nettle_cipher_func *) (encrypt),		\
+			  (digest)))
+
 struct gcm_aes128_ctx GCM_CTX(struct aes128_ctx);
 
 void
@@ -220,6 +360,44 @@ void
 gcm_aes128_digest(struct gcm_aes128_ctx *ctx,
 		  uint8_t *digest);
 
+void
+gcm_aes128_encrypt_iov(struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_crypt_iov *iov);
+
+void
+gcm_aes128_decrypt_iov(struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_crypt_iov *iov);
+
+void
+gcm_aes128_seal_batch(const struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_aead_batch *msgs);
+
+int
+gcm_aes128_open_batch(const struct gcm_aes128_ctx *ctx,
+		       size_t count, const struct nettle_aead_batch *msgs,
+		       int *valid);
+
+struct gcm_aes128_compact_ctx GCM_COMPACT_CTX(struct aes128_ctx);
+
+void
+gcm_aes128_compact_set_key(struct gcm_aes128_compact_ctx *ctx,
+			   const uint8_t *key);
+void
+gcm_aes128_compact_set_iv(struct gcm_aes128_compact_ctx *ctx,
+			  size_t length, const uint8_t *iv);
+void
+gcm_aes128_compact_update(struct gcm_aes128_compact_ctx *ctx,
+			  size_t length, const uint8_t *data);
+void
+gcm_aes128_compact_encrypt(struct gcm_aes128_compact_ctx *ctx,
+			   size_t length, uint8_t *dst, const uint8_t *src);
+void
+gcm_aes128_compact_decrypt(struct gcm_aes128_compact_ctx *ctx,
+			   size_t length, uint8_t *dst, const uint8_t *src);
+void
+gcm_aes128_compact_digest(struct gcm_aes128_compact_ctx *ctx,
+			  uint8_t *digest);
+
 struct gcm_aes192_ctx GCM_CTX(struct aes192_ctx);
 
 void
@@ -268,6 +446,44 @@ void
 gcm_aes256_digest(struct gcm_aes256_ctx *ctx,
 		  uint8_t *digest);
 
+void
+gcm_aes256_encrypt_iov(struct gcm_aes256_ctx *ctx,
+		       size_t count, const struct nettle_crypt_iov *iov);
+
+void
+gcm_aes256_decrypt_iov(struct gcm_aes256_ctx *ctx,
+		       size_t count, const struct nettle_crypt_iov *iov);
+
+void
+gcm_aes256_seal_batch(const struct gcm_aes256_ctx *ctx,
+		       size_t count, const struct nettle_aead_batch *msgs);
+
+int
+gcm_aes256_open_batch(const struct gcm_aes256_ctx *ctx,
+		       size_t count, const struct nettle_aead_batch *msgs,
+		       int *valid);
+
+struct gcm_aes256_compact_ctx GCM_COMPACT_CTX(struct aes256_ctx);
+
+void
+gcm_aes256_compact_set_key(struct gcm_aes256_compact_ctx *ctx,
+			   const uint8_t *key);
+void
+gcm_aes256_compact_set_iv(struct gcm_aes256_compact_ctx *ctx,
+			  size_t length, const uint8_t *iv);
+void
+gcm_aes256_compact_update(struct gcm_aes256_compact_ctx *ctx,
+			  size_t length, const uint8_t *data);
+void
+gcm_aes256_compact_encrypt(struct gcm_aes256_compact_ctx *ctx,
+			   size_t length, uint8_t *dst, const uint8_t *src);
+void
+gcm_aes256_compact_decrypt(struct gcm_aes256_compact_ctx *ctx,
+			   size_t length, uint8_t *dst, const uint8_t *src);
+void
+gcm_aes256_compact_digest(struct gcm_aes256_compact_ctx *ctx,
+			  uint8_t *digest);
+
 
 struct gcm_camellia128_ctx GCM_CTX(struct camellia128_ctx);
 
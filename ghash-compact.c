@@ -0,0 +1,232 @@
+/* ghash-compact.c
+
+   Galois counter mode, with a compact hashing subkey.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ghash-internal.h"
+#include "macros.h"
+
+/* For fat builds, the C implementation is selected at runtime only if
+   no carry-less multiplication is available. */
+#if HAVE_NATIVE_fat_ghash_set_key
+void
+_nettle_ghash_compact_set_key_c (struct gcm_compact_key *ctx,
+				 const union nettle_block16 *key);
+const uint8_t *
+_nettle_ghash_compact_update_c (const struct gcm_compact_key *ctx,
+				union nettle_block16 *state,
+				size_t blocks, const uint8_t *data);
+#define _nettle_ghash_compact_set_key _nettle_ghash_compact_set_key_c
+#define _nettle_ghash_compact_update _nettle_ghash_compact_update_c
+#endif
+
+#if HAVE_NATIVE_ghash_set_key && HAVE_NATIVE_ghash_update \
+  && !HAVE_NATIVE_fat_ghash_set_key
+/* All native implementations of _ghash_set_key are based on
+   carry-less multiplication, and use at most 8 blocks of the key. */
+void
+_ghash_compact_set_key (struct gcm_compact_key *ctx,
+			const union nettle_block16 *key)
+{
+  _ghash_set_key ((struct gcm_key *) ctx, key);
+}
+
+const uint8_t *
+_ghash_compact_update (const struct gcm_compact_key *ctx,
+		       union nettle_block16 *state,
+		       size_t blocks, const uint8_t *data)
+{
+  return _ghash_update ((const struct gcm_key *) ctx, state, blocks, data);
+}
+
+#else /* !HAVE_NATIVE_ghash_set_key */
+
+/* Table-free implementation, using integer multiplication to
+   implement carry-less multiplication of 64-bit words. Field elements
+   are represented as a pair of 64-bit words, (x1, x0), read in
+   big-endian order, so that bit reversal is needed to get the high
+   half of a product.
+
+   The key holds the powers H, H^2, ..., H^8, to reduce only once per
+   8 blocks. Each power occupies two blocks, the second with bit
+   reversed words. */
+#define GHASH_COMPACT_POWERS (_GCM_COMPACT_KEY_BLOCKS / 2)
+
+/* Low 64 bits of the carry-less product. Holes of 3 zero bits
+   between the bits of each partial product ensures carries never
+   reach the bits that are kept. */
+static uint64_t
+bmul64 (uint64_t x, uint64_t y)
+{
+  uint64_t x0, x1, x2, x3;
+  uint64_t y0, y1, y2, y3;
+  uint64_t z0, z1, z2, z3;
+
+  x0 = x & 0x1111111111111111ULL;
+  x1 = x & 0x2222222222222222ULL;
+  x2 = x & 0x4444444444444444ULL;
+  x3 = x & 0x8888888888888888ULL;
+  y0 = y & 0x1111111111111111ULL;
+  y1 = y & 0x2222222222222222ULL;
+  y2 = y & 0x4444444444444444ULL;
+  y3 = y & 0x8888888888888888ULL;
+  z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+  z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+  z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+  z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+  return (z0 & 0x1111111111111111ULL) | (z1 & 0x2222222222222222ULL)
+    | (z2 & 0x4444444444444444ULL) | (z3 & 0x8888888888888888ULL);
+}
+
+static uint64_t
+rev64 (uint64_t x)
+{
+#define RMS(m, s) x = ((x & (m)) << (s)) | ((x >> (s)) & (m))
+  RMS(0x5555555555555555ULL, 1);
+  RMS(0x3333333333333333ULL, 2);
+  RMS(0x0F0F0F0F0F0F0F0FULL, 4);
+  RMS(0x00FF00FF00FF00FFULL, 8);
+  RMS(0x0000FFFF0000FFFFULL, 16);
+#undef RMS
+  return (x << 32) | (x >> 32);
+}
+
+/* Adds the unreduced product of (x1, x0) and the power p into z,
+   using Karatsuba. */
+static void
+ghash_mul_add (uint64_t *z, const union nettle_block16 *p,
+	       uint64_t x1, uint64_t x0)
+{
+  uint64_t h1 = p[0].u64[0];
+  uint64_t h0 = p[0].u64[1];
+  uint64_t h1r = p[1].u64[0];
+  uint64_t h0r = p[1].u64[1];
+  uint64_t x1r = rev64 (x1);
+  uint64_t x0r = rev64 (x0);
+  uint64_t z0, z1, z2, z0h, z1h, z2h;
+
+  z0 = bmul64 (x0, h0);
+  z1 = bmul64 (x1, h1);
+  z2 = bmul64 (x0 ^ x1, h0 ^ h1) ^ z0 ^ z1;
+  z0h = bmul64 (x0r, h0r);
+  z1h = bmul64 (x1r, h1r);
+  z2h = bmul64 (x0r ^ x1r, h0r ^ h1r) ^ z0h ^ z1h;
+
+  z[0] ^= z0;
+  z[1] ^= z2 ^ (rev64 (z0h) >> 1);
+  z[2] ^= z1 ^ (rev64 (z2h) >> 1);
+  z[3] ^= rev64 (z1h) >> 1;
+}
+
+/* Reduces the 255-bit product z, with the bit reflected
+   polynomial. */
+static void
+ghash_reduce (uint64_t *x1, uint64_t *x0, const uint64_t *z)
+{
+  uint64_t v0, v1, v2, v3;
+
+  v3 = (z[3] << 1) | (z[2] >> 63);
+  v2 = (z[2] << 1) | (z[1] >> 63);
+  v1 = (z[1] << 1) | (z[0] >> 63);
+  v0 = z[0] << 1;
+
+  v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+  v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+  v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+  v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+
+  *x1 = v3;
+  *x0 = v2;
+}
+
+static void
+ghash_set_power (union nettle_block16 *p, uint64_t h1, uint64_t h0)
+{
+  p[0].u64[0] = h1;
+  p[0].u64[1] = h0;
+  p[1].u64[0] = rev64 (h1);
+  p[1].u64[1] = rev64 (h0);
+}
+
+void
+_ghash_compact_set_key (struct gcm_compact_key *ctx,
+			const union nettle_block16 *key)
+{
+  uint64_t h1 = READ_UINT64 (key->b);
+  uint64_t h0 = READ_UINT64 (key->b + 8);
+  unsigned i;
+
+  ghash_set_power (ctx->h, h1, h0);
+  for (i = 1; i < GHASH_COMPACT_POWERS; i++)
+    {
+      uint64_t z[4] = { 0, 0, 0, 0 };
+      ghash_mul_add (z, ctx->h, h1, h0);
+      ghash_reduce (&h1, &h0, z);
+      ghash_set_power (ctx->h + 2*i, h1, h0);
+    }
+}
+
+const uint8_t *
+_ghash_compact_update (const struct gcm_compact_key *ctx,
+		       union nettle_block16 *state,
+		       size_t blocks, const uint8_t *data)
+{
+  uint64_t x1 = READ_UINT64 (state->b);
+  uint64_t x0 = READ_UINT64 (state->b + 8);
+
+  while (blocks > 0)
+    {
+      /* Aggregated reduction, X_1 H^n + X_2 H^{n-1} + ... + X_n H,
+	 where the state is added to X_1. */
+      uint64_t z[4] = { 0, 0, 0, 0 };
+      unsigned n = blocks < GHASH_COMPACT_POWERS
+	? blocks : GHASH_COMPACT_POWERS;
+      unsigned i;
+
+      blocks -= n;
+      for (i = n; i-- > 0; data += GCM_BLOCK_SIZE)
+	{
+	  ghash_mul_add (z, ctx->h + 2*i,
+			 x1 ^ READ_UINT64 (data), x0 ^ READ_UINT64 (data + 8));
+	  x1 = x0 = 0;
+	}
+      ghash_reduce (&x1, &x0, z);
+    }
+  WRITE_UINT64 (state->b, x1);
+  WRITE_UINT64 (state->b + 8, x0);
+  return data;
+}
+#endif /* !HAVE_NATIVE_ghash_set_key */
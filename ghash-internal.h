@@ -40,6 +40,8 @@
 #define _ghash_update _nettle_ghash_update
 #define _siv_ghash_set_key _nettle_siv_ghash_set_key
 #define _siv_ghash_update _nettle_siv_ghash_update
+#define _ghash_compact_set_key _nettle_ghash_compact_set_key
+#define _ghash_compact_update _nettle_ghash_compact_update
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +73,18 @@ const uint8_t *
 _siv_ghash_update (const struct gcm_key *ctx, union nettle_block16 *state,
 		 size_t blocks, const uint8_t *data);
 
+/* Like _ghash_set_key and _ghash_update, but for the compact key.
+   With carry-less multiplication instructions, these use the same
+   native code and key layout. */
+void
+_ghash_compact_set_key (struct gcm_compact_key *ctx,
+			const union nettle_block16 *key);
+
+const uint8_t *
+_ghash_compact_update (const struct gcm_compact_key *ctx,
+		       union nettle_block16 *state,
+		       size_t blocks, const uint8_t *data);
+
 #ifdef __cplusplus
 }
 #endif
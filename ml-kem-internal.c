@@ -577,11 +577,46 @@ _ml_kem_inner_generate_keypair (const struct ml_kem_params *params,
   vector_encode (key, s, params->k, Q_BITS);
 }
 
+size_t
+_ml_kem_inner_expand_public_key_size (const struct ml_kem_params *params)
+{
+  return N * (params->k * params->k + params->k);
+}
+
+void
+_ml_kem_inner_expand_public_key (const struct ml_kem_params *params,
+				 uint16_t *expanded,
+				 const uint8_t *pub)
+{
+  const uint8_t *rho = &pub[(params->k * Q_BITS * N) / 8];
+  uint16_t *a, *t;
+
+  a = expanded;
+  t = a + N * params->k * params->k;
+
+  vector_decode (t, pub, params->k, Q_BITS);
+  matrix_sample (a, rho, params->k);
+}
+
+size_t
+_ml_kem_inner_expand_private_key_size (const struct ml_kem_params *params)
+{
+  return N * params->k;
+}
+
+void
+_ml_kem_inner_expand_private_key (const struct ml_kem_params *params,
+				  uint16_t *expanded,
+				  const uint8_t *key)
+{
+  vector_decode (expanded, key, params->k, Q_BITS);
+}
+
 size_t
 _ml_kem_inner_encrypt_itch (const struct ml_kem_params *params)
 {
-  return N * (params->k * params->k + params->k + 1 +
-	      params->k + params->k + params->k);
+  return _ml_kem_inner_expand_public_key_size (params)
+    + _ml_kem_inner_encrypt_expanded_itch (params);
 }
 
 void
@@ -592,21 +627,39 @@ _ml_kem_inner_encrypt (const struct ml_kem_params *params,
 		       uint8_t *ciphertext,
 		       uint16_t *scratch)
 {
-  const uint8_t *rho = &pub[(params->k * Q_BITS * N) / 8];
-  uint16_t *a, *r, *e1, *e2, *t, *u;
+  size_t size = _ml_kem_inner_expand_public_key_size (params);
+
+  _ml_kem_inner_expand_public_key (params, scratch, pub);
+  _ml_kem_inner_encrypt_expanded (params, scratch, msg, seed, ciphertext,
+				  scratch + size);
+}
+
+size_t
+_ml_kem_inner_encrypt_expanded_itch (const struct ml_kem_params *params)
+{
+  return N * (params->k + 1 + params->k + params->k);
+}
+
+void
+_ml_kem_inner_encrypt_expanded (const struct ml_kem_params *params,
+				const uint16_t *expanded,
+				const uint8_t *msg,
+				const uint8_t *seed,
+				uint8_t *ciphertext,
+				uint16_t *scratch)
+{
+  const uint16_t *a, *t;
+  uint16_t *r, *e1, *e2, *u;
   uint16_t m[N], v[N];
   size_t i;
 
-  a = scratch;
-  e1 = a + N * params->k * params->k;
+  a = expanded;
+  t = a + N * params->k * params->k;
+
+  e1 = scratch;
   e2 = e1 + N * params->k;
   r = e2 + N;
-  t = r + N * params->k;
-  u = t + N * params->k;
-
-  vector_decode (t, pub, params->k, Q_BITS);
-
-  matrix_sample (a, rho, params->k);
+  u = r + N * params->k;
 
   vector_sample (r, seed, params->eta1, 0, params->k);
   vector_sample (e1, seed, ETA2, params->k, params->k);
@@ -666,7 +719,8 @@ _ml_kem_inner_encrypt (const struct ml_kem_params *params,
 size_t
 _ml_kem_inner_decrypt_itch (const struct ml_kem_params *params)
 {
-  return N * (params->k + params->k);
+  return _ml_kem_inner_expand_private_key_size (params)
+    + _ml_kem_inner_decrypt_expanded_itch (params);
 }
 
 void
@@ -676,11 +730,30 @@ _ml_kem_inner_decrypt (const struct ml_kem_params *params,
 		       uint8_t *plaintext,
 		       uint16_t *scratch)
 {
-  uint16_t r[N], *s, *u, v[N];
+  size_t size = _ml_kem_inner_expand_private_key_size (params);
+
+  _ml_kem_inner_expand_private_key (params, scratch, key);
+  _ml_kem_inner_decrypt_expanded (params, scratch, ciphertext, plaintext,
+				  scratch + size);
+}
+
+size_t
+_ml_kem_inner_decrypt_expanded_itch (const struct ml_kem_params *params)
+{
+  return N * params->k;
+}
+
+void
+_ml_kem_inner_decrypt_expanded (const struct ml_kem_params *params,
+				const uint16_t *s,
+				const uint8_t *ciphertext,
+				uint8_t *plaintext,
+				uint16_t *scratch)
+{
+  uint16_t r[N], *u, v[N];
   size_t i;
 
-  s = scratch;
-  u = s + N * params->k;
+  u = scratch;
 
   vector_decode (u, ciphertext, params->k, params->du);
 
@@ -700,8 +773,6 @@ _ml_kem_inner_decrypt (const struct ml_kem_params *params,
   for (i = 0; i < N; i++)
     v[i] = decompress (v[i], params->dv);
 
-  vector_decode (s, key, params->k, Q_BITS);
-
   for (i = 0; i < params->k; i++)
     poly_into_ntt (VECTOR_GET_POLY (u, i));
 
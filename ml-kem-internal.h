@@ -49,6 +49,14 @@
 #define _ml_kem_inner_encrypt _nettle_ml_kem_inner_encrypt
 #define _ml_kem_inner_decrypt_itch _nettle_ml_kem_inner_decrypt_itch
 #define _ml_kem_inner_decrypt _nettle_ml_kem_inner_decrypt
+#define _ml_kem_inner_expand_public_key_size _nettle_ml_kem_inner_expand_public_key_size
+#define _ml_kem_inner_expand_public_key _nettle_ml_kem_inner_expand_public_key
+#define _ml_kem_inner_expand_private_key_size _nettle_ml_kem_inner_expand_private_key_size
+#define _ml_kem_inner_expand_private_key _nettle_ml_kem_inner_expand_private_key
+#define _ml_kem_inner_encrypt_expanded_itch _nettle_ml_kem_inner_encrypt_expanded_itch
+#define _ml_kem_inner_encrypt_expanded _nettle_ml_kem_inner_encrypt_expanded
+#define _ml_kem_inner_decrypt_expanded_itch _nettle_ml_kem_inner_decrypt_expanded_itch
+#define _ml_kem_inner_decrypt_expanded _nettle_ml_kem_inner_decrypt_expanded
 
 struct ml_kem_params
 {
@@ -95,4 +103,44 @@ _ml_kem_inner_decrypt (const struct ml_kem_params *params,
 		       uint8_t *plaintext,
 		       uint16_t *scratch);
 
+/* The expanded public key is the matrix A followed by the vector t,
+   both in NTT domain. The expanded private key is the vector s, in
+   NTT domain. Sizes are in uint16_t units. */
+size_t
+_ml_kem_inner_expand_public_key_size (const struct ml_kem_params *params);
+
+void
+_ml_kem_inner_expand_public_key (const struct ml_kem_params *params,
+				 uint16_t *expanded,
+				 const uint8_t *pub);
+
+size_t
+_ml_kem_inner_expand_private_key_size (const struct ml_kem_params *params);
+
+void
+_ml_kem_inner_expand_private_key (const struct ml_kem_params *params,
+				  uint16_t *expanded,
+				  const uint8_t *key);
+
+size_t
+_ml_kem_inner_encrypt_expanded_itch (const struct ml_kem_params *params);
+
+void
+_ml_kem_inner_encrypt_expanded (const struct ml_kem_params *params,
+				const uint16_t *expanded,
+				const uint8_t *msg,
+				const uint8_t *seed,
+				uint8_t *ciphertext,
+				uint16_t *scratch);
+
+size_t
+_ml_kem_inner_decrypt_expanded_itch (const struct ml_kem_params *params);
+
+void
+_ml_kem_inner_decrypt_expanded (const struct ml_kem_params *params,
+				const uint16_t *expanded,
+				const uint8_t *ciphertext,
+				uint8_t *plaintext,
+				uint16_t *scratch);
+
 #endif /* NETTLE_ML_KEM_INTERNAL_H_INCLUDED */
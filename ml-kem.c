@@ -183,3 +183,125 @@ ml_kem_decap (const struct ml_kem_params *params,
 
   cnd_memcpy (!ok, secret, k2, 32);
 }
+
+/* The expanded public key is the inner expanded key, followed by
+   H(ek). The expanded private key is the inner expanded private key,
+   followed by the expanded public key, and z. */
+#define HASH_SIZE (32 / sizeof(uint16_t))
+
+size_t
+ml_kem_expanded_public_key_size (const struct ml_kem_params *params)
+{
+  return _ml_kem_inner_expand_public_key_size (params) + HASH_SIZE;
+}
+
+void
+ml_kem_public_key_expand (const struct ml_kem_params *params,
+			  uint16_t *expanded,
+			  const uint8_t *pub)
+{
+  struct sha3_ctx hctx;
+  uint8_t *h = (uint8_t *) (expanded
+			    + _ml_kem_inner_expand_public_key_size (params));
+
+  _ml_kem_inner_expand_public_key (params, expanded, pub);
+  H (&hctx, params->public_key_size, pub, h);
+}
+
+size_t
+ml_kem_encap_expanded_itch (const struct ml_kem_params *params)
+{
+  return _ml_kem_inner_encrypt_expanded_itch (params);
+}
+
+void
+ml_kem_encap_expanded (const struct ml_kem_params *params,
+		       const uint16_t *expanded,
+		       uint8_t *secret, uint8_t *ciphertext,
+		       void *random_ctx, nettle_random_func *random,
+		       uint16_t *scratch)
+{
+  uint8_t m[32], buffer[64], *r = &buffer[32];
+  const uint8_t *h = (const uint8_t *)
+    (expanded + _ml_kem_inner_expand_public_key_size (params));
+  struct sha3_ctx gctx;
+
+  random (random_ctx, sizeof(m), m);
+
+  G2 (&gctx, sizeof(m), m, 32, h, buffer);
+
+  _ml_kem_inner_encrypt_expanded (params, expanded, m, r, ciphertext,
+				  scratch);
+
+  memcpy (secret, buffer, 32);
+}
+
+size_t
+ml_kem_expanded_private_key_size (const struct ml_kem_params *params)
+{
+  return _ml_kem_inner_expand_private_key_size (params)
+    + ml_kem_expanded_public_key_size (params) + HASH_SIZE;
+}
+
+void
+ml_kem_private_key_expand (const struct ml_kem_params *params,
+			   uint16_t *expanded,
+			   const uint8_t *key)
+{
+  const uint8_t *pub = key + params->inner_private_key_size;
+  const uint8_t *h = pub + params->inner_public_key_size;
+  const uint8_t *z = h + 32;
+  uint16_t *epub = expanded + _ml_kem_inner_expand_private_key_size (params);
+
+  _ml_kem_inner_expand_private_key (params, expanded, key);
+  _ml_kem_inner_expand_public_key (params, epub, pub);
+
+  epub += _ml_kem_inner_expand_public_key_size (params);
+  memcpy (epub, h, 32);
+  memcpy (epub + HASH_SIZE, z, 32);
+}
+
+size_t
+ml_kem_decap_expanded_itch (const struct ml_kem_params *params)
+{
+  /* As for ml_kem_decap_itch. */
+  return _ml_kem_inner_encrypt_expanded_itch (params)
+    + params->ciphertext_size / sizeof(uint16_t);
+}
+
+void
+ml_kem_decap_expanded (const struct ml_kem_params *params,
+		       const uint16_t *expanded,
+		       uint8_t *secret,
+		       const uint8_t *ciphertext,
+		       uint16_t *scratch)
+{
+  uint8_t m[32], buffer[64], k2[32];
+  const uint16_t *epub
+    = expanded + _ml_kem_inner_expand_private_key_size (params);
+  const uint8_t *h = (const uint8_t *)
+    (epub + _ml_kem_inner_expand_public_key_size (params));
+  const uint8_t *z = h + 32;
+  struct sha3_ctx hctx;
+  struct sha3_ctx gctx;
+  volatile int ok = 1;
+  uint8_t *ciphertext2 = (uint8_t *)
+    (scratch + _ml_kem_inner_encrypt_expanded_itch (params));
+
+  _ml_kem_inner_decrypt_expanded (params, expanded, ciphertext, m, scratch);
+
+  G2 (&gctx, sizeof(m), m, 32, h, buffer);
+
+  _ml_kem_inner_encrypt_expanded (params, epub, m, &buffer[32],
+				  ciphertext2, scratch);
+
+  /* K1 = KBar2 */
+  memcpy (secret, buffer, 32);
+
+  /* K2 = J(z || cipherText) */
+  J2 (&hctx, 32, z, params->ciphertext_size, ciphertext, k2);
+
+  ok &= memeql_sec (ciphertext, ciphertext2, params->ciphertext_size);
+
+  cnd_memcpy (!ok, secret, k2, 32);
+}
@@ -47,6 +47,14 @@ extern "C" {
 #define ml_kem_encap nettle_ml_kem_encap
 #define ml_kem_decap_itch nettle_ml_kem_decap_itch
 #define ml_kem_decap nettle_ml_kem_decap
+#define ml_kem_expanded_public_key_size nettle_ml_kem_expanded_public_key_size
+#define ml_kem_public_key_expand nettle_ml_kem_public_key_expand
+#define ml_kem_encap_expanded_itch nettle_ml_kem_encap_expanded_itch
+#define ml_kem_encap_expanded nettle_ml_kem_encap_expanded
+#define ml_kem_expanded_private_key_size nettle_ml_kem_expanded_private_key_size
+#define ml_kem_private_key_expand nettle_ml_kem_private_key_expand
+#define ml_kem_decap_expanded_itch nettle_ml_kem_decap_expanded_itch
+#define ml_kem_decap_expanded nettle_ml_kem_decap_expanded
 
 #define ML_KEM_SEED_SIZE 64
 #define ML_KEM_SESSION_KEY_SIZE 32
@@ -92,6 +100,46 @@ ml_kem_decap (const struct ml_kem_params *params,
 	      const uint8_t *ciphertext,
 	      uint16_t *scratch);
 
+/* Keys expanded into the matrix and vectors in NTT domain, for
+   repeated use of the same key. The expanded key is an opaque array
+   of uint16_t, of the size returned by the *_size function, and does
+   not refer to the original key. */
+size_t
+ml_kem_expanded_public_key_size (const struct ml_kem_params *params);
+
+void
+ml_kem_public_key_expand (const struct ml_kem_params *params,
+			  uint16_t *expanded,
+			  const uint8_t *pub);
+
+size_t
+ml_kem_encap_expanded_itch (const struct ml_kem_params *params);
+
+void
+ml_kem_encap_expanded (const struct ml_kem_params *params,
+		       const uint16_t *expanded,
+		       uint8_t *secret, uint8_t *ciphertext,
+		       void *random_ctx, nettle_random_func *random,
+		       uint16_t *scratch);
+
+size_t
+ml_kem_expanded_private_key_size (const struct ml_kem_params *params);
+
+void
+ml_kem_private_key_expand (const struct ml_kem_params *params,
+			   uint16_t *expanded,
+			   const uint8_t *key);
+
+size_t
+ml_kem_decap_expanded_itch (const struct ml_kem_params *params);
+
+void
+ml_kem_decap_expanded (const struct ml_kem_params *params,
+		       const uint16_t *expanded,
+		       uint8_t *secret,
+		       const uint8_t *ciphertext,
+		       uint16_t *scratch);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,19 +33,26 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
 #include <stddef.h>
 
 #include "nettle-meta.h"
 
+#include "memops.h"
+
 const struct nettle_aead * const _nettle_aeads[] = {
   &nettle_gcm_aes128,
   &nettle_gcm_aes192,
   &nettle_gcm_aes256,
+  &nettle_gcm_aes128_compact,
+  &nettle_gcm_aes256_compact,
   &nettle_gcm_camellia128,
   &nettle_gcm_camellia256,
   &nettle_gcm_sm4,
   &nettle_eax_aes128,
   &nettle_chacha_poly1305,
+  &nettle_aegis128l,
+  &nettle_aegis256,
   NULL
 };
 
@@ -54,3 +61,71 @@ nettle_get_aeads (void)
 {
   return _nettle_aeads;
 }
+
+const struct nettle_aead_v2 * const _nettle_aeads_v2[] = {
+  &nettle_gcm_aes128_v2,
+  &nettle_gcm_aes256_v2,
+  &nettle_ccm_aes128_v2,
+  &nettle_ccm_aes256_v2,
+  &nettle_eax_aes128_v2,
+  &nettle_ocb_aes128_v2,
+  &nettle_chacha_poly1305_v2,
+  &nettle_siv_gcm_aes128_v2,
+  &nettle_siv_gcm_aes256_v2,
+  NULL
+};
+
+const struct nettle_aead_v2 * const *
+nettle_get_aeads_v2 (void)
+{
+  return _nettle_aeads_v2;
+}
+
+/* Large enough for all the aeads above. */
+#define AEAD_V2_MAX_DIGEST_SIZE 16
+
+void
+nettle_aead_v2_encrypt_message (const struct nettle_aead_v2 *aead,
+				const void *key, void *state,
+				const uint8_t *nonce,
+				size_t alength, const uint8_t *adata,
+				size_t clength, uint8_t *dst,
+				const uint8_t *src)
+{
+  size_t mlength;
+
+  if (aead->encrypt_message)
+    {
+      aead->encrypt_message (key, nonce, alength, adata, clength, dst, src);
+      return;
+    }
+  assert (clength >= aead->digest_size);
+  mlength = clength - aead->digest_size;
+
+  aead->init (state, key, nonce);
+  aead->update (state, key, alength, adata);
+  aead->encrypt (state, key, mlength, dst, src);
+  aead->digest (state, key, dst + mlength);
+}
+
+int
+nettle_aead_v2_decrypt_message (const struct nettle_aead_v2 *aead,
+				const void *key, void *state,
+				const uint8_t *nonce,
+				size_t alength, const uint8_t *adata,
+				size_t mlength, uint8_t *dst,
+				const uint8_t *src)
+{
+  uint8_t digest[AEAD_V2_MAX_DIGEST_SIZE];
+
+  if (aead->decrypt_message)
+    return aead->decrypt_message (key, nonce, alength, adata,
+				  mlength, dst, src);
+
+  assert (aead->digest_size <= sizeof (digest));
+  aead->init (state, key, nonce);
+  aead->update (state, key, alength, adata);
+  aead->decrypt (state, key, mlength, dst, src);
+  aead->digest (state, key, digest);
+  return memeql_sec (digest, src + mlength, aead->digest_size);
+}
@@ -197,11 +197,113 @@ nettle_get_aeads (void);
 extern const struct nettle_aead nettle_gcm_aes128;
 extern const struct nettle_aead nettle_gcm_aes192;
 extern const struct nettle_aead nettle_gcm_aes256;
+extern const struct nettle_aead nettle_gcm_aes128_compact;
+extern const struct nettle_aead nettle_gcm_aes256_compact;
 extern const struct nettle_aead nettle_gcm_camellia128;
 extern const struct nettle_aead nettle_gcm_camellia256;
 extern const struct nettle_aead nettle_gcm_sm4;
 extern const struct nettle_aead nettle_eax_aes128;
 extern const struct nettle_aead nettle_chacha_poly1305;
+extern const struct nettle_aead nettle_aegis128l;
+extern const struct nettle_aead nettle_aegis256;
+
+/* Interface with the expanded key separate from the per-message
+   state. After set_key, the key is never modified, so that one key
+   can be used for any number of messages, also from several threads
+   at a time. */
+typedef void nettle_aead_init_func(void *state, const void *key,
+				   const uint8_t *nonce);
+typedef void nettle_aead_update_func(void *state, const void *key,
+				     size_t length, const uint8_t *data);
+typedef void nettle_aead_crypt_func(void *state, const void *key,
+				    size_t length, uint8_t *dst,
+				    const uint8_t *src);
+typedef void nettle_aead_digest_func(void *state, const void *key,
+				     uint8_t *digest);
+
+/* The clength argument includes the digest, which is stored last.
+   Similarly, the source of decrypt has mlength + digest_size bytes. */
+typedef void nettle_aead_encrypt_message_func(const void *key,
+					      const uint8_t *nonce,
+					      size_t alength,
+					      const uint8_t *adata,
+					      size_t clength, uint8_t *dst,
+					      const uint8_t *src);
+typedef int nettle_aead_decrypt_message_func(const void *key,
+					     const uint8_t *nonce,
+					     size_t alength,
+					     const uint8_t *adata,
+					     size_t mlength, uint8_t *dst,
+					     const uint8_t *src);
+
+struct nettle_aead_v2
+{
+  const char *name;
+
+  /* Size of the expanded key. */
+  unsigned key_context_size;
+  /* Size of the per-message state, zero if incremental processing
+     isn't supported. */
+  unsigned state_size;
+  /* Block size for encrypt and decrypt. */
+  unsigned block_size;
+  unsigned key_size;
+  unsigned nonce_size;
+  unsigned digest_size;
+
+  /* Used for both encryption and decryption. */
+  nettle_set_key_func *set_key;
+
+  /* Incremental processing. NULL for constructions that need the
+     complete message up front, i.e., CCM and SIV-GCM. */
+  nettle_aead_init_func *init;
+  nettle_aead_update_func *update;
+  nettle_aead_crypt_func *encrypt;
+  nettle_aead_crypt_func *decrypt;
+  nettle_aead_digest_func *digest;
+
+  /* Processing of a complete message, NULL if incremental processing
+     is supported. Use nettle_aead_v2_encrypt_message and
+     nettle_aead_v2_decrypt_message for either kind. */
+  nettle_aead_encrypt_message_func *encrypt_message;
+  nettle_aead_decrypt_message_func *decrypt_message;
+};
+
+/* The state must be state_size bytes, and is unused if state_size is
+   zero. */
+void
+nettle_aead_v2_encrypt_message (const struct nettle_aead_v2 *aead,
+				const void *key, void *state,
+				const uint8_t *nonce,
+				size_t alength, const uint8_t *adata,
+				size_t clength, uint8_t *dst,
+				const uint8_t *src);
+
+/* Returns 1 if the digest is valid, otherwise 0. */
+int
+nettle_aead_v2_decrypt_message (const struct nettle_aead_v2 *aead,
+				const void *key, void *state,
+				const uint8_t *nonce,
+				size_t alength, const uint8_t *adata,
+				size_t mlength, uint8_t *dst,
+				const uint8_t *src);
+
+/* null-terminated list of aead constructions with separate key and
+   state. */
+const struct nettle_aead_v2 * const * _NETTLE_ATTRIBUTE_PURE
+nettle_get_aeads_v2 (void);
+
+#define nettle_aeads_v2 (nettle_get_aeads_v2())
+
+extern const struct nettle_aead_v2 nettle_gcm_aes128_v2;
+extern const struct nettle_aead_v2 nettle_gcm_aes256_v2;
+extern const struct nettle_aead_v2 nettle_ccm_aes128_v2;
+extern const struct nettle_aead_v2 nettle_ccm_aes256_v2;
+extern const struct nettle_aead_v2 nettle_eax_aes128_v2;
+extern const struct nettle_aead_v2 nettle_ocb_aes128_v2;
+extern const struct nettle_aead_v2 nettle_chacha_poly1305_v2;
+extern const struct nettle_aead_v2 nettle_siv_gcm_aes128_v2;
+extern const struct nettle_aead_v2 nettle_siv_gcm_aes256_v2;
 
 #define _NETTLE_HMAC(name, HASH) {		\
   #name,					\
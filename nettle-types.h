@@ -107,6 +107,37 @@ typedef void nettle_hash_update_func(void *ctx,
 				     const uint8_t *src);
 typedef void nettle_hash_digest_func(void *ctx, uint8_t *dst);
 
+/* Fragments of a message, for the _iov functions, e.g.,
+   sha256_update_iov. */
+struct nettle_iov
+{
+  size_t length;
+  const uint8_t *data;
+};
+
+/* For encryption and decryption, dst and src may be equal. */
+struct nettle_crypt_iov
+{
+  size_t length;
+  uint8_t *dst;
+  const uint8_t *src;
+};
+
+/* One message for the batched AEAD functions, e.g.,
+   gcm_aes128_seal_batch. The nonce size is fixed by the algorithm.
+   When sealing, the digest is written, when opening, it is the
+   received digest to check. */
+struct nettle_aead_batch
+{
+  const uint8_t *nonce;
+  size_t adata_length;
+  const uint8_t *adata;
+  size_t length;
+  uint8_t *dst;
+  const uint8_t *src;
+  uint8_t *digest;
+};
+
 #ifdef __cplusplus
 }
 #endif
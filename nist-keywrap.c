@@ -46,15 +46,104 @@
 #include "macros.h"
 #include "bswap-internal.h"
 
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* Number of independent wraps processed together. */
+#define KEYWRAP_LANES 8
+
+/* The wrapping function W, for several keys of n 64-bit blocks each,
+   in place. Each call to encrypt processes one block of each lane. */
+static void
+keywrap_lanes (const void *ctx, nettle_cipher_func *encrypt,
+	       size_t lanes, size_t n,
+	       union nettle_block8 *A, uint8_t * const *R)
+{
+  union nettle_block16 B[KEYWRAP_LANES];
+  size_t i, j, l;
+
+  for (j = 0; j < 6; j++)
+    for (i = 0; i < n; i++)
+      {
+	/* A = MSB(64, B) ^ t where t = (n*j)+i */
+	uint64_t t = bswap64_if_le ((n * j) + (i + 1));
+
+	/* B = AES(K, A | R[i]) */
+	for (l = 0; l < lanes; l++)
+	  {
+	    B[l].u64[0] = A[l].u64;
+	    memcpy (B[l].b + 8, R[l] + (i * 8), 8);
+	  }
+	encrypt (ctx, 16 * lanes, B[0].b, B[0].b);
+
+	for (l = 0; l < lanes; l++)
+	  {
+	    A[l].u64 = B[l].u64[0] ^ t;
+	    /* R[i] = LSB(64, B) */
+	    memcpy (R[l] + (i * 8), B[l].b + 8, 8);
+	  }
+      }
+}
+
+/* The inverse function W^-1. */
+static void
+keyunwrap_lanes (const void *ctx, nettle_cipher_func *decrypt,
+		 size_t lanes, size_t n,
+		 union nettle_block8 *A, uint8_t * const *R)
+{
+  union nettle_block16 B[KEYWRAP_LANES];
+  size_t i, j, l;
+
+  for (j = 6; j-- > 0; )
+    for (i = n; i-- > 0; )
+      {
+	uint64_t t = bswap64_if_le ((n * j) + (i + 1));
+
+	/* B = AES-1(K, (A ^ t) | R[i]) where t = n*j+i */
+	for (l = 0; l < lanes; l++)
+	  {
+	    B[l].u64[0] = A[l].u64 ^ t;
+	    memcpy (B[l].b + 8, R[l] + (i * 8), 8);
+	  }
+	decrypt (ctx, 16 * lanes, B[0].b, B[0].b);
+
+	for (l = 0; l < lanes; l++)
+	  {
+	    /* A = MSB(64, B) */
+	    A[l].u64 = B[l].u64[0];
+	    /* R[i] = LSB(64, B) */
+	    memcpy (R[l] + (i * 8), B[l].b + 8, 8);
+	  }
+      }
+}
+
 void
 nist_keywrap16 (const void *ctx, nettle_cipher_func *encrypt,
 		const uint8_t *iv, size_t ciphertext_length,
 		uint8_t *ciphertext, const uint8_t *cleartext)
 {
-  union nettle_block16 I, B;
-  union nettle_block8 A;
-  size_t i, j, n;
-  uint8_t *R = ciphertext + 8;
+  nist_keywrap16_batch (ctx, encrypt, iv, 1,
+			ciphertext_length, ciphertext, cleartext);
+}
+
+int
+nist_keyunwrap16 (const void *ctx, nettle_cipher_func *decrypt,
+		  const uint8_t *iv, size_t cleartext_length,
+		  uint8_t *cleartext, const uint8_t *ciphertext)
+{
+  return nist_keyunwrap16_batch (ctx, decrypt, iv, 1,
+				 cleartext_length, cleartext, ciphertext,
+				 NULL);
+}
+
+void
+nist_keywrap16_batch (const void *ctx, nettle_cipher_func *encrypt,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts)
+{
+  union nettle_block8 A[KEYWRAP_LANES];
+  uint8_t *R[KEYWRAP_LANES];
+  size_t n, l;
 
   /* ciphertext_length must be at least 16
    * and be divisible by 8 */
@@ -62,41 +151,39 @@ nist_keywrap16 (const void *ctx, nettle_cipher_func *encrypt,
   assert (!(ciphertext_length % 8));
 
   n = (ciphertext_length - 8) / 8;
-  memcpy (R, cleartext, (ciphertext_length - 8));
-  memcpy (A.b, iv, 8);
 
-  for (j = 0; j < 6; j++)
+  while (count > 0)
     {
-      for (i = 0; i < n; i++)
+      size_t lanes = MIN (count, KEYWRAP_LANES);
+      for (l = 0; l < lanes; l++)
 	{
-	  /* I = A | R[1] */
-	  I.u64[0] = A.u64;
-	  memcpy (I.b + 8, R + (i * 8), 8);
-
-	  /* B = AES(K, I) */
-	  encrypt (ctx, 16, B.b, I.b);
+	  R[l] = ciphertexts + l * ciphertext_length + 8;
+	  memcpy (R[l], cleartexts + l * (ciphertext_length - 8),
+		  ciphertext_length - 8);
+	  memcpy (A[l].b, iv, 8);
+	}
+      keywrap_lanes (ctx, encrypt, lanes, n, A, R);
 
-	  /* A = MSB(64, B) ^ t where t = (n*j)+i */
-	  A.u64 = B.u64[0] ^ bswap64_if_le ((n * j) + (i + 1));
+      for (l = 0; l < lanes; l++)
+	memcpy (ciphertexts + l * ciphertext_length, A[l].b, 8);
 
-	  /* R[i] = LSB(64, B) */
-	  memcpy (R + (i * 8), B.b + 8, 8);
-	}
+      count -= lanes;
+      ciphertexts += lanes * ciphertext_length;
+      cleartexts += lanes * (ciphertext_length - 8);
     }
-
-  memcpy (ciphertext, A.b, 8);
 }
 
 int
-nist_keyunwrap16 (const void *ctx, nettle_cipher_func *decrypt,
-		  const uint8_t *iv, size_t cleartext_length,
-		  uint8_t *cleartext, const uint8_t *ciphertext)
+nist_keyunwrap16_batch (const void *ctx, nettle_cipher_func *decrypt,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid)
 {
-  union nettle_block16 I, B;
-  union nettle_block8 A;
-  int i, j;
-  size_t n;
-  uint8_t *R = cleartext;
+  union nettle_block8 A[KEYWRAP_LANES];
+  uint8_t *R[KEYWRAP_LANES];
+  size_t n, l;
+  int res = 1;
 
   /* cleartext_length must be at least 8
    * and be divisible by 8 */
@@ -104,27 +191,179 @@ nist_keyunwrap16 (const void *ctx, nettle_cipher_func *decrypt,
   assert (!(cleartext_length % 8));
 
   n = (cleartext_length / 8);
-  memcpy (A.b, ciphertext, 8);
-  memcpy (R, ciphertext + 8, cleartext_length);
 
-  for (j = 5; j >= 0; j--)
+  while (count > 0)
     {
-      for (i = n - 1; i >= 0; i--)
+      size_t lanes = MIN (count, KEYWRAP_LANES);
+      for (l = 0; l < lanes; l++)
+	{
+	  R[l] = cleartexts + l * cleartext_length;
+	  memcpy (A[l].b, ciphertexts + l * (cleartext_length + 8), 8);
+	  memcpy (R[l], ciphertexts + l * (cleartext_length + 8) + 8,
+		  cleartext_length);
+	}
+      keyunwrap_lanes (ctx, decrypt, lanes, n, A, R);
+
+      for (l = 0; l < lanes; l++)
 	{
-	  /* B = AES-1(K, (A ^ t) | R[i]) where t = n*j+i */
-	  I.u64[0] = A.u64 ^ bswap64_if_le ((n * j) + (i + 1));
-	  memcpy (I.b + 8, R + (i * 8), 8);
-	  decrypt (ctx, 16, B.b, I.b);
+	  int ok = memeql_sec (A[l].b, iv, 8);
+	  if (valid)
+	    valid[l] = ok;
+	  res &= ok;
+	}
+
+      count -= lanes;
+      cleartexts += lanes * cleartext_length;
+      ciphertexts += lanes * (cleartext_length + 8);
+      if (valid)
+	valid += lanes;
+    }
+  return res;
+}
+
+/* The alternative initial value of RFC 5649, followed by the 32-bit
+   message length. */
+static const uint8_t kwp_aiv[4] = { 0xa6, 0x59, 0x59, 0xa6 };
+
+void
+nist_keywrap16_pad (const void *ctx, nettle_cipher_func *encrypt,
+		    size_t cleartext_length,
+		    uint8_t *ciphertext, const uint8_t *cleartext)
+{
+  nist_keywrap16_pad_batch (ctx, encrypt, 1,
+			    cleartext_length, ciphertext, cleartext);
+}
+
+int
+nist_keyunwrap16_pad (const void *ctx, nettle_cipher_func *decrypt,
+		      size_t ciphertext_length, size_t *cleartext_length,
+		      uint8_t *cleartext, const uint8_t *ciphertext)
+{
+  return nist_keyunwrap16_pad_batch (ctx, decrypt, 1, ciphertext_length,
+				     cleartext_length, cleartext, ciphertext,
+				     NULL);
+}
+
+void
+nist_keywrap16_pad_batch (const void *ctx, nettle_cipher_func *encrypt,
+			  size_t count, size_t cleartext_length,
+			  uint8_t *ciphertexts, const uint8_t *cleartexts)
+{
+  union nettle_block8 A[KEYWRAP_LANES];
+  uint8_t *R[KEYWRAP_LANES];
+  size_t ciphertext_length;
+  size_t n, l;
+
+  assert (cleartext_length > 0);
+  assert (cleartext_length <= 0xffffffff);
 
-	  /* A = MSB(64, B) */
-	  A.u64 = B.u64[0];
+  ciphertext_length = NIST_KEYWRAP16_PAD_LENGTH (cleartext_length);
+  n = (ciphertext_length - 8) / 8;
 
-	  /* R[i] = LSB(64, B) */
-	  memcpy (R + (i * 8), B.b + 8, 8);
+  while (count > 0)
+    {
+      size_t lanes = MIN (count, KEYWRAP_LANES);
+      for (l = 0; l < lanes; l++)
+	{
+	  R[l] = ciphertexts + l * ciphertext_length + 8;
+	  memcpy (R[l], cleartexts + l * cleartext_length, cleartext_length);
+	  memset (R[l] + cleartext_length, 0,
+		  ciphertext_length - 8 - cleartext_length);
+	  memcpy (A[l].b, kwp_aiv, 4);
+	  WRITE_UINT32 (A[l].b + 4, cleartext_length);
+	}
+      if (n == 1)
+	{
+	  /* A single block is encrypted directly. */
+	  for (l = 0; l < lanes; l++)
+	    {
+	      memcpy (R[l] - 8, A[l].b, 8);
+	      encrypt (ctx, 16, R[l] - 8, R[l] - 8);
+	    }
+	}
+      else
+	{
+	  keywrap_lanes (ctx, encrypt, lanes, n, A, R);
+	  for (l = 0; l < lanes; l++)
+	    memcpy (R[l] - 8, A[l].b, 8);
 	}
+
+      count -= lanes;
+      ciphertexts += lanes * ciphertext_length;
+      cleartexts += lanes * cleartext_length;
     }
+}
+
+int
+nist_keyunwrap16_pad_batch (const void *ctx, nettle_cipher_func *decrypt,
+			    size_t count, size_t ciphertext_length,
+			    size_t *cleartext_lengths,
+			    uint8_t *cleartexts, const uint8_t *ciphertexts,
+			    int *valid)
+{
+  union nettle_block8 A[KEYWRAP_LANES];
+  uint8_t *R[KEYWRAP_LANES];
+  size_t n, l;
+  int res = 1;
 
-  return memeql_sec (A.b, iv, 8);
+  assert (ciphertext_length >= 16);
+  assert (!(ciphertext_length % 8));
+
+  n = (ciphertext_length - 8) / 8;
+
+  while (count > 0)
+    {
+      size_t lanes = MIN (count, KEYWRAP_LANES);
+      for (l = 0; l < lanes; l++)
+	{
+	  const uint8_t *c = ciphertexts + l * ciphertext_length;
+	  R[l] = cleartexts + l * (ciphertext_length - 8);
+	  if (n == 1)
+	    {
+	      union nettle_block16 B;
+	      decrypt (ctx, 16, B.b, c);
+	      memcpy (A[l].b, B.b, 8);
+	      memcpy (R[l], B.b + 8, 8);
+	    }
+	  else
+	    {
+	      memcpy (A[l].b, c, 8);
+	      memcpy (R[l], c + 8, ciphertext_length - 8);
+	    }
+	}
+      if (n > 1)
+	keyunwrap_lanes (ctx, decrypt, lanes, n, A, R);
+
+      for (l = 0; l < lanes; l++)
+	{
+	  /* The length must be in the range 8(n-1) < mli <= 8n, and
+	     the padding must be zero. */
+	  uint32_t mli = READ_UINT32 (A[l].b + 4);
+	  const uint8_t *last = R[l] + 8 * (n - 1);
+	  unsigned pad = 0;
+	  unsigned i;
+	  int ok;
+
+	  for (i = 0; i < 8; i++)
+	    pad |= last[i] & - (unsigned) (8 * (n - 1) + i >= mli);
+
+	  ok = memeql_sec (A[l].b, kwp_aiv, 4)
+	    & (mli > 8 * (n - 1)) & (mli <= 8 * n) & (pad == 0);
+
+	  cleartext_lengths[l] = ok ? mli : 0;
+	  if (valid)
+	    valid[l] = ok;
+	  res &= ok;
+	}
+
+      count -= lanes;
+      cleartexts += lanes * (ciphertext_length - 8);
+      ciphertexts += lanes * ciphertext_length;
+      cleartext_lengths += lanes;
+      if (valid)
+	valid += lanes;
+    }
+  return res;
 }
 
 void
@@ -180,3 +419,72 @@ aes256_keyunwrap (struct aes256_ctx *ctx,
   return nist_keyunwrap16 (ctx, (nettle_cipher_func *) & aes256_decrypt,
 			   iv, cleartext_length, cleartext, ciphertext);
 }
+
+void
+aes128_keywrap_batch (const struct aes128_ctx *ctx,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts)
+{
+  nist_keywrap16_batch (ctx, (nettle_cipher_func *) & aes128_encrypt,
+			iv, count, ciphertext_length,
+			ciphertexts, cleartexts);
+}
+
+int
+aes128_keyunwrap_batch (const struct aes128_ctx *ctx,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid)
+{
+  return nist_keyunwrap16_batch (ctx, (nettle_cipher_func *) & aes128_decrypt,
+				 iv, count, cleartext_length,
+				 cleartexts, ciphertexts, valid);
+}
+
+void
+aes192_keywrap_batch (const struct aes192_ctx *ctx,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts)
+{
+  nist_keywrap16_batch (ctx, (nettle_cipher_func *) & aes192_encrypt,
+			iv, count, ciphertext_length,
+			ciphertexts, cleartexts);
+}
+
+int
+aes192_keyunwrap_batch (const struct aes192_ctx *ctx,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid)
+{
+  return nist_keyunwrap16_batch (ctx, (nettle_cipher_func *) & aes192_decrypt,
+				 iv, count, cleartext_length,
+				 cleartexts, ciphertexts, valid);
+}
+
+void
+aes256_keywrap_batch (const struct aes256_ctx *ctx,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts)
+{
+  nist_keywrap16_batch (ctx, (nettle_cipher_func *) & aes256_encrypt,
+			iv, count, ciphertext_length,
+			ciphertexts, cleartexts);
+}
+
+int
+aes256_keyunwrap_batch (const struct aes256_ctx *ctx,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid)
+{
+  return nist_keyunwrap16_batch (ctx, (nettle_cipher_func *) & aes256_decrypt,
+				 iv, count, cleartext_length,
+				 cleartexts, ciphertexts, valid);
+}
@@ -53,6 +53,21 @@ extern "C" {
 #define aes128_keyunwrap nettle_aes128_keyunwrap
 #define aes192_keyunwrap nettle_aes192_keyunwrap
 #define aes256_keyunwrap nettle_aes256_keyunwrap
+#define nist_keywrap16_batch nettle_nist_keywrap16_batch
+#define nist_keyunwrap16_batch nettle_nist_keyunwrap16_batch
+#define nist_keywrap16_pad nettle_nist_keywrap16_pad
+#define nist_keyunwrap16_pad nettle_nist_keyunwrap16_pad
+#define nist_keywrap16_pad_batch nettle_nist_keywrap16_pad_batch
+#define nist_keyunwrap16_pad_batch nettle_nist_keyunwrap16_pad_batch
+#define aes128_keywrap_batch nettle_aes128_keywrap_batch
+#define aes192_keywrap_batch nettle_aes192_keywrap_batch
+#define aes256_keywrap_batch nettle_aes256_keywrap_batch
+#define aes128_keyunwrap_batch nettle_aes128_keyunwrap_batch
+#define aes192_keyunwrap_batch nettle_aes192_keyunwrap_batch
+#define aes256_keyunwrap_batch nettle_aes256_keyunwrap_batch
+
+/* Size of the RFC 5649 wrapping of a key of the given length. */
+#define NIST_KEYWRAP16_PAD_LENGTH(length) (8 + (((length) + 7) & -8))
 
 void
 nist_keywrap16 (const void *ctx, nettle_cipher_func *encrypt,
@@ -94,6 +109,93 @@ aes256_keyunwrap (struct aes256_ctx *ctx,
 		  const uint8_t *iv, size_t cleartext_length,
 		  uint8_t *cleartext, const uint8_t *ciphertext);
 
+/* Wraps count keys of the same size, stored consecutively, under the
+   same key encryption key. Independent wraps are interleaved, so that
+   each call to encrypt processes several blocks. */
+void
+nist_keywrap16_batch (const void *ctx, nettle_cipher_func *encrypt,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts);
+
+/* Returns 1 if all keys are valid. If valid is non-NULL, the result
+   for each key is stored in valid[i]. */
+int
+nist_keyunwrap16_batch (const void *ctx, nettle_cipher_func *decrypt,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid);
+
+/* Key wrap with padding, RFC 5649. The ciphertext size is
+   NIST_KEYWRAP16_PAD_LENGTH(cleartext_length). */
+void
+nist_keywrap16_pad (const void *ctx, nettle_cipher_func *encrypt,
+		    size_t cleartext_length,
+		    uint8_t *ciphertext, const uint8_t *cleartext);
+
+/* The cleartext buffer must have room for ciphertext_length - 8
+   bytes, including the padding. On success, returns 1 and stores the
+   unpadded size in *cleartext_length. */
+int
+nist_keyunwrap16_pad (const void *ctx, nettle_cipher_func *decrypt,
+		      size_t ciphertext_length, size_t *cleartext_length,
+		      uint8_t *cleartext, const uint8_t *ciphertext);
+
+/* Consecutive ciphertexts are NIST_KEYWRAP16_PAD_LENGTH(cleartext_length)
+   bytes apart. */
+void
+nist_keywrap16_pad_batch (const void *ctx, nettle_cipher_func *encrypt,
+			  size_t count, size_t cleartext_length,
+			  uint8_t *ciphertexts, const uint8_t *cleartexts);
+
+/* Consecutive cleartexts are ciphertext_length - 8 bytes apart. */
+int
+nist_keyunwrap16_pad_batch (const void *ctx, nettle_cipher_func *decrypt,
+			    size_t count, size_t ciphertext_length,
+			    size_t *cleartext_lengths,
+			    uint8_t *cleartexts, const uint8_t *ciphertexts,
+			    int *valid);
+
+void
+aes128_keywrap_batch (const struct aes128_ctx *ctx,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts);
+
+void
+aes192_keywrap_batch (const struct aes192_ctx *ctx,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts);
+
+void
+aes256_keywrap_batch (const struct aes256_ctx *ctx,
+		      const uint8_t *iv, size_t count,
+		      size_t ciphertext_length,
+		      uint8_t *ciphertexts, const uint8_t *cleartexts);
+
+int
+aes128_keyunwrap_batch (const struct aes128_ctx *ctx,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid);
+
+int
+aes192_keyunwrap_batch (const struct aes192_ctx *ctx,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid);
+
+int
+aes256_keyunwrap_batch (const struct aes256_ctx *ctx,
+			const uint8_t *iv, size_t count,
+			size_t cleartext_length,
+			uint8_t *cleartexts, const uint8_t *ciphertexts,
+			int *valid);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,104 @@
+/* ocb-aes128-meta.c
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ocb.h"
+#include "nettle-meta.h"
+
+/* Nonce size as recommended by RFC 7253. */
+#define OCB_AES128_V2_NONCE_SIZE 12
+
+/* Expanded key for nettle_ocb_aes128_v2, with both encryption and
+   decryption subkeys. */
+struct ocb_aes128_v2_key
+{
+  struct ocb_aes128_encrypt_key encrypt;
+  struct aes128_ctx decrypt;
+};
+
+static void
+ocb_aes128_v2_set_key (struct ocb_aes128_v2_key *key, const uint8_t *aes_key)
+{
+  ocb_aes128_set_decrypt_key (&key->encrypt, &key->decrypt, aes_key);
+}
+
+static void
+ocb_aes128_v2_init (struct ocb_ctx *ctx, const struct ocb_aes128_v2_key *key,
+		    const uint8_t *nonce)
+{
+  ocb_aes128_set_nonce (ctx, &key->encrypt, OCB_DIGEST_SIZE,
+			OCB_AES128_V2_NONCE_SIZE, nonce);
+}
+
+static void
+ocb_aes128_v2_update (struct ocb_ctx *ctx, const struct ocb_aes128_v2_key *key,
+		      size_t length, const uint8_t *data)
+{
+  ocb_aes128_update (ctx, &key->encrypt, length, data);
+}
+
+static void
+ocb_aes128_v2_encrypt (struct ocb_ctx *ctx, const struct ocb_aes128_v2_key *key,
+		       size_t length, uint8_t *dst, const uint8_t *src)
+{
+  ocb_aes128_encrypt (ctx, &key->encrypt, length, dst, src);
+}
+
+static void
+ocb_aes128_v2_decrypt (struct ocb_ctx *ctx, const struct ocb_aes128_v2_key *key,
+		       size_t length, uint8_t *dst, const uint8_t *src)
+{
+  ocb_aes128_decrypt (ctx, &key->encrypt, &key->decrypt, length, dst, src);
+}
+
+static void
+ocb_aes128_v2_digest (struct ocb_ctx *ctx, const struct ocb_aes128_v2_key *key,
+		      uint8_t *digest)
+{
+  ocb_aes128_digest (ctx, &key->encrypt, digest);
+}
+
+const struct nettle_aead_v2
+nettle_ocb_aes128_v2 =
+  { "ocb_aes128", sizeof(struct ocb_aes128_v2_key), sizeof(struct ocb_ctx),
+    OCB_BLOCK_SIZE, AES128_KEY_SIZE,
+    OCB_AES128_V2_NONCE_SIZE, OCB_DIGEST_SIZE,
+    (nettle_set_key_func *) ocb_aes128_v2_set_key,
+    (nettle_aead_init_func *) ocb_aes128_v2_init,
+    (nettle_aead_update_func *) ocb_aes128_v2_update,
+    (nettle_aead_crypt_func *) ocb_aes128_v2_encrypt,
+    (nettle_aead_crypt_func *) ocb_aes128_v2_decrypt,
+    (nettle_aead_digest_func *) ocb_aes128_v2_digest,
+    NULL, NULL,
+  };
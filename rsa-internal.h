@@ -45,6 +45,7 @@
 #define _rsa_sec_compute_root_tr _nettle_rsa_sec_compute_root_tr
 #define _rsa_oaep_encrypt _nettle_rsa_oaep_encrypt
 #define _rsa_oaep_decrypt _nettle_rsa_oaep_decrypt
+#define _rsa_prepared_powm _nettle_rsa_prepared_powm
 
 /* Internal functions. */
 int
@@ -60,6 +61,17 @@ _rsa_verify_recover(const struct rsa_public_key *key,
 size_t
 _rsa_check_size(mpz_t n);
 
+#define RSA_PREPARED_MAX_LIMBS \
+  ((RSA_PREPARED_MAX_OCTETS + sizeof(mp_limb_t) - 1) / sizeof(mp_limb_t))
+#define RSA_PREPARED_POWM_ITCH(n) (3*(n))
+
+/* Computes r = s^e mod n, with s < n. Not side-channel silent, for
+   public key operations only. */
+void
+_rsa_prepared_powm(const struct rsa_prepared_public_key *ctx,
+		   mp_limb_t *rp, const mp_limb_t *sp,
+		   mp_limb_t *scratch);
+
 /* side-channel silent root computation */
 mp_size_t
 _rsa_sec_compute_root_itch(const struct rsa_private_key *key);
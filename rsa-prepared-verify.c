@@ -0,0 +1,154 @@
+/* rsa-prepared-verify.c
+
+   Verifying RSA signatures.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+
+#include "rsa.h"
+#include "rsa-internal.h"
+
+#include "gmp-glue.h"
+#include "hogweed-internal.h"
+#include "nettle-internal.h"
+#include "pss.h"
+
+/* Checks that 0 < s < n. */
+static int
+check_range (const struct rsa_prepared_public_key *ctx,
+	     const mp_limb_t *sp)
+{
+  mp_size_t n = ctx->limbs;
+  return !mpn_zero_p (sp, n) && mpn_cmp (sp, ctx->n, n) < 0;
+}
+
+/* Scratch space: n + RSA_PREPARED_POWM_ITCH(n) limbs, and 2 * size
+   octets. */
+static int
+pkcs1_verify_n (const struct rsa_prepared_public_key *ctx,
+		size_t length, const uint8_t *digest_info,
+		const mp_limb_t *sp,
+		mp_limb_t *scratch, uint8_t *em)
+{
+  size_t size = ctx->size;
+
+  if (!check_range (ctx, sp))
+    return 0;
+
+  _rsa_prepared_powm (ctx, scratch, sp, scratch + ctx->limbs);
+  mpn_get_base256 (em, size, scratch, ctx->limbs);
+
+  return (_pkcs1_signature_prefix (size, em + size,
+				   length, digest_info, 0) != NULL
+	  && !memcmp (em, em + size, size));
+}
+
+int
+rsa_prepared_pkcs1_verify(const struct rsa_prepared_public_key *ctx,
+			  size_t length, const uint8_t *digest_info,
+			  const mpz_t s)
+{
+  mp_size_t n = ctx->limbs;
+  TMP_DECL(scratch, mp_limb_t, 5*RSA_PREPARED_MAX_LIMBS);
+  TMP_DECL(em, uint8_t, 2*RSA_PREPARED_MAX_OCTETS);
+
+  if (mpz_sgn (s) <= 0 || mpz_size (s) > (size_t) n)
+    return 0;
+
+  TMP_ALLOC(scratch, 2*n + RSA_PREPARED_POWM_ITCH (n));
+  TMP_ALLOC(em, 2*ctx->size);
+
+  mpz_limbs_copy (scratch, s, n);
+  return pkcs1_verify_n (ctx, length, digest_info, scratch,
+			 scratch + n, em);
+}
+
+int
+rsa_prepared_pkcs1_verify_batch(const struct rsa_prepared_public_key *ctx,
+				size_t count,
+				size_t length, const uint8_t *digest_infos,
+				const uint8_t *signatures,
+				int *valid)
+{
+  mp_size_t n = ctx->limbs;
+  size_t size = ctx->size;
+  size_t i;
+  int res;
+  TMP_DECL(scratch, mp_limb_t, 5*RSA_PREPARED_MAX_LIMBS);
+  TMP_DECL(em, uint8_t, 2*RSA_PREPARED_MAX_OCTETS);
+
+  TMP_ALLOC(scratch, 2*n + RSA_PREPARED_POWM_ITCH (n));
+  TMP_ALLOC(em, 2*size);
+
+  for (i = 0, res = 1; i < count; i++)
+    {
+      int ok;
+      mpn_set_base256 (scratch, n, signatures + i*size, size);
+      ok = pkcs1_verify_n (ctx, length, digest_infos + i*length,
+			   scratch, scratch + n, em);
+      if (valid)
+	valid[i] = ok;
+      res &= ok;
+    }
+  return res;
+}
+
+int
+rsa_prepared_pss_sha256_verify_digest(const struct rsa_prepared_public_key *ctx,
+				      size_t salt_length,
+				      const uint8_t *digest,
+				      const mpz_t signature)
+{
+  mp_size_t n = ctx->limbs;
+  mpz_t m;
+  size_t bits;
+  TMP_DECL(scratch, mp_limb_t, 5*RSA_PREPARED_MAX_LIMBS);
+
+  if (mpz_sgn (signature) <= 0 || mpz_size (signature) > (size_t) n)
+    return 0;
+
+  TMP_ALLOC(scratch, 2*n + RSA_PREPARED_POWM_ITCH (n));
+
+  mpz_limbs_copy (scratch, signature, n);
+  if (!check_range (ctx, scratch))
+    return 0;
+
+  _rsa_prepared_powm (ctx, scratch + n, scratch, scratch + 2*n);
+
+  bits = mpz_sizeinbase (mpz_roinit_n (m, ctx->n, n), 2) - 1;
+
+  return pss_verify_mgf1 (mpz_roinit_n (m, scratch + n, n), bits,
+			  &nettle_sha256, salt_length, digest);
+}
@@ -0,0 +1,179 @@
+/* rsa-prepared.c
+
+   RSA public key operations with precomputed Montgomery state.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+
+#include "rsa.h"
+#include "rsa-internal.h"
+
+#include "gmp-glue.h"
+#include "nettle-internal.h"
+#include "pkcs1.h"
+
+int
+rsa_prepared_public_key_init(struct rsa_prepared_public_key *ctx,
+			     const struct rsa_public_key *key)
+{
+  mpz_t r;
+  size_t size;
+  mp_size_t n;
+  mp_limb_t inv;
+  unsigned i;
+
+  if (mpz_sgn (key->n) <= 0 || !mpz_odd_p (key->n)
+      || !mpz_fits_ulong_p (key->e) || !mpz_odd_p (key->e)
+      || mpz_cmp_ui (key->e, 3) < 0)
+    return 0;
+
+  size = (mpz_sizeinbase (key->n, 2) + 7) / 8;
+  if (size < RSA_MINIMUM_N_OCTETS || size > RSA_PREPARED_MAX_OCTETS)
+    return 0;
+
+  n = mpz_size (key->n);
+
+  ctx->size = size;
+  ctx->limbs = n;
+  ctx->e = mpz_get_ui (key->e);
+  ctx->n = gmp_alloc_limbs (2*n);
+
+  mpz_limbs_copy (ctx->n, key->n, n);
+
+  /* n^{-1} mod B, by Newton iteration. Initial value is correct to
+     5 bits. */
+  inv = (3 * ctx->n[0]) ^ 2;
+  for (i = 5; i < GMP_NUMB_BITS; i *= 2)
+    inv = 2*inv - inv*inv*ctx->n[0];
+  ctx->ninv = -inv;
+
+  mpz_init (r);
+  mpz_setbit (r, 2 * n * GMP_NUMB_BITS);
+  mpz_mod (r, r, key->n);
+  mpz_limbs_copy (ctx->n + n, r, n);
+  mpz_clear (r);
+
+  return 1;
+}
+
+void
+rsa_prepared_public_key_clear(struct rsa_prepared_public_key *ctx)
+{
+  gmp_free_limbs (ctx->n, 2*ctx->limbs);
+}
+
+/* Computes r = a b / R mod n, with a, b < n. Result is fully reduced.
+   Needs 2n limbs of scratch, r must not overlap the scratch area. */
+static void
+mont_mul (const struct rsa_prepared_public_key *ctx,
+	  mp_limb_t *rp, const mp_limb_t *ap, const mp_limb_t *bp,
+	  mp_limb_t *tp)
+{
+  const mp_limb_t *np = ctx->n;
+  mp_size_t n = ctx->limbs;
+  mp_size_t i;
+  mp_limb_t hi;
+
+  if (ap == bp)
+    mpn_sqr (tp, ap, n);
+  else
+    mpn_mul_n (tp, ap, bp, n);
+
+  /* Clear the low limbs, one at a time. Each carry limb is stored in
+     the position just cleared, and added in at the end. */
+  for (i = 0; i < n; i++)
+    tp[i] = mpn_addmul_1 (tp + i, np, n, tp[i] * ctx->ninv);
+
+  hi = mpn_add_n (rp, tp + n, tp, n);
+  if (hi || mpn_cmp (rp, np, n) >= 0)
+    mpn_sub_n (rp, rp, np, n);
+}
+
+void
+_rsa_prepared_powm(const struct rsa_prepared_public_key *ctx,
+		   mp_limb_t *rp, const mp_limb_t *sp,
+		   mp_limb_t *scratch)
+{
+#define tp scratch
+#define xp (scratch + 2*n)
+  mp_size_t n = ctx->limbs;
+  unsigned long e = ctx->e;
+  int i;
+
+  /* Left-to-right binary exponentiation, where the top and bottom
+     bits of e are known to be set. For e = 65537, that is 16
+     squarings and a single multiply. */
+  mont_mul (ctx, xp, sp, ctx->n + n, tp);
+  mpn_copyi (rp, xp, n);
+
+  for (i = sizeof (e) * CHAR_BIT - 1; !((e >> i) & 1); i--)
+    ;
+
+  while (--i > 0)
+    {
+      mont_mul (ctx, rp, rp, rp, tp);
+      if ((e >> i) & 1)
+	mont_mul (ctx, rp, rp, xp, tp);
+    }
+  mont_mul (ctx, rp, rp, rp, tp);
+  /* Multiplying by the non-Montgomery s both applies the low bit of e
+     and converts the result out of Montgomery representation. */
+  mont_mul (ctx, rp, rp, sp, tp);
+#undef tp
+#undef xp
+}
+
+int
+rsa_prepared_encrypt(const struct rsa_prepared_public_key *ctx,
+		     void *random_ctx, nettle_random_func *random,
+		     size_t length, const uint8_t *cleartext,
+		     mpz_t cipher)
+{
+  mp_size_t n = ctx->limbs;
+  TMP_DECL(scratch, mp_limb_t, 4*RSA_PREPARED_MAX_LIMBS);
+
+  if (!pkcs1_encrypt (ctx->size, random_ctx, random,
+		      length, cleartext, cipher))
+    return 0;
+
+  TMP_ALLOC(scratch, n + RSA_PREPARED_POWM_ITCH (n));
+
+  mpz_limbs_copy (scratch, cipher, n);
+  _rsa_prepared_powm (ctx, mpz_limbs_write (cipher, n), scratch,
+		      scratch + n);
+  mpz_limbs_finish (cipher, n);
+
+  return 1;
+}
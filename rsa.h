@@ -86,6 +86,12 @@ extern "C" {
 #define rsa_pss_sha512_sign_digest_tr nettle_rsa_pss_sha512_sign_digest_tr
 #define rsa_pss_sha512_verify_digest nettle_rsa_pss_sha512_verify_digest
 #define rsa_encrypt nettle_rsa_encrypt
+#define rsa_prepared_public_key_init nettle_rsa_prepared_public_key_init
+#define rsa_prepared_public_key_clear nettle_rsa_prepared_public_key_clear
+#define rsa_prepared_pkcs1_verify nettle_rsa_prepared_pkcs1_verify
+#define rsa_prepared_pkcs1_verify_batch nettle_rsa_prepared_pkcs1_verify_batch
+#define rsa_prepared_pss_sha256_verify_digest nettle_rsa_prepared_pss_sha256_verify_digest
+#define rsa_prepared_encrypt nettle_rsa_prepared_encrypt
 #define rsa_decrypt nettle_rsa_decrypt
 #define rsa_decrypt_tr nettle_rsa_decrypt_tr
 #define rsa_oaep_sha256_encrypt nettle_rsa_oaep_sha256_encrypt
@@ -392,6 +398,66 @@ rsa_pss_sha512_verify_digest(const struct rsa_public_key *key,
 			     const uint8_t *digest,
 			     const mpz_t signature);
 
+/* Public key operations with precomputed Montgomery state, for
+   repeated use of the same key. Supports public exponents that fit
+   in an unsigned long, and moduli up to RSA_PREPARED_MAX_OCTETS. The
+   exponentiation does no heap allocation. A prepared key is
+   read-only after initialization, and can be shared between
+   threads. */
+
+#define RSA_PREPARED_MAX_OCTETS 2048
+
+struct rsa_prepared_public_key
+{
+  /* Size of the modulo, in octets. */
+  size_t size;
+  /* Size of the modulo, in limbs. */
+  mp_size_t limbs;
+  unsigned long e;
+  /* -n^{-1} mod B, where B is the limb base. */
+  mp_limb_t ninv;
+  /* The modulo n, followed by R^2 mod n, where R = B^limbs. */
+  mp_limb_t *n;
+};
+
+/* Returns 1 on success, and 0 if the key is invalid or not supported,
+   in which case nothing is allocated. The prepared key does not
+   refer to the original key. */
+int
+rsa_prepared_public_key_init(struct rsa_prepared_public_key *ctx,
+			     const struct rsa_public_key *key);
+
+void
+rsa_prepared_public_key_clear(struct rsa_prepared_public_key *ctx);
+
+int
+rsa_prepared_pkcs1_verify(const struct rsa_prepared_public_key *ctx,
+			  size_t length, const uint8_t *digest_info,
+			  const mpz_t signature);
+
+/* Verifies count signatures, each ctx->size octets in big-endian
+   order, of the corresponding digest_info, each length
+   octets. Returns 1 if all signatures are valid. If valid is
+   non-NULL, the result for each signature is stored in valid[i]. */
+int
+rsa_prepared_pkcs1_verify_batch(const struct rsa_prepared_public_key *ctx,
+				size_t count,
+				size_t length, const uint8_t *digest_infos,
+				const uint8_t *signatures,
+				int *valid);
+
+int
+rsa_prepared_pss_sha256_verify_digest(const struct rsa_prepared_public_key *ctx,
+				      size_t salt_length,
+				      const uint8_t *digest,
+				      const mpz_t signature);
+
+int
+rsa_prepared_encrypt(const struct rsa_prepared_public_key *ctx,
+		     void *random_ctx, nettle_random_func *random,
+		     size_t length, const uint8_t *cleartext,
+		     mpz_t cipher);
+
 
 /* RSA encryption, using PKCS#1 */
 
@@ -0,0 +1,335 @@
+/* sexp-index.c
+
+   Index for random access to lists in large s-expressions.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sexp.h"
+
+#include "buffer.h"
+#include "macros.h"
+
+/* Serialized format, all numbers are 32-bit big-endian:
+
+     Header:   magic, data length, number of lists, table size
+     Entries:  start, length, parent, expression hash, head hash
+     Tables:   expression table, followed by assoc table
+
+   Entries are stored in the order of the lists' start positions.
+   Tables use linear probing, and each slot holds an entry number
+   plus one, or zero for an empty slot. A head hash of zero means
+   that the list doesn't start with a plain atom. */
+
+#define SEXP_INDEX_MAGIC 0x73786931 /* "sxi1" */
+#define HEADER_SIZE 16
+#define ENTRY_SIZE 20
+
+#define ENTRY_START 0
+#define ENTRY_LENGTH 4
+#define ENTRY_PARENT 8
+#define ENTRY_EXPR_HASH 12
+#define ENTRY_HEAD_HASH 16
+
+/* Limit on the number of lists, so that the table size, a power of
+   two at least twice the count, fits in 32 bits. */
+#define MAX_COUNT ((uint32_t) 1 << 30)
+
+/* FNV-1a. Collisions only affect speed, since all matches are
+   verified. */
+static uint32_t
+sexp_index_hash(size_t length, const uint8_t *data)
+{
+  uint32_t h = 0x811c9dc5;
+  size_t i;
+  for (i = 0; i < length; i++)
+    h = (h ^ data[i]) * 0x01000193;
+  return h;
+}
+
+static uint32_t
+sexp_index_assoc_hash(uint32_t parent, uint32_t head_hash)
+{
+  return head_hash ^ ((parent + 1) * 0x9e3779b9);
+}
+
+static const uint8_t *
+sexp_index_entry(const struct sexp_index *index, uint32_t id)
+{
+  return index->entries + (size_t) id * ENTRY_SIZE;
+}
+
+static void
+sexp_index_insert(uint8_t *table, uint32_t mask, uint32_t hash, uint32_t id)
+{
+  uint32_t i;
+  for (i = hash & mask; READ_UINT32 (table + 4*i); i = (i + 1) & mask)
+    ;
+  WRITE_UINT32 (table + 4*i, id + 1);
+}
+
+int
+sexp_index_build(struct nettle_buffer *buffer,
+		 size_t length, const uint8_t *data)
+{
+  struct sexp_iterator i;
+  size_t base = buffer->size;
+  uint32_t count, current, size, id;
+  uint8_t *p;
+
+  if (length >= SEXP_INDEX_ROOT)
+    return 0;
+
+  if (!nettle_buffer_space (buffer, HEADER_SIZE)
+      || !sexp_iterator_first (&i, length, data))
+    goto fail;
+
+  for (count = 0, current = SEXP_INDEX_ROOT;;)
+    switch (i.type)
+      {
+      case SEXP_LIST:
+	if (count >= MAX_COUNT)
+	  goto fail;
+	p = nettle_buffer_space (buffer, ENTRY_SIZE);
+	if (!p)
+	  goto fail;
+
+	WRITE_UINT32 (p + ENTRY_START, i.start);
+	WRITE_UINT32 (p + ENTRY_PARENT, current);
+	current = count++;
+
+	if (!sexp_iterator_enter_list (&i))
+	  goto fail;
+
+	if (i.type == SEXP_ATOM && !i.display)
+	  {
+	    uint32_t h = sexp_index_hash (i.atom_length, i.atom);
+	    WRITE_UINT32 (p + ENTRY_HEAD_HASH, h ? h : 1);
+	  }
+	else
+	  WRITE_UINT32 (p + ENTRY_HEAD_HASH, 0);
+	break;
+
+      case SEXP_ATOM:
+	if (!sexp_iterator_next (&i))
+	  goto fail;
+	break;
+
+      case SEXP_END:
+	if (!i.level)
+	  goto done;
+
+	p = buffer->contents + base + HEADER_SIZE
+	  + (size_t) current * ENTRY_SIZE;
+	{
+	  uint32_t start = READ_UINT32 (p + ENTRY_START);
+	  WRITE_UINT32 (p + ENTRY_LENGTH, i.pos - start);
+	  WRITE_UINT32 (p + ENTRY_EXPR_HASH,
+			sexp_index_hash (i.pos - start, data + start));
+	}
+	current = READ_UINT32 (p + ENTRY_PARENT);
+
+	if (!sexp_iterator_exit_list (&i))
+	  goto fail;
+	break;
+
+      default:
+	abort ();
+      }
+ done:
+  /* Tables at most half full. */
+  for (size = 2; size < 2 * count; size <<= 1)
+    ;
+  p = nettle_buffer_space (buffer, 8 * (size_t) size);
+  if (!p)
+    goto fail;
+  memset (p, 0, 8 * (size_t) size);
+
+  p = buffer->contents + base;
+  WRITE_UINT32 (p, SEXP_INDEX_MAGIC);
+  WRITE_UINT32 (p + 4, length);
+  WRITE_UINT32 (p + 8, count);
+  WRITE_UINT32 (p + 12, size);
+
+  for (id = 0; id < count; id++)
+    {
+      const uint8_t *entry = p + HEADER_SIZE + (size_t) id * ENTRY_SIZE;
+      uint8_t *table = p + HEADER_SIZE + (size_t) count * ENTRY_SIZE;
+      uint32_t head_hash = READ_UINT32 (entry + ENTRY_HEAD_HASH);
+
+      sexp_index_insert (table, size - 1,
+			 READ_UINT32 (entry + ENTRY_EXPR_HASH), id);
+      if (head_hash)
+	sexp_index_insert (table + 4 * (size_t) size, size - 1,
+			   sexp_index_assoc_hash (
+			     READ_UINT32 (entry + ENTRY_PARENT), head_hash),
+			   id);
+    }
+  return 1;
+
+ fail:
+  /* Don't leave a partial index in the buffer. */
+  buffer->size = base;
+  return 0;
+}
+
+int
+sexp_index_init(struct sexp_index *index,
+		size_t index_length, const uint8_t *index_data,
+		size_t length, const uint8_t *data)
+{
+  uint32_t count, size, id;
+  int expr_empty, assoc_empty;
+
+  if (index_length < HEADER_SIZE
+      || READ_UINT32 (index_data) != SEXP_INDEX_MAGIC
+      || READ_UINT32 (index_data + 4) != length)
+    return 0;
+
+  count = READ_UINT32 (index_data + 8);
+  size = READ_UINT32 (index_data + 12);
+  if (count >= MAX_COUNT || size < 2 * count
+      || (size & (size - 1))
+      || index_length != HEADER_SIZE + (size_t) count * ENTRY_SIZE
+      + 8 * (size_t) size)
+    return 0;
+
+  index->length = length;
+  index->data = data;
+  index->count = count;
+  index->mask = size - 1;
+  index->entries = index_data + HEADER_SIZE;
+  index->expr_table = index->entries + (size_t) count * ENTRY_SIZE;
+  index->assoc_table = index->expr_table + 4 * (size_t) size;
+
+  /* Validate entries and tables, so that lookups can trust them. */
+  for (id = 0; id < count; id++)
+    {
+      const uint8_t *entry = sexp_index_entry (index, id);
+      uint32_t start = READ_UINT32 (entry + ENTRY_START);
+      uint32_t parent = READ_UINT32 (entry + ENTRY_PARENT);
+      if (start >= length
+	  || READ_UINT32 (entry + ENTRY_LENGTH) > length - start
+	  || data[start] != '('
+	  || (parent != SEXP_INDEX_ROOT && parent >= id))
+	return 0;
+    }
+  for (id = expr_empty = assoc_empty = 0; id < size; id++)
+    {
+      uint32_t expr_slot = READ_UINT32 (index->expr_table + 4 * (size_t) id);
+      uint32_t assoc_slot = READ_UINT32 (index->assoc_table + 4 * (size_t) id);
+      if (expr_slot > count || assoc_slot > count)
+	return 0;
+      expr_empty |= !expr_slot;
+      assoc_empty |= !assoc_slot;
+    }
+  /* An empty slot in each table guarantees that probing
+     terminates. */
+  return expr_empty && assoc_empty;
+}
+
+uint32_t
+sexp_index_parent(const struct sexp_index *index, uint32_t id)
+{
+  return READ_UINT32 (sexp_index_entry (index, id) + ENTRY_PARENT);
+}
+
+int
+sexp_index_iterator(const struct sexp_index *index, uint32_t id,
+		    struct sexp_iterator *iterator)
+{
+  const uint8_t *entry = sexp_index_entry (index, id);
+  return sexp_iterator_first (iterator,
+			      READ_UINT32 (entry + ENTRY_LENGTH),
+			      index->data + READ_UINT32 (entry + ENTRY_START));
+}
+
+int
+sexp_index_lookup(const struct sexp_index *index,
+		  size_t length, const uint8_t *expr, uint32_t *id)
+{
+  uint32_t hash = sexp_index_hash (length, expr);
+  uint32_t i, slot;
+
+  for (i = hash & index->mask;
+       (slot = READ_UINT32 (index->expr_table + 4*i));
+       i = (i + 1) & index->mask)
+    {
+      const uint8_t *entry = sexp_index_entry (index, slot - 1);
+      if (READ_UINT32 (entry + ENTRY_EXPR_HASH) == hash
+	  && READ_UINT32 (entry + ENTRY_LENGTH) == length
+	  && !memcmp (index->data + READ_UINT32 (entry + ENTRY_START),
+		      expr, length))
+	{
+	  *id = slot - 1;
+	  return 1;
+	}
+    }
+  return 0;
+}
+
+int
+sexp_index_assoc(const struct sexp_index *index, uint32_t parent,
+		 const char *key, uint32_t *id)
+{
+  size_t key_length = strlen (key);
+  uint32_t head_hash = sexp_index_hash (key_length, (const uint8_t *) key);
+  uint32_t i, slot;
+
+  if (!head_hash)
+    head_hash = 1;
+
+  for (i = sexp_index_assoc_hash (parent, head_hash) & index->mask;
+       (slot = READ_UINT32 (index->assoc_table + 4*i));
+       i = (i + 1) & index->mask)
+    {
+      const uint8_t *entry = sexp_index_entry (index, slot - 1);
+      struct sexp_iterator iterator;
+
+      if (READ_UINT32 (entry + ENTRY_HEAD_HASH) == head_hash
+	  && READ_UINT32 (entry + ENTRY_PARENT) == parent
+	  && sexp_index_iterator (index, slot - 1, &iterator)
+	  && sexp_iterator_enter_list (&iterator)
+	  && iterator.type == SEXP_ATOM && !iterator.display
+	  && iterator.atom_length == key_length
+	  && !memcmp (iterator.atom, key, key_length))
+	{
+	  *id = slot - 1;
+	  return 1;
+	}
+    }
+  return 0;
+}
@@ -0,0 +1,289 @@
+/* sexp-stream.c
+
+   Incremental parsing of canonical s-expressions.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "sexp.h"
+
+/* Parser states, between calls. */
+enum {
+  /* Expecting the start of a new element, or end of list. */
+  SEXP_STREAM_START,
+  /* Expecting first digit of the length of a display type. */
+  SEXP_STREAM_DISPLAY,
+  /* Expecting first digit of the atom length, after a display
+     type. */
+  SEXP_STREAM_ATOM,
+  /* Reading length digits. */
+  SEXP_STREAM_LENGTH,
+  /* Seen a length of "0", expecting ':'. */
+  SEXP_STREAM_ZERO,
+  /* Inside string contents. */
+  SEXP_STREAM_STRING,
+  /* After display type, expecting ']'. */
+  SEXP_STREAM_DISPLAY_END,
+  /* After a syntax error. */
+  SEXP_STREAM_FAILED,
+};
+
+/* Transport decoding states. */
+enum {
+  SEXP_STREAM_TRANSPORT_SPACE,
+  SEXP_STREAM_TRANSPORT_COMMENT,
+  SEXP_STREAM_TRANSPORT_CODED,
+};
+
+void
+sexp_stream_parser_init(struct sexp_stream_parser *parser)
+{
+  parser->length = parser->pos = 0;
+  parser->buffer = NULL;
+  parser->level = 0;
+  parser->state = SEXP_STREAM_START;
+  parser->count = 0;
+  parser->transport_state = SEXP_STREAM_TRANSPORT_SPACE;
+  parser->type = SEXP_END; /* Value doesn't matter */
+  parser->display = 0;
+  parser->atom_length = 0;
+  parser->atom = NULL;
+  parser->remaining = 0;
+}
+
+void
+sexp_stream_parser_input(struct sexp_stream_parser *parser,
+			 size_t length, const uint8_t *data)
+{
+  /* All of the previous input must be consumed. */
+  assert (parser->pos == parser->length);
+  parser->length = length;
+  parser->buffer = data;
+  parser->pos = 0;
+}
+
+/* Digits of a string length. Returns 0 on overflow. */
+static int
+sexp_stream_add_digit(struct sexp_stream_parser *parser, unsigned digit)
+{
+  if (parser->count > (~(size_t) 0) / 10)
+    return 0;
+  parser->count = parser->count * 10 + digit;
+  return parser->count >= digit;
+}
+
+int
+sexp_stream_parser_next(struct sexp_stream_parser *parser)
+{
+  if (parser->state == SEXP_STREAM_FAILED)
+    return SEXP_STREAM_ERROR;
+
+  for (;;)
+    {
+      uint8_t c;
+      if (parser->state == SEXP_STREAM_STRING)
+	{
+	  size_t left = parser->length - parser->pos;
+	  size_t n = parser->remaining < left ? parser->remaining : left;
+
+	  /* Empty strings are reported as a single empty fragment, but
+	     otherwise, wait for more data. */
+	  if (!n && parser->remaining)
+	    break;
+
+	  parser->type = SEXP_ATOM;
+	  parser->atom = parser->buffer + parser->pos;
+	  parser->atom_length = n;
+	  parser->pos += n;
+	  parser->remaining -= n;
+
+	  if (!parser->remaining)
+	    parser->state = parser->display
+	      ? SEXP_STREAM_DISPLAY_END : SEXP_STREAM_START;
+	  return SEXP_STREAM_EVENT;
+	}
+      if (parser->pos == parser->length)
+	break;
+
+      c = parser->buffer[parser->pos++];
+      switch (parser->state)
+	{
+	case SEXP_STREAM_START:
+	  parser->display = 0;
+	  switch (c)
+	    {
+	    case '(':
+	      parser->level++;
+	      parser->type = SEXP_LIST;
+	      return SEXP_STREAM_EVENT;
+	    case ')':
+	      if (!parser->level)
+		goto fail;
+	      parser->level--;
+	      parser->type = SEXP_END;
+	      return SEXP_STREAM_EVENT;
+	    case '[':
+	      parser->display = 1;
+	      parser->state = SEXP_STREAM_DISPLAY;
+	      break;
+	    default:
+	      goto atom;
+	    }
+	  break;
+
+	case SEXP_STREAM_DISPLAY:
+	case SEXP_STREAM_ATOM:
+	atom:
+	  if (c == '0')
+	    parser->state = SEXP_STREAM_ZERO;
+	  else if (c >= '1' && c <= '9')
+	    {
+	      parser->count = c - '0';
+	      parser->state = SEXP_STREAM_LENGTH;
+	    }
+	  else
+	    goto fail;
+	  break;
+
+	case SEXP_STREAM_LENGTH:
+	  if (c >= '0' && c <= '9')
+	    {
+	      if (!sexp_stream_add_digit (parser, c - '0'))
+		goto fail;
+	      break;
+	    }
+	  if (c != ':')
+	    goto fail;
+	  parser->remaining = parser->count;
+	  parser->state = SEXP_STREAM_STRING;
+	  break;
+
+	case SEXP_STREAM_ZERO:
+	  if (c != ':')
+	    goto fail;
+	  parser->remaining = 0;
+	  parser->state = SEXP_STREAM_STRING;
+	  break;
+
+	case SEXP_STREAM_DISPLAY_END:
+	  if (c != ']')
+	    goto fail;
+	  parser->display = 0;
+	  parser->state = SEXP_STREAM_ATOM;
+	  break;
+
+	default:
+	  abort ();
+	}
+    }
+  return SEXP_STREAM_MORE;
+
+ fail:
+  parser->state = SEXP_STREAM_FAILED;
+  return SEXP_STREAM_ERROR;
+}
+
+int
+sexp_stream_parser_final(const struct sexp_stream_parser *parser)
+{
+  return parser->pos == parser->length
+    && parser->state == SEXP_STREAM_START && !parser->level
+    && parser->transport_state != SEXP_STREAM_TRANSPORT_CODED;
+}
+
+int
+sexp_stream_parser_transport_input(struct sexp_stream_parser *parser,
+				   size_t length, uint8_t *data)
+{
+  size_t in, out;
+
+  for (in = out = 0; in < length; )
+    switch (parser->transport_state)
+      {
+      case SEXP_STREAM_TRANSPORT_SPACE:
+	switch (data[in++])
+	  {
+	  case ' ':  /* SPC, TAB, LF, CR */
+	  case '\t':
+	  case '\n':
+	  case '\r':
+	    break;
+	  case ';':
+	    parser->transport_state = SEXP_STREAM_TRANSPORT_COMMENT;
+	    break;
+	  case '{':
+	    base64_decode_init (&parser->base64);
+	    parser->transport_state = SEXP_STREAM_TRANSPORT_CODED;
+	    break;
+	  default:
+	    return 0;
+	  }
+	break;
+
+      case SEXP_STREAM_TRANSPORT_COMMENT:
+	if (data[in++] == '\n')
+	  parser->transport_state = SEXP_STREAM_TRANSPORT_SPACE;
+	break;
+
+      case SEXP_STREAM_TRANSPORT_CODED:
+	{
+	  size_t end, done;
+	  for (end = in; end < length && data[end] != '}'; end++)
+	    ;
+
+	  /* Decodes in place, output never overtakes input. */
+	  done = BASE64_DECODE_LENGTH (end - in);
+	  if (!base64_decode_update (&parser->base64, &done, data + out,
+				     end - in, (const char *) data + in))
+	    return 0;
+	  out += done;
+	  in = end;
+	  if (in < length)
+	    {
+	      if (!base64_decode_final (&parser->base64))
+		return 0;
+	      in++;
+	      parser->transport_state = SEXP_STREAM_TRANSPORT_SPACE;
+	    }
+	  break;
+	}
+      default:
+	abort ();
+      }
+
+  sexp_stream_parser_input (parser, out, data);
+  return 1;
+}
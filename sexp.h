@@ -35,6 +35,7 @@
 
 #include <stdarg.h>
 #include "nettle-types.h"
+#include "base64.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +57,17 @@ extern "C" {
 #define sexp_transport_format nettle_sexp_transport_format
 #define sexp_transport_vformat nettle_sexp_transport_vformat
 #define sexp_token_chars nettle_sexp_token_chars
+#define sexp_stream_parser_init nettle_sexp_stream_parser_init
+#define sexp_stream_parser_input nettle_sexp_stream_parser_input
+#define sexp_stream_parser_transport_input nettle_sexp_stream_parser_transport_input
+#define sexp_stream_parser_next nettle_sexp_stream_parser_next
+#define sexp_stream_parser_final nettle_sexp_stream_parser_final
+#define sexp_index_build nettle_sexp_index_build
+#define sexp_index_init nettle_sexp_index_init
+#define sexp_index_parent nettle_sexp_index_parent
+#define sexp_index_iterator nettle_sexp_index_iterator
+#define sexp_index_lookup nettle_sexp_index_lookup
+#define sexp_index_assoc nettle_sexp_index_assoc
 
 enum sexp_type
   { SEXP_ATOM, SEXP_LIST, SEXP_END };
@@ -145,12 +157,143 @@ sexp_iterator_assoc(struct sexp_iterator *iterator,
 		    struct sexp_iterator *values);
 
 
-/* Output functions. What is a reasonable API for this? It seems
- * ugly to have to reimplement string streams. */
+/* Incremental parsing of canonical s-expressions, supplied in
+ * arbitrarily sized chunks, e.g., file blocks, or all at once, e.g.,
+ * an mmapped file. Atoms are not copied; a string is reported as one
+ * or more SEXP_ATOM fragments pointing into the input, where the
+ * fragment boundaries depend on the chunk boundaries. */
+
+/* Return values for sexp_stream_parser_next. */
+enum sexp_stream_result
+  { SEXP_STREAM_ERROR = -1, SEXP_STREAM_MORE = 0, SEXP_STREAM_EVENT = 1 };
+
+struct sexp_stream_parser
+{
+  /* Current input chunk */
+  size_t length;
+  const uint8_t *buffer;
+  size_t pos;
+
+  /* Nesting level after the current event. */
+  unsigned level;
+
+  /* Internal state */
+  int state;
+  size_t count;
+  int transport_state;
+  struct base64_decode_ctx base64;
+
+  /* Current event. SEXP_LIST for start of a list, SEXP_END for end
+   * of a list, and SEXP_ATOM for a string fragment. */
+  enum sexp_type type;
+  /* Non-zero if the fragment belongs to a display type, which is
+   * followed by fragments of the corresponding atom. */
+  int display;
+  size_t atom_length;
+  const uint8_t *atom;
+  /* Number of octets of the current string still to come in later
+   * fragments. Zero for the final fragment of a string. */
+  size_t remaining;
+};
+
+void
+sexp_stream_parser_init(struct sexp_stream_parser *parser);
+
+/* Supplies the next chunk of input. The data must be kept valid
+ * until sexp_stream_parser_next returns SEXP_STREAM_MORE. */
+void
+sexp_stream_parser_input(struct sexp_stream_parser *parser,
+			 size_t length, const uint8_t *data);
+
+/* Like sexp_stream_parser_input, but for input in transport
+ * encoding, i.e., base64 coded expressions enclosed in {}, separated
+ * by white space or comments. NOTE: Decodes the input chunk in
+ * place. Returns 1 on success, 0 on invalid input. */
+int
+sexp_stream_parser_transport_input(struct sexp_stream_parser *parser,
+				   size_t length, uint8_t *data);
+
+/* Returns SEXP_STREAM_EVENT when the next event has been stored in
+ * the parser struct, SEXP_STREAM_MORE when all input is consumed, or
+ * SEXP_STREAM_ERROR on syntax errors. */
+int
+sexp_stream_parser_next(struct sexp_stream_parser *parser);
+
+/* Returns 1 if all input is consumed, and ends with one or more
+ * complete expressions, otherwise 0. */
+int
+sexp_stream_parser_final(const struct sexp_stream_parser *parser);
+
+
+/* Index for constant time lookup of lists in a large canonical
+ * s-expression, e.g., a key ring. The index is built in a single
+ * pass, and it is serialized in a portable format, so it can be
+ * stored next to the data and mmapped. Lists are identified by
+ * number, in the order they appear in the data. Limited to data of
+ * size less than 4 GB. */
+
+/* Parent of top-level lists. */
+#define SEXP_INDEX_ROOT 0xffffffffU
 
 /* Declared for real in buffer.h */
 struct nettle_buffer;
 
+struct sexp_index
+{
+  size_t length;
+  const uint8_t *data;
+
+  uint32_t count;
+  uint32_t mask;
+  const uint8_t *entries;
+  const uint8_t *expr_table;
+  const uint8_t *assoc_table;
+};
+
+/* Builds an index for the data, appending it to BUFFER. Returns 1 on
+ * success, 0 on syntax error, out of memory, or if the data is too
+ * large for the 32-bit format: 2^32 - 1 octets or more, or 2^30
+ * lists or more. */
+int
+sexp_index_build(struct nettle_buffer *buffer,
+		 size_t length, const uint8_t *data);
+
+/* Sets up an index, from an index previously built for the same
+ * data. Both areas must stay valid as long as the index is used.
+ * Returns 0 if the index is malformed or doesn't match the data. */
+int
+sexp_index_init(struct sexp_index *index,
+		size_t index_length, const uint8_t *index_data,
+		size_t length, const uint8_t *data);
+
+/* Returns the number of the enclosing list, or SEXP_INDEX_ROOT. */
+uint32_t
+sexp_index_parent(const struct sexp_index *index, uint32_t id);
+
+/* Initializes an iterator pointing at the given list. */
+int
+sexp_index_iterator(const struct sexp_index *index, uint32_t id,
+		    struct sexp_iterator *iterator);
+
+/* Looks up a list with the given canonical encoding. E.g., to find
+ * the key with a given public value n, look up "(1:n<length>:<n>)",
+ * and follow parent links. If there are several matching lists, one
+ * of them is returned. */
+int
+sexp_index_lookup(const struct sexp_index *index,
+		  size_t length, const uint8_t *expr, uint32_t *id);
+
+/* Looks up a list of the form (key ...), directly contained in the
+ * list PARENT, or at top level if PARENT is SEXP_INDEX_ROOT. The
+ * constant time analogue of sexp_iterator_assoc. */
+int
+sexp_index_assoc(const struct sexp_index *index, uint32_t parent,
+		 const char *key, uint32_t *id);
+
+
+/* Output functions. What is a reasonable API for this? It seems
+ * ugly to have to reimplement string streams. */
+
 /* Returns the number of output characters, or 0 on out of memory. If
  * buffer == NULL, just compute length.
  *
@@ -43,6 +43,12 @@ const uint8_t *
 _nettle_sha256_compress_n(uint32_t *state, const uint32_t *k,
 			  size_t blocks, const uint8_t *data);
 
+/* Four independent compressions, of one block each. STATE points to
+   4 consecutive states of 8 uint32_t words, and INPUT points to 4
+   consecutive blocks of 64 bytes, possibly unaligned. */
+void
+_nettle_sha256_compress_x4(uint32_t *state, const uint8_t *input);
+
 /* Internal compression function. STATE points to 8 uint64_t words,
    DATA points to 128 bytes of input data, possibly unaligned, and K
    points to the table of constants. */
@@ -45,12 +45,14 @@ extern "C" {
 #define sha224_digest nettle_sha224_digest
 #define sha256_init nettle_sha256_init
 #define sha256_update nettle_sha256_update
+#define sha256_update_iov nettle_sha256_update_iov
 #define sha256_digest nettle_sha256_digest
 #define sha256_compress nettle_sha256_compress
 #define sha384_init nettle_sha384_init
 #define sha384_digest nettle_sha384_digest
 #define sha512_init nettle_sha512_init
 #define sha512_update nettle_sha512_update
+#define sha512_update_iov nettle_sha512_update_iov
 #define sha512_digest nettle_sha512_digest
 #define sha512_compress nettle_sha512_compress
 #define sha512_224_init   nettle_sha512_224_init
@@ -82,6 +84,11 @@ sha256_update(struct sha256_ctx *ctx,
 	      size_t length,
 	      const uint8_t *data);
 
+/* Same as calling sha256_update for each fragment. */
+void
+sha256_update_iov(struct sha256_ctx *ctx,
+		  size_t count, const struct nettle_iov *iov);
+
 void
 sha256_digest(struct sha256_ctx *ctx,
 	      uint8_t *digest);
@@ -99,6 +106,7 @@ void
 sha224_init(struct sha256_ctx *ctx);
 
 #define sha224_update nettle_sha256_update
+#define sha224_update_iov nettle_sha256_update_iov
 
 void
 sha224_digest(struct sha256_ctx *ctx,
@@ -129,6 +137,11 @@ sha512_update(struct sha512_ctx *ctx,
 	      size_t length,
 	      const uint8_t *data);
 
+/* Same as calling sha512_update for each fragment. */
+void
+sha512_update_iov(struct sha512_ctx *ctx,
+		  size_t count, const struct nettle_iov *iov);
+
 void
 sha512_digest(struct sha512_ctx *ctx,
 	      uint8_t *digest);
@@ -146,6 +159,7 @@ void
 sha384_init(struct sha512_ctx *ctx);
 
 #define sha384_update nettle_sha512_update
+#define sha384_update_iov nettle_sha512_update_iov
 
 void
 sha384_digest(struct sha512_ctx *ctx,
@@ -77,6 +77,25 @@ sha256_compress(uint32_t *state, const uint8_t *input)
   _nettle_sha256_compress_n(state, K, 1, input);
 }
 
+/* For fat builds */
+#if HAVE_NATIVE_sha256_compress_x4
+void
+_nettle_sha256_compress_x4_c(uint32_t *state, const uint8_t *input);
+# define _nettle_sha256_compress_x4 _nettle_sha256_compress_x4_c
+#endif
+
+/* One block at a time, which is the best choice if the serial
+   compression function is fast, e.g., using the sha_ni
+   instructions. */
+void
+_nettle_sha256_compress_x4(uint32_t *state, const uint8_t *input)
+{
+  unsigned i;
+  for (i = 0; i < 4; i++)
+    _nettle_sha256_compress_n(state + i * _SHA256_DIGEST_LENGTH, K, 1,
+			      input + i * SHA256_BLOCK_SIZE);
+}
+
 #define COMPRESS(ctx, data) (sha256_compress((ctx)->state, (data)))
 
 /* Initialize the SHA values */
@@ -125,6 +144,15 @@ sha256_update(struct sha256_ctx *ctx,
   ctx->index = length;
 }
 
+void
+sha256_update_iov(struct sha256_ctx *ctx,
+		  size_t count, const struct nettle_iov *iov)
+{
+  size_t i;
+  for (i = 0; i < count; i++)
+    sha256_update (ctx, iov[i].length, iov[i].data);
+}
+
 static void
 sha256_write_digest(struct sha256_ctx *ctx,
 		    size_t length,
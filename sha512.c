@@ -151,6 +151,15 @@ sha512_update(struct sha512_ctx *ctx,
   MD_UPDATE (ctx, length, data, COMPRESS, MD_INCR(ctx));
 }
 
+void
+sha512_update_iov(struct sha512_ctx *ctx,
+		  size_t count, const struct nettle_iov *iov)
+{
+  size_t i;
+  for (i = 0; i < count; i++)
+    sha512_update (ctx, iov[i].length, iov[i].data);
+}
+
 static void
 sha512_write_digest(struct sha512_ctx *ctx,
 		    size_t length,
@@ -41,6 +41,7 @@
 #include "aes.h"
 #include "siv-cmac.h"
 #include "cmac.h"
+#include "cmac-internal.h"
 #include "ctr.h"
 #include "memxor.h"
 #include "memops.h"
@@ -57,30 +58,36 @@ _siv_s2v (const struct nettle_cipher *nc,
 	  size_t nlength, const uint8_t * nonce,
 	  size_t plength, const uint8_t * pdata, uint8_t * v)
 {
-  union nettle_block16 D, S, T;
+  union nettle_block16 D, S[3], T;
   static const union nettle_block16 const_zero = {.b = 0 };
-  struct cmac128_ctx cmac_ctx;
+  struct cmac128_ctx cmac_ctx[4];
+  struct nettle_iov msgs[4];
+  unsigned i;
   assert (nlength >= SIV_MIN_NONCE_SIZE);
 
-  cmac128_init(&cmac_ctx);
-  cmac128_update (&cmac_ctx, cmac_cipher, nc->encrypt, 16, const_zero.b);
-  cmac128_digest (&cmac_ctx, cmac_key, cmac_cipher, nc->encrypt, D.b);
+  /* The CMACs of the zero block, the associated data and the nonce
+     are independent, and so is the bulk of the plaintext, up to its
+     last block. Process all four together. */
+  msgs[0].length = 16; msgs[0].data = const_zero.b;
+  msgs[1].length = alength; msgs[1].data = adata;
+  msgs[2].length = nlength; msgs[2].data = nonce;
+  msgs[3].length = plength >= 16 ? plength - 16 : 0; msgs[3].data = pdata;
 
-  block16_mulx_be (&D, &D);
-  cmac128_update (&cmac_ctx, cmac_cipher, nc->encrypt, alength, adata);
-  cmac128_digest (&cmac_ctx, cmac_key, cmac_cipher, nc->encrypt, S.b);
-  block16_xor (&D, &S);
+  for (i = 0; i < 4; i++)
+    cmac128_init (&cmac_ctx[i]);
+
+  _cmac128_update_lanes (cmac_cipher, nc->encrypt, 4, cmac_ctx, msgs);
+  _cmac128_digest_lanes (cmac_key, cmac_cipher, nc->encrypt,
+			 3, cmac_ctx, S[0].b);
 
+  block16_mulx_be (&D, &S[0]);
+  block16_xor (&D, &S[1]);
   block16_mulx_be (&D, &D);
-  cmac128_update (&cmac_ctx, cmac_cipher, nc->encrypt, nlength, nonce);
-  cmac128_digest (&cmac_ctx, cmac_key, cmac_cipher, nc->encrypt, S.b);
-  block16_xor (&D, &S);
+  block16_xor (&D, &S[2]);
 
   /* Sn */
   if (plength >= 16)
     {
-      cmac128_update (&cmac_ctx, cmac_cipher, nc->encrypt, plength - 16, pdata);
-
       pdata += plength - 16;
 
       block16_xor_bytes (&T, &D, pdata);
@@ -98,8 +105,8 @@ _siv_s2v (const struct nettle_cipher *nc,
       block16_xor (&T, &pad);
     }
 
-  cmac128_update (&cmac_ctx, cmac_cipher, nc->encrypt, 16, T.b);
-  cmac128_digest (&cmac_ctx, cmac_key, cmac_cipher, nc->encrypt, v);
+  cmac128_update (&cmac_ctx[3], cmac_cipher, nc->encrypt, 16, T.b);
+  cmac128_digest (&cmac_ctx[3], cmac_key, cmac_cipher, nc->encrypt, v);
 }
 
 void
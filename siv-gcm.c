@@ -46,6 +46,10 @@
 
 #define MIN(a,b) (((a) < (b)) ? (a) : (b))
 
+/* Decryption alternates between the CTR and POLYVAL passes, one chunk
+   at a time. Must be a multiple of the block size. */
+#define SIV_GCM_CHUNK_SIZE 2048
+
 static void
 siv_gcm_derive_keys (const void *ctx,
 		     nettle_cipher_func *f,
@@ -119,6 +123,29 @@ siv_ghash_pad_update (struct gcm_key *ctx,
     }
 }
 
+/* Completes the POLYVAL computation, and computes the tag. */
+static void
+siv_gcm_tag (const void *ctx,
+	     const struct nettle_cipher *nc,
+	     const struct gcm_key *siv_ghash_key,
+	     union nettle_block16 *state,
+	     const uint8_t *nonce,
+	     size_t alength, size_t mlength,
+	     uint8_t *tag)
+{
+  union nettle_block16 block;
+
+  block.u64[0] = bswap64_if_be (alength * 8);
+  block.u64[1] = bswap64_if_be (mlength * 8);
+
+  _siv_ghash_update (siv_ghash_key, state, 1, block.b);
+  block16_bswap (state, state);
+
+  memxor (state->b, nonce, SIV_GCM_NONCE_SIZE);
+  state->b[15] &= 0x7f;
+  nc->encrypt (ctx, SIV_GCM_BLOCK_SIZE, tag, state->b);
+}
+
 static void
 siv_gcm_authenticate (const void *ctx,
 		      const struct nettle_cipher *nc,
@@ -130,7 +157,6 @@ siv_gcm_authenticate (const void *ctx,
 {
   union nettle_block16 state;
   struct gcm_key siv_ghash_key;
-  union nettle_block16 block;
 
   _siv_ghash_set_key (&siv_ghash_key, authentication_key);
 
@@ -138,15 +164,8 @@ siv_gcm_authenticate (const void *ctx,
   siv_ghash_pad_update (&siv_ghash_key, &state, alength, adata);
   siv_ghash_pad_update (&siv_ghash_key, &state, mlength, mdata);
 
-  block.u64[0] = bswap64_if_be (alength * 8);
-  block.u64[1] = bswap64_if_be (mlength * 8);
-
-  _siv_ghash_update (&siv_ghash_key, &state, 1, block.b);
-  block16_bswap (&state, &state);
-
-  memxor (state.b, nonce, SIV_GCM_NONCE_SIZE);
-  state.b[15] &= 0x7f;
-  nc->encrypt (ctx, SIV_GCM_BLOCK_SIZE, tag, state.b);
+  siv_gcm_tag (ctx, nc, &siv_ghash_key, &state, nonce,
+	       alength, mlength, tag);
 }
 
 void
@@ -198,8 +217,11 @@ siv_gcm_decrypt_message (const struct nettle_cipher *nc,
 {
   union nettle_block16 authentication_key;
   TMP_DECL(encryption_key, uint8_t, NETTLE_MAX_CIPHER_KEY_SIZE);
+  struct gcm_key siv_ghash_key;
+  union nettle_block16 ctr;
   union nettle_block16 state;
   uint8_t tag[SIV_GCM_DIGEST_SIZE];
+  size_t done;
 
   assert (nlength == SIV_GCM_NONCE_SIZE);
 
@@ -207,23 +229,33 @@ siv_gcm_decrypt_message (const struct nettle_cipher *nc,
   siv_gcm_derive_keys (ctx, nc->encrypt, nc->key_size, nlength, nonce,
 		       &authentication_key, encryption_key);
 
-  memcpy (state.b, src + mlength, SIV_GCM_DIGEST_SIZE);
+  memcpy (ctr.b, src + mlength, SIV_GCM_DIGEST_SIZE);
   /* The initial counter block is the tag with the most significant
      bit of the last byte set to one.  */
-  state.b[15] |= 0x80;
+  ctr.b[15] |= 0x80;
 
-  /* Decrypt the ciphertext.  */
+  /* Decrypt the ciphertext, and authenticate each chunk of plaintext
+     while it is still in the cache. */
   nc->set_encrypt_key (ctr_ctx, encryption_key);
 
-  _nettle_ctr_crypt16 (ctr_ctx, nc->encrypt, siv_gcm_fill, state.b,
-		       mlength, dst, src);
+  _siv_ghash_set_key (&siv_ghash_key, &authentication_key);
+  block16_zero (&state);
+  siv_ghash_pad_update (&siv_ghash_key, &state, alength, adata);
 
-  /* Calculate authentication tag.  */
-  siv_gcm_authenticate (ctr_ctx, nc,
-			&authentication_key,
-			nonce, alength, adata,
-			mlength, dst,
-			tag);
+  for (done = 0; mlength - done > SIV_GCM_CHUNK_SIZE;
+       done += SIV_GCM_CHUNK_SIZE)
+    {
+      _nettle_ctr_crypt16 (ctr_ctx, nc->encrypt, siv_gcm_fill, ctr.b,
+			   SIV_GCM_CHUNK_SIZE, dst + done, src + done);
+      _siv_ghash_update (&siv_ghash_key, &state,
+			 SIV_GCM_CHUNK_SIZE / SIV_GCM_BLOCK_SIZE, dst + done);
+    }
+  _nettle_ctr_crypt16 (ctr_ctx, nc->encrypt, siv_gcm_fill, ctr.b,
+		       mlength - done, dst + done, src + done);
+  siv_ghash_pad_update (&siv_ghash_key, &state, mlength - done, dst + done);
+
+  siv_gcm_tag (ctr_ctx, nc, &siv_ghash_key, &state, nonce,
+	       alength, mlength, tag);
 
   return memeql_sec (tag, src + mlength, SIV_GCM_DIGEST_SIZE);
 }
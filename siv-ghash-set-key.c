@@ -40,6 +40,14 @@
 #include "ghash-internal.h"
 #include "block-internal.h"
 
+/* For fat builds */
+#if HAVE_NATIVE_siv_ghash_set_key
+void
+_nettle_siv_ghash_set_key_c (struct gcm_key *ctx,
+			     const union nettle_block16 *key);
+#define _nettle_siv_ghash_set_key _nettle_siv_ghash_set_key_c
+#endif
+
 void
 _siv_ghash_set_key (struct gcm_key *ctx, const union nettle_block16 *key)
 {
@@ -41,25 +41,42 @@
 #include "block-internal.h"
 #include "macros.h"
 
+/* For fat builds */
+#if HAVE_NATIVE_siv_ghash_update
+const uint8_t *
+_nettle_siv_ghash_update_c (const struct gcm_key *ctx,
+			    union nettle_block16 *state,
+			    size_t blocks, const uint8_t *data);
+#define _nettle_siv_ghash_update _nettle_siv_ghash_update_c
+#endif
+
+/* Number of blocks byte reversed at a time, so that _ghash_update
+   can process several blocks per call. */
+#define SIV_GHASH_BLOCKS 16
+
 const uint8_t *
 _siv_ghash_update (const struct gcm_key *ctx, union nettle_block16 *state,
 		 size_t blocks, const uint8_t *data)
 {
-  for (; blocks-- > 0; data += GCM_BLOCK_SIZE)
+  while (blocks > 0)
     {
-      union nettle_block16 b;
+      union nettle_block16 b[SIV_GHASH_BLOCKS];
+      size_t n = blocks < SIV_GHASH_BLOCKS ? blocks : SIV_GHASH_BLOCKS;
+      size_t i;
 
+      for (i = 0; i < n; i++, data += GCM_BLOCK_SIZE)
+	{
 #if WORDS_BIGENDIAN
-      b.u64[1] = LE_READ_UINT64(data);
-      b.u64[0] = LE_READ_UINT64(data + 8);
+	  b[i].u64[1] = LE_READ_UINT64(data);
+	  b[i].u64[0] = LE_READ_UINT64(data + 8);
 #else
-      b.u64[1] = READ_UINT64(data);
-      b.u64[0] = READ_UINT64(data + 8);
+	  b[i].u64[1] = READ_UINT64(data);
+	  b[i].u64[0] = READ_UINT64(data + 8);
 #endif
-
-      _ghash_update (ctx, state, 1, b.b);
+	}
+      _ghash_update (ctx, state, n, b[0].b);
+      blocks -= n;
     }
 
   return data;
 }
-
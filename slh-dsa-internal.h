@@ -35,6 +35,9 @@
 #include <stdint.h>
 
 #include "nettle-types.h"
+#include "sha2.h"
+#include "sha3.h"
+#include "slh-dsa.h"
 
 /* Name mangling */
 #define _wots_gen _nettle_wots_gen
@@ -46,13 +49,21 @@
 #define _fors_gen _nettle_fors_gen
 #define _fors_sign _nettle_fors_sign
 #define _fors_verify _nettle_fors_verify
+#define _fors_sign_tree _nettle_fors_sign_tree
+#define _fors_pub _nettle_fors_pub
 #define _xmss_gen _nettle_xmss_gen
 #define _xmss_sign _nettle_xmss_sign
 #define _xmss_verify _nettle_xmss_verify
+#define _xmss_auth _nettle_xmss_auth
+#define _xmss_sign_auth _nettle_xmss_sign_auth
+#define _xmss_tree _nettle_xmss_tree
 #define _slh_dsa_pure_digest _nettle_slh_dsa_pure_digest
 #define _slh_dsa_pure_rdigest _nettle_slh_dsa_pure_rdigest
 #define _slh_dsa_sign _nettle_slh_dsa_sign
 #define _slh_dsa_verify _nettle_slh_dsa_verify
+#define _slh_dsa_cache_size _nettle_slh_dsa_cache_size
+#define _slh_dsa_cache_init _nettle_slh_dsa_cache_init
+#define _slh_dsa_sign_parallel _nettle_slh_dsa_sign_parallel
 
 #define _slh_dsa_128s_params _nettle_slh_dsa_128s_params
 #define _slh_dsa_128f_params _nettle_slh_dsa_128f_params
@@ -110,6 +121,15 @@ typedef void slh_hash_init_hash_func (const void *tree_ctx, void *ctx,
 typedef void slh_hash_secret_func (const void *tree_ctx,
 				   const struct slh_address_hash *ah,
 				   const uint8_t *secret, uint8_t *out);
+/* Maximum number of independent values hashed by one call to a
+   secret_n function. */
+#define SLH_HASH_LANES 4
+/* Like the secret function, for n <= SLH_HASH_LANES values, each
+   with its own address. The secret and out arguments point to n
+   consecutive values, and may be equal. */
+typedef void slh_hash_secret_n_func (const void *tree_ctx, unsigned n,
+				     const struct slh_address_hash *ah,
+				     const uint8_t *secret, uint8_t *out);
 /* Initialize a temporary context like above _init_hash, and hash two
    values: The left and right child hashes of a merkle tree node. */
 typedef void slh_hash_node_func (const void *tree_ctx,
@@ -124,6 +144,7 @@ struct slh_hash
   nettle_hash_update_func *update;
   nettle_hash_digest_func *digest;
   slh_hash_secret_func *secret;
+  slh_hash_secret_n_func *secret_n;
   slh_hash_node_func *node;
   slh_hash_randomizer_func *randomizer;
   slh_hash_msg_digest_func *msg_digest;
@@ -132,6 +153,13 @@ struct slh_hash
 extern const struct slh_hash _slh_hash_shake;  /* For sha3_ctx. */
 extern const struct slh_hash _slh_hash_sha256; /* For sha256_ctx. */
 
+/* Large enough for the context types of all struct slh_hash. */
+union slh_hash_ctx
+{
+  struct sha3_ctx sha3;
+  struct sha256_ctx sha256;
+};
+
 struct slh_merkle_ctx_public
 {
   const struct slh_hash *hash;
@@ -204,7 +232,9 @@ _wots_verify (const struct slh_hash *hash, const void *tree_ctx,
 
 /* Merkle tree functions. Could be generalized for other merkle tree
    applications, by using const void* for the ctx argument. */
-typedef void merkle_leaf_hash_func (const struct slh_merkle_ctx_secret *ctx, unsigned index, uint8_t *out);
+/* Computes the n <= SLH_HASH_LANES consecutive leaves starting at index. */
+typedef void merkle_leaf_hash_func (const struct slh_merkle_ctx_secret *ctx, unsigned index,
+				    unsigned n, uint8_t *out);
 typedef void merkle_node_hash_func (const struct slh_merkle_ctx_public *ctx, unsigned height, unsigned index,
 				    const uint8_t *left, const uint8_t *right, uint8_t *out);
 
@@ -226,6 +256,8 @@ _merkle_verify (const struct slh_merkle_ctx_public *ctx, merkle_node_hash_func *
 		unsigned height, unsigned idx, const uint8_t *signature, uint8_t *hash);
 
 #define FORS_SIGNATURE_SIZE(a, k) ((k) * ((a) + 1) * _SLH_DSA_128_SIZE)
+/* Largest k of the supported parameter sets. */
+#define FORS_MAX_K 33
 
 /* Generates a single secret value, and corresponding leaf hash. */
 void
@@ -239,6 +271,22 @@ _fors_sign (const struct slh_merkle_ctx_secret *ctx,
 	    /* Allocated by caller, initialized and clobbered by callee. */
 	    void *pub_ctx);
 
+/* Computes the signature and root hash of just the i:th tree. The
+   signature argument points to the signature of that tree. */
+void
+_fors_sign_tree (const struct slh_merkle_ctx_secret *ctx,
+		 const struct slh_fors_params *fors,
+		 const uint8_t *msg, unsigned i,
+		 uint8_t *signature, uint8_t *root);
+
+/* Computes the public key from all the tree roots. */
+void
+_fors_pub (const struct slh_merkle_ctx_public *ctx,
+	   const struct slh_fors_params *fors,
+	   const uint8_t *roots, uint8_t *pub,
+	   /* Allocated by caller, initialized and clobbered by callee. */
+	   void *pub_ctx);
+
 /* Computes candidate public key from signature. */
 void
 _fors_verify (const struct slh_merkle_ctx_public *ctx,
@@ -264,6 +312,25 @@ void
 _xmss_sign (const struct slh_merkle_ctx_secret *ctx, unsigned h,
 	    unsigned idx, const uint8_t *msg, uint8_t *signature, uint8_t *pub);
 
+/* Computes only the auth path, which does not depend on the
+   message. */
+void
+_xmss_auth (const struct slh_merkle_ctx_secret *ctx, unsigned h,
+	    unsigned idx, uint8_t *auth);
+
+/* Like _xmss_sign, but with the auth path already in place in the
+   signature. */
+void
+_xmss_sign_auth (const struct slh_merkle_ctx_secret *ctx, unsigned h,
+		 unsigned idx, const uint8_t *msg, uint8_t *signature, uint8_t *pub);
+
+/* Computes all 2^{h+1} - 1 nodes of a tree, starting with the leaves,
+   then the level above, and so on, ending with the root. */
+#define XMSS_TREE_SIZE(h) (((2 << (h)) - 1) * _SLH_DSA_128_SIZE)
+void
+_xmss_tree (const struct slh_merkle_ctx_secret *ctx, unsigned h,
+	    uint8_t *nodes);
+
 void
 _xmss_verify (const struct slh_merkle_ctx_public *ctx, unsigned h,
 	      unsigned idx, const uint8_t *msg, const uint8_t *signature, uint8_t *pub,
@@ -295,5 +362,23 @@ _slh_dsa_verify (const struct slh_dsa_params *params,
 		 const uint8_t *digest, const uint8_t *signature,
 		 void *tree_ctx, void *scratch_ctx);
 
+size_t
+_slh_dsa_cache_size (const struct slh_dsa_params *params, unsigned layers);
+
+void
+_slh_dsa_cache_init (const struct slh_dsa_params *params,
+		     const struct slh_hash *hash,
+		     const uint8_t *pub, const uint8_t *priv,
+		     unsigned layers, uint8_t *cache,
+		     void *parallel_ctx, slh_dsa_parallel_func *parallel);
+
+int
+_slh_dsa_sign_parallel (const struct slh_dsa_params *params,
+			const struct slh_hash *hash,
+			const uint8_t *pub, const uint8_t *priv,
+			const uint8_t *digest, uint8_t *signature,
+			unsigned layers, const uint8_t *cache,
+			void *parallel_ctx, slh_dsa_parallel_func *parallel,
+			void *tree_ctx, void *scratch_ctx);
 
 #endif /* NETTLE_SLH_DSA_INTERNAL_H_INCLUDED */
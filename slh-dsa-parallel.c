@@ -0,0 +1,269 @@
+/* slh-dsa-parallel.c
+
+   SLH-DSA signing split into parallel jobs, and cached top layers.
+
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "memops.h"
+#include "slh-dsa.h"
+#include "slh-dsa-internal.h"
+
+static void
+run_jobs (void *parallel_ctx, slh_dsa_parallel_func *parallel,
+	  size_t count, slh_dsa_job_func *job, void *arg)
+{
+  if (parallel)
+    parallel (parallel_ctx, count, job, arg);
+  else
+    {
+      size_t i;
+      for (i = 0; i < count; i++)
+	job (arg, i);
+    }
+}
+
+/* Number of trees in the given layer, counted from the top. */
+#define LAYER_TREES(params, j) ((size_t) 1 << ((params)->xmss.h * (j)))
+
+size_t
+_slh_dsa_cache_size (const struct slh_dsa_params *params, unsigned layers)
+{
+  size_t trees;
+  unsigned j;
+
+  assert (layers <= params->xmss.d);
+
+  for (j = trees = 0; j < layers; j++)
+    trees += LAYER_TREES (params, j);
+
+  return trees * XMSS_TREE_SIZE (params->xmss.h);
+}
+
+struct cache_job_ctx
+{
+  const struct slh_dsa_params *params;
+  const struct slh_hash *hash;
+  const uint8_t *pub;
+  const uint8_t *priv;
+  uint8_t *cache;
+};
+
+static void
+cache_job (void *arg, size_t t)
+{
+  const struct cache_job_ctx *job = arg;
+  const struct slh_dsa_params *params = job->params;
+  union slh_hash_ctx tree_ctx, scratch_ctx;
+  const struct slh_merkle_ctx_secret merkle_ctx =
+    {
+      { job->hash, &tree_ctx, 0 },
+      job->priv, &scratch_ctx,
+    };
+  uint8_t *nodes = job->cache + t * XMSS_TREE_SIZE (params->xmss.h);
+  unsigned j;
+
+  /* Trees are stored top layer first, and in order of tree index
+     within each layer. */
+  for (j = 0; t >= LAYER_TREES (params, j); j++)
+    t -= LAYER_TREES (params, j);
+
+  job->hash->init_tree (&tree_ctx, job->pub, params->xmss.d - 1 - j, t);
+  _xmss_tree (&merkle_ctx, params->xmss.h, nodes);
+}
+
+void
+_slh_dsa_cache_init (const struct slh_dsa_params *params,
+		     const struct slh_hash *hash,
+		     const uint8_t *pub, const uint8_t *priv,
+		     unsigned layers, uint8_t *cache,
+		     void *parallel_ctx, slh_dsa_parallel_func *parallel)
+{
+  struct cache_job_ctx job = { params, hash, pub, priv, cache };
+
+  run_jobs (parallel_ctx, parallel,
+	    _slh_dsa_cache_size (params, layers) / XMSS_TREE_SIZE (params->xmss.h),
+	    cache_job, &job);
+}
+
+/* Copies the auth path of leaf idx, from the nodes of a cached
+   tree. */
+static void
+cache_auth (unsigned h, const uint8_t *nodes, unsigned idx, uint8_t *auth)
+{
+  unsigned level;
+
+  for (level = 0; level < h; level++, idx >>= 1)
+    {
+      memcpy (auth + level * _SLH_DSA_128_SIZE,
+	      nodes + (idx ^ 1) * _SLH_DSA_128_SIZE, _SLH_DSA_128_SIZE);
+      nodes += (1 << (h - level)) * _SLH_DSA_128_SIZE;
+    }
+}
+
+/* Tree and leaf index for each layer. */
+static void
+layer_index (const struct slh_dsa_params *params,
+	     uint64_t tree_idx, unsigned leaf_idx, unsigned layer,
+	     uint64_t *tree, unsigned *leaf)
+{
+  if (layer > 0)
+    {
+      tree_idx >>= params->xmss.h * (layer - 1);
+      leaf_idx = tree_idx & ((1 << params->xmss.h) - 1);
+      tree_idx >>= params->xmss.h;
+    }
+  *tree = tree_idx;
+  *leaf = leaf_idx;
+}
+
+struct sign_job_ctx
+{
+  const struct slh_dsa_params *params;
+  const struct slh_merkle_ctx_secret *fors_ctx;
+  const uint8_t *pub;
+  const uint8_t *digest;
+  uint64_t tree_idx;
+  unsigned leaf_idx;
+  uint8_t *signature;
+  uint8_t *roots;
+};
+
+/* The first k jobs are the fors trees, the rest are the auth paths of
+   the uncached xmss layers. */
+static void
+sign_job (void *arg, size_t i)
+{
+  const struct sign_job_ctx *job = arg;
+  const struct slh_dsa_params *params = job->params;
+  const struct slh_hash *hash = job->fors_ctx->pub.hash;
+  union slh_hash_ctx tree_ctx, scratch_ctx;
+  const struct slh_merkle_ctx_secret merkle_ctx =
+    {
+      { hash, &tree_ctx, 0 },
+      job->fors_ctx->secret_seed, &scratch_ctx,
+    };
+  uint64_t tree;
+  unsigned leaf;
+
+  if (i < params->fors.k)
+    {
+      _fors_sign_tree (job->fors_ctx, &params->fors, job->digest, i,
+		       job->signature
+		       + i * (params->fors.a + 1) * _SLH_DSA_128_SIZE,
+		       job->roots + i * _SLH_DSA_128_SIZE);
+      return;
+    }
+  i -= params->fors.k;
+
+  layer_index (params, job->tree_idx, job->leaf_idx, i, &tree, &leaf);
+  hash->init_tree (&tree_ctx, job->pub, i, tree);
+  _xmss_auth (&merkle_ctx, params->xmss.h, leaf,
+	      job->signature + params->fors.signature_size
+	      + i * params->xmss.signature_size + WOTS_SIGNATURE_SIZE);
+}
+
+int
+_slh_dsa_sign_parallel (const struct slh_dsa_params *params,
+			const struct slh_hash *hash,
+			const uint8_t *pub, const uint8_t *priv,
+			const uint8_t *digest, uint8_t *signature,
+			unsigned layers, const uint8_t *cache,
+			void *parallel_ctx, slh_dsa_parallel_func *parallel,
+			void *tree_ctx, void *scratch_ctx)
+{
+  uint8_t roots[FORS_MAX_K * _SLH_DSA_128_SIZE];
+  uint8_t root[_SLH_DSA_128_SIZE];
+  uint64_t tree_idx;
+  unsigned leaf_idx;
+  unsigned i, uncached;
+  size_t tree_offset;
+
+  assert (params->fors.k <= FORS_MAX_K);
+  assert (layers <= params->xmss.d);
+
+  params->parse_digest (digest + params->fors.msg_size, &tree_idx, &leaf_idx);
+
+  const struct slh_merkle_ctx_secret merkle_ctx =
+    {
+      { hash, tree_ctx, leaf_idx },
+      priv, scratch_ctx,
+    };
+  struct sign_job_ctx job =
+    {
+      params, &merkle_ctx, pub, digest, tree_idx, leaf_idx,
+      signature, roots,
+    };
+
+  /* Shared, read-only, by the fors jobs. */
+  hash->init_tree (tree_ctx, pub, 0, tree_idx);
+
+  uncached = params->xmss.d - layers;
+  run_jobs (parallel_ctx, parallel, params->fors.k + uncached,
+	    sign_job, &job);
+
+  /* Auth paths from the cache, in which layers are stored top layer
+     first. */
+  for (i = params->xmss.d, tree_offset = 0; i-- > uncached; )
+    {
+      uint64_t tree;
+      unsigned leaf;
+      layer_index (params, tree_idx, leaf_idx, i, &tree, &leaf);
+
+      cache_auth (params->xmss.h,
+		  cache + (tree_offset + tree) * XMSS_TREE_SIZE (params->xmss.h),
+		  leaf,
+		  signature + params->fors.signature_size
+		  + i * params->xmss.signature_size + WOTS_SIGNATURE_SIZE);
+      tree_offset += LAYER_TREES (params, params->xmss.d - 1 - i);
+    }
+
+  /* What remains are the wots signatures, which depend on the root
+     of the layer below. */
+  _fors_pub (&merkle_ctx.pub, &params->fors, roots, root, scratch_ctx);
+  signature += params->fors.signature_size;
+
+  for (i = 0; i < params->xmss.d; i++, signature += params->xmss.signature_size)
+    {
+      uint64_t tree;
+      unsigned leaf;
+      layer_index (params, tree_idx, leaf_idx, i, &tree, &leaf);
+
+      hash->init_tree (tree_ctx, pub, i, tree);
+      _xmss_sign_auth (&merkle_ctx, params->xmss.h, leaf, root, signature, root);
+    }
+  return memeql_sec (root, pub + _SLH_DSA_128_SIZE, sizeof (root));
+}
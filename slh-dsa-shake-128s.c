@@ -101,3 +101,42 @@ slh_dsa_shake_128s_verify (const uint8_t *pub,
 			  pub, digest, signature + _SLH_DSA_128_SIZE,
 			  &tree_ctx, &scratch_ctx);
 }
+
+size_t
+slh_dsa_shake_128s_cache_size (unsigned layers)
+{
+  return _slh_dsa_cache_size (&_slh_dsa_128s_params, layers);
+}
+
+void
+slh_dsa_shake_128s_cache_init (const uint8_t *pub, const uint8_t *priv,
+			       unsigned layers, uint8_t *cache,
+			       void *parallel_ctx, slh_dsa_parallel_func *parallel)
+{
+  _slh_dsa_cache_init (&_slh_dsa_128s_params, &_slh_hash_shake,
+		       pub, priv, layers, cache, parallel_ctx, parallel);
+}
+
+int
+slh_dsa_shake_128s_sign_parallel (const uint8_t *pub, const uint8_t *priv,
+				  unsigned layers, const uint8_t *cache,
+				  size_t length, const uint8_t *msg,
+				  uint8_t *signature,
+				  void *parallel_ctx, slh_dsa_parallel_func *parallel)
+{
+  struct sha3_ctx tree_ctx, scratch_ctx;
+  uint8_t digest[SLH_DSA_M];
+  int res;
+
+  _slh_dsa_pure_rdigest (&_slh_hash_shake,
+			 pub, priv + _SLH_DSA_128_SIZE, length, msg,
+			 signature, sizeof (digest), digest);
+  res = _slh_dsa_sign_parallel (&_slh_dsa_128s_params, &_slh_hash_shake,
+				pub, priv, digest, signature + _SLH_DSA_128_SIZE,
+				layers, cache, parallel_ctx, parallel,
+				&tree_ctx, &scratch_ctx);
+  if (!res)
+    memset (signature, 0, SLH_DSA_128S_SIGNATURE_SIZE);
+
+  return res;
+}
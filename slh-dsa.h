@@ -57,6 +57,18 @@ extern "C" {
 #define slh_dsa_shake_128f_verify nettle_slh_dsa_shake_128f_verify
 #define slh_dsa_sha2_128s_verify nettle_slh_dsa_sha2_128s_verify
 #define slh_dsa_sha2_128f_verify nettle_slh_dsa_sha2_128f_verify
+#define slh_dsa_shake_128s_cache_size nettle_slh_dsa_shake_128s_cache_size
+#define slh_dsa_shake_128f_cache_size nettle_slh_dsa_shake_128f_cache_size
+#define slh_dsa_sha2_128s_cache_size nettle_slh_dsa_sha2_128s_cache_size
+#define slh_dsa_sha2_128f_cache_size nettle_slh_dsa_sha2_128f_cache_size
+#define slh_dsa_shake_128s_cache_init nettle_slh_dsa_shake_128s_cache_init
+#define slh_dsa_shake_128f_cache_init nettle_slh_dsa_shake_128f_cache_init
+#define slh_dsa_sha2_128s_cache_init nettle_slh_dsa_sha2_128s_cache_init
+#define slh_dsa_sha2_128f_cache_init nettle_slh_dsa_sha2_128f_cache_init
+#define slh_dsa_shake_128s_sign_parallel nettle_slh_dsa_shake_128s_sign_parallel
+#define slh_dsa_shake_128f_sign_parallel nettle_slh_dsa_shake_128f_sign_parallel
+#define slh_dsa_sha2_128s_sign_parallel nettle_slh_dsa_sha2_128s_sign_parallel
+#define slh_dsa_sha2_128f_sign_parallel nettle_slh_dsa_sha2_128f_sign_parallel
 
 /* Key layout:
    private:
@@ -134,6 +146,72 @@ slh_dsa_sha2_128f_verify (const uint8_t *pub,
 			  size_t length, const uint8_t *msg,
 			  const uint8_t *signature);
 
+/* Signing with the work split into independent jobs, which can run
+   in parallel. The parallel function must call job (arg, i) for each
+   0 <= i < count, possibly concurrently in other threads, and return
+   when all calls have completed. A NULL parallel function means that
+   jobs are run in sequence by the calling thread. */
+typedef void slh_dsa_job_func (void *arg, size_t i);
+typedef void slh_dsa_parallel_func (void *ctx, size_t count,
+				    slh_dsa_job_func *job, void *arg);
+
+/* Optional cache of the complete xmss trees of the top layers of the
+   hypertree, which are shared by all signatures using the same
+   key. Each cached layer is 2^9 (for the "s" variants) or 2^3 (for
+   the "f" variants) times larger than the one above; the top layer
+   is 16 KB and 240 bytes, respectively. The cache is read-only after
+   initialization, and can be shared between threads. */
+size_t
+slh_dsa_shake_128s_cache_size (unsigned layers);
+size_t
+slh_dsa_shake_128f_cache_size (unsigned layers);
+size_t
+slh_dsa_sha2_128s_cache_size (unsigned layers);
+size_t
+slh_dsa_sha2_128f_cache_size (unsigned layers);
+
+void
+slh_dsa_shake_128s_cache_init (const uint8_t *pub, const uint8_t *priv,
+			       unsigned layers, uint8_t *cache,
+			       void *parallel_ctx, slh_dsa_parallel_func *parallel);
+void
+slh_dsa_shake_128f_cache_init (const uint8_t *pub, const uint8_t *priv,
+			       unsigned layers, uint8_t *cache,
+			       void *parallel_ctx, slh_dsa_parallel_func *parallel);
+void
+slh_dsa_sha2_128s_cache_init (const uint8_t *pub, const uint8_t *priv,
+			      unsigned layers, uint8_t *cache,
+			      void *parallel_ctx, slh_dsa_parallel_func *parallel);
+void
+slh_dsa_sha2_128f_cache_init (const uint8_t *pub, const uint8_t *priv,
+			      unsigned layers, uint8_t *cache,
+			      void *parallel_ctx, slh_dsa_parallel_func *parallel);
+
+int
+slh_dsa_shake_128s_sign_parallel (const uint8_t *pub, const uint8_t *priv,
+				  unsigned layers, const uint8_t *cache,
+				  size_t length, const uint8_t *msg,
+				  uint8_t *signature,
+				  void *parallel_ctx, slh_dsa_parallel_func *parallel);
+int
+slh_dsa_shake_128f_sign_parallel (const uint8_t *pub, const uint8_t *priv,
+				  unsigned layers, const uint8_t *cache,
+				  size_t length, const uint8_t *msg,
+				  uint8_t *signature,
+				  void *parallel_ctx, slh_dsa_parallel_func *parallel);
+int
+slh_dsa_sha2_128s_sign_parallel (const uint8_t *pub, const uint8_t *priv,
+				 unsigned layers, const uint8_t *cache,
+				 size_t length, const uint8_t *msg,
+				 uint8_t *signature,
+				 void *parallel_ctx, slh_dsa_parallel_func *parallel);
+int
+slh_dsa_sha2_128f_sign_parallel (const uint8_t *pub, const uint8_t *priv,
+				 unsigned layers, const uint8_t *cache,
+				 size_t length, const uint8_t *msg,
+				 uint8_t *signature,
+				 void *parallel_ctx, slh_dsa_parallel_func *parallel);
+
 #ifdef __cplusplus
 }
 #endif
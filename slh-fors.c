@@ -35,6 +35,9 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "bswap-internal.h"
 #include "slh-dsa-internal.h"
 
@@ -57,9 +60,27 @@ _fors_gen (const struct slh_merkle_ctx_secret *ctx,
 }
 
 static void
-fors_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx, uint8_t *out)
+fors_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx,
+	   unsigned n, uint8_t *out)
 {
-  _fors_gen (ctx, idx, out, out);
+  struct slh_address_hash ah[SLH_HASH_LANES];
+  uint8_t seeds[SLH_HASH_LANES * _SLH_DSA_128_SIZE];
+  unsigned i;
+
+  assert (n <= SLH_HASH_LANES);
+  for (i = 0; i < SLH_HASH_LANES; i++)
+    {
+      ah[i].type = bswap32_if_le (SLH_FORS_PRF);
+      ah[i].keypair = bswap32_if_le (ctx->pub.keypair);
+      ah[i].height_chain = 0;
+      ah[i].index_hash = bswap32_if_le (idx + i);
+      memcpy (seeds + i * _SLH_DSA_128_SIZE, ctx->secret_seed, _SLH_DSA_128_SIZE);
+    }
+  ctx->pub.hash->secret_n (ctx->pub.tree_ctx, n, ah, seeds, out);
+
+  for (i = 0; i < n; i++)
+    ah[i].type = bswap32_if_le (SLH_FORS_TREE);
+  ctx->pub.hash->secret_n (ctx->pub.tree_ctx, n, ah, out, out);
 }
 
 static void
@@ -78,17 +99,13 @@ fors_node (const struct slh_merkle_ctx_public *ctx, unsigned height, unsigned in
 
 static void
 fors_sign_one (const struct slh_merkle_ctx_secret *ctx, unsigned a,
-	       unsigned idx, uint8_t *signature, void *pub_ctx)
+	       unsigned idx, uint8_t *signature, uint8_t *root)
 {
-  uint8_t hash[_SLH_DSA_128_SIZE];
-
-  _fors_gen (ctx, idx, signature, hash);
+  _fors_gen (ctx, idx, signature, root);
   signature += _SLH_DSA_128_SIZE;
 
   _merkle_sign (ctx, fors_leaf, fors_node, a, idx, signature);
-  _merkle_verify (&ctx->pub, fors_node, a, idx, signature, hash);
-
-  ctx->pub.hash->update (pub_ctx, _SLH_DSA_128_SIZE, hash);
+  _merkle_verify (&ctx->pub, fors_node, a, idx, signature, root);
 }
 
 void
@@ -114,12 +131,50 @@ _fors_sign (const struct slh_merkle_ctx_secret *ctx,
 	w = (w << 8) | *msg++;
       bits -= fors->a;
 
-      fors_sign_one (ctx, fors->a, (i << fors->a) + ((w >> bits) & mask), signature, pub_ctx);
+      uint8_t root[_SLH_DSA_128_SIZE];
+      fors_sign_one (ctx, fors->a, (i << fors->a) + ((w >> bits) & mask), signature, root);
+      ctx->pub.hash->update (pub_ctx, _SLH_DSA_128_SIZE, root);
      }
 
   ctx->pub.hash->digest (pub_ctx, pub);
 }
 
+void
+_fors_sign_tree (const struct slh_merkle_ctx_secret *ctx,
+		 const struct slh_fors_params *fors,
+		 const uint8_t *msg, unsigned i,
+		 uint8_t *signature, uint8_t *root)
+{
+  unsigned bit = i * fors->a;
+  unsigned j;
+  uint32_t w;
+
+  /* The index is the i:th group of a bits of the message, most
+     significant bit first. */
+  for (j = bit / 8, w = 0; 8*j < bit + fors->a; j++)
+    w = (w << 8) | msg[j];
+  w = (w >> (8*j - bit - fors->a)) & ((1 << fors->a) - 1);
+
+  fors_sign_one (ctx, fors->a, (i << fors->a) + w, signature, root);
+}
+
+void
+_fors_pub (const struct slh_merkle_ctx_public *ctx,
+	   const struct slh_fors_params *fors,
+	   const uint8_t *roots, uint8_t *pub, void *pub_ctx)
+{
+  struct slh_address_hash ah =
+    {
+      bswap32_if_le (SLH_FORS_ROOTS),
+      bswap32_if_le (ctx->keypair),
+      0, 0,
+    };
+
+  ctx->hash->init_hash (ctx->tree_ctx, pub_ctx, &ah);
+  ctx->hash->update (pub_ctx, fors->k * _SLH_DSA_128_SIZE, roots);
+  ctx->hash->digest (pub_ctx, pub);
+}
+
 static void
 fors_verify_one (const struct slh_merkle_ctx_public *ctx, unsigned a,
 		 unsigned idx, const uint8_t *signature, void *pub_ctx)
@@ -34,6 +34,7 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 
 #include "slh-dsa-internal.h"
 
@@ -54,6 +55,8 @@ _merkle_root (const struct slh_merkle_ctx_secret *ctx,
 	      /* Must have space for (height + 1) node hashes */
 	      uint8_t *stack)
 {
+  /* Leaves are generated SLH_HASH_LANES at a time. */
+  uint8_t leaves[SLH_HASH_LANES * _SLH_DSA_128_SIZE];
   unsigned stack_size = 0;
   unsigned i;
   assert (height > 0);
@@ -63,10 +66,17 @@ _merkle_root (const struct slh_merkle_ctx_secret *ctx,
     {
       /* Leaf index. */
       unsigned idx = start + i;
+      unsigned lane = i % SLH_HASH_LANES;
       unsigned h;
       assert (stack_size <= height);
 
-      leaf_hash (ctx, idx, stack + stack_size++ * _SLH_DSA_128_SIZE);
+      if (lane == 0)
+	{
+	  unsigned n = (1 << height) - i;
+	  leaf_hash (ctx, idx, n < SLH_HASH_LANES ? n : SLH_HASH_LANES, leaves);
+	}
+      memcpy (stack + stack_size++ * _SLH_DSA_128_SIZE,
+	      leaves + lane * _SLH_DSA_128_SIZE, _SLH_DSA_128_SIZE);
 
       for (h = 1; (idx&1); h++)
 	{
@@ -102,7 +112,7 @@ _merkle_sign (const struct slh_merkle_ctx_secret *ctx,
     _merkle_root (ctx, leaf_hash, node_hash, h, (idx & -(1 << h)) ^ (1 << h),
 		  signature + h*_SLH_DSA_128_SIZE, signature);
 
-  leaf_hash (ctx, idx ^ 1, signature);
+  leaf_hash (ctx, idx ^ 1, 1, signature);
 }
 
 void
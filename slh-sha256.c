@@ -33,13 +33,16 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
 #include <string.h>
 
 #include "slh-dsa-internal.h"
 
 #include "bswap-internal.h"
 #include "hmac.h"
+#include "macros.h"
 #include "sha2.h"
+#include "sha2-internal.h"
 
 /* Uses a "compressed" address,
 
@@ -87,15 +90,91 @@ slh_sha256_digest (struct sha256_ctx *ctx, uint8_t *out)
   memcpy (out, digest, _SLH_DSA_128_SIZE);
 }
 
+/* The compressed addresses and the inputs to the secret and node
+   functions fit, with padding, in the second block. The tree_ctx
+   holds the state after the first block, and the compressed tree
+   address in its buffer. */
+#define ADDRESS_SIZE 22
+
+static void
+slh_sha256_block_init (const struct sha256_ctx *tree_ctx, unsigned length,
+		       uint8_t *block)
+{
+  assert (tree_ctx->count == 1 && tree_ctx->index == 9);
+  memcpy (block, tree_ctx->block, 9);
+  block[ADDRESS_SIZE + length] = 0x80;
+  memset (block + ADDRESS_SIZE + length + 1, 0,
+	  SHA256_BLOCK_SIZE - 8 - (ADDRESS_SIZE + length + 1));
+  WRITE_UINT64 (block + SHA256_BLOCK_SIZE - 8,
+		8 * (uint64_t) (SHA256_BLOCK_SIZE + ADDRESS_SIZE + length));
+}
+
+static void
+slh_sha256_block (const struct sha256_ctx *tree_ctx,
+		  const struct slh_address_hash *ah,
+		  uint8_t *block, uint8_t *out)
+{
+  uint32_t state[_SHA256_DIGEST_LENGTH];
+  unsigned i;
+
+  /* For compressed addr, hash only last byte of the type. */
+  memcpy (block + 9, (const uint8_t *) ah + 3, sizeof (*ah) - 3);
+  memcpy (state, tree_ctx->state, sizeof (state));
+  sha256_compress (state, block);
+
+  for (i = 0; i < _SLH_DSA_128_SIZE / 4; i++)
+    WRITE_UINT32 (out + 4*i, state[i]);
+}
+
+/* Uses the four-lane compression function, except for a single
+   value, where the three idle lanes would only slow things down. */
+static void
+slh_sha256_secret_n (const struct sha256_ctx *tree_ctx, unsigned n,
+		     const struct slh_address_hash *ah,
+		     const uint8_t *secret, uint8_t *out)
+{
+  uint8_t block[SLH_HASH_LANES * SHA256_BLOCK_SIZE];
+  uint32_t state[SLH_HASH_LANES * _SHA256_DIGEST_LENGTH];
+  unsigned i, j;
+
+  assert (n <= SLH_HASH_LANES);
+  slh_sha256_block_init (tree_ctx, _SLH_DSA_128_SIZE, block);
+  if (n == 1)
+    {
+      memcpy (block + ADDRESS_SIZE, secret, _SLH_DSA_128_SIZE);
+      slh_sha256_block (tree_ctx, ah, block, out);
+      return;
+    }
+
+  /* Unused lanes hash a copy of the first block. */
+  for (i = 0; i < SLH_HASH_LANES; i++)
+    {
+      uint8_t *b = block + i * SHA256_BLOCK_SIZE;
+      if (i > 0)
+	memcpy (b, block, SHA256_BLOCK_SIZE);
+      if (i < n)
+	{
+	  memcpy (b + 9, (const uint8_t *) (ah + i) + 3, sizeof (*ah) - 3);
+	  memcpy (b + ADDRESS_SIZE, secret + i * _SLH_DSA_128_SIZE,
+		  _SLH_DSA_128_SIZE);
+	}
+      memcpy (state + i * _SHA256_DIGEST_LENGTH, tree_ctx->state,
+	      sizeof (tree_ctx->state));
+    }
+  _nettle_sha256_compress_x4 (state, block);
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < _SLH_DSA_128_SIZE / 4; j++)
+      WRITE_UINT32 (out + i * _SLH_DSA_128_SIZE + 4*j,
+		    state[i * _SHA256_DIGEST_LENGTH + j]);
+}
+
 static void
 slh_sha256_secret (const struct sha256_ctx *tree_ctx,
 		   const struct slh_address_hash *ah,
 		   const uint8_t *secret, uint8_t *out)
 {
-  struct sha256_ctx ctx;
-  slh_sha256_init_hash (tree_ctx, &ctx, ah);
-  sha256_update (&ctx, _SLH_DSA_128_SIZE, secret);
-  slh_sha256_digest (&ctx, out);
+  slh_sha256_secret_n (tree_ctx, 1, ah, secret, out);
 }
 
 static void
@@ -103,11 +182,12 @@ slh_sha256_node (const struct sha256_ctx *tree_ctx,
 		 const struct slh_address_hash *ah,
 		 const uint8_t *left, const uint8_t *right, uint8_t *out)
 {
-  struct sha256_ctx ctx;
-  slh_sha256_init_hash (tree_ctx, &ctx, ah);
-  sha256_update (&ctx, _SLH_DSA_128_SIZE, left);
-  sha256_update (&ctx, _SLH_DSA_128_SIZE, right);
-  slh_sha256_digest (&ctx, out);
+  uint8_t block[SHA256_BLOCK_SIZE];
+
+  slh_sha256_block_init (tree_ctx, 2 * _SLH_DSA_128_SIZE, block);
+  memcpy (block + ADDRESS_SIZE, left, _SLH_DSA_128_SIZE);
+  memcpy (block + ADDRESS_SIZE + _SLH_DSA_128_SIZE, right, _SLH_DSA_128_SIZE);
+  slh_sha256_block (tree_ctx, ah, block, out);
 }
 
 static void
@@ -170,6 +250,7 @@ _slh_hash_sha256 =
     (nettle_hash_update_func *) sha256_update,
     (nettle_hash_digest_func *) slh_sha256_digest,
     (slh_hash_secret_func *) slh_sha256_secret,
+    (slh_hash_secret_n_func *) slh_sha256_secret_n,
     (slh_hash_node_func *) slh_sha256_node,
     slh_sha256_randomizer,
     slh_sha256_msg_digest
@@ -33,10 +33,15 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "slh-dsa-internal.h"
 
 #include "bswap-internal.h"
+#include "macros.h"
 #include "sha3.h"
+#include "sha3-internal.h"
 
 /* Fields always big-endian */
 struct slh_address_tree
@@ -65,25 +70,60 @@ slh_shake_init_hash (const struct sha3_ctx *tree_ctx, struct sha3_ctx *ctx,
   sha3_256_update (ctx, sizeof (*ah), (const uint8_t *) ah);
 }
 
+/* The inputs to the secret and node functions, including the public
+   seed and the addresses, fit in a single block. The tree_ctx holds
+   the public seed and tree address as the first four words of the
+   state, with nothing permuted yet. */
+static void
+slh_shake_block (const struct sha3_ctx *tree_ctx, const struct slh_address_hash *ah,
+		 unsigned length, const uint8_t *data, uint8_t *out)
+{
+  struct sha3_state state;
+  unsigned i;
+
+  assert (tree_ctx->index == 32);
+  memcpy (state.a, tree_ctx->state.a, 4 * sizeof (uint64_t));
+  memset (state.a + 4, 0, (SHA3_STATE_LENGTH - 4) * sizeof (uint64_t));
+
+  state.a[4] = LE_READ_UINT64 ((const uint8_t *) ah);
+  state.a[5] = LE_READ_UINT64 ((const uint8_t *) ah + 8);
+  for (i = 6; length > 0; i++, length -= 8, data += 8)
+    state.a[i] = LE_READ_UINT64 (data);
+
+  state.a[i] = SHA3_SHAKE_MAGIC;
+  state.a[SHA3_256_BLOCK_SIZE / 8 - 1] ^= (uint64_t) 1 << 63;
+  sha3_permute (&state);
+
+  LE_WRITE_UINT64 (out, state.a[0]);
+  LE_WRITE_UINT64 (out + 8, state.a[1]);
+}
+
 static void
 slh_shake_secret (const struct sha3_ctx *tree_ctx, const struct slh_address_hash *ah,
 		  const uint8_t *secret, uint8_t *out)
 {
-  struct sha3_ctx ctx;
-  slh_shake_init_hash (tree_ctx, &ctx, ah);;
-  sha3_256_update (&ctx, _SLH_DSA_128_SIZE, secret);
-  sha3_256_shake (&ctx, _SLH_DSA_128_SIZE, out);
+  slh_shake_block (tree_ctx, ah, _SLH_DSA_128_SIZE, secret, out);
+}
+
+static void
+slh_shake_secret_n (const struct sha3_ctx *tree_ctx, unsigned n,
+		    const struct slh_address_hash *ah,
+		    const uint8_t *secret, uint8_t *out)
+{
+  unsigned i;
+  for (i = 0; i < n; i++)
+    slh_shake_block (tree_ctx, ah + i, _SLH_DSA_128_SIZE,
+		     secret + i * _SLH_DSA_128_SIZE, out + i * _SLH_DSA_128_SIZE);
 }
 
 static void
 slh_shake_node (const struct sha3_ctx *tree_ctx, const struct slh_address_hash *ah,
 		const uint8_t *left, const uint8_t *right, uint8_t *out)
 {
-  struct sha3_ctx ctx;
-  slh_shake_init_hash (tree_ctx, &ctx, ah);;
-  sha3_256_update (&ctx, _SLH_DSA_128_SIZE, left);
-  sha3_256_update (&ctx, _SLH_DSA_128_SIZE, right);
-  sha3_256_shake (&ctx, _SLH_DSA_128_SIZE, out);
+  uint8_t data[2 * _SLH_DSA_128_SIZE];
+  memcpy (data, left, _SLH_DSA_128_SIZE);
+  memcpy (data + _SLH_DSA_128_SIZE, right, _SLH_DSA_128_SIZE);
+  slh_shake_block (tree_ctx, ah, sizeof (data), data, out);
 }
 
 static void
@@ -132,6 +172,7 @@ _slh_hash_shake =
     (nettle_hash_update_func *) sha3_256_update,
     (nettle_hash_digest_func *) slh_shake_digest,
     (slh_hash_secret_func *) slh_shake_secret,
+    (slh_hash_secret_n_func *) slh_shake_secret_n,
     (slh_hash_node_func *) slh_shake_node,
     slh_shake_randomizer,
     slh_shake_msg_digest
@@ -35,48 +35,131 @@
 # include "config.h"
 #endif
 
+#include <string.h>
+
 #include "slh-dsa-internal.h"
 
 #include "bswap-internal.h"
 
-/* If s == 0, returns src and leaves dst unchanged. Otherwise, returns
-   dst. For the ah argument, leaves ah->keypair and ah->height_chain
-   unchanged, but overwrites the other fields. */
-static const uint8_t *
-wots_chain (const struct slh_hash *hash, const void *ctx,
-	    struct slh_address_hash *ah,
-	    unsigned i, unsigned s,
-	    const uint8_t *src, uint8_t *dst)
+#define WOTS_MAX_DIGIT 15
+
+/* Splits the message into base 16 digits, followed by the digits of
+   the checksum. */
+static void
+wots_digits (const uint8_t *msg, uint8_t *digits)
 {
-  unsigned j;
+  unsigned i;
+  uint32_t csum;
 
-  if (s == 0)
-    return src;
+  for (i = 0, csum = WOTS_MAX_DIGIT * 2 * _SLH_DSA_128_SIZE; i < _SLH_DSA_128_SIZE; i++)
+    {
+      digits[2*i] = msg[i] >> 4;
+      digits[2*i + 1] = msg[i] & 0xf;
+      csum -= digits[2*i] + digits[2*i + 1];
+    }
+  digits[32] = csum >> 8;
+  digits[33] = (csum >> 4) & 0xf;
+  digits[34] = csum & 0xf;
+}
 
-  ah->type = bswap32_if_le (SLH_WOTS_HASH);
-  ah->index_hash = bswap32_if_le (i);
+/* Generates the secret value for each chain. */
+static void
+wots_secrets (const struct slh_hash *hash, const void *tree_ctx,
+	      const uint8_t *secret_seed, uint32_t keypair, uint8_t *values)
+{
+  struct slh_address_hash ah[SLH_HASH_LANES];
+  uint8_t seeds[SLH_HASH_LANES * _SLH_DSA_128_SIZE];
+  unsigned i, j, n;
 
-  hash->secret (ctx, ah, src, dst);
+  for (j = 0; j < SLH_HASH_LANES; j++)
+    {
+      ah[j].type = bswap32_if_le (SLH_WOTS_PRF);
+      ah[j].keypair = bswap32_if_le (keypair);
+      ah[j].index_hash = 0;
+      memcpy (seeds + j * _SLH_DSA_128_SIZE, secret_seed, _SLH_DSA_128_SIZE);
+    }
 
-  for (j = 1; j < s; j++)
+  for (i = 0; i < _WOTS_SIGNATURE_LENGTH; i += n)
     {
-      ah->index_hash = bswap32_if_le (i + j);
-      hash->secret (ctx, ah, dst, dst);
+      n = _WOTS_SIGNATURE_LENGTH - i;
+      if (n > SLH_HASH_LANES)
+	n = SLH_HASH_LANES;
+      for (j = 0; j < n; j++)
+	ah[j].height_chain = bswap32_if_le (i + j);
+
+      hash->secret_n (tree_ctx, n, ah, seeds, values + i * _SLH_DSA_128_SIZE);
     }
+}
+
+/* Advances each chain i from position begin[i] to position end[i],
+   updating values in place. Chains are processed in parallel, in up
+   to SLH_HASH_LANES lanes, and a lane is refilled with the next chain
+   as soon as its current chain is done. */
+static void
+wots_chains (const struct slh_hash *hash, const void *tree_ctx, uint32_t keypair,
+	     const uint8_t *begin, const uint8_t *end, uint8_t *values)
+{
+  struct slh_address_hash ah[SLH_HASH_LANES];
+  uint8_t lanes[SLH_HASH_LANES * _SLH_DSA_128_SIZE];
+  unsigned chain[SLH_HASH_LANES];
+  unsigned pos[SLH_HASH_LANES];
+  unsigned next, n, j;
 
-  return dst;
+  for (next = n = 0;;)
+    {
+      for (; n < SLH_HASH_LANES && next < _WOTS_SIGNATURE_LENGTH; next++)
+	if (begin[next] < end[next])
+	  {
+	    chain[n] = next;
+	    pos[n] = begin[next];
+	    ah[n].type = bswap32_if_le (SLH_WOTS_HASH);
+	    ah[n].keypair = bswap32_if_le (keypair);
+	    ah[n].height_chain = bswap32_if_le (next);
+	    memcpy (lanes + n * _SLH_DSA_128_SIZE, values + next * _SLH_DSA_128_SIZE,
+		    _SLH_DSA_128_SIZE);
+	    n++;
+	  }
+      if (n == 0)
+	return;
+
+      for (j = 0; j < n; j++)
+	ah[j].index_hash = bswap32_if_le (pos[j]);
+
+      hash->secret_n (tree_ctx, n, ah, lanes, lanes);
+
+      for (j = 0; j < n;)
+	{
+	  if (++pos[j] < end[chain[j]])
+	    {
+	      j++;
+	      continue;
+	    }
+	  /* Chain done, move the last lane into its place. */
+	  memcpy (values + chain[j] * _SLH_DSA_128_SIZE, lanes + j * _SLH_DSA_128_SIZE,
+		  _SLH_DSA_128_SIZE);
+	  if (--n > j)
+	    {
+	      chain[j] = chain[n];
+	      pos[j] = pos[n];
+	      ah[j] = ah[n];
+	      memcpy (lanes + j * _SLH_DSA_128_SIZE, lanes + n * _SLH_DSA_128_SIZE,
+		      _SLH_DSA_128_SIZE);
+	    }
+	}
+    }
 }
 
 static void
 wots_pk_init (const struct slh_hash *hash, const void *tree_ctx,
-	      unsigned keypair, struct slh_address_hash *ah,
-	      void *ctx)
+	      unsigned keypair, void *ctx)
 {
-  ah->type = bswap32_if_le (SLH_WOTS_PK);
-  ah->keypair = bswap32_if_le (keypair);
-  ah->height_chain = 0;
-  ah->index_hash = 0;
-  hash->init_hash (tree_ctx, ctx, ah);
+  struct slh_address_hash ah =
+    {
+      bswap32_if_le (SLH_WOTS_PK),
+      bswap32_if_le (keypair),
+      0, 0,
+    };
+  hash->init_hash (tree_ctx, ctx, &ah);
 }
 
 void
@@ -84,126 +167,63 @@ _wots_gen (const struct slh_hash *hash, const void *tree_ctx,
 	   const uint8_t *secret_seed,
 	   uint32_t keypair, uint8_t *pub, void *pub_ctx)
 {
-  struct slh_address_hash ah;
-  unsigned i;
-
-  wots_pk_init (hash, tree_ctx, keypair, &ah, pub_ctx);
+  uint8_t values[_WOTS_SIGNATURE_LENGTH * _SLH_DSA_128_SIZE];
+  uint8_t begin[_WOTS_SIGNATURE_LENGTH];
+  uint8_t end[_WOTS_SIGNATURE_LENGTH];
 
-  for (i = 0; i < _WOTS_SIGNATURE_LENGTH; i++)
-    {
-      uint8_t out[_SLH_DSA_128_SIZE];
-
-      /* Generate secret value. */
-      ah.type = bswap32_if_le (SLH_WOTS_PRF);
-      ah.height_chain = bswap32_if_le (i);
-      ah.index_hash = 0;
-      hash->secret (tree_ctx, &ah, secret_seed, out);
+  memset (begin, 0, sizeof (begin));
+  memset (end, WOTS_MAX_DIGIT, sizeof (end));
 
-      /* Hash chain. */
-      wots_chain (hash, tree_ctx, &ah, 0, 15, out, out);
+  wots_secrets (hash, tree_ctx, secret_seed, keypair, values);
+  wots_chains (hash, tree_ctx, keypair, begin, end, values);
 
-      hash->update (pub_ctx, _SLH_DSA_128_SIZE, out);
-    }
+  wots_pk_init (hash, tree_ctx, keypair, pub_ctx);
+  hash->update (pub_ctx, sizeof (values), values);
   hash->digest (pub_ctx, pub);
 }
 
-/* Produces signature hash corresponding to the ith message nybble. Modifies addr. */
-static void
-wots_sign_one (const struct slh_hash *hash, const void *tree_ctx,
-	       const uint8_t *secret_seed, uint32_t keypair,
-	       unsigned i, uint8_t msg,
-	       uint8_t *signature, void *pub_ctx)
-{
-  struct slh_address_hash ah;
-  uint8_t pub[_SLH_DSA_128_SIZE];
-  signature += i*_SLH_DSA_128_SIZE;
-
-  /* Generate secret value. */
-  ah.type = bswap32_if_le (SLH_WOTS_PRF);
-  ah.keypair = bswap32_if_le (keypair);
-  ah.height_chain = bswap32_if_le (i);
-  ah.index_hash = 0;
-  hash->secret (tree_ctx, &ah, secret_seed, signature);
-
-  /* Hash chain. */
-  wots_chain (hash, tree_ctx, &ah, 0, msg, signature, signature);
-
-  hash->update (pub_ctx, _SLH_DSA_128_SIZE,
-		wots_chain (hash, tree_ctx, &ah, msg, 15 - msg, signature, pub));
-}
-
 void
 _wots_sign (const struct slh_hash *hash, const void *tree_ctx,
 	    const uint8_t *secret_seed, unsigned keypair, const uint8_t *msg,
 	    uint8_t *signature, uint8_t *pub, void *pub_ctx)
 {
-  struct slh_address_hash ah;
-  unsigned i;
-  uint32_t csum;
+  uint8_t values[_WOTS_SIGNATURE_LENGTH * _SLH_DSA_128_SIZE];
+  uint8_t digits[_WOTS_SIGNATURE_LENGTH];
+  uint8_t zero[_WOTS_SIGNATURE_LENGTH];
+  uint8_t end[_WOTS_SIGNATURE_LENGTH];
 
-  wots_pk_init (hash, tree_ctx, keypair, &ah, pub_ctx);
+  wots_digits (msg, digits);
+  memset (zero, 0, sizeof (zero));
+  memset (end, WOTS_MAX_DIGIT, sizeof (end));
 
-  for (i = 0, csum = 15*32; i < _SLH_DSA_128_SIZE; i++)
-    {
-      uint8_t m0, m1;
-      m0 = msg[i] >> 4;
-      csum -= m0;
-      wots_sign_one (hash, tree_ctx, secret_seed, keypair, 2*i, m0, signature, pub_ctx);
-
-      m1 = msg[i] & 0xf;
-      csum -= m1;
-      wots_sign_one (hash, tree_ctx, secret_seed, keypair, 2*i + 1, m1, signature, pub_ctx);
-    }
+  wots_secrets (hash, tree_ctx, secret_seed, keypair, signature);
+  wots_chains (hash, tree_ctx, keypair, zero, digits, signature);
 
-  wots_sign_one (hash, tree_ctx, secret_seed, keypair, 32, csum >> 8, signature, pub_ctx);
-  wots_sign_one (hash, tree_ctx, secret_seed, keypair, 33, (csum >> 4) & 0xf, signature, pub_ctx);
-  wots_sign_one (hash, tree_ctx, secret_seed, keypair, 34, csum & 0xf, signature, pub_ctx);
+  /* Complete the chains, to get the public key. */
+  memcpy (values, signature, sizeof (values));
+  wots_chains (hash, tree_ctx, keypair, digits, end, values);
 
+  wots_pk_init (hash, tree_ctx, keypair, pub_ctx);
+  hash->update (pub_ctx, sizeof (values), values);
   hash->digest (pub_ctx, pub);
 }
 
-static void
-wots_verify_one (const struct slh_hash *hash, const void *tree_ctx,
-		 uint32_t keypair, unsigned i, uint8_t msg,
-		 const uint8_t *signature, void *pub_ctx)
-{
-  struct slh_address_hash ah;
-  uint8_t out[_SLH_DSA_128_SIZE];
-  signature += i*_SLH_DSA_128_SIZE;
-
-  ah.keypair = bswap32_if_le (keypair);
-  ah.height_chain = bswap32_if_le (i);
-
-  hash->update (pub_ctx, _SLH_DSA_128_SIZE,
-		wots_chain (hash, tree_ctx, &ah, msg, 15 - msg, signature, out));
-}
-
 void
 _wots_verify (const struct slh_hash *hash, const void *tree_ctx,
 	      unsigned keypair, const uint8_t *msg, const uint8_t *signature, uint8_t *pub,
 	      void *pub_ctx)
 {
-  struct slh_address_hash ah;
-  unsigned i;
-  uint32_t csum;
-
-  wots_pk_init (hash, tree_ctx, keypair, &ah, pub_ctx);
+  uint8_t values[_WOTS_SIGNATURE_LENGTH * _SLH_DSA_128_SIZE];
+  uint8_t digits[_WOTS_SIGNATURE_LENGTH];
+  uint8_t end[_WOTS_SIGNATURE_LENGTH];
 
-  for (i = 0, csum = 15*32; i < _SLH_DSA_128_SIZE; i++)
-    {
-      uint8_t m0, m1;
-      m0 = msg[i] >> 4;
-      csum -= m0;
-      wots_verify_one (hash, tree_ctx, keypair, 2*i, m0, signature, pub_ctx);
-
-      m1 = msg[i] & 0xf;
-      csum -= m1;
-      wots_verify_one (hash, tree_ctx, keypair, 2*i + 1, m1, signature, pub_ctx);
-    }
+  wots_digits (msg, digits);
+  memset (end, WOTS_MAX_DIGIT, sizeof (end));
 
-  wots_verify_one (hash, tree_ctx, keypair, 32, csum >> 8, signature, pub_ctx);
-  wots_verify_one (hash, tree_ctx, keypair, 33, (csum >> 4) & 0xf, signature, pub_ctx);
-  wots_verify_one (hash, tree_ctx, keypair, 34, csum & 0xf, signature, pub_ctx);
+  memcpy (values, signature, sizeof (values));
+  wots_chains (hash, tree_ctx, keypair, digits, end, values);
 
+  wots_pk_init (hash, tree_ctx, keypair, pub_ctx);
+  hash->update (pub_ctx, sizeof (values), values);
   hash->digest (pub_ctx, pub);
 }
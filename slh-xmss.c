@@ -39,9 +39,11 @@
 #include "slh-dsa-internal.h"
 
 static void
-xmss_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx, uint8_t *leaf)
+xmss_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx,
+	   unsigned n, uint8_t *leaf)
 {
-  _wots_gen (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx, leaf, ctx->scratch_ctx);
+  for (; n > 0; n--, idx++, leaf += _SLH_DSA_128_SIZE)
+    _wots_gen (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx, leaf, ctx->scratch_ctx);
 }
 
 static void
@@ -76,15 +78,52 @@ _xmss_gen (const struct slh_hash *hash,
 void
 _xmss_sign (const struct slh_merkle_ctx_secret *ctx, unsigned h,
 	    unsigned idx, const uint8_t *msg, uint8_t *signature, uint8_t *pub)
+{
+  _xmss_auth (ctx, h, idx, signature + WOTS_SIGNATURE_SIZE);
+  _xmss_sign_auth (ctx, h, idx, msg, signature, pub);
+}
+
+void
+_xmss_auth (const struct slh_merkle_ctx_secret *ctx, unsigned h,
+	    unsigned idx, uint8_t *auth)
+{
+  _merkle_sign (ctx, xmss_leaf, xmss_node, h, idx, auth);
+}
+
+void
+_xmss_sign_auth (const struct slh_merkle_ctx_secret *ctx, unsigned h,
+		 unsigned idx, const uint8_t *msg, uint8_t *signature, uint8_t *pub)
 {
   _wots_sign (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx,
 	      msg, signature, pub, ctx->scratch_ctx);
   signature += WOTS_SIGNATURE_SIZE;
 
-  _merkle_sign (ctx, xmss_leaf, xmss_node, h, idx, signature);
   _merkle_verify (&ctx->pub, xmss_node, h, idx, signature, pub);
 }
 
+void
+_xmss_tree (const struct slh_merkle_ctx_secret *ctx, unsigned h,
+	    uint8_t *nodes)
+{
+  const uint8_t *src;
+  unsigned height, i;
+
+  for (i = 0; i < (1U << h); i++)
+    xmss_leaf (ctx, i, 1, nodes + i * _SLH_DSA_128_SIZE);
+
+  for (height = 1, src = nodes; height <= h; height++)
+    {
+      unsigned count = 1U << (h - height);
+      nodes += 2 * count * _SLH_DSA_128_SIZE;
+      for (i = 0; i < count; i++)
+	xmss_node (&ctx->pub, height, i,
+		   src + 2*i * _SLH_DSA_128_SIZE,
+		   src + (2*i + 1) * _SLH_DSA_128_SIZE,
+		   nodes + i * _SLH_DSA_128_SIZE);
+      src = nodes;
+    }
+}
+
 void
 _xmss_verify (const struct slh_merkle_ctx_public *ctx, unsigned h,
 	      unsigned idx, const uint8_t *msg, const uint8_t *signature, uint8_t *pub,
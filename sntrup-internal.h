@@ -41,6 +41,8 @@
 #ifndef NETTLE_SNTRUP_INTERNAL_H
 #define NETTLE_SNTRUP_INTERNAL_H
 
+#include "nettle-internal.h"
+
 /* Name mangling */
 #define _sntrup_hash_prefix _nettle_sntrup_hash_prefix
 #define _sntrup_hash_session _nettle_sntrup_hash_session
@@ -48,10 +50,9 @@
 #define _sntrup_urandom32 _nettle_sntrup_urandom32
 #define _sntrup_encode _nettle_sntrup_encode
 #define _sntrup_decode _nettle_sntrup_decode
-#define _sntrup_mod_3 _nettle_sntrup_mod_3
-#define _sntrup761_mod_q _nettle_sntrup761_mod_q
 #define _sntrup761_short_random _nettle__sntrup761_short_random
 #define _sntrup761_small_encode _nettle_sntrup761_small_encode
+#define _sntrup761_mult _nettle_sntrup761_mult
 #define _sntrup761_Rq_mult_small _nettle_sntrup761_Rq_mult_small
 #define _sntrup761_encap_internal _nettle_sntrup761_encap_internal
 #define _sntrup761_encoding_Rq _nettle_sntrup761_encoding_Rq
@@ -132,11 +133,51 @@ void
 _sntrup_decode (unsigned n, const struct sntrup_encoding_step *step,
 		uint16_t *R, const uint8_t *S /* Must point at *end* of input. */);
 
-int8_t
-_sntrup_mod_3 (int16_t x);
+/* Reduce input to the canonical range -1,0,1 */
+static inline int8_t
+_sntrup_mod_3 (int16_t x)
+{
+  uint16_t ux, a, r;
+  /* x is either an canonical representative of Fq, |x| <= (q-1) / 2,
+     or result of polynomial multiplication in which case |x| <= 2p
+     which is a smaller range. */
+  assert_maybe (x <= SNTRUP761_Q12);
+  assert_maybe (x >= -SNTRUP761_Q12);
+
+  /* We want ((x + 1) mod q) - 1, but also add a multiple of 3 so we
+     can use unsigned arithmetic. And (q-1)/2 happens to be a multiple
+     of 3. */
+  ux = x + 1 + SNTRUP761_Q12;
+  /* Magic constant is ceil (2^16 / 3). */
+  a = ((uint32_t) 21846 * ux) >> 16;
+  r = ux - 3*a; /* Interpreted as two's complement, |r| < 3 */
+  r += (r >> 14);
+  assert_maybe (r < 3);
+  return (int8_t) r - 1;
+}
 
-int16_t
-_sntrup761_mod_q (int32_t x);
+/* Reduce input to the canonical range -(q-1)/2...(q-1)/2 */
+static inline int16_t
+_sntrup761_mod_q (int32_t x)
+{
+  uint32_t ux, a, r;
+  /* When called from Rq_mult_small, inputs are ideally limited to
+     w*(q-1), but to allow overweight inputs and small coeffients
+     premultiplied by 3, we must allow inputs up to 3*p*(q-1). When
+     called from Fq_recip and Rq_recip3 inputs may be up to 2 q^2,
+     which is a larger range. */
+  assert_maybe (x < 2*SNTRUP761_Q * SNTRUP761_Q);
+  assert_maybe (x > -2*SNTRUP761_Q * SNTRUP761_Q);
+  /* We want ((x + (q-1)/2) mod q) - (q-1)/2, but also add a multiple
+     of q so we can use unsigned arithmetic. */
+  ux = x + SNTRUP761_Q12 + 2*SNTRUP761_Q * SNTRUP761_Q;
+  /* Magic constant is ceil (2^32 / q) */
+  a = ((uint64_t) 935519 * ux) >> 32;
+  r = ux - a * SNTRUP761_Q; /* Interpreted as two's complement, |r| < q */
+  r += ((r >> 16) & SNTRUP761_Q);
+  assert_maybe ((uint16_t) r < SNTRUP761_Q);
+  return (int32_t) (uint16_t) r - SNTRUP761_Q12;
+}
 
 /* Polynomial typedefs, passed by reference. */
 /* Coefficients mod 3, canonically represented as -1, 0, 1. But this
@@ -153,6 +194,12 @@ _sntrup761_short_random (sntrup761_R3_t out, void *random_ctx, nettle_random_fun
 void
 _sntrup761_small_encode (uint8_t *s, const sntrup761_R3_t f);
 
+/* h = f*g mod x^p - x - 1, with no reduction of the coefficients.
+   Coefficients of f must be bounded by (q-1)/2, and coefficients of g
+   by 3, in absolute value. The output may overlap the inputs. */
+void
+_sntrup761_mult (int32_t *h, const int32_t *f, const int32_t *g);
+
 void
 _sntrup761_Rq_mult_small (sntrup761_Rq_t h, const sntrup761_Rq_t f, const sntrup761_R3_t g);
 
@@ -72,32 +72,18 @@ R3_fromRq (sntrup761_R3_t out, const sntrup761_Rq_t r)
 static void
 R3_mult (sntrup761_R3_t h, const sntrup761_R3_t f, const sntrup761_R3_t g)
 {
-  int16_t fg[SNTRUP761_P + SNTRUP761_P - 1];
-  int i, j;
+  int32_t fw[SNTRUP761_P], gw[SNTRUP761_P];
+  int i;
 
   for (i = 0; i < SNTRUP761_P; i++)
     {
-      int16_t result;
-      for (result = 0, j = 0; j <= i; j++)
-	result += f[j] * g[i - j];
-      fg[i] = result;
-    }
-  for (i = SNTRUP761_P; i < SNTRUP761_P + SNTRUP761_P - 1; i++)
-    {
-      int16_t result;
-      for (result = 0, j = i - SNTRUP761_P + 1; j < SNTRUP761_P; j++)
-	result += f[j] * g[i - j];
-      fg[i] = result;
-    }
-
-  for (i = SNTRUP761_P + SNTRUP761_P - 2; i >= SNTRUP761_P; --i)
-    {
-      fg[i - SNTRUP761_P] += + fg[i];
-      fg[i - SNTRUP761_P + 1] += fg[i];
+      fw[i] = f[i];
+      gw[i] = g[i];
     }
+  _sntrup761_mult (fw, fw, gw);
 
   for (i = 0; i < SNTRUP761_P; i++)
-    h[i] = _sntrup_mod_3 (fg[i]);
+    h[i] = _sntrup_mod_3 (fw[i]);
 }
 
 /* Decodes a polynomial with coefficients supposedly all being in {-1,
@@ -101,86 +101,168 @@ Fq_recip (int16_t a)
   return x;
 }
 
+/* Bitsliced polynomials over F_3, with p + 1 coefficients.
+   Coefficient i is represented by bit i of nz, set if the coefficient
+   is non-zero, and bit i of neg, set if the coefficient is -1. */
+#define R3_WORDS ((SNTRUP761_P + 64) / 64)
+#define R3_HIGH_MASK (((uint64_t) 1 << ((SNTRUP761_P + 1) % 64)) - 1)
+
+struct r3_bitsliced
+{
+  uint64_t nz[R3_WORDS];
+  uint64_t neg[R3_WORDS];
+};
+
+static void
+r3_bitsliced_set (struct r3_bitsliced *x, unsigned i, int c)
+{
+  x->nz[i / 64] |= (uint64_t) (c & 1) << (i % 64);
+  x->neg[i / 64] |= (uint64_t) ((c & 2) >> 1) << (i % 64);
+}
+
+static int
+r3_bitsliced_get (const struct r3_bitsliced *x, unsigned i)
+{
+  return (int) ((x->nz[i / 64] >> (i % 64)) & 1)
+    - 2 * (int) ((x->neg[i / 64] >> (i % 64)) & 1);
+}
+
+/* x += c y, where the masks cn and cs are all ones if c is non-zero
+   and c == -1, respectively. */
+static void
+r3_bitsliced_addmul (struct r3_bitsliced *x, const struct r3_bitsliced *y,
+		     uint64_t cn, uint64_t cs)
+{
+  unsigned i;
+  for (i = 0; i < R3_WORDS; i++)
+    {
+      uint64_t xn = x->nz[i];
+      uint64_t xs = x->neg[i];
+      uint64_t yn = y->nz[i] & cn;
+      uint64_t ys = (y->neg[i] ^ (y->nz[i] & cs)) & cn;
+
+      /* Sum is zero if both are zero, or if they are of opposite
+	 signs. Sum is -1 for -1 + 0, 0 + -1, and 1 + 1. */
+      x->nz[i] = (xn | yn) & ~(xn & yn & (xs ^ ys));
+      x->neg[i] = (xs & ~yn) | (ys & ~xn) | (xn & yn & ~xs & ~ys);
+    }
+}
+
+static void
+r3_bitsliced_cswap (struct r3_bitsliced *x, struct r3_bitsliced *y, uint64_t mask)
+{
+  unsigned i;
+  for (i = 0; i < R3_WORDS; i++)
+    {
+      uint64_t t = mask & (x->nz[i] ^ y->nz[i]);
+      x->nz[i] ^= t;
+      y->nz[i] ^= t;
+      t = mask & (x->neg[i] ^ y->neg[i]);
+      x->neg[i] ^= t;
+      y->neg[i] ^= t;
+    }
+}
+
+/* Multiplies by x, discarding the coefficient shifted out. */
+static void
+r3_bitsliced_shift_up (struct r3_bitsliced *x)
+{
+  unsigned i;
+  for (i = R3_WORDS - 1; i > 0; i--)
+    {
+      x->nz[i] = (x->nz[i] << 1) | (x->nz[i-1] >> 63);
+      x->neg[i] = (x->neg[i] << 1) | (x->neg[i-1] >> 63);
+    }
+  x->nz[0] <<= 1;
+  x->neg[0] <<= 1;
+  x->nz[R3_WORDS - 1] &= R3_HIGH_MASK;
+  x->neg[R3_WORDS - 1] &= R3_HIGH_MASK;
+}
+
+/* Divides by x, discarding the constant coefficient. */
+static void
+r3_bitsliced_shift_down (struct r3_bitsliced *x)
+{
+  unsigned i;
+  for (i = 0; i < R3_WORDS - 1; i++)
+    {
+      x->nz[i] = (x->nz[i] >> 1) | (x->nz[i+1] << 63);
+      x->neg[i] = (x->neg[i] >> 1) | (x->neg[i+1] << 63);
+    }
+  x->nz[R3_WORDS - 1] >>= 1;
+  x->neg[R3_WORDS - 1] >>= 1;
+}
+
 /* returns 1 if recip succeeded; else 0 */
 static int
 R3_recip (sntrup761_R3_t out, const sntrup761_R3_t in)
 {
-  /* Working polynomials have non-canonical coefficients. After 8
-     iterations, coefficients may grow up to size fibonacci (11) ==
-     89, which still fit in int8_t. */
-  int8_t f[SNTRUP761_P + 1], g[SNTRUP761_P + 1], v[SNTRUP761_P + 1], r[SNTRUP761_P + 1];
-  int i, loop, delta;
-  int sign, swap, t;
+  /* Same divstep iteration as in Rq_recip3 below, but with all
+     coefficients bitsliced, and hence always canonical. */
+  struct r3_bitsliced f, g, v, r;
+  int i, loop, delta, sign;
 
-  v[0] = 0;
-  r[0] = 1;
-  for (i = 1; i < SNTRUP761_P + 1; ++i)
-    v[i] = r[i] = 0;
+  memset (&f, 0, sizeof (f));
+  memset (&g, 0, sizeof (g));
+  memset (&v, 0, sizeof (v));
+  memset (&r, 0, sizeof (r));
 
-  f[0] = 1;
-  for (i = 1; i < SNTRUP761_P - 1; ++i)
-    f[i] = 0;
-  f[SNTRUP761_P - 1] = f[SNTRUP761_P] = -1;
+  r3_bitsliced_set (&r, 0, 1);
+  r3_bitsliced_set (&f, 0, 1);
+  r3_bitsliced_set (&f, SNTRUP761_P - 1, -1);
+  r3_bitsliced_set (&f, SNTRUP761_P, -1);
 
   for (i = 0; i < SNTRUP761_P; ++i)
-    g[SNTRUP761_P - 1 - i] = in[i];
-  g[SNTRUP761_P] = 0;
+    r3_bitsliced_set (&g, SNTRUP761_P - 1 - i, in[i]);
 
   delta = 1;
 
   for (loop = 0; loop < 2 * SNTRUP761_P - 1; ++loop)
     {
-      for (i = SNTRUP761_P; i > 0; --i)
-	v[i] = v[i - 1];
-      v[0] = 0;
+      uint64_t f0n, f0s, g0n, g0s, cn, cs;
+      int swap;
 
-      /* Always canonicalize the values controlling the iteration
-	 update. */
-      g[0] = _sntrup_mod_3 (g[0]);
-      f[0] = _sntrup_mod_3 (f[0]);
+      r3_bitsliced_shift_up (&v);
 
-      if (loop && !(loop & 7))
-	{
-	  /* Re-canonicalize everything. */
-	  r[0] = _sntrup_mod_3 (r[0]);
-	  for (i = 1; i < SNTRUP761_P + 1; ++i)
-	    {
-	      g[i] = _sntrup_mod_3 (g[i]);
-	      f[i] = _sntrup_mod_3 (f[i]);
-	      v[i] = _sntrup_mod_3 (v[i]);
-	      r[i] = _sntrup_mod_3 (r[i]);
-	    }
-	}
-      sign = -g[0] * f[0];
-      swap = uint16_highbit_mask (-delta) & uint16_nonzero_mask (g[0]);
+      f0n = -(f.nz[0] & 1);
+      f0s = -(f.neg[0] & 1);
+      g0n = -(g.nz[0] & 1);
+      g0s = -(g.neg[0] & 1);
+      /* Masks for sign = -g0 f0. */
+      cn = g0n & f0n;
+      cs = cn & ~(g0s ^ f0s);
+
+      swap = uint16_highbit_mask (-delta) & -(int) (g.nz[0] & 1);
       delta ^= swap & (delta ^ -delta);
       delta += 1;
 
-      for (i = 0; i < SNTRUP761_P + 1; ++i)
-	{
-	  t = swap & (f[i] ^ g[i]);
-	  f[i] ^= t;
-	  g[i] ^= t;
-	  t = swap & (v[i] ^ r[i]);
-	  v[i] ^= t;
-	  r[i] ^= t;
-	}
+      r3_bitsliced_cswap (&f, &g, -(uint64_t) (swap & 1));
+      r3_bitsliced_cswap (&v, &r, -(uint64_t) (swap & 1));
 
-      for (i = 0; i < SNTRUP761_P; ++i)
-	g[i] = g[i+1] + sign * f[i+1];
-      g[SNTRUP761_P] = 0;
+      r3_bitsliced_addmul (&g, &f, cn, cs);
+      r3_bitsliced_shift_down (&g);
 
-      for (i = 0; i < SNTRUP761_P + 1; ++i)
-	r[i] += sign * v[i];
+      r3_bitsliced_addmul (&r, &v, cn, cs);
     }
 
-  sign = _sntrup_mod_3 (f[0]);
+  sign = r3_bitsliced_get (&f, 0);
   for (i = 0; i < SNTRUP761_P; ++i)
-    out[i] = _sntrup_mod_3 (sign * v[SNTRUP761_P - 1 - i]);
+    out[i] = sign * r3_bitsliced_get (&v, SNTRUP761_P - 1 - i);
 
   return delta == 0;
 }
 
+/* The divstep loop below never touches coefficients that are known to
+   be zero, based only on the iteration count. Before iteration i, v
+   and r have degree at most i. And if n_f and n_g bound the lengths
+   of f and g, i.e., one plus the index of the last possibly non-zero
+   coefficient, delta = n_f - n_g is preserved by each iteration,
+   while n_f + n_g decreases by one; hence both are bounded by
+   2p + 1 - i. Since the bounds are public, this does not leak any
+   information. */
+#define RECIP_VLEN(loop) ((loop) < SNTRUP761_P - 1 ? (loop) + 2 : SNTRUP761_P + 1)
+#define RECIP_FLEN(loop) ((loop) > SNTRUP761_P ? 2*SNTRUP761_P + 1 - (loop) : SNTRUP761_P + 1)
+
 /* out = 1/(3*in) in Rq */
 static void
 Rq_recip3 (sntrup761_Rq_t out, const sntrup761_R3_t in)
@@ -209,7 +291,10 @@ Rq_recip3 (sntrup761_Rq_t out, const sntrup761_R3_t in)
 
   for (loop = 0; loop < 2 * SNTRUP761_P - 1; ++loop)
     {
-      for (i = SNTRUP761_P; i > 0; --i)
+      int vlen = RECIP_VLEN (loop);
+      int flen = RECIP_FLEN (loop);
+
+      for (i = vlen - 1; i > 0; --i)
 	v[i] = v[i - 1];
       v[0] = 0;
 
@@ -217,11 +302,14 @@ Rq_recip3 (sntrup761_Rq_t out, const sntrup761_R3_t in)
       delta ^= swap & (delta ^ -delta);
       delta += 1;
 
-      for (i = 0; i < SNTRUP761_P + 1; ++i)
+      for (i = 0; i < flen; ++i)
 	{
 	  t = swap & (f[i] ^ g[i]);
 	  f[i] ^= t;
 	  g[i] ^= t;
+	}
+      for (i = 0; i < vlen; ++i)
+	{
 	  t = swap & (v[i] ^ r[i]);
 	  v[i] ^= t;
 	  r[i] ^= t;
@@ -229,11 +317,11 @@ Rq_recip3 (sntrup761_Rq_t out, const sntrup761_R3_t in)
 
       f0 = f[0];
       g0 = g[0];
-      for (i = 0; i < SNTRUP761_P; ++i)
+      for (i = 0; i < flen - 1; ++i)
 	g[i] = _sntrup761_mod_q (f0 * g[i+1] - g0 * f[i+1]);
-      g[SNTRUP761_P] = 0;
+      g[flen - 1] = 0;
 
-      for (i = 0; i < SNTRUP761_P + 1; ++i)
+      for (i = 0; i < vlen; ++i)
 	r[i] = _sntrup761_mod_q (f0 * r[i] - g0 * v[i]);
     }
 
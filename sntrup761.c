@@ -248,88 +248,102 @@ _sntrup_encode (const struct sntrup_encoding_step *step,
     }
 }
 
-/* ----- arithmetic mod 3 */
+/* ----- polynomials mod q */
 
-/* Reduce input to the canonical range -1,0,1 */
-int8_t
-_sntrup_mod_3 (int16_t x)
-{
-  uint16_t ux, a, r;
-  /* x is either an canonical representative of Fq, |x| <= (q-1) / 2,
-     or result of polynomial multiplication in which case |x| <= 2p
-     which is a smaller range. */
-  assert_maybe (x <= SNTRUP761_Q12);
-  assert_maybe (x >= -SNTRUP761_Q12);
-
-  /* We want ((x + 1) mod q) - 1, but also add a multiple of 3 so we
-     can use unsigned arithmetic. And (q-1)/2 happens to be a multiple
-     of 3. */
-  ux = x + 1 + SNTRUP761_Q12;
-  /* Magic constant is ceil (2^16 / 3). */
-  a = ((uint32_t) 21846 * ux) >> 16;
-  r = ux - 3*a; /* Interpreted as two's complement, |r| < 3 */
-  r += (r >> 14);
-  assert_maybe (r < 3);
-  return (int8_t) r - 1;
-}
+/* Polynomials are zero padded to this size for multiplication, 3 *
+   2^8. */
+#define MULT_SIZE 768
+/* Smaller sizes use schoolbook multiplication. */
+#define KARATSUBA_THRESHOLD 32
 
-/* ----- arithmetic mod q */
+/* Computes {rp, 2n-1} = {ap, n} * {bp, n}, using Karatsuba
+   multiplication. Needs scratch space of 4n elements at tp.
 
-/* Reduce input to the canonical range -(q-1)/2...(q-1)/2 */
-int16_t
-_sntrup761_mod_q (int32_t x)
+   Each level of recursion doubles the size of the coefficients of the
+   half-size operands, in the worst case. With 5 levels, and input
+   coefficients bounded by (q-1)/2 and 3, products in the base case are
+   bounded by 24 * 2^5 (q-1)/2 * 2^5 3 < 2^28. */
+static void
+poly_mul (int32_t *rp, const int32_t *ap, const int32_t *bp,
+	  unsigned n, int32_t *tp)
 {
-  uint32_t ux;
-  /* When called from Rq_mult_small, inputs are ideally limited to
-     w*(q-1), but to allow overweight inputs and small coeffients
-     premultiplied by 3, we must allow inputs up to 3*p*(q-1). When
-     called from Fq_recip and Rq_recip3 inputs may be up to 2 q^2,
-     which is a larger range. */
-  assert_maybe (x < 2*SNTRUP761_Q * SNTRUP761_Q);
-  assert_maybe (x > -2*SNTRUP761_Q * SNTRUP761_Q);
-  /* We want ((x + (q-1)/2) mod q) - (q-1)/2, but also add a multiple
-     of q so we can use unsigned arithmetic. */
-  ux = x + SNTRUP761_Q12 + 2*SNTRUP761_Q * SNTRUP761_Q;
-  /* Magic constant is ceil (2^32 / q) */
-  return (int32_t) uint32_16_mod (ux, SNTRUP761_Q, 935519) - SNTRUP761_Q12;
+  unsigned i, j;
+
+  if (n < KARATSUBA_THRESHOLD || (n & 1))
+    {
+      for (i = 0; i < 2*n - 1; i++)
+	rp[i] = 0;
+      for (i = 0; i < n; i++)
+	for (j = 0; j < n; j++)
+	  rp[i + j] += ap[i] * bp[j];
+    }
+  else
+    {
+      unsigned h = n / 2;
+      /* Sums of low and high halves, and their product. */
+      int32_t *as = tp;
+      int32_t *bs = tp + h;
+      int32_t *m = tp + n;
+
+      for (i = 0; i < h; i++)
+	{
+	  as[i] = ap[i] + ap[h + i];
+	  bs[i] = bp[i] + bp[h + i];
+	}
+      poly_mul (m, as, bs, h, tp + 2*n);
+      poly_mul (rp, ap, bp, h, tp + 2*n);
+      poly_mul (rp + n, ap + h, bp + h, h, tp + 2*n);
+      rp[n - 1] = 0;
+
+      for (i = 0; i < n - 1; i++)
+	m[i] -= rp[i] + rp[n + i];
+      for (i = 0; i < n - 1; i++)
+	rp[h + i] += m[i];
+    }
 }
 
+void
+_sntrup761_mult (int32_t *h, const int32_t *f, const int32_t *g)
+{
+  int32_t fp[MULT_SIZE], gp[MULT_SIZE];
+  int32_t fg[2*MULT_SIZE - 1];
+  int32_t scratch[4*MULT_SIZE];
+  int i;
+
+  memcpy (fp, f, SNTRUP761_P * sizeof (*fp));
+  memcpy (gp, g, SNTRUP761_P * sizeof (*gp));
+  for (i = SNTRUP761_P; i < MULT_SIZE; i++)
+    fp[i] = gp[i] = 0;
 
-/* ----- polynomials mod q */
+  poly_mul (fg, fp, gp, MULT_SIZE, scratch);
+
+  for (i = SNTRUP761_P + SNTRUP761_P - 2; i >= SNTRUP761_P; --i)
+    {
+      fg[i - SNTRUP761_P] += fg[i];
+      fg[i - SNTRUP761_P + 1] += fg[i];
+    }
+  memcpy (h, fg, SNTRUP761_P * sizeof (*h));
+}
 
 /* h = f*g in the ring Rq. Tolerates g coeffients outside of the proper
    range, up to absolute value 3. */
 void
 _sntrup761_Rq_mult_small (sntrup761_Rq_t h, const sntrup761_Rq_t f, const sntrup761_R3_t g)
 {
-  int32_t fg[SNTRUP761_P + SNTRUP761_P - 1];
-  int i, j;
+  int32_t fw[SNTRUP761_P], gw[SNTRUP761_P];
+  int i;
 
   for (i = 0; i < SNTRUP761_P; i++)
     {
-      int32_t result;
-      for (result = 0, j = 0; j <= i; j++)
-	result +=  f[j] * (int32_t) g[i - j];
-      fg[i] = result;
-    }
-  for (i = SNTRUP761_P; i < SNTRUP761_P + SNTRUP761_P - 1; i++)
-    {
-      int32_t result;
-      for (result = 0, j = i - SNTRUP761_P + 1; j < SNTRUP761_P; j++)
-	result += f[j] * (int32_t) g[i - j];
-      fg[i] = result;
-    }
-
-  for (i = SNTRUP761_P + SNTRUP761_P - 2; i >= SNTRUP761_P; --i)
-    {
-      fg[i - SNTRUP761_P] += fg[i];
-      fg[i - SNTRUP761_P + 1] += fg[i];
+      fw[i] = f[i];
+      gw[i] = g[i];
     }
+  _sntrup761_mult (fw, fw, gw);
 
   for (i = 0; i < SNTRUP761_P; i++)
     /* Coeffients to be reduced are bounded by
        2*3*p*(q-1)/2 = 10478970 < q*q. */
-    h[i] = _sntrup761_mod_q (fg[i]);
+    h[i] = _sntrup761_mod_q (fw[i]);
 }
 
 /* ----- underlying hash function */
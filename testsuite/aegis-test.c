@@ -0,0 +1,260 @@
+#include "testutils.h"
+#include "aegis128l.h"
+#include "aegis256.h"
+
+void
+test_main(void)
+{
+  /* Test vectors from draft-irtf-cfrg-aegis-aead. */
+  test_aead (&nettle_aegis128l, NULL,
+	     SHEX("10010000000000000000000000000000"),
+	     SHEX(""),
+	     SHEX("00000000000000000000000000000000"),
+	     SHEX("c1c0e58bd913006feba00f4b3cc3594e"),
+	     SHEX("10000200000000000000000000000000"),
+	     SHEX("abe0ece80c24868a226a35d16bdae37a"));
+
+  test_aead (&nettle_aegis128l, NULL,
+	     SHEX("10010000000000000000000000000000"),
+	     SHEX(""),
+	     SHEX(""),
+	     SHEX(""),
+	     SHEX("10000200000000000000000000000000"),
+	     SHEX("c2b879a67def9d74e6c14f708bbcc9b4"));
+
+  test_aead (&nettle_aegis128l, NULL,
+	     SHEX("10010000000000000000000000000000"),
+	     SHEX("0001020304050607"),
+	     SHEX("000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"),
+	     SHEX("79d94593d8c2119d7e8fd9b8fc77845c"
+		  "5c077a05b2528b6ac54b563aed8efe84"),
+	     SHEX("10000200000000000000000000000000"),
+	     SHEX("cc6f3372f6aa1bb82388d695c3962d9a"));
+
+  test_aead (&nettle_aegis128l, NULL,
+	     SHEX("10010000000000000000000000000000"),
+	     SHEX("0001020304050607"),
+	     SHEX("000102030405060708090a0b0c0d"),
+	     SHEX("79d94593d8c2119d7e8fd9b8fc77"),
+	     SHEX("10000200000000000000000000000000"),
+	     SHEX("5c04b3dba849b2701effbe32c7f0fab7"));
+
+  test_aead (&nettle_aegis256, NULL,
+	     SHEX("10010000000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX(""),
+	     SHEX("00000000000000000000000000000000"),
+	     SHEX("754fc3d8c973246dcc6d741412a4b236"),
+	     SHEX("10000200000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX("3fe91994768b332ed7f570a19ec5896e"));
+
+  test_aead (&nettle_aegis256, NULL,
+	     SHEX("10010000000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX(""),
+	     SHEX(""),
+	     SHEX(""),
+	     SHEX("10000200000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX("e3def978a0f054afd1e761d7553afba3"));
+
+  test_aead (&nettle_aegis256, NULL,
+	     SHEX("10010000000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX("0001020304050607"),
+	     SHEX("000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"),
+	     SHEX("f373079ed84b2709faee373584585d60"
+		  "accd191db310ef5d8b11833df9dec711"),
+	     SHEX("10000200000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX("8d86f91ee606e9ff26a01b64ccbdd91d"));
+
+  test_aead (&nettle_aegis256, NULL,
+	     SHEX("10010000000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX("0001020304050607"),
+	     SHEX("000102030405060708090a0b0c0d"),
+	     SHEX("f373079ed84b2709faee37358458"),
+	     SHEX("10000200000000000000000000000000"
+		  "00000000000000000000000000000000"),
+	     SHEX("c60b9c2d33ceb058f96e6dd03c215652"));
+
+  /* Longer messages, generated with the C implementation, to check
+     native implementations. At least 17 blocks of both associated
+     data and message, plus a partial block, so that test_aead's
+     splitting exercises every exit of the unrolled loops and at
+     least one full iteration. */
+  test_aead (&nettle_aegis128l, NULL,
+	     SHEX("202122232425262728292a2b2c2d2e2f"),
+	     SHEX("000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"
+		  "404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"
+		  "606162636465666768696a6b6c6d6e6f"
+		  "707172737475767778797a7b7c7d7e7f"
+		  "808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		  "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		  "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		  "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+		  "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		  "000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"
+		  "404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"
+		  "606162636465666768696a6b6c6d6e6f"
+		  "707172737475767778797a7b7c7d7e7f"
+		  "808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		  "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		  "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		  "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+		  "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		  "000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "20212223242526"),
+	     SHEX("808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		  "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		  "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		  "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+		  "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		  "000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"
+		  "404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"
+		  "606162636465666768696a6b6c6d6e6f"
+		  "707172737475767778797a7b7c7d7e7f"
+		  "808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		  "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		  "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		  "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+		  "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		  "000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"
+		  "404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"
+		  "606162636465666768696a6b6c6d6e6f"
+		  "707172737475767778797a7b7c7d7e7f"
+		  "808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aa"),
+	     SHEX("b9cf168220eefe0790d36c21eac43210"
+		  "1d1f141888139cdaffecde03fcc7d7a0"
+		  "bbb3c6d7644ba9e0a312259958de14c9"
+		  "874dc844d89a116874880d3962ebb719"
+		  "440e1d8a9768740a6c46b9ec2ce9b363"
+		  "8bd864f8cde771c4d3815c7e7f79b51b"
+		  "90cb75486a918e8ad45aec098791d809"
+		  "445117cb02a107d2c59f25a34fb9fd1b"
+		  "a60cb8c340fc16c5b70a0ba1df5b6b96"
+		  "8f5023b85fa2c877813930a0e4b9c0c6"
+		  "7e86bec41aba9c67a0fd5903586a376c"
+		  "26eab46fde186fdd693906a0004c0cfe"
+		  "8ce5ea8517b938cb99fc9ae2c6a5e36e"
+		  "2283bcedcd58ad2b65a6c2bd2625f5ac"
+		  "d8cccb34261dcc5ae1875f51713ee206"
+		  "ffe1b09d4dbe859cb4c7e97fc4382b16"
+		  "a9fed11afc2637eb40fba712a36a624b"
+		  "3d2bd072ed15d16cddbb2d9e6e7867c0"
+		  "4eba7a39ce644d3b2ccdfd758b8813ff"
+		  "233e8027d15ff64a3f82d7e1b40c1049"
+		  "88932c812ddc3f8277abf8e0ede43255"
+		  "86fe90263c5b845728832a78f988950a"
+		  "572e54c615b93b21c390385b0ced5cd4"
+		  "7e18c2c4546137e6918be91faffd82d4"
+		  "d23433421724ed3d65f49587871185d9"
+		  "863384e9e487ed3def954d311d23ac6b"
+		  "88ec03fe0f43790987fa068aa2b61391"
+		  "e268eb5060de88b311e6d33eca834ba7"
+		  "2ba7f2e0a2122c140eb8286f5af9d82b"
+		  "4ed2923e88de3cca4dc6549c68a33f0c"
+		  "cd390236a6da5e56c57a237525069473"
+		  "c1e4134574e368f687fc6ae29d8f6280"
+		  "115c5c9f4ce2e3512f39f7f9dffb5dda"
+		  "8a2b00095c6df9652c10d172fdf742ed"
+		  "5e7499345b1e517ba6619d"),
+	     SHEX("404142434445464748494a4b4c4d4e4f"),
+	     SHEX("5b261a599d9cb1d12a41b6ecbeeefbb2"));
+
+  test_aead (&nettle_aegis256, NULL,
+	     SHEX("202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"),
+	     SHEX("000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"
+		  "404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"
+		  "606162636465666768696a6b6c6d6e6f"
+		  "707172737475767778797a7b7c7d7e7f"
+		  "808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		  "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		  "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		  "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+		  "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		  "000102030405060708090a0b0c0d0e0f"
+		  "10111213141516"),
+	     SHEX("808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a9b9c9d9e9f"
+		  "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+		  "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+		  "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		  "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+		  "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+		  "000102030405060708090a0b0c0d0e0f"
+		  "101112131415161718191a1b1c1d1e1f"
+		  "202122232425262728292a2b2c2d2e2f"
+		  "303132333435363738393a3b3c3d3e3f"
+		  "404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"
+		  "606162636465666768696a6b6c6d6e6f"
+		  "707172737475767778797a7b7c7d7e7f"
+		  "808182838485868788898a8b8c8d8e8f"
+		  "909192939495969798999a"),
+	     SHEX("bfdd3f95fad9ab4908f6f54c137f80db"
+		  "4fb360e06c2b07bbb044480a55e74a75"
+		  "7fe037b48ca39878048ebddb889f28aa"
+		  "48a883a1aff63d14f8ce4da02a4ff286"
+		  "8ee39c450fdfc502bc3fe080c4532416"
+		  "fdbbc789b539e9788ca0e8ce766615a3"
+		  "ef209dc681212e47610ddea9a6c42072"
+		  "eef0f9fc953fb82abc79f912cab0d84c"
+		  "a2c753bc371308fc48f2c0bf43285b52"
+		  "b33c95837547b203797bd8fc9322c466"
+		  "7248155740556266fa488af28aa77dae"
+		  "059e21e9121a28a285c67cfdeabb7d48"
+		  "6f03f0b03628e04e2c532ef0e845e058"
+		  "6f0e8f4656c99047444271305b5449a0"
+		  "295513061d07ccec56440742a0f18d2e"
+		  "c569f5d11dd433f62d89fb048b27d279"
+		  "75196368577733d56a275d54a41a9b1c"
+		  "bd2acdf86130d60f7cc82d"),
+	     SHEX("404142434445464748494a4b4c4d4e4f"
+		  "505152535455565758595a5b5c5d5e5f"),
+	     SHEX("1bbcef1c3bae1d80b0bc596686249874"));
+}
@@ -149,6 +149,119 @@ test_specific_unwrap_fail (struct nettle_specific_wrap *w,
     }
 }
 
+static void
+test_wrap_pad (const struct tstring *key,
+	       const struct tstring *cleartext,
+	       const struct tstring *ciphertext)
+{
+  struct aes192_ctx ctx;
+  uint8_t data[40];
+  uint8_t bad[40];
+  size_t length;
+
+  ASSERT (ciphertext->length
+	  == NIST_KEYWRAP16_PAD_LENGTH (cleartext->length));
+
+  aes192_set_encrypt_key (&ctx, key->data);
+  nist_keywrap16_pad (&ctx, (nettle_cipher_func *) aes192_encrypt,
+		      cleartext->length, data, cleartext->data);
+  ASSERT (MEMEQ (ciphertext->length, data, ciphertext->data));
+
+  aes192_set_decrypt_key (&ctx, key->data);
+  ASSERT (nist_keyunwrap16_pad (&ctx, (nettle_cipher_func *) aes192_decrypt,
+				ciphertext->length, &length,
+				data, ciphertext->data));
+  ASSERT (length == cleartext->length);
+  ASSERT (MEMEQ (length, data, cleartext->data));
+
+  memcpy (bad, ciphertext->data, ciphertext->length);
+  bad[ciphertext->length - 1] ^= 1;
+  ASSERT (!nist_keyunwrap16_pad (&ctx, (nettle_cipher_func *) aes192_decrypt,
+				 ciphertext->length, &length, data, bad));
+}
+
+/* Compare the batch functions with separate wraps, for more keys
+   than are processed together. */
+#define BATCH_COUNT 11
+
+static void
+test_wrap_batch (size_t length)
+{
+  static const uint8_t iv[8] = {
+    0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6
+  };
+  struct aes128_ctx ctx;
+  uint8_t keys[BATCH_COUNT * 32];
+  uint8_t wrapped[BATCH_COUNT * 40];
+  uint8_t padwrapped[BATCH_COUNT * 40];
+  uint8_t unwrapped[BATCH_COUNT * 40];
+  uint8_t ref[40];
+  size_t lengths[BATCH_COUNT];
+  int valid[BATCH_COUNT];
+  size_t padded = NIST_KEYWRAP16_PAD_LENGTH (length);
+  unsigned i;
+
+  for (i = 0; i < sizeof (keys); i++)
+    keys[i] = i * 13 + length;
+
+  aes128_set_encrypt_key (&ctx, H("000102030405060708090A0B0C0D0E0F"));
+
+  if (length % 8 == 0)
+    {
+      aes128_keywrap_batch (&ctx, iv, BATCH_COUNT, length + 8, wrapped, keys);
+      for (i = 0; i < BATCH_COUNT; i++)
+	{
+	  aes128_keywrap (&ctx, iv, length + 8, ref, keys + i * length);
+	  ASSERT (MEMEQ (length + 8, wrapped + i * (length + 8), ref));
+	}
+    }
+
+  nist_keywrap16_pad_batch (&ctx, (nettle_cipher_func *) aes128_encrypt,
+			    BATCH_COUNT, length, padwrapped, keys);
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      nist_keywrap16_pad (&ctx, (nettle_cipher_func *) aes128_encrypt,
+			  length, ref, keys + i * length);
+      ASSERT (MEMEQ (padded, padwrapped + i * padded, ref));
+    }
+
+  aes128_set_decrypt_key (&ctx, H("000102030405060708090A0B0C0D0E0F"));
+
+  /* Corrupt one of the wrapped keys. */
+  padwrapped[3 * padded + 5] ^= 0x10;
+  ASSERT (!nist_keyunwrap16_pad_batch (&ctx,
+				       (nettle_cipher_func *) aes128_decrypt,
+				       BATCH_COUNT, padded, lengths,
+				       unwrapped, padwrapped, valid));
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      ASSERT (valid[i] == (i != 3));
+      if (valid[i])
+	{
+	  ASSERT (lengths[i] == length);
+	  ASSERT (MEMEQ (length, unwrapped + i * (padded - 8),
+			 keys + i * length));
+	}
+    }
+
+  if (length % 8 == 0)
+    {
+      wrapped[9 * (length + 8)] ^= 1;
+      ASSERT (!aes128_keyunwrap_batch (&ctx, iv, BATCH_COUNT, length,
+				       unwrapped, wrapped, valid));
+      for (i = 0; i < BATCH_COUNT; i++)
+	{
+	  ASSERT (valid[i] == (i != 9));
+	  if (valid[i])
+	    ASSERT (MEMEQ (length, unwrapped + i * length, keys + i * length));
+	}
+      wrapped[9 * (length + 8)] ^= 1;
+      ASSERT (aes128_keyunwrap_batch (&ctx, iv, BATCH_COUNT, length,
+				      unwrapped, wrapped, NULL));
+      ASSERT (MEMEQ (BATCH_COUNT * length, unwrapped, keys));
+    }
+}
+
 void
 test_main (void)
 {
@@ -479,4 +592,19 @@ test_main (void)
 			SHEX ("A6A6A6A6A6A6A6A6"),
 			SHEX
 			("28C9F404C4B810F4 CBCCB35CFB87F826 3F5786E2D80ED426 CBC7F0E71A99F43B FB988B9B7A02DD21"));
+
+  /* RFC 5649, section 6. */
+  test_wrap_pad (SHEX ("5840df6e29b02af1 ab493b705bf16ea1 ae8338f4dcc176a8"),
+		 SHEX ("c37b7e6492584340 bed1220780894115 5068f738"),
+		 SHEX ("138bdeaa9b8fa7fc 61f97742e72248ee 5ae6ae5360d1ae6a"
+		       "5f54f373fa543b6a"));
+  test_wrap_pad (SHEX ("5840df6e29b02af1 ab493b705bf16ea1 ae8338f4dcc176a8"),
+		 SHEX ("466f7250617369"),
+		 SHEX ("afbeb0f07dfbf541 9200f2ccb50bb24f"));
+
+  test_wrap_batch (1);
+  test_wrap_batch (8);
+  test_wrap_batch (16);
+  test_wrap_batch (20);
+  test_wrap_batch (32);
 }
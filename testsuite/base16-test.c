@@ -36,6 +36,48 @@ test_base16 (size_t data_length, const uint8_t *data,
   free(check);
 }
 
+static void
+test_base16_decode (const char *ascii, const struct tstring *data)
+{
+  size_t ascii_length = strlen(ascii);
+  uint8_t *buffer = xalloc(1 + BASE16_DECODE_LENGTH (ascii_length));
+  struct base16_decode_ctx decode;
+  size_t done;
+  size_t i;
+
+  /* Both in a single call, and split at all possible positions. */
+  for (i = 0; i <= ascii_length; i++)
+    {
+      size_t first;
+      memset(buffer, 0x55, 1 + data->length);
+      base16_decode_init (&decode);
+
+      first = BASE16_DECODE_LENGTH (i);
+      ASSERT (base16_decode_update(&decode, &first, buffer, i, ascii));
+      done = data->length - first;
+      ASSERT (base16_decode_update(&decode, &done, buffer + first,
+				   ascii_length - i, ascii + i));
+      ASSERT (first + done == data->length);
+      ASSERT (base16_decode_final (&decode));
+      ASSERT (MEMEQ(data->length, buffer, data->data));
+      ASSERT (0x55 == buffer[data->length]);
+    }
+  free(buffer);
+}
+
+static void
+test_base16_invalid (const char *ascii)
+{
+  size_t ascii_length = strlen(ascii);
+  uint8_t *buffer = xalloc(BASE16_DECODE_LENGTH (ascii_length));
+  struct base16_decode_ctx decode;
+  size_t done = BASE16_DECODE_LENGTH (ascii_length);
+
+  base16_decode_init (&decode);
+  ASSERT (!base16_decode_update(&decode, &done, buffer, ascii_length, ascii));
+  free(buffer);
+}
+
 void
 test_main(void)
 {
@@ -56,4 +98,18 @@ test_main(void)
   test_base16 (LDATA("Hell"), "48656c6c");
   test_base16 (LDATA("Hello"), "48656c6c6f");
   test_base16 (LDATA("Hello\0"), "48656c6c6f00");
+  test_base16 (LDATA("\x01\x23\x45\x67\x89\xab\xcd\xef\xfe\xdc\xba\x98\x76"
+		     "\x54\x32\x10\x0f\xf0\xa5"),
+	       "0123456789abcdeffedcba98765432100ff0a5");
+
+  test_base16_decode ("0123456789ABCDEFfedcba9876543210",
+		      SHEX("0123456789abcdeffedcba9876543210"));
+  test_base16_decode ("01234567 89abcdef\n01234567\t89ABcdef 0f",
+		      SHEX("0123456789abcdef0123456789abcdef0f"));
+  test_base16_invalid ("0123456789abcdeg");
+  test_base16_invalid ("0123456789abcde:");
+  test_base16_invalid ("0123456789abcde@");
+  test_base16_invalid ("0123456/89abcdef");
+  test_base16_invalid ("01234567\x80" "0abcdef");
+  test_base16_invalid ("0123456789abcdef012345678G");
 }
@@ -288,6 +288,119 @@ test_cipher_ccm(const struct nettle_cipher *cipher,
   free(de_data);
 }
 
+typedef void
+ccm_aes_encrypt_message_func(const void *ctx,
+			     size_t nlength, const uint8_t *nonce,
+			     size_t alength, const uint8_t *adata,
+			     size_t tlength,
+			     size_t clength, uint8_t *dst, const uint8_t *src);
+typedef void
+ccm_aes_seal_batch_func(const void *ctx, size_t nlength, size_t tlength,
+			size_t count, const struct nettle_aead_batch *msgs);
+typedef int
+ccm_aes_open_batch_func(const void *ctx, size_t nlength, size_t tlength,
+			size_t count, const struct nettle_aead_batch *msgs,
+			int *valid);
+
+/* Compares the batch functions, and the aes specific message
+   functions, to the generic ccm_encrypt_message. */
+static void
+test_ccm_batch(const struct nettle_cipher *cipher,
+	       ccm_aes_encrypt_message_func *encrypt_message,
+	       ccm_aes_seal_batch_func *seal_batch,
+	       ccm_aes_open_batch_func *open_batch)
+{
+  static const size_t lengths[] = {
+    0, 1, 15, 16, 17, 31, 32, 33, 100, 255, 256, 1000,
+  };
+  static const size_t alengths[] = {
+    0, 3, 14, 16, 20, 0, 30, 7, 0xff00, 1, 0, 100,
+  };
+#define CCM_BATCH_COUNT (sizeof (lengths) / sizeof (lengths[0]))
+  struct nettle_aead_batch msgs[CCM_BATCH_COUNT];
+  uint8_t *adata[CCM_BATCH_COUNT];
+  uint8_t *clear[CCM_BATCH_COUNT];
+  uint8_t *ref[CCM_BATCH_COUNT];
+  uint8_t nonces[CCM_BATCH_COUNT][13];
+  uint8_t digests[CCM_BATCH_COUNT][CCM_DIGEST_SIZE];
+  int valid[CCM_BATCH_COUNT];
+  struct knuth_lfib_ctx rand;
+  void *ctx = xalloc (cipher->context_size);
+  uint8_t *key = xalloc (cipher->key_size);
+  size_t tlength, i;
+
+  knuth_lfib_init (&rand, 17);
+  knuth_lfib_random (&rand, cipher->key_size, key);
+  cipher->set_encrypt_key (ctx, key);
+
+  for (tlength = 4; tlength <= 16; tlength += 12)
+    {
+      for (i = 0; i < CCM_BATCH_COUNT; i++)
+	{
+	  uint8_t *out;
+	  adata[i] = xalloc (alengths[i] + 1);
+	  clear[i] = xalloc (lengths[i] + 1);
+	  ref[i] = xalloc (lengths[i] + tlength);
+	  out = xalloc (lengths[i] + tlength);
+	  knuth_lfib_random (&rand, sizeof (nonces[i]), nonces[i]);
+	  knuth_lfib_random (&rand, alengths[i], adata[i]);
+	  knuth_lfib_random (&rand, lengths[i], clear[i]);
+
+	  ccm_encrypt_message (ctx, cipher->encrypt,
+			       sizeof (nonces[i]), nonces[i],
+			       alengths[i], adata[i], tlength,
+			       lengths[i] + tlength, ref[i], clear[i]);
+	  encrypt_message (ctx, sizeof (nonces[i]), nonces[i],
+			   alengths[i], adata[i], tlength,
+			   lengths[i] + tlength, out, clear[i]);
+	  ASSERT (MEMEQ (lengths[i] + tlength, out, ref[i]));
+	  free (out);
+
+	  msgs[i].nonce = nonces[i];
+	  msgs[i].adata_length = alengths[i];
+	  msgs[i].adata = adata[i];
+	  msgs[i].length = lengths[i];
+	  msgs[i].src = msgs[i].dst = xalloc (lengths[i] + 1);
+	  memcpy (msgs[i].dst, clear[i], lengths[i]);
+	  msgs[i].digest = digests[i];
+	}
+
+      /* In-place sealing. */
+      seal_batch (ctx, sizeof (nonces[0]), tlength, CCM_BATCH_COUNT, msgs);
+      for (i = 0; i < CCM_BATCH_COUNT; i++)
+	{
+	  ASSERT (MEMEQ (lengths[i], msgs[i].dst, ref[i]));
+	  ASSERT (MEMEQ (tlength, msgs[i].digest, ref[i] + lengths[i]));
+	}
+
+      /* In-place opening, with one corrupted digest. */
+      msgs[3].digest[0] ^= 1;
+      ASSERT (!open_batch (ctx, sizeof (nonces[0]), tlength,
+			   CCM_BATCH_COUNT, msgs, valid));
+      for (i = 0; i < CCM_BATCH_COUNT; i++)
+	{
+	  ASSERT (valid[i] == (i != 3));
+	  ASSERT (MEMEQ (lengths[i], msgs[i].dst, clear[i]));
+	}
+      msgs[3].digest[0] ^= 1;
+      for (i = 0; i < CCM_BATCH_COUNT; i++)
+	memcpy (msgs[i].dst, ref[i], lengths[i]);
+      ASSERT (ccm_open_batch (ctx, cipher->encrypt,
+			      sizeof (nonces[0]), tlength,
+			      CCM_BATCH_COUNT, msgs, NULL));
+
+      for (i = 0; i < CCM_BATCH_COUNT; i++)
+	{
+	  free (adata[i]);
+	  free (clear[i]);
+	  free (ref[i]);
+	  free (msgs[i].dst);
+	}
+    }
+  free (ctx);
+  free (key);
+}
+
 void
 test_main(void)
 {
@@ -755,4 +868,32 @@ test_main(void)
 		  SHEX("90ae61cf7baebd4cade494c54a29ae70269aec71"),
 		  SHEX("6c05313e45dc8ec10bea6c670bd94f31569386a6"
 		       "8f3829e8e76ee23c04f566189e63c686"));
+
+  /* Separate key and state. Inputs from SP 800-38C example 3, with
+     a 16 byte tag, so only the ciphertext matches the spec. */
+  test_aead_v2(&nettle_ccm_aes128_v2,
+	       SHEX("404142434445464748494a4b4c4d4e4f"),
+	       SHEX("000102030405060708090a0b0c0d0e0f10111213"),
+	       SHEX("202122232425262728292a2b2c2d2e2f3031323334353637"),
+	       SHEX("e3b201a9f5b71a7a9b1ceaeccd97e70b6176aad9a4428aa5"),
+	       SHEX("101112131415161718191a1b"),
+	       SHEX("c87ae488918de93f17dd3e4934347f44"));
+
+  /* D.2.9 above */
+  test_aead_v2(&nettle_ccm_aes256_v2,
+	       SHEX("f8d476cfd646ea6c2384cb1c27d6195dfef1a9f37b9c8d21a79c21f8cb90d289"),
+	       SHEX("7bd859a247961a21823b380e9fe8b65082ba61d3"),
+	       SHEX("90ae61cf7baebd4cade494c54a29ae70269aec71"),
+	       SHEX("6c05313e45dc8ec10bea6c670bd94f31569386a6"),
+	       SHEX("dbd1a3636024b7b402da7d6f"),
+	       SHEX("8f3829e8e76ee23c04f566189e63c686"));
+
+  test_ccm_batch(&nettle_aes128,
+		 (ccm_aes_encrypt_message_func *) ccm_aes128_encrypt_message,
+		 (ccm_aes_seal_batch_func *) ccm_aes128_seal_batch,
+		 (ccm_aes_open_batch_func *) ccm_aes128_open_batch);
+  test_ccm_batch(&nettle_aes256,
+		 (ccm_aes_encrypt_message_func *) ccm_aes256_encrypt_message,
+		 (ccm_aes_seal_batch_func *) ccm_aes256_seal_batch,
+		 (ccm_aes_open_batch_func *) ccm_aes256_open_batch);
 }
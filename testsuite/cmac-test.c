@@ -11,6 +11,57 @@
 #define test_cmac_des3(key, msg, ref)			\
   test_mac(&nettle_cmac_des3, NULL, key, msg, ref)
 
+/* Compare the multi-message functions with separate CMACs, for
+   messages of varying lengths, and more messages than are processed
+   together. */
+static void
+test_cmac_multi(void)
+{
+  static const size_t lengths[] = {
+    0, 16, 17, 1, 48, 15, 100, 32, 33, 0, 64, 5, 200, 31,
+  };
+  const unsigned count = sizeof(lengths) / sizeof(lengths[0]);
+  struct nettle_iov msgs[sizeof(lengths) / sizeof(lengths[0])];
+  uint8_t data[300];
+  uint8_t digests[sizeof(lengths) / sizeof(lengths[0])][16];
+  uint8_t ref[16];
+  struct cmac_aes128_ctx aes128;
+  struct cmac_aes256_ctx aes256;
+  unsigned i, n;
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = i * 17 + 3;
+
+  for (i = 0; i < count; i++)
+    {
+      msgs[i].length = lengths[i];
+      msgs[i].data = data + i;
+    }
+
+  cmac_aes128_set_key (&aes128, H("2b7e151628aed2a6abf7158809cf4f3c"));
+  cmac_aes256_set_key (&aes256, H("603deb1015ca71be2b73aef0857d7781"
+				  "1f352c073b6108d72d9810a30914dff4"));
+
+  for (n = 0; n <= count; n++)
+    {
+      cmac_aes128_digest_multi (&aes128, n, msgs, digests[0]);
+      for (i = 0; i < n; i++)
+	{
+	  cmac_aes128_update (&aes128, msgs[i].length, msgs[i].data);
+	  cmac_aes128_digest (&aes128, ref);
+	  ASSERT (MEMEQ (16, digests[i], ref));
+	}
+
+      cmac_aes256_digest_multi (&aes256, n, msgs, digests[0]);
+      for (i = 0; i < n; i++)
+	{
+	  cmac_aes256_update (&aes256, msgs[i].length, msgs[i].data);
+	  cmac_aes256_digest (&aes256, ref);
+	  ASSERT (MEMEQ (16, digests[i], ref));
+	}
+    }
+}
+
 void
 test_main(void)
 {
@@ -92,4 +143,6 @@ test_main(void)
   test_cmac_des3 (SHEX("0123456789abcdef23456789abcdef01456789abcdef0123"),
 		  SHEX("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"),
 		  SHEX("99429bd0bf7904e5"));
+
+  test_cmac_multi ();
 }
@@ -32,6 +32,7 @@
 #include "testutils.h"
 
 #include "curve25519.h"
+#include "knuth-lfib.h"
 
 static void
 test_g (const uint8_t *s, const uint8_t *r)
@@ -80,6 +81,103 @@ test_a (const uint8_t *s, const uint8_t *b, const uint8_t *r)
     }
 }
 
+/* Compare batch multiplication with separate multiplications. */
+static void
+test_g_batch (size_t count)
+{
+  struct knuth_lfib_ctx rctx;
+  uint8_t *s = xalloc (count * CURVE25519_SIZE);
+  uint8_t *r = xalloc (count * CURVE25519_SIZE);
+  uint8_t ref[CURVE25519_SIZE];
+  size_t i;
+
+  knuth_lfib_init (&rctx, 4711);
+  knuth_lfib_random (&rctx, count * CURVE25519_SIZE, s);
+
+  curve25519_mul_g_batch (count, r, s);
+  for (i = 0; i < count; i++)
+    {
+      curve25519_mul_g (ref, s + i * CURVE25519_SIZE);
+      ASSERT (MEMEQ (CURVE25519_SIZE, r + i * CURVE25519_SIZE, ref));
+    }
+  free (s);
+  free (r);
+}
+
+/* Check curve25519_mul against curve25519_mul_g, with the base
+   point, and for a shared secret. */
+static void
+test_dh (unsigned count)
+{
+  static const uint8_t g[CURVE25519_SIZE] = { 9 };
+  struct knuth_lfib_ctx rctx;
+  uint8_t s[CURVE25519_SIZE], t[CURVE25519_SIZE];
+  uint8_t sg[CURVE25519_SIZE], tg[CURVE25519_SIZE];
+  uint8_t p[CURVE25519_SIZE], q[CURVE25519_SIZE];
+  unsigned i;
+
+  knuth_lfib_init (&rctx, 17);
+  for (i = 0; i < count; i++)
+    {
+      knuth_lfib_random (&rctx, CURVE25519_SIZE, s);
+      knuth_lfib_random (&rctx, CURVE25519_SIZE, t);
+      curve25519_mul_g (sg, s);
+      curve25519_mul_g (tg, t);
+
+      curve25519_mul (p, s, g);
+      ASSERT (MEMEQ (CURVE25519_SIZE, p, sg));
+
+      curve25519_mul (p, s, tg);
+      curve25519_mul (q, t, sg);
+      ASSERT (MEMEQ (CURVE25519_SIZE, p, q));
+    }
+}
+
+#if HAVE_UINT128
+/* Compare the radix 2^51 ladder with the generic ecc_mul_m code, for
+   random scalars and random, possibly non-canonical, points. */
+static void
+test_ladder (unsigned count)
+{
+  const struct ecc_modulo *m = &_nettle_curve25519.p;
+  struct knuth_lfib_ctx rctx;
+  uint8_t s[CURVE25519_SIZE], b[CURVE25519_SIZE];
+  uint8_t p[CURVE25519_SIZE], r[CURVE25519_SIZE];
+  mp_size_t itch = m->size + ECC_MUL_M_ITCH (m->size);
+  mp_limb_t *x = xalloc_limbs (itch);
+  unsigned i;
+
+  knuth_lfib_init (&rctx, 1729);
+  for (i = 0; i < count; i++)
+    {
+      knuth_lfib_random (&rctx, CURVE25519_SIZE, s);
+      knuth_lfib_random (&rctx, CURVE25519_SIZE, b);
+
+      curve25519_ladder (p, s, b);
+
+      mpn_set_base256_le (x, m->size, b, CURVE25519_SIZE);
+      x[255/GMP_NUMB_BITS] &= ~((mp_limb_t) 1 << (255 % GMP_NUMB_BITS));
+      ecc_mul_m (m, 121665, 3, 253, x, s, x, x + m->size);
+      mpn_get_base256_le (r, CURVE25519_SIZE, x, m->size);
+
+      if (!MEMEQ (CURVE25519_SIZE, p, r))
+	{
+	  printf ("curve25519_ladder failure:\ns = ");
+	  print_hex (CURVE25519_SIZE, s);
+	  printf ("\nb = ");
+	  print_hex (CURVE25519_SIZE, b);
+	  printf ("\np = ");
+	  print_hex (CURVE25519_SIZE, p);
+	  printf (" (bad)\nr = ");
+	  print_hex (CURVE25519_SIZE, r);
+	  printf (" (expected)\n");
+	  abort ();
+	}
+    }
+  free (x);
+}
+#endif
+
 void
 test_main (void)
 {
@@ -150,4 +248,12 @@ test_main (void)
 	    "3f8343c85b78674dadfc7e146f882bcf"),
 	  H("4a5d9d5ba4ce2de1728e3bf480350f25"
 	    "e07e21c947d19e3376f09b3c1e161742"));
+
+  test_g_batch (1);
+  test_g_batch (20);
+
+  test_dh (20);
+#if HAVE_UINT128
+  test_ladder (200);
+#endif
 }
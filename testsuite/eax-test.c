@@ -85,4 +85,21 @@ test_main(void)
 	    SHEX("CB8920F87A6C75CFF39627B56E3ED197C552D295A7"),
 	    SHEX("22E7ADD93CFC6393C57EC0B3C17D6B44"),
 	    SHEX("CFC46AFC253B4652B1AF3795B124AB6E"));
+
+  /* Separate key and state. */
+  test_aead_v2(&nettle_eax_aes128_v2,
+	       SHEX("91945D3F4DCBEE0BF45EF52255F095A4"),
+	       SHEX("FA3BFD4806EB53FA"),
+	       SHEX("F7FB"),
+	       SHEX("19DD"),
+	       SHEX("BECAF043B0A23D843194BA972C66DEBD"),
+	       SHEX("5C4C9331049D0BDAB0277408F67967E5"));
+
+  test_aead_v2(&nettle_eax_aes128_v2,
+	       SHEX("01F74AD64077F2E704C0F60ADA3DD523"),
+	       SHEX("234A3463C1264AC6"),
+	       SHEX("1A47CB4933"),
+	       SHEX("D851D5BAE0"),
+	       SHEX("70C3DB4F0D26368400A10ED05D2BFF5E"),
+	       SHEX("3A59F238A23E39199DC9266626C40F80"));
 }
@@ -43,7 +43,8 @@ ref_modinv (mp_limb_t *rp, const mp_limb_t *ap,
 
 static void
 test_modulo (gmp_randstate_t rands, const char *name,
-	     const struct ecc_modulo *m, int use_redc)
+	     const struct ecc_modulo *m, ecc_mod_inv_func *invert,
+	     int use_redc)
 {
   mp_limb_t *a;
   mp_limb_t *ai;
@@ -62,7 +63,7 @@ test_modulo (gmp_randstate_t rands, const char *name,
   /* Check behaviour for zero input */
   mpn_zero (a, m->size);
   memset (ai, 17, m->size * sizeof(*ai));
-  m->invert (m, ai, a, scratch);
+  invert (m, ai, a, scratch);
   if (!ecc_mod_zero_p (m, ai))
     {
       fprintf (stderr, "%s->invert failed for zero input (bit size %u):\n",
@@ -77,7 +78,7 @@ test_modulo (gmp_randstate_t rands, const char *name,
 	  
   /* Check behaviour for a = m */
   memset (ai, 17, m->size * sizeof(*ai));
-  m->invert (m, ai, m->m, scratch);
+  invert (m, ai, m->m, scratch);
   if (!ecc_mod_zero_p (m, ai))
     {
       fprintf (stderr, "%s->invert failed for a = p input (bit size %u):\n",
@@ -107,7 +108,7 @@ test_modulo (gmp_randstate_t rands, const char *name,
 		     j, m->bit_size, name);
 	  continue;
 	}
-      m->invert (m, ai, a, scratch);
+      invert (m, ai, a, scratch);
       if (!ecc_mod_equal_p (m, ai, ref, scratch))
 	{
 	  fprintf (stderr, "%s->invert failed (test %u, bit size %u):\n",
@@ -143,8 +144,13 @@ test_main (void)
 
   for (i = 0; ecc_curves[i]; i++)
     {
-      test_modulo (rands, "p", &ecc_curves[i]->p, ecc_curves[i]->use_redc);
-      test_modulo (rands, "q", &ecc_curves[i]->q, 0);
+      test_modulo (rands, "p", &ecc_curves[i]->p,
+		   ecc_curves[i]->p.invert, ecc_curves[i]->use_redc);
+      test_modulo (rands, "q", &ecc_curves[i]->q,
+		   ecc_curves[i]->q.invert, 0);
+      /* Only used for the scalar field, when verifying signatures. */
+      test_modulo (rands, "q (vartime)", &ecc_curves[i]->q,
+		   ecc_mod_inv_vartime, 0);
     }
   gmp_randclear (rands);
 }
@@ -1,6 +1,85 @@
 #include "testutils.h"
 #include "knuth-lfib.h"
 
+#if HAVE_PTHREAD && HAVE_STDATOMIC
+#include <pthread.h>
+#include <sched.h>
+
+#define THREAD_SIGNATURES 200
+
+struct fill_ctx
+{
+  struct ecdsa_presign_pool *pool;
+  struct knuth_lfib_ctx rctx;
+};
+
+static void *
+fill_thread (void *arg)
+{
+  struct fill_ctx *ctx = arg;
+  unsigned done;
+
+  for (done = 0; done < THREAD_SIGNATURES; )
+    {
+      unsigned n = ecdsa_presign_pool_fill (
+	ctx->pool, &ctx->rctx, (nettle_random_func *) knuth_lfib_random,
+	THREAD_SIGNATURES - done);
+      if (!n)
+	sched_yield ();
+      done += n;
+    }
+  return NULL;
+}
+
+/* One thread fills the pool while the main thread signs, with no
+   locking. */
+static void
+test_pool_threads (const struct ecc_curve *ecc, const struct tstring *digest)
+{
+  struct knuth_lfib_ctx rctx;
+  struct ecdsa_presign_pool pool;
+  struct fill_ctx ctx;
+  struct ecc_point pub;
+  struct ecc_scalar key;
+  struct dsa_signature signature;
+  pthread_t thread;
+  unsigned done;
+
+  knuth_lfib_init (&rctx, 17);
+  ecc_point_init (&pub, ecc);
+  ecc_scalar_init (&key, ecc);
+  ecdsa_generate_keypair (&pub, &key, &rctx,
+			  (nettle_random_func *) knuth_lfib_random);
+  dsa_signature_init (&signature);
+
+  ecdsa_presign_pool_init (&pool, ecc, 5);
+  ctx.pool = &pool;
+  knuth_lfib_init (&ctx.rctx, 18);
+  ASSERT (pthread_create (&thread, NULL, fill_thread, &ctx) == 0);
+
+  for (done = 0; done < THREAD_SIGNATURES; )
+    {
+      if (!ecdsa_sign_from_pool (&pool, &key, digest->length, digest->data,
+				 &signature))
+	{
+	  sched_yield ();
+	  continue;
+	}
+      if (!ecdsa_verify (&pub, digest->length, digest->data, &signature))
+	die ("ecdsa_verify failed for ecdsa_sign_from_pool in thread test.\n");
+      done++;
+    }
+  ASSERT (pthread_join (thread, NULL) == 0);
+  ASSERT (!ecdsa_sign_from_pool (&pool, &key, digest->length, digest->data,
+				 &signature));
+
+  ecdsa_presign_pool_clear (&pool);
+  dsa_signature_clear (&signature);
+  ecc_point_clear (&pub);
+  ecc_scalar_clear (&key);
+}
+#endif
+
 void
 test_main (void)
 {
@@ -76,8 +155,76 @@ test_main (void)
 			 &signature))
 	die ("ecdsa_verify returned success with invalid signature.s.\n");
 
+      /* Signing with precomputed nonces. */
+      {
+	struct ecdsa_presign_pool pool;
+	unsigned j;
+
+	ecdsa_presign_pool_init (&pool, ecc, 3);
+	ASSERT (ecdsa_presign_pool_fill (&pool, &rctx,
+					 (nettle_random_func *) knuth_lfib_random,
+					 2) == 2);
+	ASSERT (ecdsa_presign_pool_fill (&pool, &rctx,
+					 (nettle_random_func *) knuth_lfib_random,
+					 5) == 1);
+	for (j = 0; j < 3; j++)
+	  {
+	    struct dsa_signature ref;
+	    dsa_signature_init (&ref);
+	    mpz_set (ref.r, signature.r);
+
+	    ASSERT (ecdsa_sign_from_pool (&pool, &key, digest->length,
+					  digest->data, &signature));
+	    if (!ecdsa_verify (&pub, digest->length, digest->data,
+			       &signature))
+	      die ("ecdsa_verify failed for ecdsa_sign_from_pool.\n");
+	    /* Each nonce is used once. */
+	    ASSERT (mpz_cmp (ref.r, signature.r) != 0);
+	    dsa_signature_clear (&ref);
+	  }
+	ASSERT (!ecdsa_sign_from_pool (&pool, &key, digest->length,
+				       digest->data, &signature));
+	ASSERT (ecdsa_presign_pool_fill (&pool, &rctx,
+					 (nettle_random_func *) knuth_lfib_random,
+					 1) == 1);
+	ASSERT (ecdsa_sign_from_pool (&pool, &key, digest->length,
+				      digest->data, &signature));
+	if (!ecdsa_verify (&pub, digest->length, digest->data,
+			   &signature))
+	  die ("ecdsa_verify failed for ecdsa_sign_from_pool.\n");
+	ecdsa_presign_pool_clear (&pool);
+      }
+
       ecc_point_clear (&pub);
       ecc_scalar_clear (&key);
+
+      /* More keys than share an inversion. */
+      {
+	struct ecc_point pubs[20];
+	struct ecc_scalar keys[20];
+	struct ecc_point ref;
+	unsigned j;
+
+	ecc_point_init (&ref, ecc);
+	for (j = 0; j < 20; j++)
+	  {
+	    ecc_point_init (&pubs[j], ecc);
+	    ecc_scalar_init (&keys[j], ecc);
+	  }
+	ecdsa_generate_keypair_batch (20, pubs, keys, &rctx,
+				      (nettle_random_func *) knuth_lfib_random);
+	for (j = 0; j < 20; j++)
+	  {
+	    ecc_point_mul_g (&ref, &keys[j]);
+	    ASSERT (mpn_cmp (ref.p, pubs[j].p, 2*ecc->p.size) == 0);
+	    ecc_point_clear (&pubs[j]);
+	    ecc_scalar_clear (&keys[j]);
+	  }
+	ecc_point_clear (&ref);
+      }
     }
+#if HAVE_PTHREAD && HAVE_STDATOMIC
+  test_pool_threads (nettle_get_secp_256r1 (), digest);
+#endif
   dsa_signature_clear (&signature);
 }
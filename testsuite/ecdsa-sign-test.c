@@ -1,4 +1,5 @@
 #include "testutils.h"
+#include "knuth-lfib.h"
 
 static void
 test_ecdsa (const struct ecc_curve *ecc,
@@ -19,6 +20,9 @@ test_ecdsa (const struct ecc_curve *ecc,
   mp_limb_t *sp = xalloc_limbs (ecc->p.size);
   mp_limb_t *zp = xalloc_limbs (ecc->p.size);
   mp_limb_t *kp = xalloc_limbs (ecc->p.size);
+  mp_limb_t *kinvp = xalloc_limbs (ecc->p.size);
+  mp_limb_t *r2p = xalloc_limbs (ecc->p.size);
+  mp_limb_t *s2p = xalloc_limbs (ecc->p.size);
   mp_limb_t *scratch = xalloc_limbs (ecc_ecdsa_sign_itch (ecc));
 
   dsa_signature_init (&ref);
@@ -56,10 +60,24 @@ test_ecdsa (const struct ecc_curve *ecc,
       abort();
     }
 
+  /* Same signature, with precomputed r and k^{-1}. */
+  ecc_ecdsa_presign (ecc, kp, r2p, kinvp, scratch);
+  ecc_ecdsa_sign_presigned (ecc, zp, r2p, kinvp,
+			    h->length, h->data, s2p, scratch);
+
+  mark_bytes_defined (sizeof(mp_limb_t) * ecc->p.size, r2p);
+  mark_bytes_defined (sizeof(mp_limb_t) * ecc->p.size, s2p);
+
+  ASSERT (mpn_cmp (rp, r2p, ecc->p.size) == 0);
+  ASSERT (mpn_cmp (sp, s2p, ecc->p.size) == 0);
+
   free (rp);
   free (sp);
   free (zp);
   free (kp);
+  free (kinvp);
+  free (r2p);
+  free (s2p);
   free (scratch);
 
   dsa_signature_clear (&ref);
@@ -67,9 +85,55 @@ test_ecdsa (const struct ecc_curve *ecc,
   mpz_clear (z);
 }
 
+/* Compare batch signing with separate signatures. */
+static void
+test_ecdsa_batch (const struct ecc_curve *ecc, size_t n)
+{
+  struct knuth_lfib_ctx rctx;
+  mp_size_t size = ecc->p.size;
+  mp_limb_t *zp = xalloc_limbs (size);
+  mp_limb_t *kp = xalloc_limbs (n*size);
+  mp_limb_t *rp = xalloc_limbs (n*size);
+  mp_limb_t *sp = xalloc_limbs (n*size);
+  mp_limb_t *r1p = xalloc_limbs (size);
+  mp_limb_t *s1p = xalloc_limbs (size);
+  mp_limb_t *scratch = xalloc_limbs (ecc_ecdsa_sign_batch_itch (ecc, n));
+  uint8_t *digests = xalloc (n*32);
+  size_t i;
+
+  knuth_lfib_init (&rctx, 17);
+  ecc_mod_random (&ecc->q, zp, &rctx,
+		  (nettle_random_func *) knuth_lfib_random, scratch);
+  for (i = 0; i < n; i++)
+    ecc_mod_random (&ecc->q, kp + i*size, &rctx,
+		    (nettle_random_func *) knuth_lfib_random, scratch);
+  knuth_lfib_random (&rctx, n*32, digests);
+
+  ecc_ecdsa_sign_batch (ecc, zp, n, kp, 32, digests, rp, sp, scratch);
+
+  for (i = 0; i < n; i++)
+    {
+      ecc_ecdsa_sign (ecc, zp, kp + i*size, 32, digests + i*32,
+		      r1p, s1p, scratch);
+      ASSERT (mpn_cmp (rp + i*size, r1p, size) == 0);
+      ASSERT (mpn_cmp (sp + i*size, s1p, size) == 0);
+    }
+
+  free (zp);
+  free (kp);
+  free (rp);
+  free (sp);
+  free (r1p);
+  free (s1p);
+  free (scratch);
+  free (digests);
+}
+
 void
 test_main (void)
 {
+  unsigned i;
+
 #if NETTLE_USE_MINI_GMP || WITH_EXTRA_ASSERTS
   if (test_side_channel)
     SKIP();
@@ -197,4 +261,13 @@ test_main (void)
 	      "97536710 1F67D1CF 9BCCBF2F 3D239534"
 	      "FA509E70 AAC851AE 01AAC68D 62F86647"
 	      "2660"); /* s */
+
+  for (i = 0; ecc_curves[i]; i++)
+    {
+      const struct ecc_curve *ecc = ecc_curves[i];
+      if (ecc->p.bit_size == 255 || ecc->p.bit_size == 448)
+	continue;
+      test_ecdsa_batch (ecc, 1);
+      test_ecdsa_batch (ecc, 7);
+    }
 }
@@ -70,6 +70,8 @@ test_one (const char *line)
   uint8_t *msg;
   size_t msg_size;
   uint8_t s2[ED25519_SIGNATURE_SIZE];
+  struct ed25519_sha512_key key;
+  mp_limb_t *scratch = xalloc_limbs (ed25519_sha512_sign_itch ());
 
   decode_hex (ED25519_KEY_SIZE, sk, line);
 
@@ -103,6 +105,12 @@ test_one (const char *line)
 
   ASSERT (MEMEQ (ED25519_SIGNATURE_SIZE, s, s2));
 
+  ed25519_sha512_set_key (&key, pk, sk);
+  ed25519_sha512_sign_with_key (&key, msg_size, msg, s2, scratch);
+  mark_bytes_defined (ED25519_SIGNATURE_SIZE, s2);
+
+  ASSERT (MEMEQ (ED25519_SIGNATURE_SIZE, s, s2));
+
   ASSERT (ed25519_sha512_verify (pk, msg_size, msg, s));
 
   s2[ED25519_SIGNATURE_SIZE/3] ^= 0x40;
@@ -120,6 +128,7 @@ test_one (const char *line)
       ASSERT (!ed25519_sha512_verify (pk, msg_size, msg, s));
     }
   free (msg);
+  free (scratch);
 }
 
 #ifndef HAVE_GETLINE
@@ -71,6 +71,8 @@ test_one (const char *line)
   uint8_t *msg;
   size_t msg_size;
   uint8_t s2[ED448_SIGNATURE_SIZE];
+  struct ed448_shake256_key key;
+  mp_limb_t *scratch = xalloc_limbs (ed448_shake256_sign_itch ());
 
   decode_hex (ED448_KEY_SIZE, sk, line);
 
@@ -104,6 +106,12 @@ test_one (const char *line)
 
   ASSERT (MEMEQ (ED448_SIGNATURE_SIZE, s, s2));
 
+  ed448_shake256_set_key (&key, pk, sk);
+  ed448_shake256_sign_with_key (&key, msg_size, msg, s2, scratch);
+  mark_bytes_defined (ED448_SIGNATURE_SIZE, s2);
+
+  ASSERT (MEMEQ (ED448_SIGNATURE_SIZE, s, s2));
+
   ASSERT (ed448_shake256_verify (pk, msg_size, msg, s));
 
   s2[ED448_SIGNATURE_SIZE/3] ^= 0x40;
@@ -121,6 +129,7 @@ test_one (const char *line)
       ASSERT (!ed448_shake256_verify (pk, msg_size, msg, s));
     }
   free (msg);
+  free (scratch);
 }
 
 /* Subset of test vectors from
@@ -1,6 +1,7 @@
 #include "testutils.h"
 #include "nettle-internal.h"
 #include "gcm.h"
+#include "knuth-lfib.h"
 #include "ghash-internal.h"
 
 static void
@@ -68,6 +69,76 @@ test_ghash_internal (const struct tstring *key,
       fprintf(stderr, "\n");
       FAIL();
     }
+
+  struct gcm_compact_key compact_key;
+  memcpy (state.b, key->data, GCM_BLOCK_SIZE);
+  mark_bytes_undefined (sizeof(state), &state);
+  _ghash_compact_set_key (&compact_key, &state);
+
+  memcpy (state.b, iv->data, GCM_BLOCK_SIZE);
+  mark_bytes_undefined (sizeof(state), &state);
+  mark_bytes_undefined (message->length, message->data);
+  _ghash_compact_update (&compact_key, &state,
+			 message->length / GCM_BLOCK_SIZE, message->data);
+  mark_bytes_defined (sizeof(state), &state);
+  mark_bytes_defined (message->length, message->data);
+
+  if (!MEMEQ(GCM_BLOCK_SIZE, state.b, digest->data))
+    {
+      fprintf (stderr, "gcm_hash (compact) failed\n");
+      fprintf(stderr, "Key: ");
+      tstring_print_hex(key);
+      fprintf(stderr, "\nIV: ");
+      tstring_print_hex(iv);
+      fprintf(stderr, "\nOutput: ");
+      print_hex(GCM_BLOCK_SIZE, state.b);
+      fprintf(stderr, "\nExpected:");
+      tstring_print_hex(digest);
+      fprintf(stderr, "\n");
+      FAIL();
+    }
+}
+
+/* Compares the compact key to the table based key, for all message
+   sizes up to a few multiples of the number of powers in the compact
+   key. */
+static void
+test_ghash_compact (void)
+{
+  struct knuth_lfib_ctx rand;
+  struct gcm_key gcm_key;
+  struct gcm_compact_key compact_key;
+  union nettle_block16 key, ref, state;
+  uint8_t data[20 * GCM_BLOCK_SIZE];
+  unsigned i, blocks;
+
+  knuth_lfib_init (&rand, 17);
+  for (i = 0; i < 10; i++)
+    {
+      knuth_lfib_random (&rand, sizeof(key), key.b);
+      knuth_lfib_random (&rand, sizeof(data), data);
+      _ghash_set_key (&gcm_key, &key);
+      _ghash_compact_set_key (&compact_key, &key);
+
+      for (blocks = 0; blocks <= 20; blocks++)
+	{
+	  knuth_lfib_random (&rand, sizeof(ref), ref.b);
+	  state = ref;
+	  _ghash_update (&gcm_key, &ref, blocks, data);
+	  ASSERT (_ghash_compact_update (&compact_key, &state, blocks, data)
+		  == data + blocks * GCM_BLOCK_SIZE);
+	  if (!MEMEQ (GCM_BLOCK_SIZE, state.b, ref.b))
+	    {
+	      fprintf (stderr, "gcm_hash (compact) failed, blocks %u\n", blocks);
+	      fprintf (stderr, "Output: ");
+	      print_hex (GCM_BLOCK_SIZE, state.b);
+	      fprintf (stderr, "\nExpected:");
+	      print_hex (GCM_BLOCK_SIZE, ref.b);
+	      fprintf (stderr, "\n");
+	      FAIL ();
+	    }
+	}
+    }
 }
 
 /* Hack that uses a 16-byte nonce, a 12-byte standard GCM nonce and an
@@ -614,6 +685,260 @@ test_main(void)
 
 
 
+  /* Some of the above, with the compact key. */
+  test_aead(&nettle_gcm_aes128_compact, NULL,
+	    SHEX("feffe9928665731c6d6a8f9467308308"),
+	    SHEX("feedfacedeadbeeffeedfacedeadbeef"
+		 "abaddad2"),
+	    SHEX("d9313225f88406e5a55909c5aff5269a"
+		 "86a7a9531534f7da2e4c303d8a318a72"
+		 "1c3c0c95956809532fcf0e2449a6b525"
+		 "b16aedf5aa0de657ba637b39"),
+	    SHEX("42831ec2217774244b7221b784d0d49c"
+		 "e3aa212f2c02a4e035c17e2329aca12e"
+		 "21d514b25466931c7d8f6a5aac84aa05"
+		 "1ba30b396a0aac973d58e091"),
+	    SHEX("cafebabefacedbaddecaf888"),
+	    SHEX("5bc94fbc3221a5db94fae95ae7121a47"));
+
+  test_aead(&nettle_gcm_aes128_compact,
+	    (nettle_hash_update_func *) gcm_aes128_compact_set_iv,
+	    SHEX("feffe9928665731c6d6a8f9467308308"),
+	    SHEX("feedfacedeadbeeffeedfacedeadbeef"
+		 "abaddad2"),
+	    SHEX("d9313225f88406e5a55909c5aff5269a"
+		 "86a7a9531534f7da2e4c303d8a318a72"
+		 "1c3c0c95956809532fcf0e2449a6b525"
+		 "b16aedf5aa0de657ba637b39"),
+	    SHEX("8ce24998625615b603a033aca13fb894"
+		 "be9112a5c3a211a8ba262a3cca7e2ca7"
+		 "01e4a9a4fba43c90ccdcb281d48c7c6f"
+		 "d62875d2aca417034c34aee5"),
+	    SHEX("9313225df88406e555909c5aff5269aa"
+		 "6a7a9538534f7da1e4c303d2a318a728"
+		 "c3c0c95156809539fcf0e2429a6b5254"
+		 "16aedbf5a0de6a57a637b39b"),
+	    SHEX("619cc5aefffe0bfa462af43c1699d050"));
+
+  test_aead(&nettle_gcm_aes128_compact, NULL,
+	    SHEX("feffe9928665731c6d6a8f9467308308"),
+	    SHEX(""),
+	    SHEX("d9313225f88406e5a55909c5aff5269a"
+		 "86a7a9531534f7da2e4c303d8a318a72"
+		 "1c3c0c95956809532fcf0e2449a6b525"
+		 "b16aedf5aa0de657ba637b391aafd255"
+		 "5ae376bc5e9f6a1b08e34db7a6ee0736"
+		 "9ba662ea12f6f197e6bc3ed69d2480f3"
+		 "ea5691347f2ba69113eb37910ebc18c8"
+		 "0f697234582016fa956ca8f63ae6b473"),
+	    SHEX("42831ec2217774244b7221b784d0d49c"
+		 "e3aa212f2c02a4e035c17e2329aca12e"
+		 "21d514b25466931c7d8f6a5aac84aa05"
+		 "1ba30b396a0aac973d58e091473f5985"
+		 "874b1178906ddbeab04ab2fe6cce8c57"
+		 "8d7e961bd13fd6a8c56b66ca5e576492"
+		 "1a48cd8bda04e66343e73055118b69b9"
+		 "ced486813846958a11e602c03cfc232b"),
+	    SHEX("cafebabefacedbaddecaf888"),
+	    SHEX("796836f1246c9d735c5e1be0a715ccc3"));
+
+  test_aead(&nettle_gcm_aes256_compact, NULL,
+	    SHEX("6235f895fca5ebf60e921204d3a13f2e"
+	         "8b32cfe744ed1359043877b0b9adb438"),
+	    SHEX(""),
+	    SHEX("42c1cc08486f413f2f11668b2a16f0e0"
+		"5883f0c37014c05b3fec1d253c51d203"
+		"cf59741fb285b407c66a63398a5bdecb"
+		"af0844bd6f9115e1f57a6e18bddd6150"
+		"59a997abbb0e745c00a4435404549b3b"
+		"77ecfd5ca6e87b08aee6103f3265d1fc"
+		"a41d2c31fb337ab33523f42041d4ad82"
+		"8ba4ad961c2053be0ea6f4dc78493e72"
+		"b1a9b583cb0854b7ad493aae98cea666"
+		"1030908c5583d77c8be653ded26e1821"
+		"0152d19f9dbb9c7357cc8909759b7870"
+		"ed26974db4e40ca5fa700470c6961c7d"
+		"544177a8e3b07e9682d9eca2876855f9"
+		"8f9e7343476a08369367a82ddeac41a9"
+		"5c4d73970f7068fa564d00c23b1fc8b9"
+		"781f5107e39a134eed2b2ea3f744b2e7"
+		"ab1937d9ba765ed2f25315174c6b169f"
+		"026649ca7c9105f245361ef577ad1f46"
+		"a813fb63b608996382a2edb3acdf4319"
+		"45ea7873d9b73911a3137cf83ff7ad81"
+		"482fa95c5fa0f079a4477d802026fd63"
+		"0ac77e6d7547ff76662e8a6c8135af0b"
+		"2e6a4960c110e1e15403a4090c377a15"
+		"23275b8b4ba56497ae4a50731f661c5c"
+		"03253c8d485871340eec4e551a036ae5"
+		"b6192b842a20d1ea806f960e0562c778"
+		"8779603846b425576e1663f8ad6ed742"
+		"69e188ef6ed5b49a3c786c3be5a01d22"
+		"865c743aeb2426c709fc919647874f1a"
+		"d66b2c1847c0b824a85a4a9ecb03e72a"
+		"09e64d9c6d8660f52f4869379ff2d2cb"
+		"0e5add6e8afb6afe0b63de8742798a68"
+		"51289b7aebafb82f9dd1c7459008c983"
+		"e98384cb28690969ce99460054cbd838"
+		"f9534abf31ce571533fa96043342e3c0"
+		"b7544a657a7c02e61995d00e820763f9"
+		"e12b2afc559252c9b59f232860e72051"
+		"10d3ed6d9babb8e25d9a34b3be9c64cb"
+		"78c69122409180bed7785c0e0adc08e9"
+		"6710a483987923e792daa92216b1e778"
+		"a31c6c8f357c4d372f6e0b505c34b9f9"
+		"e63d910d3295aa3d481106bb2df26388"
+		"3f7309e245563151fa5e4e62f790f9a9"
+		"7d7b1bb1c8266e66f6909a7ff257cc23"
+		"59fafaaa440401a7a478db743d8bb5"),
+	    SHEX("840bdbd5b7a8fe20bbb1127f41eab3c0"
+		 "a2b437191158b60b4c1d380554d11673"
+		 "8e1c2090a29ab77447e6d8fc183ab4ea"
+		 "d5165a2c530146b31833746c50f2e8c0"
+		 "73da6022ebe3e59b20936c4b3799b823"
+		 "3b4eace85be80fb7c38ffb4a37d93995"
+		 "34f1db8f71d9c70b02f163fc9bfcc5ab"
+		 "b9141321dfceaa8844301ece260192f8"
+		 "9f004b0c4bf75fe089ca9466112197ca"
+		 "3e83742ddb4d11eb97c214ff9e1ea06b"
+		 "08b4312b85c6856c90ec39c0ecb3b54e"
+		 "f39ce7833a770af456fece18336d0b2d"
+		 "33dac8055cb4092ade6b529801ef363d"
+		 "bdf98fa83eaacdd1012d4249c3b684bb"
+		 "4896e090936c4864d4fa7f932ca621c8"
+		 "7a237baa205612ae169d940f54a1ecca"
+		 "514ef239f4f85f045a0dbff583a115e1"
+		 "f53cd862a3ed4789854ce5dbac9e171d"
+		 "0c09e33e395b4d740ef534ee70114cfd"
+		 "db34b1b5103f73b7f5faedb01fa5cd3c"
+		 "8d3583d411446e6c5be00e69a539e5bb"
+		 "a9572437e61fddcf162a13f96a2d90a0"
+		 "03607aed69d5008b7e4fcbb9fa91b937"
+		 "c126ce9097226464c172431bf6acc154"
+		 "8a109cdd8dd58eb2e485dae0205ff4b4"
+		 "15b5a08d127449233adf4ad3f03b89eb"
+		 "f8cc627bfb9307416126945870a63ce4"
+		 "ff58c4133dcb366b32e5b26d03746f76"
+		 "9377de48c4fa304ada4980770f1cbe11"
+		 "c848b1e5bbf28ae1962f9fd18e8a5ce2"
+		 "f7d7d854f33fc491b8fb86dc46249160"
+		 "6c2fc94137514954098121f3039f2be3"
+		 "1f3963aff4d75360a7c754f9eeb1b17d"
+		 "75546593feb1686b5702f9bb0ef9f8bf"
+		 "011227b4fee4797a405b514bdf38ecb1"
+		 "6a56ff354d4233aa6f1be4dce0db8535"
+		 "6210d4ecebc57e451c6f17ca3b8e2d66"
+		 "4f4b3656cd1b59aad29b17b958df7b64"
+		 "8aff3b9ca6b5489eaae25d0971325fb6"
+		 "29bee7c7527e91826b6d33e134063621"
+		 "5ebe1e2f3ec1fbea492cb5caf7b037ea"
+		 "1fed1004d9480d1a1cfbe7840e835374"
+		 "c765e25ce5ba734c0ee1b51145614346"
+		 "aa258fbd8508fa4c15c1c0d8f5dc16bb"
+		 "7b1de38757a72a1d38589e8a43dc57"),
+	    SHEX("00ffffffff0000ffffff00ff"),
+	    SHEX("d1817d2be9ff993a4b24525855e14914"));
+
+  test_aead(&nettle_gcm_aes256_compact, NULL,
+	    SHEX("feffe9928665731c6d6a8f9467308308"
+		 "feffe9928665731c6d6a8f9467308308"),
+	    SHEX("feedfacedeadbeeffeedfacedeadbeef"
+		 "abaddad2"),
+	    SHEX("d9313225f88406e5a55909c5aff5269a"
+		 "86a7a9531534f7da2e4c303d8a318a72"
+		 "1c3c0c95956809532fcf0e2449a6b525"
+		 "b16aedf5aa0de657ba637b39"),
+	    SHEX("522dc1f099567d07f47f37a32a84427d"
+		 "643a8cdcbfe5c0c97598a2bd2555d1aa"
+		 "8cb08e48590dbb3da7b08b1056828838"
+		 "c5f61e6393ba7a0abcc9f662"),
+	    SHEX("cafebabefacedbaddecaf888"),
+	    SHEX("76fc6ece0f4e1768cddf8853bb2d551b"));
+
+  test_aead(&nettle_gcm_aes256_compact,
+	    (nettle_hash_update_func *) gcm_aes256_compact_set_iv,
+	    SHEX("feffe9928665731c6d6a8f9467308308"
+		 "feffe9928665731c6d6a8f9467308308"),
+	    SHEX("feedfacedeadbeeffeedfacedeadbeef"
+		 "abaddad2"),
+	    SHEX("d9313225f88406e5a55909c5aff5269a"
+		 "86a7a9531534f7da2e4c303d8a318a72"
+		 "1c3c0c95956809532fcf0e2449a6b525"
+		 "b16aedf5aa0de657ba637b39"),
+	    SHEX("c3762df1ca787d32ae47c13bf19844cb"
+		 "af1ae14d0b976afac52ff7d79bba9de0"
+		 "feb582d33934a4f0954cc2363bc73f78"
+		 "62ac430e64abe499f47c9b1f"),
+	    SHEX("cafebabefacedbad"),
+	    SHEX("3a337dbf46a792c45e454913fe2ea8f2"));
+
+  /* Separate key and state. */
+  test_aead_v2(&nettle_gcm_aes128_v2,
+	       SHEX("feffe9928665731c6d6a8f9467308308"),
+	       SHEX("feedfacedeadbeeffeedfacedeadbeef"
+		    "abaddad2"),
+	       SHEX("d9313225f88406e5a55909c5aff5269a"
+		    "86a7a9531534f7da2e4c303d8a318a72"
+		    "1c3c0c95956809532fcf0e2449a6b525"
+		    "b16aedf5aa0de657ba637b39"),
+	       SHEX("42831ec2217774244b7221b784d0d49c"
+		    "e3aa212f2c02a4e035c17e2329aca12e"
+		    "21d514b25466931c7d8f6a5aac84aa05"
+		    "1ba30b396a0aac973d58e091"),
+	       SHEX("cafebabefacedbaddecaf888"),
+	       SHEX("5bc94fbc3221a5db94fae95ae7121a47"));
+
+  test_aead_v2(&nettle_gcm_aes128_v2,
+	       SHEX("feffe9928665731c6d6a8f9467308308"),
+	       SHEX(""),
+	       SHEX("d9313225f88406e5a55909c5aff5269a"
+		    "86a7a9531534f7da2e4c303d8a318a72"
+		    "1c3c0c95956809532fcf0e2449a6b525"
+		    "b16aedf5aa0de657ba637b391aafd255"
+		    "5ae376bc5e9f6a1b08e34db7a6ee0736"
+		    "9ba662ea12f6f197e6bc3ed69d2480f3"
+		    "ea5691347f2ba69113eb37910ebc18c8"
+		    "0f697234582016fa956ca8f63ae6b473"),
+	       SHEX("42831ec2217774244b7221b784d0d49c"
+		    "e3aa212f2c02a4e035c17e2329aca12e"
+		    "21d514b25466931c7d8f6a5aac84aa05"
+		    "1ba30b396a0aac973d58e091473f5985"
+		    "874b1178906ddbeab04ab2fe6cce8c57"
+		    "8d7e961bd13fd6a8c56b66ca5e576492"
+		    "1a48cd8bda04e66343e73055118b69b9"
+		    "ced486813846958a11e602c03cfc232b"),
+	       SHEX("cafebabefacedbaddecaf888"),
+	       SHEX("796836f1246c9d735c5e1be0a715ccc3"));
+
+  test_aead_v2(&nettle_gcm_aes256_v2,
+	       SHEX("feffe9928665731c6d6a8f9467308308"
+		    "feffe9928665731c6d6a8f9467308308"),
+	       SHEX("feedfacedeadbeeffeedfacedeadbeef"
+		    "abaddad2"),
+	       SHEX("d9313225f88406e5a55909c5aff5269a"
+		    "86a7a9531534f7da2e4c303d8a318a72"
+		    "1c3c0c95956809532fcf0e2449a6b525"
+		    "b16aedf5aa0de657ba637b39"),
+	       SHEX("522dc1f099567d07f47f37a32a84427d"
+		    "643a8cdcbfe5c0c97598a2bd2555d1aa"
+		    "8cb08e48590dbb3da7b08b1056828838"
+		    "c5f61e6393ba7a0abcc9f662"),
+	       SHEX("cafebabefacedbaddecaf888"),
+	       SHEX("76fc6ece0f4e1768cddf8853bb2d551b"));
+
+  test_aead_batch (&nettle_gcm_aes128,
+		   (nettle_seal_batch_func *) gcm_aes128_seal_batch,
+		   (nettle_open_batch_func *) gcm_aes128_open_batch);
+  test_aead_batch (&nettle_gcm_aes256,
+		   (nettle_seal_batch_func *) gcm_aes256_seal_batch,
+		   (nettle_open_batch_func *) gcm_aes256_open_batch);
+  test_aead_iov (&nettle_gcm_aes128,
+		 (nettle_crypt_iov_func *) gcm_aes128_encrypt_iov,
+		 (nettle_crypt_iov_func *) gcm_aes128_decrypt_iov);
+  test_aead_iov (&nettle_gcm_aes256,
+		 (nettle_crypt_iov_func *) gcm_aes256_encrypt_iov,
+		 (nettle_crypt_iov_func *) gcm_aes256_decrypt_iov);
+
   /* 
    * GCM-Camellia Test Vectors obtained from the authors
    */
@@ -887,4 +1212,6 @@ test_main(void)
 		      SHEX("0000000000000000 0000000000000000"),
 		      SHEX("0011223344556677 89abcdef01234567"),
 		      SHEX("1503b3c4a3c44c3a 800f1ff13ff0e00f"));
+
+  test_ghash_compact ();
 }
@@ -6,11 +6,27 @@ const char* aeads[] = {
   "gcm_aes128",
   "gcm_aes192",
   "gcm_aes256",
+  "gcm_aes128_compact",
+  "gcm_aes256_compact",
   "gcm_camellia128",
   "gcm_camellia256",
   "gcm_sm4",
   "eax_aes128",
   "chacha_poly1305",
+  "aegis128l",
+  "aegis256",
+};
+
+const char* aeads_v2[] = {
+  "gcm_aes128",
+  "gcm_aes256",
+  "ccm_aes128",
+  "ccm_aes256",
+  "eax_aes128",
+  "ocb_aes128",
+  "chacha_poly1305",
+  "siv_gcm_aes128",
+  "siv_gcm_aes256",
 };
 
 void
@@ -29,5 +45,17 @@ test_main(void)
   while (NULL != nettle_aeads[j])
     j++;
   ASSERT(j == count); /* we are not missing testing any aeads */
+
+  count = sizeof(aeads_v2)/sizeof(*aeads_v2);
+  for (i = 0; i < count; i++) {
+    for (j = 0; NULL != nettle_aeads_v2[j]; j++) {
+      if (0 == strcmp(aeads_v2[i], nettle_aeads_v2[j]->name))
+        break;
+    }
+    ASSERT(NULL != nettle_aeads_v2[j]);
+  }
+  j = 0;
+  while (NULL != nettle_aeads_v2[j])
+    j++;
+  ASSERT(j == count);
 }
-  
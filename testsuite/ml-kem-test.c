@@ -77,6 +77,7 @@ test_ml_kem_encap (const struct ml_kem_params *params,
   uint8_t *ciphertext2;
   uint8_t secret2[32];
   uint16_t *scratch;
+  uint16_t *expanded;
 
   ASSERT (pk->length == params->public_key_size);
   ASSERT (seed->length == 32);
@@ -98,6 +99,27 @@ test_ml_kem_encap (const struct ml_kem_params *params,
   ASSERT (MEMEQ (ciphertext->length, ciphertext->data, ciphertext2));
   ASSERT (MEMEQ (secret->length, secret->data, secret2));
 
+  free (scratch);
+
+  /* Same, with expanded public key. */
+  expanded = xalloc (ml_kem_expanded_public_key_size (params)
+		     * sizeof(uint16_t));
+  scratch = xalloc (ml_kem_encap_expanded_itch (params) * sizeof(uint16_t));
+
+  ml_kem_public_key_expand (params, expanded, pk->data);
+
+  memset (ciphertext2, 0, params->ciphertext_size);
+  ml_kem_encap_expanded (params, expanded, secret2, ciphertext2,
+			 (void *)seed, (nettle_random_func *)random_from_seed,
+			 scratch);
+
+  mark_bytes_defined (params->ciphertext_size, ciphertext2);
+  mark_bytes_defined (sizeof(secret2), secret2);
+
+  ASSERT (MEMEQ (ciphertext->length, ciphertext->data, ciphertext2));
+  ASSERT (MEMEQ (secret->length, secret->data, secret2));
+
+  free (expanded);
   free (ciphertext2);
   free (scratch);
 }
@@ -110,6 +132,7 @@ test_ml_kem_decap (const struct ml_kem_params *params,
 {
   uint8_t secret2[32];
   uint16_t *scratch;
+  uint16_t *expanded;
 
   ASSERT (sk->length == params->private_key_size);
   ASSERT (ciphertext->length == params->ciphertext_size);
@@ -126,6 +149,27 @@ test_ml_kem_decap (const struct ml_kem_params *params,
   ASSERT (MEMEQ (secret->length, secret->data, secret2));
 
   free (scratch);
+
+  /* Same, with expanded private key. */
+  expanded = xalloc (ml_kem_expanded_private_key_size (params)
+		     * sizeof(uint16_t));
+  scratch = xalloc (ml_kem_decap_expanded_itch (params) * sizeof(uint16_t));
+
+  ml_kem_private_key_expand (params, expanded, sk->data);
+
+  mark_bytes_undefined (_ml_kem_inner_expand_private_key_size (params)
+			* sizeof(uint16_t), expanded);
+
+  memset (secret2, 0, sizeof(secret2));
+  ml_kem_decap_expanded (params, expanded, secret2, ciphertext->data,
+			 scratch);
+
+  mark_bytes_defined (sizeof(secret2), secret2);
+
+  ASSERT (MEMEQ (secret->length, secret->data, secret2));
+
+  free (expanded);
+  free (scratch);
 }
 
 static void
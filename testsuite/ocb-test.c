@@ -393,4 +393,16 @@ test_main(void)
 		"140452dc850989f6762e3578bbb04be3"), /* ciphertext */
 	   SHEX("BBAA9988776655443322110D"), /* nonce */
 	   SHEX("1a237c599c4649f4e586b2de")); /* tag */
+
+  /* Separate key and state. */
+  test_aead_v2(&nettle_ocb_aes128_v2,
+	       SHEX("000102030405060708090A0B0C0D0E0F"), /* key */
+	       SHEX("000102030405060708090A0B0C0D0E0F1011121314151617"
+		    "18191A1B1C1D1E1F2021222324252627"), /* auth data */
+	       SHEX("000102030405060708090A0B0C0D0E0F1011121314151617"
+		    "18191A1B1C1D1E1F2021222324252627"), /* plaintext */
+	       SHEX("D5CA91748410C1751FF8A2F618255B68A0A12E093FF45460"
+		    "6E59F9C1D0DDC54B65E8628E568BAD7A"), /* ciphertext */
+	       SHEX("BBAA9988776655443322110D"), /* nonce */
+	       SHEX("ED07BA06A4A69483A7035490C5769E60"));
 }
@@ -1,4 +1,110 @@
 #include "testutils.h"
+#include "knuth-lfib.h"
+
+#define PREPARED_COUNT 3
+
+static void
+test_rsa_prepared(struct rsa_public_key *pub,
+		  struct rsa_private_key *key)
+{
+  struct rsa_prepared_public_key ctx;
+  struct knuth_lfib_ctx rstate;
+  uint8_t digest_infos[PREPARED_COUNT * 20];
+  uint8_t *signatures;
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  uint8_t salt[SHA256_DIGEST_SIZE];
+  int valid[PREPARED_COUNT];
+  mpz_t s, c1, c2, e;
+  size_t length;
+  unsigned i;
+
+  mpz_init (s);
+  mpz_init (c1);
+  mpz_init (c2);
+  mpz_init_set (e, pub->e);
+  knuth_lfib_init (&rstate, 19);
+
+  ASSERT (rsa_prepared_public_key_init (&ctx, pub));
+  ASSERT (ctx.size == pub->size);
+
+  signatures = xalloc (PREPARED_COUNT * pub->size);
+  knuth_lfib_random (&rstate, sizeof (digest_infos), digest_infos);
+
+  for (i = 0; i < PREPARED_COUNT; i++)
+    {
+      ASSERT (rsa_pkcs1_sign (key, 20, digest_infos + 20*i, s));
+      ASSERT (rsa_pkcs1_verify (pub, 20, digest_infos + 20*i, s));
+      ASSERT (rsa_prepared_pkcs1_verify (&ctx, 20, digest_infos + 20*i, s));
+      ASSERT (!rsa_prepared_pkcs1_verify (&ctx, 20, digest_infos
+					  + 20*((i+1) % PREPARED_COUNT), s));
+      nettle_mpz_get_str_256 (pub->size, signatures + i*pub->size, s);
+
+      mpz_combit (s, 17);
+      ASSERT (!rsa_prepared_pkcs1_verify (&ctx, 20, digest_infos + 20*i, s));
+    }
+  ASSERT (!rsa_prepared_pkcs1_verify (&ctx, 20, digest_infos, pub->n));
+  mpz_set_ui (s, 0);
+  ASSERT (!rsa_prepared_pkcs1_verify (&ctx, 20, digest_infos, s));
+
+  ASSERT (rsa_prepared_pkcs1_verify_batch (&ctx, PREPARED_COUNT, 20,
+					   digest_infos, signatures, NULL));
+  signatures[pub->size + 5] ^= 1;
+  ASSERT (!rsa_prepared_pkcs1_verify_batch (&ctx, PREPARED_COUNT, 20,
+					    digest_infos, signatures, valid));
+  ASSERT (valid[0] && !valid[1] && valid[2]);
+
+  knuth_lfib_random (&rstate, sizeof (digest), digest);
+  knuth_lfib_random (&rstate, sizeof (salt), salt);
+  ASSERT (rsa_pss_sha256_sign_digest_tr (pub, key, &rstate,
+					 (nettle_random_func *) knuth_lfib_random,
+					 sizeof (salt), salt, digest, s));
+  ASSERT (rsa_prepared_pss_sha256_verify_digest (&ctx, sizeof (salt),
+						 digest, s));
+  digest[3] ^= 1;
+  ASSERT (!rsa_prepared_pss_sha256_verify_digest (&ctx, sizeof (salt),
+						  digest, s));
+
+  ASSERT (rsa_prepared_encrypt (&ctx, &rstate,
+				(nettle_random_func *) knuth_lfib_random,
+				20, digest_infos, c1));
+  length = sizeof (digest);
+  ASSERT (rsa_decrypt (key, &length, digest, c1));
+  ASSERT (length == 20 && MEMEQ (20, digest, digest_infos));
+
+  rsa_prepared_public_key_clear (&ctx);
+
+  /* Compare with rsa_encrypt, for other exponents. */
+  for (i = 0; i < 2; i++)
+    {
+      mpz_set_ui (pub->e, i ? 65537 : 3);
+      ASSERT (rsa_prepared_public_key_init (&ctx, pub));
+
+      knuth_lfib_init (&rstate, 23);
+      ASSERT (rsa_encrypt (pub, &rstate,
+			   (nettle_random_func *) knuth_lfib_random,
+			   20, digest_infos, c1));
+      knuth_lfib_init (&rstate, 23);
+      ASSERT (rsa_prepared_encrypt (&ctx, &rstate,
+				    (nettle_random_func *) knuth_lfib_random,
+				    20, digest_infos, c2));
+      ASSERT (mpz_cmp (c1, c2) == 0);
+      rsa_prepared_public_key_clear (&ctx);
+    }
+
+  /* Unsupported exponents. */
+  mpz_set_ui (pub->e, 65536);
+  ASSERT (!rsa_prepared_public_key_init (&ctx, pub));
+  mpz_set_ui (pub->e, 1);
+  ASSERT (!rsa_prepared_public_key_init (&ctx, pub));
+
+  mpz_set (pub->e, e);
+
+  free (signatures);
+  mpz_clear (s);
+  mpz_clear (c1);
+  mpz_clear (c2);
+  mpz_clear (e);
+}
 
 void
 test_main(void)
@@ -57,6 +163,8 @@ test_main(void)
 
   test_rsa_sha512(&pub, &key, expected);
 
+  test_rsa_prepared(&pub, &key);
+
   /* Test detection of invalid keys with even modulo */
   mpz_clrbit (pub.n, 0);
   ASSERT (!rsa_public_key_prepare (&pub));
@@ -177,6 +285,8 @@ test_main(void)
 
   test_rsa_sha512(&pub, &key, expected);
 
+  test_rsa_prepared(&pub, &key);
+
   rsa_private_key_clear(&key);
   rsa_public_key_clear(&pub);
   mpz_clear(expected);
@@ -0,0 +1,115 @@
+#include "testutils.h"
+#include "sexp.h"
+#include "buffer.h"
+
+static const char keyring[] =
+  "(7:keyring"
+  "(11:private-key(9:rsa-pkcs1(1:n1:\x11)(1:e1:\x03)))"
+  "(10:public-key(16:rsa-pkcs1-sha256(1:n1:\x22)(1:e1:\x03)))"
+  "(10:public-key(16:rsa-pkcs1-sha256(1:n1:\x33)(1:e1:\x03)))"
+  "(10:public-key[4:text]3:foo)"
+  "())"
+  "(7:comment)";
+
+static void
+check_list(const struct sexp_index *index, uint32_t id,
+	   const char *expr)
+{
+  struct sexp_iterator i;
+  const uint8_t *p;
+  size_t length;
+
+  ASSERT (sexp_index_iterator (index, id, &i));
+  ASSERT (i.type == SEXP_LIST);
+  p = sexp_iterator_subexpr (&i, &length);
+  ASSERT (p);
+  ASSERT (length == strlen (expr));
+  ASSERT (MEMEQ (length, p, expr));
+}
+
+void
+test_main(void)
+{
+  struct nettle_buffer buffer;
+  struct sexp_index index;
+  const uint8_t *data = (const uint8_t *) keyring;
+  size_t length = sizeof(keyring) - 1;
+  uint32_t id, ring, key;
+
+  nettle_buffer_init (&buffer);
+  ASSERT (sexp_index_build (&buffer, length, data));
+  ASSERT (sexp_index_init (&index, buffer.size, buffer.contents,
+			   length, data));
+  ASSERT (index.count == 16);
+
+  ASSERT (sexp_index_assoc (&index, SEXP_INDEX_ROOT, "keyring", &ring));
+  ASSERT (ring == 0);
+  ASSERT (sexp_index_parent (&index, ring) == SEXP_INDEX_ROOT);
+  ASSERT (sexp_index_assoc (&index, SEXP_INDEX_ROOT, "comment", &id));
+  check_list (&index, id, "(7:comment)");
+  ASSERT (!sexp_index_assoc (&index, SEXP_INDEX_ROOT, "public-key", &id));
+
+  ASSERT (sexp_index_assoc (&index, ring, "private-key", &key));
+  ASSERT (sexp_index_parent (&index, key) == ring);
+  ASSERT (sexp_index_assoc (&index, key, "rsa-pkcs1", &id));
+  ASSERT (sexp_index_assoc (&index, id, "e", &id));
+  check_list (&index, id, "(1:e1:\x03)");
+  ASSERT (!sexp_index_assoc (&index, ring, "rsa-pkcs1", &id));
+
+  /* Find public key by value of n */
+  ASSERT (sexp_index_lookup (&index, LDATA("(1:n1:\x33)"), &id));
+  check_list (&index, id, "(1:n1:\x33)");
+  id = sexp_index_parent (&index, id);
+  check_list (&index, id, "(16:rsa-pkcs1-sha256(1:n1:\x33)(1:e1:\x03))");
+  key = sexp_index_parent (&index, id);
+  ASSERT (sexp_index_parent (&index, key) == ring);
+  check_list (&index, key,
+	      "(10:public-key(16:rsa-pkcs1-sha256(1:n1:\x33)(1:e1:\x03)))");
+  ASSERT (!sexp_index_lookup (&index, LDATA("(1:n1:\x44)"), &id));
+  ASSERT (!sexp_index_lookup (&index, LDATA("(1:n1:\x33"), &id));
+  ASSERT (sexp_index_lookup (&index, LDATA("()"), &id));
+  ASSERT (sexp_index_parent (&index, id) == ring);
+
+  /* Mismatch or corruption. */
+  ASSERT (!sexp_index_init (&index, buffer.size, buffer.contents,
+			    length - 1, data));
+  ASSERT (!sexp_index_init (&index, buffer.size - 1, buffer.contents,
+			    length, data));
+  buffer.contents[16 + 20 + 8] ^= 1;
+  ASSERT (!sexp_index_init (&index, buffer.size, buffer.contents,
+			    length, data));
+
+  /* Failure must leave the buffer unchanged, also when entries have
+     already been appended. */
+  nettle_buffer_reset (&buffer);
+  ASSERT (nettle_buffer_write (&buffer, LDATA("xyz")));
+  ASSERT (!sexp_index_build (&buffer, LDATA("(3:foo")));
+  ASSERT (buffer.size == 3);
+  ASSERT (!sexp_index_build (&buffer, LDATA("((1:a)(1:b)(1:c")));
+  ASSERT (buffer.size == 3);
+  ASSERT (!sexp_index_build (&buffer, LDATA("(1:a(1:b))3:fo")));
+  ASSERT (buffer.size == 3);
+  ASSERT (MEMEQ (3, buffer.contents, "xyz"));
+
+  /* Out of space for the tables, after the entries are written. */
+  {
+    struct nettle_buffer small;
+    /* The index needs 16 + 3*20 octets for header and entries, and
+       64 for the tables. */
+    uint8_t space[150];
+    nettle_buffer_init_size (&small, sizeof (space), space);
+    ASSERT (nettle_buffer_space (&small, 20));
+    ASSERT (!sexp_index_build (&small, LDATA("((1:a)(1:b))")));
+    ASSERT (small.size == 20);
+    nettle_buffer_reset (&small);
+    ASSERT (sexp_index_build (&small, LDATA("((1:a)(1:b))")));
+  }
+  nettle_buffer_reset (&buffer);
+  ASSERT (sexp_index_build (&buffer, LDATA("3:foo")));
+  ASSERT (sexp_index_init (&index, buffer.size, buffer.contents,
+			   LDATA("3:foo")));
+  ASSERT (index.count == 0);
+  ASSERT (!sexp_index_lookup (&index, LDATA("()"), &id));
+
+  nettle_buffer_clear (&buffer);
+}
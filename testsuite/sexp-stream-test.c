@@ -0,0 +1,148 @@
+#include "testutils.h"
+#include "sexp.h"
+#include "buffer.h"
+
+/* Feeds input in chunks of the given size, and reconstructs the
+   canonical expression from the events. */
+static int
+parse_chunked(struct nettle_buffer *out, int transport,
+	      size_t length, const uint8_t *input, size_t chunk)
+{
+  struct sexp_stream_parser parser;
+  uint8_t *copy = xalloc(length + 1);
+  struct nettle_buffer atom;
+  size_t pos;
+
+  memcpy (copy, input, length);
+  nettle_buffer_init (&atom);
+  nettle_buffer_reset (out);
+  sexp_stream_parser_init (&parser);
+
+  for (pos = 0; pos < length; pos += chunk)
+    {
+      size_t n = length - pos < chunk ? length - pos : chunk;
+      int res;
+      if (transport)
+	{
+	  if (!sexp_stream_parser_transport_input (&parser, n, copy + pos))
+	    goto fail;
+	}
+      else
+	sexp_stream_parser_input (&parser, n, copy + pos);
+
+      while ( (res = sexp_stream_parser_next (&parser)) == SEXP_STREAM_EVENT)
+	switch (parser.type)
+	  {
+	  case SEXP_LIST:
+	    ASSERT (NETTLE_BUFFER_PUTC(out, '('));
+	    break;
+	  case SEXP_END:
+	    ASSERT (NETTLE_BUFFER_PUTC(out, ')'));
+	    break;
+	  case SEXP_ATOM:
+	    ASSERT (nettle_buffer_write (&atom, parser.atom_length,
+					 parser.atom));
+	    if (!parser.remaining)
+	      {
+		char prefix[30];
+		if (parser.display)
+		  ASSERT (NETTLE_BUFFER_PUTC(out, '['));
+		snprintf (prefix, sizeof(prefix), "%lu:",
+			  (unsigned long) atom.size);
+		ASSERT (nettle_buffer_write (out, strlen(prefix),
+					     (const uint8_t *) prefix));
+		ASSERT (nettle_buffer_write (out, atom.size, atom.contents));
+		if (parser.display)
+		  ASSERT (NETTLE_BUFFER_PUTC(out, ']'));
+		nettle_buffer_reset (&atom);
+	      }
+	    break;
+	  default:
+	    abort ();
+	  }
+      if (res == SEXP_STREAM_ERROR)
+	goto fail;
+    }
+  free (copy);
+  nettle_buffer_clear (&atom);
+  return sexp_stream_parser_final (&parser);
+
+ fail:
+  free (copy);
+  nettle_buffer_clear (&atom);
+  return 0;
+}
+
+static void
+test_stream(size_t length, const uint8_t *input)
+{
+  struct nettle_buffer out;
+  size_t chunk;
+
+  nettle_buffer_init (&out);
+  for (chunk = 1; chunk <= length; chunk++)
+    {
+      ASSERT (parse_chunked (&out, 0, length, input, chunk));
+      ASSERT (out.size == length);
+      ASSERT (MEMEQ (length, out.contents, input));
+    }
+  nettle_buffer_clear (&out);
+}
+
+static void
+test_stream_transport(const char *input, size_t length, const uint8_t *expected)
+{
+  struct nettle_buffer out;
+  size_t chunk;
+
+  nettle_buffer_init (&out);
+  for (chunk = 1; chunk <= strlen (input); chunk++)
+    {
+      ASSERT (parse_chunked (&out, 1, strlen (input),
+			     (const uint8_t *) input, chunk));
+      ASSERT (out.size == length);
+      ASSERT (MEMEQ (length, out.contents, expected));
+    }
+  nettle_buffer_clear (&out);
+}
+
+static void
+test_stream_invalid(size_t length, const uint8_t *input)
+{
+  struct nettle_buffer out;
+  size_t chunk;
+
+  nettle_buffer_init (&out);
+  for (chunk = 1; chunk <= length; chunk++)
+    ASSERT (!parse_chunked (&out, 0, length, input, chunk));
+  nettle_buffer_clear (&out);
+}
+
+void
+test_main(void)
+{
+  test_stream (LDATA(""));
+  test_stream (LDATA("()"));
+  test_stream (LDATA("3:foo0:[3:bar]12:xxxxxxxxxxxx"));
+  test_stream (LDATA("(3:foo(3:bar[1:x]0:)(3:baz1:\0)())"));
+  test_stream (LDATA("(11:private-key(9:rsa-pkcs1(1:n3:\x01\x02\x03)"
+		     "(1:e1:\x03)))(10:public-key)"));
+
+  test_stream_invalid (LDATA("("));
+  test_stream_invalid (LDATA(")"));
+  test_stream_invalid (LDATA("3"));
+  test_stream_invalid (LDATA("3:"));
+  test_stream_invalid (LDATA("4:foo"));
+  test_stream_invalid (LDATA("01:x"));
+  test_stream_invalid (LDATA("[3:bar]"));
+  test_stream_invalid (LDATA("[3:bar][1:x]1:y"));
+  test_stream_invalid (LDATA("(3:foo) 3:bar"));
+  test_stream_invalid (LDATA("18446744073709551616:foo"));
+
+  test_stream_transport ("{Mzpmb28=} {MDo=}\n"
+			 "; Comment\n"
+			 "{WzM6YmFyXTEyOnh4eHh4eHh4eHh4eA==}",
+			 LDATA("3:foo0:[3:bar]12:xxxxxxxxxxxx"));
+  test_stream_transport ("{KDM6Zm9v Mzpi\nYXIp}",
+			 LDATA("(3:foo3:bar)"));
+}
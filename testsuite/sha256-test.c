@@ -2,6 +2,8 @@
 
 #include "nettle-write.h"
 #include "sha2.h"
+#include "sha2-internal.h"
+#include "knuth-lfib.h"
 
 /* Test compression only. */
 static void
@@ -35,6 +37,80 @@ test_sha256_compress(const struct tstring *input,
     }
 }
 
+/* Compares sha256_update_iov to sha256_update, for fragments of
+   many sizes. */
+static void
+test_sha256_iov(void)
+{
+  static const size_t sizes[] = { 0, 1, 3, SHA256_BLOCK_SIZE - 1,
+				  SHA256_BLOCK_SIZE, 2 * SHA256_BLOCK_SIZE + 5 };
+  struct nettle_iov iov[20];
+  uint8_t data[1000];
+  size_t i, offset;
+  struct knuth_lfib_ctx rand;
+
+  knuth_lfib_init (&rand, 17);
+  knuth_lfib_random (&rand, sizeof (data), data);
+
+  for (i = offset = 0; i < 20; i++)
+    {
+      iov[i].length = sizes[(i * 5) % 6];
+      iov[i].data = data + offset;
+      offset += iov[i].length;
+    }
+  ASSERT (offset <= sizeof (data));
+
+  for (i = 0; i <= 20; i++)
+    {
+      struct sha256_ctx ctx;
+      uint8_t expected[SHA256_DIGEST_SIZE];
+      uint8_t digest[SHA256_DIGEST_SIZE];
+      size_t j, length;
+
+      for (j = length = 0; j < i; j++)
+	length += iov[j].length;
+
+      sha256_init (&ctx);
+      sha256_update (&ctx, length, data);
+      sha256_digest (&ctx, expected);
+
+      sha256_init (&ctx);
+      sha256_update_iov (&ctx, i, iov);
+      sha256_digest (&ctx, digest);
+      ASSERT (MEMEQ (SHA256_DIGEST_SIZE, digest, expected));
+    }
+}
+
+/* Compares _nettle_sha256_compress_x4 to four calls to
+   sha256_compress, on random states and blocks. */
+static void
+test_sha256_compress_x4(void)
+{
+  struct knuth_lfib_ctx rand;
+  unsigned count;
+
+  knuth_lfib_init (&rand, 4711);
+  for (count = 0; count < 100; count++)
+    {
+      uint32_t state[4 * _SHA256_DIGEST_LENGTH];
+      uint32_t expected[4 * _SHA256_DIGEST_LENGTH];
+      /* Extra byte to test unaligned input. */
+      uint8_t input[4 * SHA256_BLOCK_SIZE + 1];
+      unsigned i;
+
+      for (i = 0; i < 4 * _SHA256_DIGEST_LENGTH; i++)
+	state[i] = expected[i] = knuth_lfib_get (&rand);
+      knuth_lfib_random (&rand, sizeof (input), input);
+
+      for (i = 0; i < 4; i++)
+	sha256_compress (expected + i * _SHA256_DIGEST_LENGTH,
+			 input + 1 + i * SHA256_BLOCK_SIZE);
+
+      _nettle_sha256_compress_x4 (state, input + 1);
+      ASSERT (MEMEQ (sizeof (state), state, expected));
+    }
+}
+
 void
 test_main(void)
 {
@@ -102,6 +178,9 @@ test_main(void)
 		  "5678901234567890"),
 	    SHEX("f371bc4a311f2b00 9eef952dd83ca80e"
 		 "2b60026c8e935592 d0f9c308453c813e"));
+
+  test_sha256_iov ();
+  test_sha256_compress_x4 ();
 }
 
 /* These are intermediate values for the single sha1_compress call
@@ -1,5 +1,52 @@
 #include "testutils.h"
 
+#include "sha2.h"
+#include "knuth-lfib.h"
+
+/* Compares sha512_update_iov to sha512_update, for fragments of
+   many sizes. */
+static void
+test_sha512_iov(void)
+{
+  static const size_t sizes[] = { 0, 1, 3, SHA512_BLOCK_SIZE - 1,
+				  SHA512_BLOCK_SIZE, 2 * SHA512_BLOCK_SIZE + 5 };
+  struct nettle_iov iov[20];
+  uint8_t data[20 * 3 * SHA512_BLOCK_SIZE];
+  size_t i, offset;
+  struct knuth_lfib_ctx rand;
+
+  knuth_lfib_init (&rand, 17);
+  knuth_lfib_random (&rand, sizeof (data), data);
+
+  for (i = offset = 0; i < 20; i++)
+    {
+      iov[i].length = sizes[(i * 5) % 6];
+      iov[i].data = data + offset;
+      offset += iov[i].length;
+    }
+  ASSERT (offset <= sizeof (data));
+
+  for (i = 0; i <= 20; i++)
+    {
+      struct sha512_ctx ctx;
+      uint8_t expected[SHA512_DIGEST_SIZE];
+      uint8_t digest[SHA512_DIGEST_SIZE];
+      size_t j, length;
+
+      for (j = length = 0; j < i; j++)
+	length += iov[j].length;
+
+      sha512_init (&ctx);
+      sha512_update (&ctx, length, data);
+      sha512_digest (&ctx, expected);
+
+      sha512_init (&ctx);
+      sha512_update_iov (&ctx, i, iov);
+      sha512_digest (&ctx, digest);
+      ASSERT (MEMEQ (SHA512_DIGEST_SIZE, digest, expected));
+    }
+}
+
 void
 test_main(void)
 {
@@ -108,6 +155,8 @@ test_main(void)
 		 "135bb61de24ec0d1 914042246e0aec3a"
 		 "2354e093d76f3048 b456764346900cb1"
 		 "30d2a4fd5dd16abb 5e30bcb850dee843"));
+
+  test_sha512_iov ();
 }
 
 /* For first test case.
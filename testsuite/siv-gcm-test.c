@@ -102,6 +102,96 @@ test_polyval_internal (const struct tstring *key,
     }
 }
 
+/* Checks that processing several blocks per call, which may use
+   aggregated reduction, agrees with processing one block at a
+   time. */
+static void
+test_polyval_blocks (void)
+{
+  struct gcm_key gcm_key;
+  union nettle_block16 key;
+  union nettle_block16 state;
+  union nettle_block16 ref;
+  uint8_t data[40 * GCM_BLOCK_SIZE];
+  size_t blocks, i;
+
+  for (i = 0; i < sizeof (data); i++)
+    data[i] = 17*i + 3;
+  for (i = 0; i < GCM_BLOCK_SIZE; i++)
+    key.b[i] = 0xa5 ^ (31*i);
+
+  _siv_ghash_set_key (&gcm_key, &key);
+  for (blocks = 1; blocks <= 40; blocks++)
+    {
+      block16_zero (&ref);
+      for (i = 0; i < blocks; i++)
+	_siv_ghash_update (&gcm_key, &ref, 1, data + i * GCM_BLOCK_SIZE);
+
+      block16_zero (&state);
+      ASSERT (_siv_ghash_update (&gcm_key, &state, blocks, data)
+	      == data + blocks * GCM_BLOCK_SIZE);
+      if (!MEMEQ (GCM_BLOCK_SIZE, state.b, ref.b))
+	{
+	  fprintf (stderr, "POLYVAL failed for %u blocks\n",
+		   (unsigned) blocks);
+	  fprintf (stderr, "Output: ");
+	  print_hex (GCM_BLOCK_SIZE, state.b);
+	  fprintf (stderr, "\nExpected:");
+	  print_hex (GCM_BLOCK_SIZE, ref.b);
+	  fprintf (stderr, "\n");
+	  FAIL();
+	}
+    }
+}
+
+/* Decryption processes long messages in chunks, check that it
+   agrees with encryption. */
+static void
+test_siv_gcm_long (void)
+{
+  struct aes128_ctx ctx;
+  uint8_t key[AES128_KEY_SIZE];
+  uint8_t nonce[SIV_GCM_NONCE_SIZE];
+  uint8_t adata[100];
+  uint8_t *src, *dst, *clear;
+  size_t lengths[] = { 2047, 2048, 2049, 4096, 5000 };
+  size_t i, j;
+
+  memset (key, 7, sizeof (key));
+  memset (nonce, 9, sizeof (nonce));
+  memset (adata, 11, sizeof (adata));
+  aes128_set_encrypt_key (&ctx, key);
+
+  for (i = 0; i < sizeof (lengths) / sizeof (lengths[0]); i++)
+    {
+      size_t length = lengths[i];
+      src = xalloc (length);
+      dst = xalloc (length + SIV_GCM_DIGEST_SIZE);
+      clear = xalloc (length);
+
+      for (j = 0; j < length; j++)
+	src[j] = j * 5 + i;
+
+      siv_gcm_aes128_encrypt_message (&ctx, sizeof (nonce), nonce,
+				      sizeof (adata), adata,
+				      length + SIV_GCM_DIGEST_SIZE, dst, src);
+      ASSERT (siv_gcm_aes128_decrypt_message (&ctx,
+					      sizeof (nonce), nonce,
+					      sizeof (adata), adata,
+					      length, clear, dst));
+      ASSERT (MEMEQ (length, clear, src));
+
+      dst[length / 2] ^= 1;
+      ASSERT (!siv_gcm_aes128_decrypt_message (&ctx,
+					       sizeof (nonce), nonce,
+					       sizeof (adata), adata,
+					       length, clear, dst));
+      free (src);
+      free (dst);
+      free (clear);
+    }
+}
+
 void
 test_main(void)
 {
@@ -111,6 +201,9 @@ test_main(void)
 			      "d1a24ddd2721d006bbe45f20d3c9f362"),
 			 SHEX("f7a3b47b846119fae5b7866cf5e5b77e"));
 
+  test_polyval_blocks ();
+  test_siv_gcm_long ();
+
   /* RFC8452, Appendix C.1.  */
   test_aead_message(&siv_gcm_aes128,
 		       SHEX("01000000000000000000000000000000"),
@@ -617,4 +710,21 @@ test_main(void)
 		       SHEX("18ce4f0b8cb4d0cac65fea8f79257b20"
 		            "888e53e72299e56dffffffff00000000"
 		            "0000000000000000"));
+
+  test_aead_v2(&nettle_siv_gcm_aes128_v2,
+	       SHEX("01000000000000000000000000000000"),
+	       SHEX("01"),
+	       SHEX("0200000000000000"),
+	       SHEX("1e6daba35669f427"),
+	       SHEX("030000000000000000000000"),
+	       SHEX("3b0a1a2560969cdf790d99759abd1508"));
+
+  test_aead_v2(&nettle_siv_gcm_aes256_v2,
+	       SHEX("01000000000000000000000000000000"
+		    "00000000000000000000000000000000"),
+	       SHEX(""),
+	       SHEX("010000000000000000000000"),
+	       SHEX("9aab2aeb3faa0a34aea8e2b1"),
+	       SHEX("030000000000000000000000"),
+	       SHEX("8ca50da9ae6559e48fd10f6e5c9ca17e"));
 }
@@ -86,10 +86,14 @@ test_wots_sign (const struct tstring *public_seed, const struct tstring *secret_
 
 /* The xmss_leaf and xmss_node functions copied from slh-xmss.c */
 static void
-xmss_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx, uint8_t *leaf)
+xmss_leaf (const struct slh_merkle_ctx_secret *ctx, unsigned idx,
+	   unsigned n, uint8_t *leaf)
 {
-  _wots_gen (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx, leaf, ctx->scratch_ctx);
-  mark_bytes_defined (SLH_DSA_128_SEED_SIZE, leaf);
+  for (; n > 0; n--, idx++, leaf += _SLH_DSA_128_SIZE)
+    {
+      _wots_gen (ctx->pub.hash, ctx->pub.tree_ctx, ctx->secret_seed, idx, leaf, ctx->scratch_ctx);
+      mark_bytes_defined (SLH_DSA_128_SEED_SIZE, leaf);
+    }
 }
 
 static void
@@ -261,12 +265,26 @@ typedef int sign_func (const uint8_t *pub, const uint8_t *priv,
 typedef int verify_func (const uint8_t *pub,
 			 size_t length, const uint8_t *msg,
 			 const uint8_t *signature);
+typedef size_t cache_size_func (unsigned layers);
+typedef void cache_init_func (const uint8_t *pub, const uint8_t *priv,
+			      unsigned layers, uint8_t *cache,
+			      void *parallel_ctx, slh_dsa_parallel_func *parallel);
+typedef int sign_parallel_func (const uint8_t *pub, const uint8_t *priv,
+				unsigned layers, const uint8_t *cache,
+				size_t length, const uint8_t *msg,
+				uint8_t *signature,
+				void *parallel_ctx, slh_dsa_parallel_func *parallel);
 struct slh_dsa_alg
 {
   const char *name;
   size_t signature_size;
   sign_func *sign;
   verify_func *verify;
+  /* Number of layers to cache when testing parallel signing. */
+  unsigned cache_layers;
+  cache_size_func *cache_size;
+  cache_init_func *cache_init;
+  sign_parallel_func *sign_parallel;
 };
 
 static const struct slh_dsa_alg
@@ -275,6 +293,10 @@ slh_dsa_shake_128s = {
   SLH_DSA_128S_SIGNATURE_SIZE,
   slh_dsa_shake_128s_sign,
   slh_dsa_shake_128s_verify,
+  1,
+  slh_dsa_shake_128s_cache_size,
+  slh_dsa_shake_128s_cache_init,
+  slh_dsa_shake_128s_sign_parallel,
 };
 
 static const struct slh_dsa_alg
@@ -283,6 +305,10 @@ slh_dsa_shake_128f = {
   SLH_DSA_128F_SIGNATURE_SIZE,
   slh_dsa_shake_128f_sign,
   slh_dsa_shake_128f_verify,
+  2,
+  slh_dsa_shake_128f_cache_size,
+  slh_dsa_shake_128f_cache_init,
+  slh_dsa_shake_128f_sign_parallel,
 };
 
 static const struct slh_dsa_alg
@@ -291,6 +317,10 @@ slh_dsa_sha2_128s = {
   SLH_DSA_128S_SIGNATURE_SIZE,
   slh_dsa_sha2_128s_sign,
   slh_dsa_sha2_128s_verify,
+  1,
+  slh_dsa_sha2_128s_cache_size,
+  slh_dsa_sha2_128s_cache_init,
+  slh_dsa_sha2_128s_sign_parallel,
 };
 
 static const struct slh_dsa_alg
@@ -299,8 +329,23 @@ slh_dsa_sha2_128f = {
   SLH_DSA_128F_SIGNATURE_SIZE,
   slh_dsa_sha2_128f_sign,
   slh_dsa_sha2_128f_verify,
+  2,
+  slh_dsa_sha2_128f_cache_size,
+  slh_dsa_sha2_128f_cache_init,
+  slh_dsa_sha2_128f_sign_parallel,
 };
 
+/* Runs the jobs in reverse order, to check that they are
+   independent. */
+static void
+parallel_reverse (void *ctx, size_t count, slh_dsa_job_func *job, void *arg)
+{
+  size_t *jobs = ctx;
+  *jobs += count;
+  while (count-- > 0)
+    job (arg, count);
+}
+
 static void
 test_slh_dsa (const struct slh_dsa_alg *alg,
 	      const struct tstring *pub, const struct tstring *priv,
@@ -308,6 +353,8 @@ test_slh_dsa (const struct slh_dsa_alg *alg,
 {
   uint8_t *sig = xalloc (alg->signature_size);
   uint8_t bad_key[SLH_DSA_128_KEY_SIZE];
+  uint8_t *cache;
+  size_t jobs;
 
   ASSERT (pub->length == SLH_DSA_128_KEY_SIZE);
   ASSERT (priv->length == SLH_DSA_128_KEY_SIZE);
@@ -326,6 +373,23 @@ test_slh_dsa (const struct slh_dsa_alg *alg,
     }
   ASSERT (alg->verify (pub->data, msg->length, msg->data, sig));
 
+  memset (sig, 0, alg->signature_size);
+  cache = xalloc (alg->cache_size (alg->cache_layers));
+  jobs = 0;
+  alg->cache_init (pub->data, priv->data, alg->cache_layers, cache,
+		   &jobs, parallel_reverse);
+  ASSERT (jobs > 0);
+  ASSERT (alg->sign_parallel (pub->data, priv->data, alg->cache_layers, cache,
+			      msg->length, msg->data, sig,
+			      &jobs, parallel_reverse));
+  ASSERT (MEMEQ (alg->signature_size, sig, ref->data));
+
+  memset (sig, 0, alg->signature_size);
+  ASSERT (alg->sign_parallel (pub->data, priv->data, 0, NULL,
+			      msg->length, msg->data, sig, NULL, NULL));
+  ASSERT (MEMEQ (alg->signature_size, sig, ref->data));
+  free (cache);
+
   if (msg->length > 0)
     ASSERT (!alg->verify (pub->data, msg->length-1, msg->data, sig));
   sig[alg->signature_size-1] ^= 1;
@@ -36,6 +36,7 @@
 #include "sntrup-internal.h"
 
 #include "drbg-ctr.h"
+#include "knuth-lfib.h"
 #include "macros.h"
 
 static void
@@ -162,6 +163,71 @@ test_randomized (void)
     }
 }
 
+static void
+ref_mult (int32_t *h, const int32_t *f, const int32_t *g)
+{
+  int32_t fg[2*SNTRUP761_P - 1];
+  int i, j;
+
+  for (i = 0; i < 2*SNTRUP761_P - 1; i++)
+    fg[i] = 0;
+  for (i = 0; i < SNTRUP761_P; i++)
+    for (j = 0; j < SNTRUP761_P; j++)
+      fg[i + j] += f[i] * g[j];
+  for (i = 2*SNTRUP761_P - 2; i >= SNTRUP761_P; i--)
+    {
+      fg[i - SNTRUP761_P] += fg[i];
+      fg[i - SNTRUP761_P + 1] += fg[i];
+    }
+  memcpy (h, fg, SNTRUP761_P * sizeof (*h));
+}
+
+static void
+test_mult_one (const int32_t *f, const int32_t *g)
+{
+  int32_t h[SNTRUP761_P], ref[SNTRUP761_P];
+
+  _sntrup761_mult (h, f, g);
+  ref_mult (ref, f, g);
+  if (memcmp (h, ref, sizeof (h)))
+    {
+      printf ("_sntrup761_mult failed\n");
+      abort ();
+    }
+}
+
+static void
+test_mult (void)
+{
+  struct knuth_lfib_ctx lfib;
+  int32_t f[SNTRUP761_P], g[SNTRUP761_P];
+  unsigned count;
+  int i;
+
+  /* Largest coefficients, which exercise the intermediate bounds of
+     the Karatsuba recursion. */
+  for (i = 0; i < SNTRUP761_P; i++)
+    {
+      f[i] = SNTRUP761_Q12;
+      g[i] = 3;
+    }
+  test_mult_one (f, g);
+  for (i = 0; i < SNTRUP761_P; i++)
+    g[i] = -3;
+  test_mult_one (f, g);
+
+  knuth_lfib_init (&lfib, 17);
+  for (count = 0; count < 20; count++)
+    {
+      for (i = 0; i < SNTRUP761_P; i++)
+	{
+	  f[i] = (int32_t) (knuth_lfib_get (&lfib) % SNTRUP761_Q) - SNTRUP761_Q12;
+	  g[i] = (int32_t) (knuth_lfib_get (&lfib) % 7) - 3;
+	}
+      test_mult_one (f, g);
+    }
+}
+
 void
 test_main (void)
 {
@@ -193,5 +259,6 @@ test_main (void)
 	       SHEX ("16C15126F734E51268BA916CE3B39A72E171AE79B8C2B6A6"
 		     "8B34AB0DC5621B7E"));
 
+  test_mult ();
   test_randomized ();
 }
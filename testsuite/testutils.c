@@ -1026,6 +1026,329 @@ test_aead(const struct nettle_aead *aead,
   free(buffer);
 }
 
+void
+test_aead_v2(const struct nettle_aead_v2 *aead,
+	     const struct tstring *key,
+	     const struct tstring *authtext,
+	     const struct tstring *cleartext,
+	     const struct tstring *ciphertext,
+	     const struct tstring *nonce,
+	     const struct tstring *digest)
+{
+  void *key_ctx = xalloc (aead->key_context_size);
+  void *key_copy = xalloc (aead->key_context_size);
+  void *state[2];
+  size_t length = cleartext->length;
+  size_t clength = length + aead->digest_size;
+  uint8_t *buf = xalloc (clength + 1);
+  uint8_t *expected = xalloc (clength);
+  uint8_t *clear = xalloc (length + 1);
+  size_t i;
+
+  ASSERT (key->length == aead->key_size);
+  ASSERT (nonce->length == aead->nonce_size);
+  ASSERT (digest->length == aead->digest_size);
+  ASSERT (ciphertext->length == length);
+
+  memcpy (expected, ciphertext->data, length);
+  memcpy (expected + length, digest->data, digest->length);
+
+  state[0] = xalloc (aead->state_size ? aead->state_size : 1);
+  state[1] = xalloc (aead->state_size ? aead->state_size : 1);
+
+  aead->set_key (key_ctx, key->data);
+  memcpy (key_copy, key_ctx, aead->key_context_size);
+
+  buf[clength] = 0xae;
+  nettle_aead_v2_encrypt_message (aead, key_ctx, state[0], nonce->data,
+				  authtext->length, authtext->data,
+				  clength, buf, cleartext->data);
+  if (!MEMEQ (clength, buf, expected))
+    {
+      fprintf (stderr, "%s: encrypt_message failed:\n  got: ", aead->name);
+      print_hex (clength, buf);
+      fprintf (stderr, "  exp: ");
+      print_hex (clength, expected);
+      FAIL();
+    }
+  ASSERT (buf[clength] == 0xae);
+
+  memset (buf, 0xae, clength + 1);
+  ASSERT (nettle_aead_v2_decrypt_message (aead, key_ctx, state[0], nonce->data,
+					  authtext->length, authtext->data,
+					  length, buf, expected));
+  ASSERT (MEMEQ (length, buf, cleartext->data));
+  ASSERT (buf[length] == 0xae);
+
+  expected[clength - 1] ^= 1;
+  ASSERT (!nettle_aead_v2_decrypt_message (aead, key_ctx, state[0],
+					   nonce->data,
+					   authtext->length, authtext->data,
+					   length, buf, expected));
+  expected[clength - 1] ^= 1;
+
+  if (aead->init)
+    {
+      size_t block = aead->block_size;
+
+      /* Interleave encryption and decryption using the same key, a
+	 block at a time. */
+      aead->init (state[0], key_ctx, nonce->data);
+      aead->init (state[1], key_ctx, nonce->data);
+      aead->update (state[0], key_ctx, authtext->length, authtext->data);
+      aead->update (state[1], key_ctx, authtext->length, authtext->data);
+      for (i = 0; i < length; i += block)
+	{
+	  size_t n = length - i < block ? length - i : block;
+	  aead->encrypt (state[0], key_ctx, n, buf + i, cleartext->data + i);
+	  aead->decrypt (state[1], key_ctx, n, clear + i, expected + i);
+	}
+      ASSERT (MEMEQ (length, buf, ciphertext->data));
+      ASSERT (MEMEQ (length, clear, cleartext->data));
+
+      aead->digest (state[0], key_ctx, buf);
+      ASSERT (MEMEQ (digest->length, buf, digest->data));
+      aead->digest (state[1], key_ctx, buf);
+      ASSERT (MEMEQ (digest->length, buf, digest->data));
+    }
+  else
+    ASSERT (aead->state_size == 0);
+
+  if (!MEMEQ (aead->key_context_size, key_ctx, key_copy))
+    {
+      fprintf (stderr, "%s: key modified.\n", aead->name);
+      FAIL();
+    }
+
+  free (key_ctx);
+  free (key_copy);
+  free (state[0]);
+  free (state[1]);
+  free (buf);
+  free (expected);
+  free (clear);
+}
+
+void
+test_aead_batch(const struct nettle_aead *aead,
+		nettle_seal_batch_func *seal,
+		nettle_open_batch_func *open)
+{
+  static const size_t lengths[] = {
+    0, 1, 15, 16, 17, 63, 64, 65, 100, 191, 192, 193, 255, 256, 257,
+    600, 1500,
+  };
+#define BATCH_COUNT (sizeof (lengths) / sizeof (lengths[0]))
+  struct nettle_aead_batch msgs[BATCH_COUNT];
+  uint8_t *nonces[BATCH_COUNT];
+  uint8_t *adata[BATCH_COUNT];
+  uint8_t *clear[BATCH_COUNT];
+  uint8_t *cipher[BATCH_COUNT];
+  uint8_t *digest[BATCH_COUNT];
+  int valid[BATCH_COUNT];
+  struct knuth_lfib_ctx rand;
+  void *ctx = xalloc (aead->context_size);
+  void *ref = xalloc (aead->context_size);
+  uint8_t *key = xalloc (aead->key_size);
+  size_t i;
+
+  knuth_lfib_init (&rand, 4711);
+  knuth_lfib_random (&rand, aead->key_size, key);
+  aead->set_encrypt_key (ctx, key);
+  aead->set_encrypt_key (ref, key);
+
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      size_t alength = (i * 7) % 40;
+      nonces[i] = xalloc (aead->nonce_size);
+      adata[i] = xalloc (alength + 1);
+      clear[i] = xalloc (lengths[i] + 1);
+      cipher[i] = xalloc (lengths[i] + 1);
+      digest[i] = xalloc (aead->digest_size);
+      knuth_lfib_random (&rand, aead->nonce_size, nonces[i]);
+      knuth_lfib_random (&rand, alength, adata[i]);
+      knuth_lfib_random (&rand, lengths[i], clear[i]);
+
+      aead->set_nonce (ref, nonces[i]);
+      aead->update (ref, alength, adata[i]);
+      aead->encrypt (ref, lengths[i], cipher[i], clear[i]);
+      aead->digest (ref, digest[i]);
+
+      msgs[i].nonce = nonces[i];
+      msgs[i].adata_length = alength;
+      msgs[i].adata = adata[i];
+      msgs[i].length = lengths[i];
+    }
+
+  /* In-place sealing. */
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      msgs[i].src = msgs[i].dst = xalloc (lengths[i] + 1);
+      memcpy (msgs[i].dst, clear[i], lengths[i]);
+      msgs[i].digest = xalloc (aead->digest_size);
+    }
+  seal (ctx, BATCH_COUNT, msgs);
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      if (!MEMEQ (lengths[i], msgs[i].dst, cipher[i])
+	  || !MEMEQ (aead->digest_size, msgs[i].digest, digest[i]))
+	{
+	  fprintf (stderr, "%s: seal_batch failed, message %u\n",
+		   aead->name, (unsigned) i);
+	  FAIL ();
+	}
+    }
+
+  /* In-place opening, with one bad digest. */
+  msgs[3].digest[0] ^= 1;
+  ASSERT (!open (ctx, BATCH_COUNT, msgs, valid));
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      ASSERT (valid[i] == (i != 3));
+      if (i != 3)
+	ASSERT (MEMEQ (lengths[i], msgs[i].dst, clear[i]));
+    }
+
+  /* Separate output, subsets of the batch. */
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      free (msgs[i].dst);
+      msgs[i].src = cipher[i];
+      msgs[i].dst = xalloc (lengths[i] + 1);
+      memcpy (msgs[i].digest, digest[i], aead->digest_size);
+    }
+  ASSERT (open (ctx, 0, msgs, NULL));
+  ASSERT (open (ctx, 5, msgs + 2, NULL));
+  ASSERT (open (ctx, BATCH_COUNT, msgs, valid));
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      ASSERT (valid[i] == 1);
+      ASSERT (MEMEQ (lengths[i], msgs[i].dst, clear[i]));
+    }
+
+  for (i = 0; i < BATCH_COUNT; i++)
+    {
+      free (nonces[i]);
+      free (adata[i]);
+      free (clear[i]);
+      free (cipher[i]);
+      free (digest[i]);
+      free (msgs[i].dst);
+      free (msgs[i].digest);
+    }
+  free (ctx);
+  free (ref);
+  free (key);
+#undef BATCH_COUNT
+}
+
+/* Splits length bytes into random fragments, including empty ones,
+   and returns the number of fragments. */
+static size_t
+test_iov_split(struct knuth_lfib_ctx *rand, size_t length,
+	       size_t max_count, struct nettle_crypt_iov *iov,
+	       uint8_t *dst, const uint8_t *src)
+{
+  size_t count;
+  for (count = 0; length > 0 && count < max_count - 1; count++)
+    {
+      size_t n = knuth_lfib_get (rand) % 70;
+      if (n > length)
+	n = length;
+      iov[count].length = n;
+      iov[count].dst = dst;
+      iov[count].src = src;
+      dst += n;
+      src += n;
+      length -= n;
+    }
+  iov[count].length = length;
+  iov[count].dst = dst;
+  iov[count].src = src;
+  return count + 1;
+}
+
+void
+test_aead_iov(const struct nettle_aead *aead,
+	      nettle_crypt_iov_func *encrypt,
+	      nettle_crypt_iov_func *decrypt)
+{
+  static const size_t lengths[] = {
+    0, 1, 16, 17, 64, 65, 200, 600, 1500, 5000,
+  };
+  struct nettle_crypt_iov iov[100];
+  struct knuth_lfib_ctx rand;
+  void *ctx = xalloc (aead->context_size);
+  uint8_t *key = xalloc (aead->key_size);
+  uint8_t *nonce = xalloc (aead->nonce_size);
+  uint8_t *digest = xalloc (aead->digest_size);
+  uint8_t *iov_digest = xalloc (aead->digest_size);
+  uint8_t adata[20];
+  size_t i;
+
+  knuth_lfib_init (&rand, 4711);
+  knuth_lfib_random (&rand, aead->key_size, key);
+  knuth_lfib_random (&rand, sizeof (adata), adata);
+  aead->set_encrypt_key (ctx, key);
+
+  for (i = 0; i < 2 * sizeof (lengths) / sizeof (lengths[0]); i++)
+    {
+      size_t length = lengths[i / 2];
+      /* Every other message is processed in place. */
+      int in_place = i & 1;
+      uint8_t *clear = xalloc (length + 1);
+      uint8_t *cipher = xalloc (length + 1);
+      uint8_t *buf = xalloc (length + 1);
+      size_t count;
+
+      knuth_lfib_random (&rand, aead->nonce_size, nonce);
+      knuth_lfib_random (&rand, length, clear);
+
+      aead->set_nonce (ctx, nonce);
+      aead->update (ctx, sizeof (adata), adata);
+      aead->encrypt (ctx, length, cipher, clear);
+      aead->digest (ctx, digest);
+
+      memcpy (buf, clear, length);
+      count = test_iov_split (&rand, length, 100, iov, buf,
+			      in_place ? buf : clear);
+      aead->set_nonce (ctx, nonce);
+      aead->update (ctx, sizeof (adata), adata);
+      encrypt (ctx, count, iov);
+      aead->digest (ctx, iov_digest);
+      if (!MEMEQ (length, buf, cipher)
+	  || !MEMEQ (aead->digest_size, iov_digest, digest))
+	{
+	  fprintf (stderr, "%s: encrypt_iov failed, length %u, %u fragments\n",
+		   aead->name, (unsigned) length, (unsigned) count);
+	  FAIL ();
+	}
+
+      memcpy (buf, cipher, length);
+      count = test_iov_split (&rand, length, 100, iov, buf,
+			      in_place ? buf : cipher);
+      aead->set_nonce (ctx, nonce);
+      aead->update (ctx, sizeof (adata), adata);
+      decrypt (ctx, count, iov);
+      aead->digest (ctx, iov_digest);
+      if (!MEMEQ (length, buf, clear)
+	  || !MEMEQ (aead->digest_size, iov_digest, digest))
+	{
+	  fprintf (stderr, "%s: decrypt_iov failed, length %u, %u fragments\n",
+		   aead->name, (unsigned) length, (unsigned) count);
+	  FAIL ();
+	}
+      free (clear);
+      free (cipher);
+      free (buf);
+    }
+  free (ctx);
+  free (key);
+  free (nonce);
+  free (digest);
+  free (iov_digest);
+}
+
 void
 test_aead_message (const struct nettle_aead_message *aead,
 		   const struct tstring *key,
@@ -104,6 +104,18 @@ nettle_decrypt_message_func(void *ctx,
 			    size_t alength, const uint8_t *adata,
 			    size_t mlength, uint8_t *dst, const uint8_t *src);
 
+typedef void
+nettle_seal_batch_func(const void *ctx, size_t count,
+		       const struct nettle_aead_batch *msgs);
+
+typedef int
+nettle_open_batch_func(const void *ctx, size_t count,
+		       const struct nettle_aead_batch *msgs, int *valid);
+
+typedef void
+nettle_crypt_iov_func(void *ctx, size_t count,
+		      const struct nettle_crypt_iov *iov);
+
 struct nettle_aead_message
 {
   const char *name;
@@ -177,6 +189,31 @@ test_aead(const struct nettle_aead *aead,
 	  const struct tstring *nonce,
 	  const struct tstring *digest);
 
+/* Encrypts and decrypts with two states sharing the same key, and
+   checks that the key isn't modified. */
+void
+test_aead_v2(const struct nettle_aead_v2 *aead,
+	     const struct tstring *key,
+	     const struct tstring *authtext,
+	     const struct tstring *cleartext,
+	     const struct tstring *ciphertext,
+	     const struct tstring *nonce,
+	     const struct tstring *digest);
+
+/* Compares batch processing of messages of various sizes to aead,
+   which must use the same context type. */
+void
+test_aead_batch(const struct nettle_aead *aead,
+		nettle_seal_batch_func *seal,
+		nettle_open_batch_func *open);
+
+/* Compares processing of fragmented messages to aead, which must use
+   the same context type. */
+void
+test_aead_iov(const struct nettle_aead *aead,
+	      nettle_crypt_iov_func *encrypt,
+	      nettle_crypt_iov_func *decrypt);
+
 void
 test_aead_message(const struct nettle_aead_message *aead,
 		  const struct tstring *key,
@@ -40,6 +40,9 @@
 
 #include "input.h"
 
+/* Maximum size of each fread call for verbatim strings. */
+#define SEXP_READ_CHUNK_SIZE 0x10000
+
 void
 sexp_input_init(struct sexp_input *input, FILE *f)
 {
@@ -294,12 +297,36 @@ sexp_get_string_length(struct sexp_input *input, enum sexp_mode mode,
     }
 
   if (input->c == ':')
-    /* Verbatim */
-    for (; length; length--)
-      {
-	sexp_next_char(input);
-	sexp_push_char(input, string);
-      }
+    {
+      /* Verbatim */
+      if (!input->coding)
+	{
+	  /* Read the string in large chunks, but don't trust the
+	     length prefix for allocation before the data has
+	     actually arrived. */
+	  while (length > 0)
+	    {
+	      unsigned chunk = length < SEXP_READ_CHUNK_SIZE
+		? length : SEXP_READ_CHUNK_SIZE;
+	      uint8_t *p = nettle_buffer_space(string, chunk);
+	      if (!p)
+		die("Virtual memory exhasuted.\n");
+	      if (fread(p, 1, chunk, input->f) != chunk)
+		{
+		  if (ferror(input->f))
+		    die("Read error: %s\n", strerror(errno));
+		  die("Unexpected end of file.\n");
+		}
+	      length -= chunk;
+	    }
+	}
+      else
+	for (; length; length--)
+	  {
+	    sexp_next_char(input);
+	    sexp_push_char(input, string);
+	  }
+    }
 
   else if (mode != SEXP_ADVANCED)
     die("Encountered advanced string in canonical mode.\n");
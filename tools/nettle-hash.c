@@ -2,7 +2,7 @@
 
    General hashing tool.
 
-   Copyright (C) 2011, 2013 Niels Möller
+   Copyright (C) 2011, 2013, 2026 Niels Möller
 
    This file is part of GNU Nettle.
 
@@ -40,13 +40,30 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if HAVE_SYS_TYPES_H
+# include <sys/types.h>
+#endif
+#if HAVE_SYS_STAT_H
+# include <sys/stat.h>
+#endif
+#if HAVE_SYS_MMAN_H
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+#if HAVE_PTHREAD
+# include <pthread.h>
+#endif
+
 #include "nettle-meta.h"
 #include "base16.h"
 
 #include "getopt.h"
 #include "misc.h"
 
-#define BUFSIZE 16384
+#define BUFSIZE 0x20000
+
+/* Length meaning rest of the file. */
+#define TO_EOF ((uint64_t) -1)
 
 static void
 list_algorithms (void)
@@ -62,18 +79,94 @@ list_algorithms (void)
 
 /* Also in examples/io.c */
 static int
-hash_file(const struct nettle_hash *hash, void *ctx, FILE *f)
+hash_file(const struct nettle_hash *hash, void *ctx, FILE *f,
+	  uint64_t length)
 {
-  for (;;)
+  uint8_t *buffer = xalloc(BUFSIZE);
+  int res = 1;
+  while (length > 0)
     {
-      uint8_t buffer[BUFSIZE];
-      size_t res = fread(buffer, 1, sizeof(buffer), f);
+      size_t size = length < BUFSIZE ? length : BUFSIZE;
+      size_t done = fread(buffer, 1, size, f);
       if (ferror(f))
-	return 0;
-      
-      hash->update(ctx, res, buffer);
+	{
+	  res = 0;
+	  break;
+	}
+      hash->update(ctx, done, buffer);
+      length -= done;
       if (feof(f))
-	return 1;
+	break;
+    }
+  free (buffer);
+  return res;
+}
+
+/* Hashes LENGTH octets starting at OFFSET, or until end of file,
+   using mmap for regular files, when possible. */
+static int
+hash_range(const struct nettle_hash *hash, void *ctx, FILE *f,
+	   uint64_t offset, uint64_t length)
+{
+#if HAVE_SYS_MMAN_H
+  struct stat st;
+  if (fstat(fileno(f), &st) == 0 && S_ISREG(st.st_mode)
+      && (uint64_t) st.st_size > offset)
+    {
+      uint64_t end = st.st_size;
+      uint64_t start = offset - offset % sysconf(_SC_PAGESIZE);
+      size_t size;
+      void *p;
+
+      if (length < end - offset)
+	end = offset + length;
+      size = end - start;
+      if (size == end - start
+	  && (p = mmap(NULL, size, PROT_READ, MAP_PRIVATE,
+		       fileno(f), start)) != MAP_FAILED)
+	{
+#ifdef MADV_SEQUENTIAL
+	  madvise(p, size, MADV_SEQUENTIAL);
+#endif
+	  hash->update(ctx, end - offset, (const uint8_t *) p + (offset - start));
+	  munmap(p, size);
+	  return 1;
+	}
+    }
+#endif
+  if (offset > 0 && (offset != (uint64_t) (long) offset
+		     || fseek(f, offset, SEEK_SET) != 0))
+    return 0;
+
+  return hash_file(hash, ctx, f, length);
+}
+
+static void
+print_digest(const struct nettle_hash *alg,
+	     unsigned digest_length, int raw,
+	     const uint8_t *digest)
+{
+  if (raw)
+    fwrite (digest, digest_length, 1, stdout);
+
+  else
+    {
+      /* Groups of 8 octets, each followed by a space. */
+      char *hex = xalloc(BASE16_ENCODE_LENGTH(digest_length)
+			 + digest_length / 8 + 2);
+      char *p;
+      unsigned i;
+      for (i = 0, p = hex; i + 8 < digest_length; i += 8)
+	{
+	  base16_encode_update(p, 8, digest + i);
+	  p += BASE16_ENCODE_LENGTH(8);
+	  *p++ = ' ';
+	}
+      base16_encode_update(p, digest_length - i, digest + i);
+      p += BASE16_ENCODE_LENGTH(digest_length - i);
+      *p = 0;
+      printf("%s %s\n", hex, alg->name);
+      free(hex);
     }
 }
 
@@ -88,7 +181,7 @@ digest_file(const struct nettle_hash *alg,
 
   alg->init(ctx);
 
-  if (!hash_file (alg, ctx, f))
+  if (!hash_file (alg, ctx, f, TO_EOF))
     {
       free (ctx);
       return 0;
@@ -98,29 +191,197 @@ digest_file(const struct nettle_hash *alg,
   alg->digest(ctx, digest);
   free(ctx);
 
-  if (raw)
-    fwrite (digest, digest_length, 1, stdout);
+  print_digest (alg, digest_length, raw, digest);
+  free(digest);
+
+  return 1;
+}
+
+/* A file, or a chunk of a file, to be hashed. */
+struct hash_job
+{
+  const char *name;
+  int chunked;
+  uint64_t offset;
+  uint64_t length;
+
+  /* Results */
+  int done;
+  int open_failed;
+  int error;
+  uint8_t *digest;
+};
+
+static void
+hash_job_run(const struct nettle_hash *alg, struct hash_job *job)
+{
+  FILE *f = fopen (job->name, "rb");
+  void *ctx;
+
+  if (!f)
+    {
+      job->open_failed = 1;
+      job->error = errno;
+      return;
+    }
+  ctx = xalloc(alg->context_size);
+  alg->init(ctx);
+
+  if (hash_range (alg, ctx, f, job->offset, job->length))
+    {
+      job->digest = xalloc(alg->digest_size);
+      alg->digest(ctx, job->digest);
+    }
+  else
+    job->error = errno;
+
+  free (ctx);
+  fclose (f);
+}
 
+static void
+hash_job_print(const struct nettle_hash *alg,
+	       unsigned digest_length, int raw,
+	       struct hash_job *job)
+{
+  if (job->open_failed)
+    die ("Cannot open `%s': %s\n", job->name, strerror(job->error));
+  if (!job->digest)
+    die("Reading `%s' failed: %s\n", job->name, strerror(job->error));
+
+  if (job->chunked)
+    printf("%s+%llu: ", job->name, (unsigned long long) job->offset);
   else
+    printf("%s: ", job->name);
+
+  print_digest (alg, digest_length, raw, job->digest);
+  free (job->digest);
+  job->digest = NULL;
+}
+
+#if HAVE_PTHREAD
+struct hash_queue
+{
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+
+  const struct nettle_hash *alg;
+  struct hash_job *jobs;
+  size_t count;
+  size_t next;
+};
+
+static void *
+hash_worker(void *arg)
+{
+  struct hash_queue *queue = arg;
+  for (;;)
     {
-      unsigned i;
-      char hex[BASE16_ENCODE_LENGTH(8) + 1];
-      for (i = 0; i + 8 < digest_length; i += 8)
+      struct hash_job *job;
+
+      pthread_mutex_lock (&queue->lock);
+      if (queue->next == queue->count)
 	{
-	  base16_encode_update(hex, 8, digest + i);
-	  hex[BASE16_ENCODE_LENGTH(8)] = 0;
-	  printf("%s ", hex);
+	  pthread_mutex_unlock (&queue->lock);
+	  return NULL;
 	}
-      base16_encode_update(hex, digest_length - i, digest + i);
-      hex[BASE16_ENCODE_LENGTH(digest_length - i)] = 0;
-      printf("%s %s\n", hex, alg->name);
+      job = &queue->jobs[queue->next++];
+      pthread_mutex_unlock (&queue->lock);
+
+      hash_job_run (queue->alg, job);
+
+      pthread_mutex_lock (&queue->lock);
+      job->done = 1;
+      pthread_cond_broadcast (&queue->cond);
+      pthread_mutex_unlock (&queue->lock);
     }
-  
-  free(digest);
+}
 
-  return 1;
+/* Hashes jobs in parallel, printing results in order as they
+   complete. */
+static void
+hash_jobs_parallel(const struct nettle_hash *alg,
+		   unsigned digest_length, int raw,
+		   unsigned threads, size_t count, struct hash_job *jobs)
+{
+  struct hash_queue queue;
+  pthread_t *workers;
+  unsigned i;
+  size_t j;
+
+  pthread_mutex_init (&queue.lock, NULL);
+  pthread_cond_init (&queue.cond, NULL);
+  queue.alg = alg;
+  queue.jobs = jobs;
+  queue.count = count;
+  queue.next = 0;
+
+  if (threads > count)
+    threads = count;
+
+  workers = xalloc (threads * sizeof(*workers));
+  for (i = 0; i < threads; i++)
+    if (pthread_create (&workers[i], NULL, hash_worker, &queue))
+      die ("Creating thread failed.\n");
+
+  for (j = 0; j < count; j++)
+    {
+      pthread_mutex_lock (&queue.lock);
+      while (!jobs[j].done)
+	pthread_cond_wait (&queue.cond, &queue.lock);
+      pthread_mutex_unlock (&queue.lock);
+
+      hash_job_print (alg, digest_length, raw, &jobs[j]);
+    }
+
+  for (i = 0; i < threads; i++)
+    pthread_join (workers[i], NULL);
+
+  free (workers);
+  pthread_cond_destroy (&queue.cond);
+  pthread_mutex_destroy (&queue.lock);
+}
+#endif /* HAVE_PTHREAD */
+
+static void
+hash_jobs(const struct nettle_hash *alg,
+	  unsigned digest_length, int raw,
+	  unsigned threads, size_t count, struct hash_job *jobs)
+{
+  size_t j;
+#if HAVE_PTHREAD
+  if (threads > 1 && count > 1)
+    {
+      hash_jobs_parallel (alg, digest_length, raw, threads, count, jobs);
+      return;
+    }
+#endif
+  for (j = 0; j < count; j++)
+    {
+      hash_job_run (alg, &jobs[j]);
+      hash_job_print (alg, digest_length, raw, &jobs[j]);
+    }
+}
+
+static uint64_t
+file_size(const char *name)
+{
+#if HAVE_SYS_STAT_H
+  struct stat st;
+  if (stat (name, &st) != 0)
+    die ("Cannot open `%s': %s\n", name, strerror(errno));
+  if (!S_ISREG (st.st_mode))
+    die ("Chunked mode requires a regular file: `%s'\n", name);
+  return st.st_size;
+#else
+  die ("Chunked mode not supported.\n");
+#endif
 }
 
+/* Number of chunks. An empty file gets a single empty chunk. */
+#define CHUNK_COUNT(size, chunk_size) \
+  ((size) ? ((size) - 1) / (chunk_size) + 1 : 1)
+
 static void
 usage (FILE *f)
 {
@@ -131,7 +392,10 @@ usage (FILE *f)
 	  "  --list              List supported hash algorithms.\n"
 	  "  -a, --algorithm=ALG Hash algorithm to use.\n"
 	  "  -l, --length=LENGTH Desired digest length (octets)\n"
-	  "  --raw               Raw binary output.\n");
+	  "  --raw               Raw binary output.\n"
+	  "  -j, --jobs=N        Hash up to N files or chunks in parallel.\n"
+	  "  --chunk-size=SIZE   Output one digest per chunk of SIZE octets,\n"
+	  "                      prefixed by FILE+OFFSET.\n");
 }
 
 /* FIXME: Be more compatible with md5sum and sha1sum. Options -c
@@ -143,10 +407,12 @@ main (int argc, char **argv)
   const char *alg_name = NULL;
   const struct nettle_hash *alg;
   unsigned length = 0;
+  unsigned threads = 1;
+  uint64_t chunk_size = 0;
   int raw = 0;
   int c;
 
-  enum { OPT_HELP = 0x300, OPT_RAW, OPT_LIST };
+  enum { OPT_HELP = 0x300, OPT_RAW, OPT_LIST, OPT_CHUNK_SIZE };
   static const struct option options[] =
     {
       /* Name, args, flag, val */
@@ -156,11 +422,13 @@ main (int argc, char **argv)
       { "length", required_argument, NULL, 'l' },
       { "list", no_argument, NULL, OPT_LIST },
       { "raw", no_argument, NULL, OPT_RAW },
+      { "jobs", required_argument, NULL, 'j' },
+      { "chunk-size", required_argument, NULL, OPT_CHUNK_SIZE },
 
       { NULL, 0, NULL, 0 }
     };
 
-  while ( (c = getopt_long(argc, argv, "Va:l:", options, NULL)) != -1)
+  while ( (c = getopt_long(argc, argv, "Va:l:j:", options, NULL)) != -1)
     switch (c)
       {
       default:
@@ -186,6 +454,23 @@ main (int argc, char **argv)
 	  length = arg;
 	}
 	break;
+      case 'j':
+	{
+	  int arg;
+	  arg = atoi (optarg);
+	  if (arg <= 0)
+	    die ("Invalid jobs argument: `%s'\n", optarg);
+	  threads = arg;
+	}
+	break;
+      case OPT_CHUNK_SIZE:
+	{
+	  char *end;
+	  chunk_size = strtoull (optarg, &end, 10);
+	  if (!chunk_size || *end)
+	    die ("Invalid chunk size argument: `%s'\n", optarg);
+	}
+	break;
       case OPT_RAW:
 	raw = 1;
 	break;
@@ -214,20 +499,58 @@ main (int argc, char **argv)
   argc -= optind;
 
   if (argc == 0)
-    digest_file (alg, length, raw, stdin);
+    {
+      if (chunk_size)
+	die ("Chunked mode requires file arguments.\n");
+      digest_file (alg, length, raw, stdin);
+    }
   else
     {
+      struct hash_job *jobs;
+      size_t count;
       int i;
-      for (i = 0; i < argc; i++)
+
+      if (chunk_size)
+	{
+	  uint64_t *sizes = xalloc (argc * sizeof(*sizes));
+	  uint64_t total;
+	  for (i = 0, total = 0; i < argc; i++)
+	    {
+	      sizes[i] = file_size (argv[i]);
+	      total += CHUNK_COUNT (sizes[i], chunk_size);
+	    }
+	  count = total;
+	  if (count != total || count > (size_t) -1 / sizeof(*jobs))
+	    die ("Too many chunks.\n");
+
+	  jobs = xalloc (count * sizeof(*jobs));
+	  memset (jobs, 0, count * sizeof(*jobs));
+	  for (i = 0, count = 0; i < argc; i++)
+	    {
+	      uint64_t j;
+	      for (j = 0; j < CHUNK_COUNT (sizes[i], chunk_size); j++, count++)
+		{
+		  jobs[count].name = argv[i];
+		  jobs[count].chunked = 1;
+		  jobs[count].offset = j * chunk_size;
+		  jobs[count].length = chunk_size;
+		}
+	    }
+	  free (sizes);
+	}
+      else
 	{
-	  FILE *f = fopen (argv[i], "rb");
-	  if (!f)
-	    die ("Cannot open `%s': %s\n", argv[i], strerror(errno));
-	  printf("%s: ", argv[i]);
-	  if (!digest_file (alg, length, raw, f))
-	    die("Reading `%s' failed: %s\n", argv[i], strerror(errno));
-	  fclose(f);
+	  count = argc;
+	  jobs = xalloc (count * sizeof(*jobs));
+	  memset (jobs, 0, count * sizeof(*jobs));
+	  for (i = 0; i < argc; i++)
+	    {
+	      jobs[i].name = argv[i];
+	      jobs[i].length = TO_EOF;
+	    }
 	}
+      hash_jobs (alg, length, raw, threads, count, jobs);
+      free (jobs);
     }
   if (fflush(stdout) != 0 )
     die("Write failed: %s\n", strerror(errno));
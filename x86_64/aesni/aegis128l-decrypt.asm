@@ -0,0 +1,186 @@
+C x86_64/aesni/aegis128l-decrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input arguments
+define(`STATE',	`%rdi')
+define(`LENGTH',`%rsi')
+define(`DST',	`%rdx')
+define(`SRC',	`%rcx')
+
+define(`S0', `%xmm0')
+define(`S1', `%xmm1')
+define(`S2', `%xmm2')
+define(`S3', `%xmm3')
+define(`S4', `%xmm4')
+define(`S5', `%xmm5')
+define(`S6', `%xmm6')
+define(`S7', `%xmm7')
+define(`M0', `%xmm8')
+define(`M1', `%xmm9')
+define(`Z0', `%xmm10')
+define(`Z1', `%xmm11')
+
+C The first eight arguments of the macros below are the registers
+C holding S0, ..., S7. Each update leaves the new state rotated one
+C step in the registers, and the unrolled loop passes them in rotated
+C order, so no moves are needed.
+
+C Key stream, Z0 = S6 ^ S1 ^ (S2 & S3), Z1 = S2 ^ S5 ^ (S6 & S7)
+define(`AEGIS128L_STREAM', `
+	movdqa	$3, Z0
+	pand	$4, Z0
+	pxor	$7, Z0
+	pxor	$2, Z0
+	movdqa	$7, Z1
+	pand	$8, Z1
+	pxor	$3, Z1
+	pxor	$6, Z1
+')
+
+C State update, absorbing M0 and M1. Each new state block Si' is
+C computed in the register of S(i-1).
+define(`AEGIS128L_UPDATE', `
+	pxor	$1, M0
+	pxor	$5, M1
+	aesenc	$2, $1
+	aesenc	$3, $2
+	aesenc	$4, $3
+	aesenc	M1, $4
+	aesenc	$6, $5
+	aesenc	$7, $6
+	aesenc	$8, $7
+	aesenc	M0, $8
+')
+
+C Decrypts one block. The last argument is the offset from SRC and DST.
+define(`AEGIS128L_BLOCK', `
+	movups	$9`'(SRC), M0
+	movups	eval($9 + 16)(SRC), M1
+	AEGIS128L_STREAM($1, $2, $3, $4, $5, $6, $7, $8)
+	pxor	Z0, M0
+	pxor	Z1, M1
+	movups	M0, $9`'(DST)
+	movups	M1, eval($9 + 16)(DST)
+	AEGIS128L_UPDATE($1, $2, $3, $4, $5, $6, $7, $8)
+')
+
+define(`AEGIS128L_STORE', `
+	movups	$1, (STATE)
+	movups	$2, 16(STATE)
+	movups	$3, 32(STATE)
+	movups	$4, 48(STATE)
+	movups	$5, 64(STATE)
+	movups	$6, 80(STATE)
+	movups	$7, 96(STATE)
+	movups	$8, 112(STATE)
+')
+
+	.file "aegis128l-decrypt.asm"
+
+	C size_t _aegis128l_decrypt (union nettle_block16 *state,
+	C		size_t length, uint8_t *dst, const uint8_t *src)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_aegis128l_decrypt)
+	W64_ENTRY(4, 12)
+	mov	LENGTH, %rax
+	and	$-32, %rax
+	shr	$5, LENGTH
+	jz	.Lend
+
+	movups	(STATE), S0
+	movups	16(STATE), S1
+	movups	32(STATE), S2
+	movups	48(STATE), S3
+	movups	64(STATE), S4
+	movups	80(STATE), S5
+	movups	96(STATE), S6
+	movups	112(STATE), S7
+
+	C Eight blocks per iteration, exiting after any block. After k
+	C blocks, the state is rotated k steps.
+.Lblock_loop:
+	AEGIS128L_BLOCK(S0, S1, S2, S3, S4, S5, S6, S7, 0)
+	dec	LENGTH
+	jz	.Lstore1
+	AEGIS128L_BLOCK(S7, S0, S1, S2, S3, S4, S5, S6, 32)
+	dec	LENGTH
+	jz	.Lstore2
+	AEGIS128L_BLOCK(S6, S7, S0, S1, S2, S3, S4, S5, 64)
+	dec	LENGTH
+	jz	.Lstore3
+	AEGIS128L_BLOCK(S5, S6, S7, S0, S1, S2, S3, S4, 96)
+	dec	LENGTH
+	jz	.Lstore4
+	AEGIS128L_BLOCK(S4, S5, S6, S7, S0, S1, S2, S3, 128)
+	dec	LENGTH
+	jz	.Lstore5
+	AEGIS128L_BLOCK(S3, S4, S5, S6, S7, S0, S1, S2, 160)
+	dec	LENGTH
+	jz	.Lstore6
+	AEGIS128L_BLOCK(S2, S3, S4, S5, S6, S7, S0, S1, 192)
+	dec	LENGTH
+	jz	.Lstore7
+	AEGIS128L_BLOCK(S1, S2, S3, S4, S5, S6, S7, S0, 224)
+	add	$256, SRC
+	add	$256, DST
+	dec	LENGTH
+	jnz	.Lblock_loop
+
+	AEGIS128L_STORE(S0, S1, S2, S3, S4, S5, S6, S7)
+	jmp	.Lend
+.Lstore1:
+	AEGIS128L_STORE(S7, S0, S1, S2, S3, S4, S5, S6)
+	jmp	.Lend
+.Lstore2:
+	AEGIS128L_STORE(S6, S7, S0, S1, S2, S3, S4, S5)
+	jmp	.Lend
+.Lstore3:
+	AEGIS128L_STORE(S5, S6, S7, S0, S1, S2, S3, S4)
+	jmp	.Lend
+.Lstore4:
+	AEGIS128L_STORE(S4, S5, S6, S7, S0, S1, S2, S3)
+	jmp	.Lend
+.Lstore5:
+	AEGIS128L_STORE(S3, S4, S5, S6, S7, S0, S1, S2)
+	jmp	.Lend
+.Lstore6:
+	AEGIS128L_STORE(S2, S3, S4, S5, S6, S7, S0, S1)
+	jmp	.Lend
+.Lstore7:
+	AEGIS128L_STORE(S1, S2, S3, S4, S5, S6, S7, S0)
+
+.Lend:
+	W64_EXIT(4, 12)
+	ret
+EPILOGUE(_nettle_aegis128l_decrypt)
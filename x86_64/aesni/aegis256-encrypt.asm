@@ -0,0 +1,157 @@
+C x86_64/aesni/aegis256-encrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input arguments
+define(`STATE',	`%rdi')
+define(`LENGTH',`%rsi')
+define(`DST',	`%rdx')
+define(`SRC',	`%rcx')
+
+define(`S0', `%xmm0')
+define(`S1', `%xmm1')
+define(`S2', `%xmm2')
+define(`S3', `%xmm3')
+define(`S4', `%xmm4')
+define(`S5', `%xmm5')
+define(`M', `%xmm6')
+define(`Z', `%xmm7')
+
+C The first six arguments of the macros below are the registers
+C holding S0, ..., S5. Each update leaves the new state rotated one
+C step in the registers, and the unrolled loop passes them in rotated
+C order, so no moves are needed.
+
+C Key stream, Z = S1 ^ S4 ^ S5 ^ (S2 & S3)
+define(`AEGIS256_STREAM', `
+	movdqa	$3, Z
+	pand	$4, Z
+	pxor	$2, Z
+	pxor	$5, Z
+	pxor	$6, Z
+')
+
+C State update, absorbing M. Each new state block Si' is computed in
+C the register of S(i-1).
+define(`AEGIS256_UPDATE', `
+	pxor	$1, M
+	aesenc	$2, $1
+	aesenc	$3, $2
+	aesenc	$4, $3
+	aesenc	$5, $4
+	aesenc	$6, $5
+	aesenc	M, $6
+')
+
+C Encrypts one block. The last argument is the offset from SRC and DST.
+define(`AEGIS256_BLOCK', `
+	movups	$7`'(SRC), M
+	AEGIS256_STREAM($1, $2, $3, $4, $5, $6)
+	pxor	M, Z
+	movups	Z, $7`'(DST)
+	AEGIS256_UPDATE($1, $2, $3, $4, $5, $6)
+')
+
+define(`AEGIS256_STORE', `
+	movups	$1, (STATE)
+	movups	$2, 16(STATE)
+	movups	$3, 32(STATE)
+	movups	$4, 48(STATE)
+	movups	$5, 64(STATE)
+	movups	$6, 80(STATE)
+')
+
+	.file "aegis256-encrypt.asm"
+
+	C size_t _aegis256_encrypt (union nettle_block16 *state,
+	C		size_t length, uint8_t *dst, const uint8_t *src)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_aegis256_encrypt)
+	W64_ENTRY(4, 8)
+	mov	LENGTH, %rax
+	and	$-16, %rax
+	shr	$4, LENGTH
+	jz	.Lend
+
+	movups	(STATE), S0
+	movups	16(STATE), S1
+	movups	32(STATE), S2
+	movups	48(STATE), S3
+	movups	64(STATE), S4
+	movups	80(STATE), S5
+
+	C Six blocks per iteration, exiting after any block. After k
+	C blocks, the state is rotated k steps.
+.Lblock_loop:
+	AEGIS256_BLOCK(S0, S1, S2, S3, S4, S5, 0)
+	dec	LENGTH
+	jz	.Lstore1
+	AEGIS256_BLOCK(S5, S0, S1, S2, S3, S4, 16)
+	dec	LENGTH
+	jz	.Lstore2
+	AEGIS256_BLOCK(S4, S5, S0, S1, S2, S3, 32)
+	dec	LENGTH
+	jz	.Lstore3
+	AEGIS256_BLOCK(S3, S4, S5, S0, S1, S2, 48)
+	dec	LENGTH
+	jz	.Lstore4
+	AEGIS256_BLOCK(S2, S3, S4, S5, S0, S1, 64)
+	dec	LENGTH
+	jz	.Lstore5
+	AEGIS256_BLOCK(S1, S2, S3, S4, S5, S0, 80)
+	add	$96, SRC
+	add	$96, DST
+	dec	LENGTH
+	jnz	.Lblock_loop
+
+	AEGIS256_STORE(S0, S1, S2, S3, S4, S5)
+	jmp	.Lend
+.Lstore1:
+	AEGIS256_STORE(S5, S0, S1, S2, S3, S4)
+	jmp	.Lend
+.Lstore2:
+	AEGIS256_STORE(S4, S5, S0, S1, S2, S3)
+	jmp	.Lend
+.Lstore3:
+	AEGIS256_STORE(S3, S4, S5, S0, S1, S2)
+	jmp	.Lend
+.Lstore4:
+	AEGIS256_STORE(S2, S3, S4, S5, S0, S1)
+	jmp	.Lend
+.Lstore5:
+	AEGIS256_STORE(S1, S2, S3, S4, S5, S0)
+
+.Lend:
+	W64_EXIT(4, 8)
+	ret
+EPILOGUE(_nettle_aegis256_encrypt)
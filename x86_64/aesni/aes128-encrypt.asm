@@ -49,6 +49,8 @@ define(`KEY9', `%xmm9')
 define(`KEY10', `%xmm10')
 define(`X', `%xmm11')
 define(`Y', `%xmm12')
+define(`Z', `%xmm13')
+define(`W', `%xmm14')
 
 	.file "aes128-encrypt.asm"
 
@@ -59,7 +61,7 @@ define(`Y', `%xmm12')
 	.text
 	ALIGN(16)
 PROLOGUE(nettle_aes128_encrypt)
-	W64_ENTRY(4, 13)
+	W64_ENTRY(4, 15)
 	shr	$4, LENGTH
 	test	LENGTH, LENGTH
 	jz	.Lend
@@ -76,7 +78,7 @@ PROLOGUE(nettle_aes128_encrypt)
 	movups	144(CTX), KEY9
 	movups	160(CTX), KEY10
 	shr	LENGTH
-	jnc	.Lblock_loop
+	jnc	.Lblock2
 
 	movups	(SRC), X
 	pxor	KEY0, X
@@ -94,43 +96,107 @@ PROLOGUE(nettle_aes128_encrypt)
 	movups	X, (DST)
 	add	$16, SRC
 	add	$16, DST
+
+.Lblock2:
+	shr	LENGTH
+	jnc	.Lblock4
+
+	movups	(SRC), X
+	movups	16(SRC), Y
+	pxor	KEY0, X
+	pxor	KEY0, Y
+	aesenc	KEY1, X
+	aesenc	KEY1, Y
+	aesenc	KEY2, X
+	aesenc	KEY2, Y
+	aesenc	KEY3, X
+	aesenc	KEY3, Y
+	aesenc	KEY4, X
+	aesenc	KEY4, Y
+	aesenc	KEY5, X
+	aesenc	KEY5, Y
+	aesenc	KEY6, X
+	aesenc	KEY6, Y
+	aesenc	KEY7, X
+	aesenc	KEY7, Y
+	aesenc	KEY8, X
+	aesenc	KEY8, Y
+	aesenc	KEY9, X
+	aesenc	KEY9, Y
+	aesenclast KEY10, X
+	aesenclast KEY10, Y
+
+	movups	X, (DST)
+	movups	Y, 16(DST)
+	add	$32, SRC
+	add	$32, DST
+
+.Lblock4:
 	test	LENGTH, LENGTH
 	jz	.Lend
 
+	C Four blocks at a time, to keep more blocks in flight, e.g.,
+	C for the independent messages of the batch functions.
 .Lblock_loop:
 	movups	(SRC), X
 	movups	16(SRC), Y
+	movups	32(SRC), Z
+	movups	48(SRC), W
 	pxor	KEY0, X
 	pxor	KEY0, Y
+	pxor	KEY0, Z
+	pxor	KEY0, W
 	aesenc	KEY1, X
 	aesenc	KEY1, Y
+	aesenc	KEY1, Z
+	aesenc	KEY1, W
 	aesenc	KEY2, X
 	aesenc	KEY2, Y
+	aesenc	KEY2, Z
+	aesenc	KEY2, W
 	aesenc	KEY3, X
 	aesenc	KEY3, Y
+	aesenc	KEY3, Z
+	aesenc	KEY3, W
 	aesenc	KEY4, X
 	aesenc	KEY4, Y
+	aesenc	KEY4, Z
+	aesenc	KEY4, W
 	aesenc	KEY5, X
 	aesenc	KEY5, Y
+	aesenc	KEY5, Z
+	aesenc	KEY5, W
 	aesenc	KEY6, X
 	aesenc	KEY6, Y
+	aesenc	KEY6, Z
+	aesenc	KEY6, W
 	aesenc	KEY7, X
 	aesenc	KEY7, Y
+	aesenc	KEY7, Z
+	aesenc	KEY7, W
 	aesenc	KEY8, X
 	aesenc	KEY8, Y
+	aesenc	KEY8, Z
+	aesenc	KEY8, W
 	aesenc	KEY9, X
 	aesenc	KEY9, Y
+	aesenc	KEY9, Z
+	aesenc	KEY9, W
 	aesenclast KEY10, X
 	aesenclast KEY10, Y
+	aesenclast KEY10, Z
+	aesenclast KEY10, W
 
 	movups	X, (DST)
 	movups	Y, 16(DST)
-	add	$32, SRC
-	add	$32, DST
+	movups	Z, 32(DST)
+	movups	W, 48(DST)
+	add	$64, SRC
+	add	$64, DST
 	dec	LENGTH
 	jnz	.Lblock_loop
 
 .Lend:
-	W64_EXIT(4, 13)
+	W64_EXIT(4, 15)
 	ret
 EPILOGUE(nettle_aes128_encrypt)
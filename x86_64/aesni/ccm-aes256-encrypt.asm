@@ -0,0 +1,182 @@
+C x86_64/aesni/ccm-aes256-encrypt.asm
+
+ifelse(`
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Input argument
+define(`CTX',	`%rdi')
+define(`KEYS',	`%rsi')
+define(`LENGTH',`%rdx')
+define(`DST',	`%rcx')
+define(`SRC',	`%r8')
+
+define(`KEY0', `%xmm0')
+define(`KEY1', `%xmm1')
+define(`KEY2', `%xmm2')
+define(`KEY3', `%xmm3')
+define(`KEY4', `%xmm4')
+define(`KEY5', `%xmm5')
+define(`KEY6', `%xmm6')
+define(`KEY7', `%xmm7')
+define(`KEY8', `%xmm8')
+define(`KEY9', `%xmm9')
+define(`KEY10', `%xmm10')
+define(`TAG', `%xmm11')
+define(`KS', `%xmm12')
+define(`X', `%xmm13')
+define(`CTR', `%xmm14')
+define(`K', `%xmm15')
+
+	.file "ccm-aes256-encrypt.asm"
+
+C The CBC-MAC is a serial chain, with the latency of the complete
+C cipher per block. The counter block for CTR mode is independent of
+C it, and is processed in parallel, in the otherwise idle slots of the
+C aes unit.
+C
+C The counter is incremented as a 64-bit number, which is enough for
+C the at most 8 byte count field of CCM.
+
+	C size_t _ccm_aes256_encrypt(struct ccm_ctx *ctx,
+	C			     const struct aes256_ctx *cipher,
+	C			     size_t length, uint8_t *dst,
+	C			     const uint8_t *src);
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_ccm_aes256_encrypt)
+	W64_ENTRY(5, 16)
+	and	$-16, LENGTH
+	mov	LENGTH, %rax
+	jz	.Lend
+
+	movups	(KEYS), KEY0
+	movups	16(KEYS), KEY1
+	movups	32(KEYS), KEY2
+	movups	48(KEYS), KEY3
+	movups	64(KEYS), KEY4
+	movups	80(KEYS), KEY5
+	movups	96(KEYS), KEY6
+	movups	112(KEYS), KEY7
+	movups	128(KEYS), KEY8
+	movups	144(KEYS), KEY9
+	movups	160(KEYS), KEY10
+	movups	(CTX), CTR
+	pshufb	.Lbswap(%rip), CTR
+	movups	16(CTX), TAG
+
+	C Complete any partial block of associated data.
+	cmpw	$0, 32(CTX)
+	je	.Lpadded
+	movw	$0, 32(CTX)
+	pxor	KEY0, TAG
+	aesenc	KEY1, TAG
+	aesenc	KEY2, TAG
+	aesenc	KEY3, TAG
+	aesenc	KEY4, TAG
+	aesenc	KEY5, TAG
+	aesenc	KEY6, TAG
+	aesenc	KEY7, TAG
+	aesenc	KEY8, TAG
+	aesenc	KEY9, TAG
+	aesenc	KEY10, TAG
+	movups	176(KEYS), K
+	aesenc	K, TAG
+	movups	192(KEYS), K
+	aesenc	K, TAG
+	movups	208(KEYS), K
+	aesenc	K, TAG
+	movups	224(KEYS), K
+	aesenclast K, TAG
+
+.Lpadded:
+
+.Loop:
+	movups	(SRC), X
+	movdqa	CTR, KS
+	pshufb	.Lbswap(%rip), KS
+	paddq	.Lone(%rip), CTR
+	pxor	X, TAG
+	pxor	KEY0, TAG
+	pxor	KEY0, KS
+	aesenc	KEY1, TAG
+	aesenc	KEY1, KS
+	aesenc	KEY2, TAG
+	aesenc	KEY2, KS
+	aesenc	KEY3, TAG
+	aesenc	KEY3, KS
+	aesenc	KEY4, TAG
+	aesenc	KEY4, KS
+	aesenc	KEY5, TAG
+	aesenc	KEY5, KS
+	aesenc	KEY6, TAG
+	aesenc	KEY6, KS
+	aesenc	KEY7, TAG
+	aesenc	KEY7, KS
+	aesenc	KEY8, TAG
+	aesenc	KEY8, KS
+	aesenc	KEY9, TAG
+	aesenc	KEY9, KS
+	aesenc	KEY10, TAG
+	aesenc	KEY10, KS
+	movups	176(KEYS), K
+	aesenc	K, TAG
+	aesenc	K, KS
+	movups	192(KEYS), K
+	aesenc	K, TAG
+	aesenc	K, KS
+	movups	208(KEYS), K
+	aesenc	K, TAG
+	aesenc	K, KS
+	movups	224(KEYS), K
+	aesenclast K, TAG
+	aesenclast K, KS
+	pxor	X, KS
+	movups	KS, (DST)
+	add	$16, SRC
+	add	$16, DST
+	sub	$16, LENGTH
+	jnz	.Loop
+
+	pshufb	.Lbswap(%rip), CTR
+	movups	CTR, (CTX)
+	movups	TAG, 16(CTX)
+
+.Lend:
+	W64_EXIT(5, 16)
+	ret
+EPILOGUE(_nettle_ccm_aes256_encrypt)
+
+	RODATA
+	ALIGN(16)
+.Lbswap:
+	.byte 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+.Lone:
+	.byte 1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
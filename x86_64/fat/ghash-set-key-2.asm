@@ -32,6 +32,7 @@ ifelse(`
 
 dnl picked up by configure
 dnl PROLOGUE(_nettle_ghash_set_key)
+dnl PROLOGUE(_nettle_fat_ghash_set_key)
 
 define(`fat_transform', `$1_pclmul')
 include_src(`x86_64/pclmul/ghash-set-key.asm')
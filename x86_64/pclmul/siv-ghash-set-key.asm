@@ -0,0 +1,114 @@
+C x86_64/pclmul/siv-ghash-set-key.asm
+
+ifelse(`
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Common registers
+
+define(`CTX', `%rdi')
+define(`KEY', `%rsi')
+define(`P', `%xmm0')
+define(`H', `%xmm1')
+define(`D', `%xmm2')
+define(`X', `%xmm3')
+define(`T', `%xmm4')
+define(`M', `%xmm5')
+define(`F', `%xmm6')
+
+C POLYVAL uses the same field as GHASH, but without any bit
+C reflection. With the representation used by _ghash_set_key, the
+C byte reversal and the multiplication by x needed to express POLYVAL
+C in terms of GHASH cancel, and the key is used as is.
+C
+C The expanded key holds the powers H, H^2, ..., H^8, each followed
+C by the corresponding D = x^{-64} H^k, for the aggregated reduction
+C in _siv_ghash_update.
+
+    C void _siv_ghash_set_key (struct gcm_key *ctx, const union nettle_block16 *key)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_siv_ghash_set_key)
+	W64_ENTRY(2, 7)
+	movdqa	.Lpolynomial(%rip), P
+	movups	(KEY), H
+
+	C Set D = x^{-64} H = {H0, H1} + P1 H0
+	movdqa	H, T
+	pshufd	$0x4e, H, D	C Swap H0, H1
+	pclmullqhqdq P, T
+	pxor	T, D
+	movups	H, (CTX)
+	movups	D, 16(CTX)
+
+	movdqa	H, X
+	mov	$7, %eax
+.Loop:
+	C Multiply X by H
+	movdqa		X, M
+	movdqa		X, F
+	movdqa		X, T
+	pclmulhqlqdq	H, T	C H0 * X1
+	pclmulhqhqdq	H, M	C H1 * X1
+	pclmullqlqdq	D, F 	C D0 * X0
+	pclmullqhqdq	D, X	C D1 * X0
+	pxor		T, F
+	pxor		M, X
+
+	pshufd		$0x4e, F, T		C Swap halves of F
+	pxor		T, X
+	pclmullqhqdq	P, F
+	pxor		F, X
+
+	C And the corresponding x^{-64} X
+	movdqa	X, T
+	pshufd	$0x4e, X, M
+	pclmullqhqdq P, T
+	pxor	T, M
+
+	add	$32, CTX
+	movups	X, (CTX)
+	movups	M, 16(CTX)
+	dec	%eax
+	jnz	.Loop
+
+	W64_EXIT(2, 7)
+	ret
+EPILOGUE(_nettle_siv_ghash_set_key)
+
+	RODATA
+	C The GCM polynomial is x^{128} + x^7 + x^2 + x + 1,
+	C but in bit-reversed representation, that is
+	C P = x^{128}+ x^{127} + x^{126} + x^{121} + 1
+	C We will mainly use the middle part,
+	C P1 = (P + a + x^{128}) / x^64 = x^{563} + x^{62} + x^{57}
+	ALIGN(16)
+.Lpolynomial:
+	.byte 1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0xC2
@@ -0,0 +1,167 @@
+C x86_64/pclmul/siv-ghash-update.asm
+
+ifelse(`
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+C Common registers
+
+define(`CTX', `%rdi')
+define(`X', `%rsi')
+define(`BLOCKS', `%rdx')
+define(`DATA', `%rcx')
+
+define(`P', `%xmm0')
+define(`BSWAP', `%xmm1')
+define(`R', `%xmm2')
+define(`F', `%xmm3')
+define(`M', `%xmm4')
+define(`T', `%xmm5')
+define(`T2', `%xmm6')
+define(`T3', `%xmm7')
+
+C Like _ghash_update, but the data blocks are used without byte
+C reversal, and the key holds the powers H, ..., H^8, see
+C siv-ghash-set-key.asm. Eight blocks are processed per iteration,
+C
+C   R + x^{-64} F = x^{-127} (M_1 H^8 + M_2 H^7 + ... + M_8 H)
+C
+C where the state is added to M_1, and the final reduction is done
+C only once per iteration. The key powers are used as memory
+C operands, leaving registers only for the accumulators and
+C temporaries.
+
+C MUL_ADD(i), multiplies block i by H^{8-i}, and accumulates in R, F.
+define(`MUL_ADD', `
+	movups		eval(16*$1)(DATA), M
+	movdqa		M, T
+	movdqa		M, T2
+	movdqa		M, T3
+	pclmullqlqdq	eval(32*(7-$1)+16)(CTX), T	C D0 * M0
+	pclmullqhqdq	eval(32*(7-$1)+16)(CTX), T2	C D1 * M0
+	pclmulhqlqdq	eval(32*(7-$1))(CTX), T3	C H0 * M1
+	pclmulhqhqdq	eval(32*(7-$1))(CTX), M	C H1 * M1
+	pxor		T, F
+	pxor		T2, R
+	pxor		T3, F
+	pxor		M, R
+')
+
+	C const uint8_t *_siv_ghash_update (const struct gcm_key *ctx,
+	C				    union nettle_block16 *x,
+	C				    size_t blocks, const uint8_t *data)
+
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_siv_ghash_update)
+	W64_ENTRY(4, 8)
+	movdqa		.Lpolynomial(%rip), P
+	movdqa		.Lbswap(%rip), BSWAP
+	movups		(X), R
+	pshufb		BSWAP, R
+
+	mov		BLOCKS, %rax
+	shr		$3, %rax
+	jz		.Lrest
+
+.Loop:
+	movups		(DATA), M
+	pxor		R, M
+	movdqa		M, F
+	movdqa		M, R
+	movdqa		M, T
+	pclmullqlqdq	240(CTX), F	C {D^8}0 * M0
+	pclmullqhqdq	240(CTX), R	C {D^8}1 * M0
+	pclmulhqlqdq	224(CTX), T	C {H^8}0 * M1
+	pclmulhqhqdq	224(CTX), M	C {H^8}1 * M1
+	pxor		T, F
+	pxor		M, R
+
+	MUL_ADD(1)
+	MUL_ADD(2)
+	MUL_ADD(3)
+	MUL_ADD(4)
+	MUL_ADD(5)
+	MUL_ADD(6)
+	MUL_ADD(7)
+
+	pshufd		$0x4e, F, T		C Swap halves of F
+	pxor		T, R
+	pclmullqhqdq	P, F
+	pxor		F, R
+
+	add		$128, DATA
+	dec		%rax
+	jnz		.Loop
+
+.Lrest:
+	and		$7, BLOCKS
+	jz		.Ldone
+
+.Loop1:
+	movups		(DATA), M
+	pxor		R, M
+	movdqa		M, F
+	movdqa		M, R
+	movdqa		M, T
+	pclmullqlqdq	16(CTX), F	C D0 * M0
+	pclmullqhqdq	16(CTX), R	C D1 * M0
+	pclmulhqlqdq	(CTX), T	C H0 * M1
+	pclmulhqhqdq	(CTX), M	C H1 * M1
+	pxor		T, F
+	pxor		M, R
+
+	pshufd		$0x4e, F, T		C Swap halves of F
+	pxor		T, R
+	pclmullqhqdq	P, F
+	pxor		F, R
+
+	add		$16, DATA
+	dec		BLOCKS
+	jnz		.Loop1
+
+.Ldone:
+	pshufb		BSWAP, R
+	movups		R, (X)
+	mov		DATA, %rax
+	W64_EXIT(4, 8)
+	ret
+EPILOGUE(_nettle_siv_ghash_update)
+
+	RODATA
+	C The GCM polynomial is x^{128} + x^7 + x^2 + x + 1,
+	C but in bit-reversed representation, that is
+	C P = x^{128}+ x^{127} + x^{126} + x^{121} + 1
+	C We will mainly use the middle part,
+	C P1 = (P + a + x^{128}) / x^64 = x^{563} + x^{62} + x^{57}
+	ALIGN(16)
+.Lpolynomial:
+	.byte 1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0xC2
+.Lbswap:
+	.byte 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
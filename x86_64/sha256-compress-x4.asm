@@ -0,0 +1,373 @@
+C x86_64/sha256-compress-x4.asm
+
+ifelse(`
+   Copyright (C) 2026 Niels Möller
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+')
+
+	.file "sha256-compress-x4.asm"
+define(`STATE', `%rdi')
+define(`INPUT', `%rsi')
+define(`K', `%rdx')
+define(`COUNT', `%ecx')
+define(`FRAME', `%r11')
+
+C Each register holds one state word for all four lanes.
+define(`SA', `%xmm0')
+define(`SB', `%xmm1')
+define(`SC', `%xmm2')
+define(`SD', `%xmm3')
+define(`SE', `%xmm4')
+define(`SF', `%xmm5')
+define(`SG', `%xmm6')
+define(`SH', `%xmm7')
+define(`T0', `%xmm8')
+define(`T1', `%xmm9')
+define(`X', `%xmm10')
+define(`Y', `%xmm11')
+define(`U0', `%xmm12')
+define(`U1', `%xmm13')
+define(`U2', `%xmm14')
+define(`U3', `%xmm15')
+
+C The message schedule is kept in a 16-entry ring buffer on the
+C (aligned) stack, followed by a copy of the initial state. K points
+C at the round constants for the current group of 16 rounds, each
+C one repeated for all lanes.
+define(`WREG', `eval(16*(($1) % 16))(%rsp)')
+define(`SREG', `eval(256 + 16*($1))(%rsp)')
+define(`KREG', `eval(16*(($1) % 16))(K)')
+
+C TRANSPOSE(I0, I1, I2, I3, O0, O1, O2, O3)
+C Transposes a 4x4 matrix of 32-bit words, clobbering the inputs.
+define(`TRANSPOSE', `
+	movdqa	$1, $5
+	punpckldq	$2, $5
+	punpckhdq	$2, $1
+	movdqa	$3, $7
+	punpckldq	$4, $7
+	punpckhdq	$4, $3
+	movdqa	$5, $6
+	punpckhqdq	$7, $6
+	punpcklqdq	$7, $5
+	movdqa	$1, $8
+	punpckhqdq	$3, $8
+	movdqa	$1, $7
+	punpcklqdq	$3, $7
+')
+
+C BSWAP(R), byte swap of each 32-bit word, clobbers X. Without
+C pshufb, swap the 16-bit halves, and then the bytes of each half.
+define(`BSWAP', `
+	pshuflw	`$'0xb1, $1, $1
+	pshufhw	`$'0xb1, $1, $1
+	movdqa	$1, X
+	psllw	`$'8, $1
+	psrlw	`$'8, X
+	por	X, $1
+')
+
+C LOADW(i), loads and transposes message words i, ..., i+3 of all
+C lanes, using SA, ..., SD as temporaries.
+define(`LOADW', `
+	movdqu	eval(4*$1)(INPUT), U0
+	movdqu	eval(4*$1 + 64)(INPUT), U1
+	movdqu	eval(4*$1 + 128)(INPUT), U2
+	movdqu	eval(4*$1 + 192)(INPUT), U3
+	TRANSPOSE(U0, U1, U2, U3, SA, SB, SC, SD)
+	BSWAP(SA)
+	BSWAP(SB)
+	BSWAP(SC)
+	BSWAP(SD)
+	movdqa	SA, WREG($1)
+	movdqa	SB, WREG($1 + 1)
+	movdqa	SC, WREG($1 + 2)
+	movdqa	SD, WREG($1 + 3)
+')
+
+C LOADS(i, A, B, C, D), loads state words i, ..., i+3 of all lanes.
+define(`LOADS', `
+	movdqu	eval(4*$1)(STATE), U0
+	movdqu	eval(4*$1 + 32)(STATE), U1
+	movdqu	eval(4*$1 + 64)(STATE), U2
+	movdqu	eval(4*$1 + 96)(STATE), U3
+	TRANSPOSE(U0, U1, U2, U3, $2, $3, $4, $5)
+	movdqa	$2, SREG($1)
+	movdqa	$3, SREG($1 + 1)
+	movdqa	$4, SREG($1 + 2)
+	movdqa	$5, SREG($1 + 3)
+')
+
+C STORES(i, A, B, C, D), adds the initial state and stores words
+C i, ..., i+3 of all lanes.
+define(`STORES', `
+	paddd	SREG($1), $2
+	paddd	SREG($1 + 1), $3
+	paddd	SREG($1 + 2), $4
+	paddd	SREG($1 + 3), $5
+	TRANSPOSE($2, $3, $4, $5, U0, U1, U2, U3)
+	movdqu	U0, eval(4*$1)(STATE)
+	movdqu	U1, eval(4*$1 + 32)(STATE)
+	movdqu	U2, eval(4*$1 + 64)(STATE)
+	movdqu	U3, eval(4*$1 + 96)(STATE)
+')
+
+C EXPN(i) computes W[i] = s1(W[i-2]) + W[i-7] + s0(W[i-15]) + W[i-16],
+C where s0(x) = (x >>> 7) ^ (x >>> 18) ^ (x >> 3)
+C and s1(x) = (x >>> 17) ^ (x >>> 19) ^ (x >> 10)
+define(`EXPN', `
+	movdqa	WREG($1 - 15), X
+	movdqa	X, T0
+	psrld	`$'3, T0
+	movdqa	X, T1
+	psrld	`$'7, T1
+	pxor	T1, T0
+	psrld	`$'11, T1
+	pxor	T1, T0
+	pslld	`$'14, X
+	pxor	X, T0
+	pslld	`$'11, X
+	pxor	X, T0
+	paddd	WREG($1), T0
+	paddd	WREG($1 - 7), T0
+	movdqa	WREG($1 - 2), X
+	movdqa	X, T1
+	psrld	`$'10, T1
+	movdqa	X, Y
+	psrld	`$'17, Y
+	pxor	Y, T1
+	psrld	`$'2, Y
+	pxor	Y, T1
+	pslld	`$'13, X
+	pxor	X, T1
+	pslld	`$'2, X
+	pxor	X, T1
+	paddd	T1, T0
+	movdqa	T0, WREG($1)
+')
+
+C ROUND(A,B,C,D,E,F,G,H,i)
+C
+C H += S1(E) + Choice(E,F,G) + K + W
+C D += H
+C H += S0(A) + Majority(A,B,C)
+C
+C Where
+C
+C S1(E) = E<<<26 ^ E<<<21 ^ E<<<7
+C S0(A) = A<<<30 ^ A<<<19 ^ A<<<10
+C Choice (E, F, G) = G^(E&(F^G))
+C Majority (A,B,C) = (A&B) + (C&(A^B))
+C
+C There are no vector rotates before AVX-512, so each rotation is
+C made from a pair of shifts.
+define(`ROUND', `
+	paddd	WREG($9), $8
+	paddd	KREG($9), $8
+	movdqa	$5, T0
+	psrld	`$'6, T0
+	movdqa	T0, T1
+	psrld	`$'5, T1
+	pxor	T1, T0
+	psrld	`$'14, T1
+	pxor	T1, T0
+	movdqa	$5, T1
+	pslld	`$'7, T1
+	pxor	T1, T0
+	pslld	`$'14, T1
+	pxor	T1, T0
+	pslld	`$'5, T1
+	pxor	T1, T0
+	paddd	T0, $8
+	movdqa	$6, T0
+	pxor	$7, T0
+	pand	$5, T0
+	pxor	$7, T0
+	paddd	T0, $8
+	paddd	$8, $4
+	movdqa	$1, T0
+	psrld	`$'2, T0
+	movdqa	T0, T1
+	psrld	`$'11, T1
+	pxor	T1, T0
+	psrld	`$'9, T1
+	pxor	T1, T0
+	movdqa	$1, T1
+	pslld	`$'10, T1
+	pxor	T1, T0
+	pslld	`$'9, T1
+	pxor	T1, T0
+	pslld	`$'11, T1
+	pxor	T1, T0
+	paddd	T0, $8
+	movdqa	$1, T0
+	pand	$2, T0
+	paddd	T0, $8
+	movdqa	$1, T0
+	pxor	$2, T0
+	pand	$3, T0
+	paddd	T0, $8
+')
+
+	C void
+	C _nettle_sha256_compress_x4(uint32_t *state, const uint8_t *input)
+
+	.text
+	ALIGN(16)
+
+PROLOGUE(_nettle_sha256_compress_x4)
+	W64_ENTRY(2, 16)
+	mov	%rsp, FRAME
+	sub	$384, %rsp
+	and	$-16, %rsp
+
+	lea	.Lk(%rip), K
+
+	LOADW(0)
+	LOADW(4)
+	LOADW(8)
+	LOADW(12)
+
+	LOADS(0, SA, SB, SC, SD)
+	LOADS(4, SE, SF, SG, SH)
+
+	ROUND(SA,SB,SC,SD,SE,SF,SG,SH,0)
+	ROUND(SH,SA,SB,SC,SD,SE,SF,SG,1)
+	ROUND(SG,SH,SA,SB,SC,SD,SE,SF,2)
+	ROUND(SF,SG,SH,SA,SB,SC,SD,SE,3)
+	ROUND(SE,SF,SG,SH,SA,SB,SC,SD,4)
+	ROUND(SD,SE,SF,SG,SH,SA,SB,SC,5)
+	ROUND(SC,SD,SE,SF,SG,SH,SA,SB,6)
+	ROUND(SB,SC,SD,SE,SF,SG,SH,SA,7)
+	ROUND(SA,SB,SC,SD,SE,SF,SG,SH,8)
+	ROUND(SH,SA,SB,SC,SD,SE,SF,SG,9)
+	ROUND(SG,SH,SA,SB,SC,SD,SE,SF,10)
+	ROUND(SF,SG,SH,SA,SB,SC,SD,SE,11)
+	ROUND(SE,SF,SG,SH,SA,SB,SC,SD,12)
+	ROUND(SD,SE,SF,SG,SH,SA,SB,SC,13)
+	ROUND(SC,SD,SE,SF,SG,SH,SA,SB,14)
+	ROUND(SB,SC,SD,SE,SF,SG,SH,SA,15)
+
+	mov	$3, COUNT
+	ALIGN(16)
+.Loop:
+	add	$256, K
+	EXPN(16) ROUND(SA,SB,SC,SD,SE,SF,SG,SH,16)
+	EXPN(17) ROUND(SH,SA,SB,SC,SD,SE,SF,SG,17)
+	EXPN(18) ROUND(SG,SH,SA,SB,SC,SD,SE,SF,18)
+	EXPN(19) ROUND(SF,SG,SH,SA,SB,SC,SD,SE,19)
+	EXPN(20) ROUND(SE,SF,SG,SH,SA,SB,SC,SD,20)
+	EXPN(21) ROUND(SD,SE,SF,SG,SH,SA,SB,SC,21)
+	EXPN(22) ROUND(SC,SD,SE,SF,SG,SH,SA,SB,22)
+	EXPN(23) ROUND(SB,SC,SD,SE,SF,SG,SH,SA,23)
+	EXPN(24) ROUND(SA,SB,SC,SD,SE,SF,SG,SH,24)
+	EXPN(25) ROUND(SH,SA,SB,SC,SD,SE,SF,SG,25)
+	EXPN(26) ROUND(SG,SH,SA,SB,SC,SD,SE,SF,26)
+	EXPN(27) ROUND(SF,SG,SH,SA,SB,SC,SD,SE,27)
+	EXPN(28) ROUND(SE,SF,SG,SH,SA,SB,SC,SD,28)
+	EXPN(29) ROUND(SD,SE,SF,SG,SH,SA,SB,SC,29)
+	EXPN(30) ROUND(SC,SD,SE,SF,SG,SH,SA,SB,30)
+	EXPN(31) ROUND(SB,SC,SD,SE,SF,SG,SH,SA,31)
+	dec	COUNT
+	jnz	.Loop
+
+	STORES(0, SA, SB, SC, SD)
+	STORES(4, SE, SF, SG, SH)
+
+	mov	FRAME, %rsp
+	W64_EXIT(2, 16)
+	ret
+EPILOGUE(_nettle_sha256_compress_x4)
+
+	RODATA
+	ALIGN(16)
+.Lk:
+	.long 0x428a2f98, 0x428a2f98, 0x428a2f98, 0x428a2f98
+	.long 0x71374491, 0x71374491, 0x71374491, 0x71374491
+	.long 0xb5c0fbcf, 0xb5c0fbcf, 0xb5c0fbcf, 0xb5c0fbcf
+	.long 0xe9b5dba5, 0xe9b5dba5, 0xe9b5dba5, 0xe9b5dba5
+	.long 0x3956c25b, 0x3956c25b, 0x3956c25b, 0x3956c25b
+	.long 0x59f111f1, 0x59f111f1, 0x59f111f1, 0x59f111f1
+	.long 0x923f82a4, 0x923f82a4, 0x923f82a4, 0x923f82a4
+	.long 0xab1c5ed5, 0xab1c5ed5, 0xab1c5ed5, 0xab1c5ed5
+	.long 0xd807aa98, 0xd807aa98, 0xd807aa98, 0xd807aa98
+	.long 0x12835b01, 0x12835b01, 0x12835b01, 0x12835b01
+	.long 0x243185be, 0x243185be, 0x243185be, 0x243185be
+	.long 0x550c7dc3, 0x550c7dc3, 0x550c7dc3, 0x550c7dc3
+	.long 0x72be5d74, 0x72be5d74, 0x72be5d74, 0x72be5d74
+	.long 0x80deb1fe, 0x80deb1fe, 0x80deb1fe, 0x80deb1fe
+	.long 0x9bdc06a7, 0x9bdc06a7, 0x9bdc06a7, 0x9bdc06a7
+	.long 0xc19bf174, 0xc19bf174, 0xc19bf174, 0xc19bf174
+	.long 0xe49b69c1, 0xe49b69c1, 0xe49b69c1, 0xe49b69c1
+	.long 0xefbe4786, 0xefbe4786, 0xefbe4786, 0xefbe4786
+	.long 0x0fc19dc6, 0x0fc19dc6, 0x0fc19dc6, 0x0fc19dc6
+	.long 0x240ca1cc, 0x240ca1cc, 0x240ca1cc, 0x240ca1cc
+	.long 0x2de92c6f, 0x2de92c6f, 0x2de92c6f, 0x2de92c6f
+	.long 0x4a7484aa, 0x4a7484aa, 0x4a7484aa, 0x4a7484aa
+	.long 0x5cb0a9dc, 0x5cb0a9dc, 0x5cb0a9dc, 0x5cb0a9dc
+	.long 0x76f988da, 0x76f988da, 0x76f988da, 0x76f988da
+	.long 0x983e5152, 0x983e5152, 0x983e5152, 0x983e5152
+	.long 0xa831c66d, 0xa831c66d, 0xa831c66d, 0xa831c66d
+	.long 0xb00327c8, 0xb00327c8, 0xb00327c8, 0xb00327c8
+	.long 0xbf597fc7, 0xbf597fc7, 0xbf597fc7, 0xbf597fc7
+	.long 0xc6e00bf3, 0xc6e00bf3, 0xc6e00bf3, 0xc6e00bf3
+	.long 0xd5a79147, 0xd5a79147, 0xd5a79147, 0xd5a79147
+	.long 0x06ca6351, 0x06ca6351, 0x06ca6351, 0x06ca6351
+	.long 0x14292967, 0x14292967, 0x14292967, 0x14292967
+	.long 0x27b70a85, 0x27b70a85, 0x27b70a85, 0x27b70a85
+	.long 0x2e1b2138, 0x2e1b2138, 0x2e1b2138, 0x2e1b2138
+	.long 0x4d2c6dfc, 0x4d2c6dfc, 0x4d2c6dfc, 0x4d2c6dfc
+	.long 0x53380d13, 0x53380d13, 0x53380d13, 0x53380d13
+	.long 0x650a7354, 0x650a7354, 0x650a7354, 0x650a7354
+	.long 0x766a0abb, 0x766a0abb, 0x766a0abb, 0x766a0abb
+	.long 0x81c2c92e, 0x81c2c92e, 0x81c2c92e, 0x81c2c92e
+	.long 0x92722c85, 0x92722c85, 0x92722c85, 0x92722c85
+	.long 0xa2bfe8a1, 0xa2bfe8a1, 0xa2bfe8a1, 0xa2bfe8a1
+	.long 0xa81a664b, 0xa81a664b, 0xa81a664b, 0xa81a664b
+	.long 0xc24b8b70, 0xc24b8b70, 0xc24b8b70, 0xc24b8b70
+	.long 0xc76c51a3, 0xc76c51a3, 0xc76c51a3, 0xc76c51a3
+	.long 0xd192e819, 0xd192e819, 0xd192e819, 0xd192e819
+	.long 0xd6990624, 0xd6990624, 0xd6990624, 0xd6990624
+	.long 0xf40e3585, 0xf40e3585, 0xf40e3585, 0xf40e3585
+	.long 0x106aa070, 0x106aa070, 0x106aa070, 0x106aa070
+	.long 0x19a4c116, 0x19a4c116, 0x19a4c116, 0x19a4c116
+	.long 0x1e376c08, 0x1e376c08, 0x1e376c08, 0x1e376c08
+	.long 0x2748774c, 0x2748774c, 0x2748774c, 0x2748774c
+	.long 0x34b0bcb5, 0x34b0bcb5, 0x34b0bcb5, 0x34b0bcb5
+	.long 0x391c0cb3, 0x391c0cb3, 0x391c0cb3, 0x391c0cb3
+	.long 0x4ed8aa4a, 0x4ed8aa4a, 0x4ed8aa4a, 0x4ed8aa4a
+	.long 0x5b9cca4f, 0x5b9cca4f, 0x5b9cca4f, 0x5b9cca4f
+	.long 0x682e6ff3, 0x682e6ff3, 0x682e6ff3, 0x682e6ff3
+	.long 0x748f82ee, 0x748f82ee, 0x748f82ee, 0x748f82ee
+	.long 0x78a5636f, 0x78a5636f, 0x78a5636f, 0x78a5636f
+	.long 0x84c87814, 0x84c87814, 0x84c87814, 0x84c87814
+	.long 0x8cc70208, 0x8cc70208, 0x8cc70208, 0x8cc70208
+	.long 0x90befffa, 0x90befffa, 0x90befffa, 0x90befffa
+	.long 0xa4506ceb, 0xa4506ceb, 0xa4506ceb, 0xa4506ceb
+	.long 0xbef9a3f7, 0xbef9a3f7, 0xbef9a3f7, 0xbef9a3f7
+	.long 0xc67178f2, 0xc67178f2, 0xc67178f2, 0xc67178f2